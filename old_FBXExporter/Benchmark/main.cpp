@@ -0,0 +1,701 @@
+#include "../Library/defines.h"
+#include "../Library/interface.h"
+#include "../Library/meshlet.h"
+#include "../Library/weld.h"
+#include "../Runtime/interface.h"
+#include "../Runtime/loader.h"
+
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+	// Clips sampled when no paths are given. Export them from the bundled .fbx files first.
+	// .animlib files are also accepted, and every clip in them is sampled. .mesh files are
+	// accepted to time loading them.
+	const char*							defaultClips[] =
+	{
+		"../../assets/Run.anim"
+		, "../../assets/Walk.anim"
+		, "../../assets/Idle.anim"
+	};
+
+	// Meshes run through the mesh stages when no paths are given. .fbx files are read with the
+	// binary reader, so the FBX SDK is not used.
+	const char*							defaultMeshes[] =
+	{
+		"../../assets/terrain.fbx"
+		, "../../assets/BattleMage.fbx"
+	};
+
+	// Seconds spent sampling each clip.
+	const double						sampleSeconds = 1.0;
+
+	// Poses sampled between clock reads.
+	const uint32_t						posesPerBatch = 1024;
+
+	// Times each load or mesh stage is repeated. The fastest run is reported, with files in the OS cache.
+	const uint32_t						runRepetitions = 20;
+
+	/* Samples a clip repeatedly and prints its throughput.
+	  PARAMETERS
+		_in_name : The name to print the results under.
+		_in_clip : The clip to sample.
+		_in_loadMilliseconds : The time spent loading the clip.
+	*/
+	void BenchmarkClip(
+		const std::string&							_in_name
+		, const fbx_exporter::runtime::AnimationClip&	_in_clip
+		, const double								_in_loadMilliseconds
+	) {
+		using clock = std::chrono::high_resolution_clock;
+
+		fbx_exporter::runtime::AnimationPose pose;
+
+		fbx_exporter::runtime::InitializeAnimationPose(_in_clip, pose);
+
+		// step through the clip at an interval that does not line up with its keys
+		float length = _in_clip.key_interval * (_in_clip.key_count > 1 ? _in_clip.key_count - 1 : 1);
+		float step = length / 997.0f;
+		float time = 0.0f;
+		uint64_t poseCount = 0;
+		float checksum = 0.0f;
+		double seconds = 0.0;
+
+		clock::time_point sampleStart = clock::now();
+		while (seconds < sampleSeconds)
+		{
+			for (uint32_t i = 0; i < posesPerBatch; i++)
+			{
+				fbx_exporter::runtime::SampleAnimationClip(_in_clip, _in_clip.start_time + time, pose);
+				time += step;
+				if (time > length)
+					time -= length;
+			}
+
+			// read the pose so sampling cannot be optimized away
+			checksum += pose.blocks[0].rotation[3][0];
+			poseCount += posesPerBatch;
+			seconds = std::chrono::duration<double>(clock::now() - sampleStart).count();
+		}
+
+		double posesPerSecond = poseCount / seconds;
+
+		std::cout << _in_name << std::endl
+			<< "  joints : " << _in_clip.joint_count
+			<< "  keys : " << _in_clip.key_count
+			<< "  load : " << _in_loadMilliseconds << " ms" << std::endl
+			<< "  poses/sec : " << (uint64_t)posesPerSecond
+			<< "  ns/joint : " << 1.0e9 / (posesPerSecond * _in_clip.joint_count)
+			<< "  (checksum " << checksum << ")" << std::endl;
+	}
+
+	/* Adds up the bytes of a range 8 at a time, so that every page of it is touched.
+	  PARAMETERS
+		_in_data_p : The start of the range.
+		_in_size : The length of the range in bytes.
+	  RETURNS
+		The sum of the range's 64-bit words and trailing bytes.
+	*/
+	uint64_t SumBytes(
+		const void*									_in_data_p
+		, const size_t								_in_size
+	) {
+		const uint8_t* bytes_p = (const uint8_t*)_in_data_p;
+		uint64_t sum = 0;
+		size_t i = 0;
+
+		for (; i + sizeof(uint64_t) <= _in_size; i += sizeof(uint64_t))
+		{
+			uint64_t word;
+			memcpy(&word, bytes_p + i, sizeof(word));
+			sum += word;
+		}
+		for (; i < _in_size; i++)
+			sum += bytes_p[i];
+
+		return sum;
+	}
+
+	/* Runs a load or mesh stage repeatedly and measures the fastest run.
+	  PARAMETERS
+		_in_run : The work to run. Returns false if it failed.
+		_out_milliseconds : The time of the fastest run.
+	  RETURNS
+		true : Every run succeeded.
+		false : A run failed.
+	*/
+	template <typename Run>
+	bool TimeFastestRun(
+		Run											_in_run
+		, double&									_out_milliseconds
+	) {
+		using clock = std::chrono::high_resolution_clock;
+
+		_out_milliseconds = 0.0;
+		for (uint32_t i = 0; i < runRepetitions; i++)
+		{
+			clock::time_point runStart = clock::now();
+			if (!_in_run())
+				return false;
+			double milliseconds = std::chrono::duration<double, std::milli>(clock::now() - runStart).count();
+
+			if (i == 0 || milliseconds < _out_milliseconds)
+				_out_milliseconds = milliseconds;
+		}
+
+		return true;
+	}
+
+	/* Reads the header and section table of a container file, as a loader without mapping would.
+	  PARAMETERS
+		_out_stream : The open file. Left after the section table.
+		_in_type : The kind of container expected.
+		_out_sections : The section table.
+	  RETURNS
+		true : The header is valid and the section table was read.
+		false : The file is not a container of that kind.
+	*/
+	bool ReadContainerTable(
+		std::ifstream&								_out_stream
+		, const fbx_exporter::runtime::ContainerType	_in_type
+		, std::vector<fbx_exporter::runtime::ContainerSection>&	_out_sections
+	) {
+		fbx_exporter::runtime::ContainerHeader header;
+		if (!_out_stream.read((char*)&header, sizeof(header)) || header.magic != fbx_exporter::runtime::CONTAINER_MAGIC
+			|| header.version_major != fbx_exporter::runtime::CONTAINER_VERSION_MAJOR || header.type != _in_type)
+			return false;
+
+		_out_sections.resize(header.section_count);
+		_out_stream.seekg(header.section_table_offset);
+		return (bool)_out_stream.read((char*)_out_sections.data(), _out_sections.size() * sizeof(fbx_exporter::runtime::ContainerSection));
+	}
+
+	/* Reads a section of a container file into a vector, as a loader without mapping would.
+	  PARAMETERS
+		_out_stream : The open file.
+		_in_sections : The file's section table.
+		_in_type : The section to read.
+		_out_elements : The section's bytes as elements of type T. Empty if the file has no such section.
+	  RETURNS
+		true : The section was read, or the file has no such section.
+		false : The file ended early.
+	*/
+	template <typename T>
+	bool ReadContainerSection(
+		std::ifstream&								_out_stream
+		, const std::vector<fbx_exporter::runtime::ContainerSection>&	_in_sections
+		, const fbx_exporter::runtime::SectionType	_in_type
+		, std::vector<T>&							_out_elements
+	) {
+		_out_elements.clear();
+		for (const fbx_exporter::runtime::ContainerSection& section : _in_sections)
+			if (section.type == _in_type)
+			{
+				_out_elements.resize((size_t)(section.element_count * section.element_size / sizeof(T)));
+				_out_stream.seekg(section.offset);
+				return (bool)_out_stream.read((char*)_out_elements.data(), _out_elements.size() * sizeof(T));
+			}
+
+		return true;
+	}
+
+	/* Removes duplicate vertices by comparing every raw vertex against every unique vertex found
+	  so far, as CompactifyVertices did before it used a hash table. Kept as the baseline it is
+	  timed against.
+	  PARAMETERS
+		_in_vertices : The raw vertex list, three vertices per triangle.
+		_out_vertices : The unique vertex list.
+		_out_indices : The index list referencing _out_vertices.
+	*/
+	void CompactifyVerticesQuadratic(
+		const std::vector<fbx_exporter::library::Vertex>&	_in_vertices
+		, std::vector<fbx_exporter::library::Vertex>&		_out_vertices
+		, std::vector<uint32_t>&							_out_indices
+	) {
+		for (const fbx_exporter::library::Vertex& vertex : _in_vertices)
+		{
+			uint32_t index = (uint32_t)_out_vertices.size();
+			for (uint32_t v = 0; v < _out_vertices.size(); v++)
+				if (vertex == _out_vertices[v])
+				{
+					index = v;
+					break;
+				}
+
+			if (index == _out_vertices.size())
+				_out_vertices.push_back(vertex);
+			_out_indices.push_back(index);
+		}
+	}
+
+	/* Reads the first mesh of a .fbx file and times and measures each mesh stage on it.
+	  PARAMETERS
+		_in_filepath : The path to the binary .fbx file.
+	  RETURNS
+		true : The mesh was read and every stage succeeded.
+		false : The file could not be read, or a stage failed or gave a wrong result.
+	*/
+	bool BenchmarkMeshStages(const std::string& _in_filepath)
+	{
+		namespace library = fbx_exporter::library;
+
+		library::Mesh mesh;
+		if (!library::Succeeded(library::GetMeshFromFbxBinaryFile(_in_filepath.c_str(), "",
+			static_cast<uint32_t>(library::MeshElement::ALL), mesh)))
+		{
+			std::cout << "FAIL : " << _in_filepath << std::endl;
+			return false;
+		}
+
+		std::cout << _in_filepath << std::endl
+			<< "  vertices : " << mesh.vertices.size()
+			<< "  triangles : " << mesh.indices.size() / 3 << std::endl;
+
+		// -- weld --
+		// the reader welds corners as it reads them, so expand the indices back into one vertex per corner
+		std::vector<library::Vertex> corners(mesh.indices.size());
+		for (size_t i = 0; i < mesh.indices.size(); i++)
+			corners[i] = mesh.vertices[mesh.indices[i]];
+
+		std::vector<library::Vertex> quadraticVertices, hashedVertices;
+		std::vector<uint32_t> quadraticIndices, hashedIndices;
+		double quadraticMilliseconds = 0.0, hashedMilliseconds = 0.0;
+
+		bool welded = TimeFastestRun([&]()
+			{
+				quadraticVertices.clear();
+				quadraticIndices.clear();
+				CompactifyVerticesQuadratic(corners, quadraticVertices, quadraticIndices);
+				return true;
+			}, quadraticMilliseconds)
+			&& TimeFastestRun([&]()
+			{
+				hashedVertices.clear();
+				hashedIndices.clear();
+				return library::CompactifyVertices(corners, hashedVertices, hashedIndices) == library::Result::SUCCESS;
+			}, hashedMilliseconds);
+
+		// both welders keep vertices in order of first use, so their output must match exactly
+		bool identical = hashedIndices == quadraticIndices && hashedVertices.size() == quadraticVertices.size()
+			&& memcmp(hashedVertices.data(), quadraticVertices.data(), hashedVertices.size() * sizeof(library::Vertex)) == 0;
+
+		std::cout << "  weld : " << corners.size() << " corners -> " << hashedVertices.size() << " vertices, quadratic "
+			<< quadraticMilliseconds << " ms, hashed " << hashedMilliseconds << " ms ("
+			<< (hashedMilliseconds > 0.0 ? quadraticMilliseconds / hashedMilliseconds : 0.0) << "x)"
+			<< (identical ? "" : ", OUTPUT DIFFERS") << std::endl;
+		if (!welded || !identical)
+			return false;
+		// -- /weld --
+
+		// -- optimize --
+		library::Mesh optimized;
+		library::MeshOptimizationStats optimizeStats;
+		double optimizeMilliseconds = 0.0;
+
+		if (!TimeFastestRun([&]() { return library::Succeeded(library::OptimizeMesh(mesh, optimized, optimizeStats)); }, optimizeMilliseconds))
+			return false;
+
+		std::cout << "  optimize : " << optimizeMilliseconds << " ms, ACMR " << optimizeStats.source.acmr << " -> "
+			<< optimizeStats.optimized.acmr << ", ATVR " << optimizeStats.source.atvr << " -> " << optimizeStats.optimized.atvr << std::endl;
+		// -- /optimize --
+
+		// -- split --
+		library::Mesh split;
+		library::IndexSplitStats splitStats;
+		double splitMilliseconds = 0.0;
+
+		if (!TimeFastestRun([&]() { return library::Succeeded(library::SplitMeshForShortIndices(optimized, split, splitStats)); }, splitMilliseconds))
+			return false;
+
+		std::cout << "  split : " << splitMilliseconds << " ms, " << splitStats.submesh_count << " submeshes, vertices "
+			<< splitStats.source_vertex_count << " -> " << splitStats.vertex_count << ", index bytes "
+			<< splitStats.source_index_bytes << " -> " << splitStats.index_bytes << std::endl;
+		// -- /split --
+
+		// -- meshlets --
+		library::Mesh meshlets;
+		library::MeshletBuildStats meshletStats;
+		double meshletMilliseconds = 0.0;
+
+		if (!TimeFastestRun([&]()
+			{
+				return library::Succeeded(library::BuildMeshlets(split, library::MESHLET_DEFAULT_VERTEX_COUNT,
+					library::MESHLET_DEFAULT_TRIANGLE_COUNT, meshlets, meshletStats));
+			}, meshletMilliseconds))
+			return false;
+
+		uint32_t smallMeshletCount = 0;
+		for (const library::Meshlet& meshlet : meshlets.meshlets)
+			if (meshlet.triangle_count < library::MESHLET_DEFAULT_TRIANGLE_COUNT / 4)
+				smallMeshletCount++;
+
+		std::cout << "  meshlets : " << meshletMilliseconds << " ms, " << meshletStats.meshlet_count << " meshlets ("
+			<< smallMeshletCount << " under a quarter full), vertex fill " << meshletStats.vertex_fill
+			<< ", triangle fill " << meshletStats.triangle_fill << std::endl;
+		// -- /meshlets --
+
+		// -- lods --
+		// levels are generated from the welded mesh on their own, so the stages above measure only the full detail level
+		const std::vector<float> lodRatios = { 0.5f, 0.25f, 0.1f };
+		library::Mesh lods;
+		double lodMilliseconds = 0.0;
+
+		if (!TimeFastestRun([&]() { return library::Succeeded(library::GenerateMeshLods(mesh, lodRatios, lods)); }, lodMilliseconds))
+			return false;
+
+		std::cout << "  lods : " << lodMilliseconds << " ms";
+		for (const library::MeshLod& lod : lods.lods)
+			std::cout << ", " << lod.index_count / 3 << " triangles error " << lod.error;
+		std::cout << std::endl;
+		// -- /lods --
+
+		return true;
+	}
+
+	/* Times loading a .mesh file through a mapping against reading it into library::Mesh vectors.
+	  PARAMETERS
+		_in_filepath : The path to the .mesh file.
+	  RETURNS
+		true : The file was loaded both ways.
+		false : The file could not be loaded.
+	*/
+	bool BenchmarkMeshLoad(const std::string& _in_filepath)
+	{
+		namespace runtime = fbx_exporter::runtime;
+		namespace library = fbx_exporter::library;
+
+		uint64_t checksum = 0;
+		runtime::MeshInfo info;
+		size_t partCount = 0, meshletCount = 0;
+
+		// validate and point at the sections; only the header and section table are read
+		auto loadMapped = [&](bool _in_touch)
+		{
+			runtime::MappedContainer container;
+			if (runtime::MapContainerFile(_in_filepath.c_str(), container) != runtime::Result::SUCCESS)
+				return false;
+
+			runtime::MeshView view;
+			bool loaded = runtime::GetMeshView(container, view) == runtime::Result::SUCCESS;
+			if (loaded)
+			{
+				info = *view.info_p;
+				partCount = view.parts.size;
+				meshletCount = view.meshlets.size;
+			}
+			if (loaded && _in_touch)
+				checksum += SumBytes(view.vertices.data_p, view.vertices.size)
+					+ SumBytes(view.short_indices.data_p, view.short_indices.size * sizeof(uint16_t))
+					+ SumBytes(view.indices.data_p, view.indices.size * sizeof(uint32_t));
+
+			runtime::UnmapContainerFile(container);
+			return loaded;
+		};
+
+		// read every section into the vectors of library::Mesh, widening 16-bit indices as it stores them
+		auto loadVectors = [&]()
+		{
+			std::ifstream fin(_in_filepath, std::ios_base::in | std::ios_base::binary);
+			std::vector<runtime::ContainerSection> sections;
+			std::vector<runtime::MeshInfo> fileInfo;
+			std::vector<runtime::MeshPartRecord> parts;
+			std::vector<uint16_t> shortIndices;
+			std::vector<char> strings;
+			library::Mesh mesh;
+			library::PackedMesh packedMesh;
+
+			if (!ReadContainerTable(fin, runtime::ContainerType::MESH, sections)
+				|| !ReadContainerSection(fin, sections, runtime::SectionType::MESH_INFO, fileInfo) || fileInfo.size() != 1)
+				return false;
+
+			bool packed = fileInfo[0].vertex_stride != sizeof(library::Vertex);
+			bool read = (packed
+					? ReadContainerSection(fin, sections, runtime::SectionType::VERTICES, packedMesh.vertices)
+					: ReadContainerSection(fin, sections, runtime::SectionType::VERTICES, mesh.vertices))
+				&& (fileInfo[0].index_size == sizeof(uint16_t)
+					? ReadContainerSection(fin, sections, runtime::SectionType::INDICES, shortIndices)
+					: ReadContainerSection(fin, sections, runtime::SectionType::INDICES, mesh.indices))
+				&& ReadContainerSection(fin, sections, runtime::SectionType::SUBMESHES, mesh.submeshes)
+				&& ReadContainerSection(fin, sections, runtime::SectionType::LODS, mesh.lods)
+				&& ReadContainerSection(fin, sections, runtime::SectionType::PARTS, parts)
+				&& ReadContainerSection(fin, sections, runtime::SectionType::MESHLETS, mesh.meshlets)
+				&& ReadContainerSection(fin, sections, runtime::SectionType::MESHLET_VERTICES, mesh.meshlet_vertices)
+				&& ReadContainerSection(fin, sections, runtime::SectionType::MESHLET_TRIANGLES, mesh.meshlet_triangles)
+				&& ReadContainerSection(fin, sections, runtime::SectionType::STRINGS, strings);
+			if (!read)
+				return false;
+
+			if (!shortIndices.empty())
+			{
+				mesh.indices.assign(shortIndices.begin(), shortIndices.end());
+				for (const library::Submesh& submesh : mesh.submeshes)
+					for (uint32_t i = 0; i < submesh.index_count; i++)
+						mesh.indices[submesh.index_offset + i] += submesh.base_vertex;
+			}
+
+			mesh.parts.resize(parts.size());
+			for (size_t i = 0; i < parts.size(); i++)
+			{
+				mesh.parts[i].name.assign(strings.data() + parts[i].name_offset, parts[i].name_length);
+				mesh.parts[i].material = parts[i].material;
+				mesh.parts[i].index_offset = parts[i].index_offset;
+				mesh.parts[i].index_count = parts[i].index_count;
+				mesh.parts[i].base_vertex = parts[i].base_vertex;
+				mesh.parts[i].vertex_count = parts[i].vertex_count;
+				mesh.parts[i].meshlet_offset = parts[i].meshlet_offset;
+				mesh.parts[i].meshlet_count = parts[i].meshlet_count;
+				memcpy(mesh.parts[i].transform.values, parts[i].transform, sizeof(parts[i].transform));
+			}
+
+			checksum += SumBytes(mesh.vertices.data(), mesh.vertices.size() * sizeof(library::Vertex))
+				+ SumBytes(packedMesh.vertices.data(), packedMesh.vertices.size())
+				+ SumBytes(mesh.indices.data(), mesh.indices.size() * sizeof(uint32_t));
+			return true;
+		};
+
+		double mappedMilliseconds = 0.0, touchedMilliseconds = 0.0, vectorMilliseconds = 0.0;
+		if (!TimeFastestRun([&]() { return loadMapped(false); }, mappedMilliseconds)
+			|| !TimeFastestRun([&]() { return loadMapped(true); }, touchedMilliseconds)
+			|| !TimeFastestRun(loadVectors, vectorMilliseconds))
+		{
+			std::cout << "FAIL : " << _in_filepath << std::endl;
+			return false;
+		}
+
+		std::cout << _in_filepath << std::endl
+			<< "  vertices : " << info.vertex_count
+			<< "  indices : " << info.index_count << " (" << info.index_size << " bytes)"
+			<< "  parts : " << partCount
+			<< "  meshlets : " << meshletCount << std::endl
+			<< "  load : mapped " << mappedMilliseconds << " ms, mapped and touched " << touchedMilliseconds
+			<< " ms, vectors " << vectorMilliseconds << " ms" << "  (checksum " << checksum << ")" << std::endl;
+
+		return true;
+	}
+
+	/* Times loading a .anim file through a mapping against reading its keys into library clip vectors.
+	  PARAMETERS
+		_in_filepath : The path to the .anim file.
+	  RETURNS
+		true : The file was loaded both ways.
+		false : The file could not be loaded.
+	*/
+	bool BenchmarkAnimationLoad(const std::string& _in_filepath)
+	{
+		namespace runtime = fbx_exporter::runtime;
+		namespace library = fbx_exporter::library;
+
+		uint64_t checksum = 0;
+		size_t jointCount = 0, keyCount = 0;
+
+		// validate every channel and point at the sections; the key sections are not read
+		auto loadMapped = [&](bool _in_touch)
+		{
+			runtime::MappedContainer container;
+			if (runtime::MapContainerFile(_in_filepath.c_str(), container) != runtime::Result::SUCCESS)
+				return false;
+
+			runtime::AnimationView view;
+			bool loaded = runtime::GetAnimationView(container, view) == runtime::Result::SUCCESS;
+			if (loaded)
+			{
+				jointCount = view.joints.size;
+				keyCount = view.times.size + view.quantized_times.size;
+			}
+			if (loaded && _in_touch)
+				checksum += SumBytes(view.joints.data_p, view.joints.size * sizeof(runtime::ContainerJoint))
+					+ SumBytes(view.values.data_p, view.values.size * sizeof(float))
+					+ SumBytes(view.quantized_values.data_p, view.quantized_values.size * sizeof(uint16_t));
+
+			runtime::UnmapContainerFile(container);
+			return loaded;
+		};
+
+		// read the keys into the per-channel vectors of the library clip matching the file's format
+		auto loadVectors = [&]()
+		{
+			std::ifstream fin(_in_filepath, std::ios_base::in | std::ios_base::binary);
+			std::vector<runtime::ContainerSection> sections;
+			std::vector<runtime::AnimationInfo> info;
+			std::vector<runtime::AnimationTrackRecord> records;
+			std::vector<library::AnimationJoint> joints;
+
+			if (!ReadContainerTable(fin, runtime::ContainerType::ANIMATION, sections)
+				|| !ReadContainerSection(fin, sections, runtime::SectionType::ANIMATION_INFO, info) || info.size() != 1
+				|| !ReadContainerSection(fin, sections, runtime::SectionType::JOINTS, joints)
+				|| !ReadContainerSection(fin, sections, runtime::SectionType::TRACKS, records)
+				|| records.size() != joints.size() * 3)
+				return false;
+
+			checksum += SumBytes(joints.data(), joints.size() * sizeof(library::AnimationJoint));
+
+			if (info[0].format == runtime::AnimationFormat::FLOAT_KEYS)
+			{
+				std::vector<float> times, values;
+				library::SparseAnimationClip clip;
+
+				if (!ReadContainerSection(fin, sections, runtime::SectionType::KEY_TIMES, times)
+					|| !ReadContainerSection(fin, sections, runtime::SectionType::KEY_VALUES, values))
+					return false;
+
+				clip.duration = info[0].duration;
+				clip.joints = std::move(joints);
+				clip.tracks.resize(clip.joints.size());
+				for (size_t t = 0; t < records.size(); t++)
+				{
+					library::AnimationJointTracks& tracks = clip.tracks[t / 3];
+					library::AnimationTrack& track = t % 3 == 0 ? tracks.translation : (t % 3 == 1 ? tracks.rotation : tracks.scale);
+					size_t valueCount = (size_t)records[t].key_count * (t % 3 == 1 ? 4 : 3);
+
+					if (records[t].time_offset + (size_t)records[t].key_count > times.size()
+						|| records[t].value_offset + valueCount > values.size())
+						return false;
+
+					track.times.assign(times.begin() + records[t].time_offset, times.begin() + records[t].time_offset + records[t].key_count);
+					track.values.assign(values.begin() + records[t].value_offset, values.begin() + records[t].value_offset + valueCount);
+					checksum += SumBytes(track.values.data(), track.values.size() * sizeof(float));
+				}
+			}
+			else
+			{
+				std::vector<uint16_t> times, values;
+				library::QuantizedAnimationClip clip;
+
+				if (!ReadContainerSection(fin, sections, runtime::SectionType::KEY_TIMES, times)
+					|| !ReadContainerSection(fin, sections, runtime::SectionType::KEY_VALUES, values))
+					return false;
+
+				clip.duration = info[0].duration;
+				clip.joints = std::move(joints);
+				clip.tracks.resize(clip.joints.size());
+				for (size_t t = 0; t < records.size(); t++)
+				{
+					library::QuantizedJointTracks& tracks = clip.tracks[t / 3];
+					std::vector<uint16_t>& trackTimes = t % 3 == 0 ? tracks.translation.times
+						: (t % 3 == 1 ? tracks.rotation.times : tracks.scale.times);
+					std::vector<uint16_t>& trackValues = t % 3 == 0 ? tracks.translation.values
+						: (t % 3 == 1 ? tracks.rotation.values : tracks.scale.values);
+					size_t valueCount = (size_t)records[t].key_count * 3;
+
+					if (records[t].time_offset + (size_t)records[t].key_count > times.size()
+						|| records[t].value_offset + valueCount > values.size())
+						return false;
+
+					if (t % 3 != 1)
+					{
+						library::QuantizedVectorTrack& track = t % 3 == 0 ? tracks.translation : tracks.scale;
+						memcpy(track.min, records[t].min, sizeof(track.min));
+						memcpy(track.extent, records[t].extent, sizeof(track.extent));
+					}
+					trackTimes.assign(times.begin() + records[t].time_offset, times.begin() + records[t].time_offset + records[t].key_count);
+					trackValues.assign(values.begin() + records[t].value_offset, values.begin() + records[t].value_offset + valueCount);
+					checksum += SumBytes(trackValues.data(), trackValues.size() * sizeof(uint16_t));
+				}
+			}
+
+			return true;
+		};
+
+		double mappedMilliseconds = 0.0, touchedMilliseconds = 0.0, vectorMilliseconds = 0.0;
+		if (!TimeFastestRun([&]() { return loadMapped(false); }, mappedMilliseconds)
+			|| !TimeFastestRun([&]() { return loadMapped(true); }, touchedMilliseconds)
+			|| !TimeFastestRun(loadVectors, vectorMilliseconds))
+		{
+			std::cout << "FAIL : " << _in_filepath << std::endl;
+			return false;
+		}
+
+		std::cout << _in_filepath << std::endl
+			<< "  joints : " << jointCount
+			<< "  keys : " << keyCount << std::endl
+			<< "  load : mapped " << mappedMilliseconds << " ms, mapped and touched " << touchedMilliseconds
+			<< " ms, vectors " << vectorMilliseconds << " ms" << "  (checksum " << checksum << ")" << std::endl;
+
+		return true;
+	}
+
+	/* Loads a .anim or .animlib file and benchmarks every clip in it. .mesh files are only
+	  timed loading, .anim files are also timed loading before their clip is sampled, and .fbx
+	  files are run through the mesh stages.
+	  PARAMETERS
+		_in_filepath : The path to the file to load.
+	  RETURNS
+		true : The file was loaded and sampled.
+		false : The file could not be loaded.
+	*/
+	bool BenchmarkFile(const std::string& _in_filepath)
+	{
+		using clock = std::chrono::high_resolution_clock;
+
+		auto hasExtension = [&](const char* _in_extension)
+		{
+			size_t length = strlen(_in_extension);
+			return _in_filepath.size() > length && _in_filepath.compare(_in_filepath.size() - length, length, _in_extension) == 0;
+		};
+
+		if (hasExtension(".fbx"))
+			return BenchmarkMeshStages(_in_filepath);
+		if (hasExtension(".mesh"))
+			return BenchmarkMeshLoad(_in_filepath);
+		if (hasExtension(".anim") && !BenchmarkAnimationLoad(_in_filepath))
+			return false;
+
+		bool isLibrary = hasExtension(".animlib");
+		fbx_exporter::runtime::AnimationLibrary library;
+		fbx_exporter::runtime::Result result;
+
+		clock::time_point loadStart = clock::now();
+		if (isLibrary)
+		{
+			result = fbx_exporter::runtime::LoadAnimationLibrary(_in_filepath.c_str(), library);
+		}
+		else
+		{
+			library.clips.resize(1);
+			result = fbx_exporter::runtime::LoadAnimationClip(_in_filepath.c_str(), library.clips[0]);
+		}
+		double loadMilliseconds = std::chrono::duration<double, std::milli>(clock::now() - loadStart).count();
+
+		if (result != fbx_exporter::runtime::Result::SUCCESS)
+		{
+			std::cout << "FAIL : " << _in_filepath << std::endl;
+			return false;
+		}
+
+		if (isLibrary)
+			std::cout << _in_filepath << " : " << library.clips.size() << " clips, "
+				<< library.skeletons.size() << " skeletons, " << loadMilliseconds << " ms" << std::endl;
+
+		for (const fbx_exporter::runtime::AnimationClip& clip : library.clips)
+			BenchmarkClip(isLibrary ? "  " + clip.name : _in_filepath, clip, isLibrary ? 0.0 : loadMilliseconds);
+
+		return true;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	std::vector<std::string> clips;
+
+	for (int i = 1; i < argc; i++)
+		clips.push_back(argv[i]);
+	if (clips.empty())
+	{
+		clips.assign(std::begin(defaultMeshes), std::end(defaultMeshes));
+		clips.insert(clips.end(), std::begin(defaultClips), std::end(defaultClips));
+	}
+
+	std::cout << "Sampling " << fbx_exporter::runtime::JOINT_LANES << " joints per SIMD operation" << std::endl;
+
+	int failures = 0;
+	for (const std::string& clip : clips)
+		if (!BenchmarkFile(clip))
+			failures++;
+
+	return failures == 0 ? 0 : -1;
+}
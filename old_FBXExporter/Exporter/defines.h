@@ -1,15 +1,101 @@
 #ifndef _FBXEXPORTER_EXPORTER_DEFINES_H_
 #define _FBXEXPORTER_EXPORTER_DEFINES_H_
 
+#include "../Library/defines.h"
+#include "../Library/meshlet.h"
+#include "../Runtime/container.h"
+
 namespace fbx_exporter
 {
 	// Indicates how data should be used after being read from file.
 	enum struct FileReadMode
 	{
-		EXTRACT = 0  // Read and store data.
+		SKIP = -1  // Do not read data.
+		, EXTRACT = 0  // Read and store data.
 		, EXPORT  // Read, store, and export data.
 	};
 
+
+	// Indicates how animation keys are stored in exported .anim files.
+	enum struct AnimationFormat : uint32_t
+	{
+		FLOAT_KEYS = 0  // Float times, vectors, and quaternions.
+		, QUANTIZED_KEYS  // 16-bit times and range-quantized vectors, 48-bit quaternions.
+	};
+
+
+	// Settings for processing stages run between extraction and export.
+	struct ExportSettings
+	{
+		library::AnimationTolerance	animation_tolerance;  // Largest errors allowed when removing animation keys.
+		AnimationFormat				animation_format = AnimationFormat::FLOAT_KEYS;  // Layout of .anim files.
+		bool						animation_library = false;  // Extract every animation stack for a library instead of exporting .anim files.
+		bool						all_meshes = false;  // Extract every mesh of a file into one .mesh with a part per mesh and material, instead of the first mesh.
+		bool						stream_mesh = false;  // Write .mesh indices while extracting, so no raw vertices or index list are held. Skips levels of detail, reordering, splitting and meshlets.
+		std::vector<float>			lod_ratios;  // Triangle ratios of the levels of detail built before export, finest first. Empty for none.
+		bool						optimize_mesh = false;  // Reorder triangles and vertices for GPU cache reuse before export.
+		bool						build_meshlets = false;  // Split the mesh into meshlets with bounds after splitting it for 16-bit indices.
+		uint32_t					meshlet_max_vertices = library::MESHLET_DEFAULT_VERTEX_COUNT;  // Most vertices per meshlet.
+		uint32_t					meshlet_max_triangles = library::MESHLET_DEFAULT_TRIANGLE_COUNT;  // Most triangles per meshlet.
+		bool						pack_vertices = true;  // Pack mesh vertices into vertex_layout before export.
+		library::VertexLayout		vertex_layout =
+		{
+			static_cast<uint32_t>(library::MeshElement::ALL)
+			, library::VertexPositionFormat::FLOAT
+			, library::VertexNormalFormat::FLOAT
+			, library::VertexColorFormat::FLOAT
+			, library::VertexTexCoordFormat::FLOAT
+			, library::VertexSkinFormat::UNORM8_UINT8
+		};  // Formats of packed vertices. Elements are set from the elements extracted. Only skin is packed by default.
+		bool						compress_textures = false;  // Compress the textures materials reference into .tex files.
+		library::TextureFormat		color_texture_format = library::TextureFormat::BC7;  // Format of diffuse, emissive and specular textures. Normal maps are always BC5.
+	};
+
+	// Bytes of a container section held elsewhere in memory.
+	struct ContainerSpan
+	{
+		const void*						data_p = nullptr;  // First byte of the span.
+		size_t							size = 0;  // Number of bytes in the span.
+	};
+
+	// Section of a container file to write, gathered from spans of memory instead of copied.
+	struct ContainerSectionData
+	{
+		runtime::SectionType			type = runtime::SectionType::MESH_INFO;  // What the section holds.
+		uint32_t						alignment = runtime::CONTAINER_TABLE_ALIGNMENT;  // Alignment of the section in the file.
+		uint32_t						element_size = 0;  // Bytes per element.
+		uint64_t						element_count = 0;  // Number of elements.
+		std::vector<ContainerSpan>		spans;  // Bytes of the section in order. Their sizes add up to element_size * element_count.
+	};
+
+	// Reduced clip from one animation stack, ready to be written to an animation library.
+	struct AnimationLibraryClip
+	{
+		std::string						name;  // Source filename, and "/" and the stack name if the file has several stacks.
+		uint64_t						skeleton_hash = 0;  // Hash of the skeleton the clip animates.
+		library::SparseAnimationClip	sparse_clip;  // Reduced channel keys. Joints hold the skeleton.
+		library::QuantizedAnimationClip	quantized_clip;  // Quantized channel keys. Only filled for AnimationFormat::QUANTIZED_KEYS.
+	};
+
+	// Texture referenced by a material, to be compressed into a .tex file.
+	struct TextureExport
+	{
+		std::string						source_filepath;  // Path of the source image.
+		std::string						export_filepath;  // Path of the .tex file, next to the source image.
+		library::Material::ComponentType	component = library::Material::ComponentType::DIFFUSE;  // Component that first referenced the texture. Decides the format.
+	};
+
+	// Data extracted from a single .fbx file.
+	struct FbxFileData
+	{
+		library::Mesh					mesh;  // Extracted mesh.
+		library::PackedMesh				packed_mesh;  // Mesh with packed vertices. Only filled with ExportSettings::pack_vertices.
+		library::MaterialList			materials;  // Extracted materials and texture filepaths.
+		library::AnimationClip			animation;  // Extracted animation clip.
+		library::SparseAnimationClip	sparse_animation;  // Animation clip reduced for export.
+		std::vector<AnimationLibraryClip>	animation_clips;  // Reduced clips of every animation stack, with animation_library.
+	};
+
 }
 
-#endif // _FBXEXPORTER_EXPORTER_DEFINES_H_
\ No newline at end of file
+#endif // _FBXEXPORTER_EXPORTER_DEFINES_H_
@@ -1,19 +1,24 @@
 #include "interface.h"
 #include "utility.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
 
+#include "../Library/parallel.h"
 
 #include "../Library/debug.h"
 
 
 namespace fbx_exporter
 {
-#pragma region Variables
-	library::Mesh mesh;
-	library::MaterialList materials;
-	library::AnimationClip animation;
-#pragma endregion
-
 #pragma region Utility Function Definitions
 	void ReplaceExtension(
 		const char*						_in_filepath
@@ -28,228 +33,1460 @@ namespace fbx_exporter
 		memcpy(&_out_filepath[pathLen], _in_extension, extensionLen);
 	}
 
-	library::Result ExportMesh(
+	// Spans at least this large are written straight from memory instead of through the write buffer.
+	const size_t CONTAINER_DIRECT_WRITE_SIZE = 64 * 1024;
+
+	// Bytes of small spans and padding gathered before a write.
+	const size_t CONTAINER_WRITE_BUFFER_SIZE = 1024 * 1024;
+
+	// Section table entries reserved at the start of a streamed .mesh file: INDICES, VERTICES, MESH_INFO, PARTS and STRINGS.
+	const uint32_t STREAMED_MESH_SECTION_COUNT = 5;
+
+	// records written straight from library containers must keep the layout readers expect
+	static_assert(sizeof(library::Submesh) == sizeof(runtime::MeshSubmeshRecord), "Submesh layout differs from MeshSubmeshRecord");
+	static_assert(sizeof(library::MeshLod) == sizeof(runtime::MeshLodRecord), "MeshLod layout differs from MeshLodRecord");
+	static_assert(sizeof(library::Meshlet) == sizeof(runtime::MeshletRecord), "Meshlet layout differs from MeshletRecord");
+	static_assert(sizeof(library::Material) == sizeof(runtime::MaterialRecord), "Material layout differs from MaterialRecord");
+	static_assert(sizeof(library::Material::Component) == sizeof(runtime::MaterialComponentRecord), "Material layout differs from MaterialRecord");
+	static_assert(sizeof(library::TexturePath) == sizeof(runtime::TexturePathRecord), "TexturePath layout differs from TexturePathRecord");
+	static_assert(sizeof(library::AnimationJoint) == sizeof(runtime::ContainerJoint), "AnimationJoint layout differs from ContainerJoint");
+
+	// equal sizes do not catch reordered or retyped fields, so every field is checked too. Material
+	// components are private; equal sizes leave no room for anything but its component array
+	static_assert(offsetof(library::Submesh, index_offset) == offsetof(runtime::MeshSubmeshRecord, index_offset), "Submesh layout differs from MeshSubmeshRecord");
+	static_assert(offsetof(library::Submesh, index_count) == offsetof(runtime::MeshSubmeshRecord, index_count), "Submesh layout differs from MeshSubmeshRecord");
+	static_assert(offsetof(library::Submesh, base_vertex) == offsetof(runtime::MeshSubmeshRecord, base_vertex), "Submesh layout differs from MeshSubmeshRecord");
+	static_assert(offsetof(library::Submesh, vertex_count) == offsetof(runtime::MeshSubmeshRecord, vertex_count), "Submesh layout differs from MeshSubmeshRecord");
+	static_assert(offsetof(library::MeshLod, index_offset) == offsetof(runtime::MeshLodRecord, index_offset), "MeshLod layout differs from MeshLodRecord");
+	static_assert(offsetof(library::MeshLod, index_count) == offsetof(runtime::MeshLodRecord, index_count), "MeshLod layout differs from MeshLodRecord");
+	static_assert(offsetof(library::MeshLod, error) == offsetof(runtime::MeshLodRecord, error), "MeshLod layout differs from MeshLodRecord");
+	static_assert(offsetof(library::MeshLod, meshlet_offset) == offsetof(runtime::MeshLodRecord, meshlet_offset), "MeshLod layout differs from MeshLodRecord");
+	static_assert(offsetof(library::MeshLod, meshlet_count) == offsetof(runtime::MeshLodRecord, meshlet_count), "MeshLod layout differs from MeshLodRecord");
+	static_assert(offsetof(library::MeshLod, part_offset) == offsetof(runtime::MeshLodRecord, part_offset), "MeshLod layout differs from MeshLodRecord");
+	static_assert(offsetof(library::MeshLod, part_count) == offsetof(runtime::MeshLodRecord, part_count), "MeshLod layout differs from MeshLodRecord");
+	static_assert(offsetof(library::Meshlet, vertex_offset) == offsetof(runtime::MeshletRecord, vertex_offset), "Meshlet layout differs from MeshletRecord");
+	static_assert(offsetof(library::Meshlet, vertex_count) == offsetof(runtime::MeshletRecord, vertex_count), "Meshlet layout differs from MeshletRecord");
+	static_assert(offsetof(library::Meshlet, triangle_offset) == offsetof(runtime::MeshletRecord, triangle_offset), "Meshlet layout differs from MeshletRecord");
+	static_assert(offsetof(library::Meshlet, triangle_count) == offsetof(runtime::MeshletRecord, triangle_count), "Meshlet layout differs from MeshletRecord");
+	static_assert(offsetof(library::Meshlet, center) == offsetof(runtime::MeshletRecord, center), "Meshlet layout differs from MeshletRecord");
+	static_assert(offsetof(library::Meshlet, radius) == offsetof(runtime::MeshletRecord, radius), "Meshlet layout differs from MeshletRecord");
+	static_assert(offsetof(library::Meshlet, cone_apex) == offsetof(runtime::MeshletRecord, cone_apex), "Meshlet layout differs from MeshletRecord");
+	static_assert(offsetof(library::Meshlet, cone_axis) == offsetof(runtime::MeshletRecord, cone_axis), "Meshlet layout differs from MeshletRecord");
+	static_assert(offsetof(library::Meshlet, cone_cutoff) == offsetof(runtime::MeshletRecord, cone_cutoff), "Meshlet layout differs from MeshletRecord");
+	static_assert(offsetof(library::Material::Component, value) == offsetof(runtime::MaterialComponentRecord, value), "Material layout differs from MaterialRecord");
+	static_assert(offsetof(library::Material::Component, factor) == offsetof(runtime::MaterialComponentRecord, factor), "Material layout differs from MaterialRecord");
+	static_assert(offsetof(library::Material::Component, input) == offsetof(runtime::MaterialComponentRecord, input), "Material layout differs from MaterialRecord");
+	static_assert(offsetof(library::TexturePath, offset) == offsetof(runtime::TexturePathRecord, offset), "TexturePath layout differs from TexturePathRecord");
+	static_assert(offsetof(library::TexturePath, length) == offsetof(runtime::TexturePathRecord, length), "TexturePath layout differs from TexturePathRecord");
+	static_assert(offsetof(library::AnimationJoint, global_transform) == offsetof(runtime::ContainerJoint, global_transform), "AnimationJoint layout differs from ContainerJoint");
+	static_assert(offsetof(library::AnimationJoint, parent_index) == offsetof(runtime::ContainerJoint, parent_index), "AnimationJoint layout differs from ContainerJoint");
+
+	void AddContainerSection(
+		std::vector<ContainerSectionData>&	_out_sections
+		, const runtime::SectionType	_in_type
+		, const uint32_t				_in_alignment
+		, const uint32_t				_in_elementSize
+		, const uint64_t				_in_elementCount
+		, const void*					_in_data_p
+	) {
+		if (_in_elementCount == 0)
+			return;
+
+		ContainerSectionData section;
+		section.type = _in_type;
+		section.alignment = _in_alignment;
+		section.element_size = _in_elementSize;
+		section.element_count = _in_elementCount;
+		section.spans.push_back({ _in_data_p, (size_t)(_in_elementSize * _in_elementCount) });
+
+		_out_sections.push_back(section);
+	}
+	library::Result WriteContainerFile(
 		const char*						_in_filepath
-		, const library::Mesh			_in_mesh
+		, const runtime::ContainerType	_in_type
+		, const std::vector<ContainerSectionData>&	_in_sections
 	) {
-		/*
+		uint32_t numSections = (uint32_t)_in_sections.size();
+		std::vector<runtime::ContainerSection> table(numSections);
+
+		auto align = [](uint64_t _in_offset, uint32_t _in_alignment)
+		{
+			return (_in_offset + _in_alignment - 1) & ~(uint64_t)(_in_alignment - 1);
+		};
+
+		// -- lay out sections --
+
+		runtime::ContainerHeader header;
+		header.type = _in_type;
+		header.section_count = numSections;
+		header.section_table_offset = align(sizeof(header), runtime::CONTAINER_TABLE_ALIGNMENT);
+
+		uint64_t offset = header.section_table_offset + numSections * sizeof(runtime::ContainerSection);
+		for (uint32_t i = 0; i < numSections; i++)
+		{
+			const ContainerSectionData& section = _in_sections[i];
+
+			uint64_t size = 0;
+			for (const ContainerSpan& span : section.spans)
+				size += span.size;
+
+			if (section.alignment == 0 || (section.alignment & (section.alignment - 1)) != 0
+				|| size != (uint64_t)section.element_size * section.element_count)
+				return library::Result::INVALID_ARG;
+
+			table[i].type = section.type;
+			table[i].element_size = section.element_size;
+			table[i].alignment = section.alignment;
+			table[i].offset = align(offset, section.alignment);
+			table[i].element_count = section.element_count;
+
+			offset = table[i].offset + size;
+		}
+		header.file_size = offset;
+
+		// -- /lay out sections --
+
+
+		// -- write sections --
+
 		// open or create output file for writing
-		std::fstream fout = std::fstream(_outputFilepath, std::ios_base::out | std::ios_base::binary);
+		std::ofstream fout(_in_filepath, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
 
 		// verify file is open
-		if (fout.is_open())
+		if (!fout.is_open())
+			return library::Result::FAIL;
+
+		std::vector<char> buffer;
+		buffer.reserve(CONTAINER_WRITE_BUFFER_SIZE);
+		uint64_t written = 0;
+
+		auto flush = [&]()
+		{
+			fout.write(buffer.data(), buffer.size());
+			buffer.clear();
+		};
+		auto write = [&](const void* _in_data_p, size_t _in_size)
+		{
+			if (_in_size >= CONTAINER_DIRECT_WRITE_SIZE)
+			{
+				flush();
+				fout.write((const char*)_in_data_p, _in_size);
+			}
+			else
+			{
+				if (buffer.size() + _in_size > CONTAINER_WRITE_BUFFER_SIZE)
+					flush();
+				buffer.insert(buffer.end(), (const char*)_in_data_p, (const char*)_in_data_p + _in_size);
+			}
+			written += _in_size;
+		};
+		auto pad = [&](uint64_t _in_offset)
+		{
+			static const char zeros[runtime::CONTAINER_BULK_ALIGNMENT] = {};
+			while (written < _in_offset)
+				write(zeros, (size_t)std::min<uint64_t>(sizeof(zeros), _in_offset - written));
+		};
+
+		write(&header, sizeof(header));
+		pad(header.section_table_offset);
+		write(table.data(), table.size() * sizeof(runtime::ContainerSection));
+
+		for (uint32_t i = 0; i < numSections; i++)
 		{
-			uint32_t numVerts = (uint32_t)verts_compactified.size();
-			uint32_t numInds = (uint32_t)indices.size();
-			uint32_t numBytes = sizeof(numVerts) + sizeof(numInds) + (numVerts * sizeof(SIMPLE_VERTEX)) + (numInds * sizeof(uint32_t));
-			float reductionAmount = (verts_raw.size() - verts_compactified.size()) / (verts_raw.size() * 1.0f) * 100;
+			pad(table[i].offset);
+			for (const ContainerSpan& span : _in_sections[i].spans)
+				write(span.data_p, span.size);
+		}
+		flush();
+
+		// -- /write sections --
+
+		return fout.good() ? library::Result::EXPORT : library::Result::FAIL;
+	}
 
-			// write data to file with format:
-			//   uint32_t											: number of vertices
-			//   { float3, float3, float4, float2 }[numVerts]		: vertex data
-			//   uint32_t											: number of indices
-			//   uint32_t[numInds]									: index data
-			fout.write((const char*)&numVerts, sizeof(numVerts));
-			fout.write((const char*)&verts_compactified[0], numVerts * sizeof(SIMPLE_VERTEX));
-			fout.write((const char*)&numInds, sizeof(numInds));
-			fout.write((const char*)&indices[0], numInds * sizeof(uint32_t));
+	const void* DescribeMeshVertices(
+		const library::Mesh&			_in_mesh
+		, const uint32_t				_in_elements
+		, const library::PackedMesh&	_in_packedMesh
+		, runtime::MeshInfo&			_out_info
+	) {
+		uint32_t numVerts = (uint32_t)_in_mesh.vertices.size();
 
+		_out_info.vertex_count = numVerts;
 
-			std::cout
-				<< "Raw vertex count : " << verts_raw.size() << std::endl
-				<< "Unique vertex count : " << verts_compactified.size() << std::endl
-				<< "Reduction : " << reductionAmount << "%" << std::endl
-				<< "Index count : " << indices.size() << std::endl
-				<< "Wrote " << numBytes << " bytes to file" << std::endl
-				<< std::endl;
+		if (_in_packedMesh.vertex_count == numVerts && !_in_packedMesh.vertices.empty())
+		{
+			const library::VertexLayout& layout = _in_packedMesh.layout;
 
+			_out_info.vertex_stride = _in_packedMesh.vertex_stride;
+			_out_info.elements = layout.elements;
+			_out_info.position_format = static_cast<uint32_t>(layout.position);
+			_out_info.normal_format = static_cast<uint32_t>(layout.normal);
+			_out_info.color_format = static_cast<uint32_t>(layout.color);
+			_out_info.texcoord_format = static_cast<uint32_t>(layout.texcoord);
+			_out_info.skin_format = static_cast<uint32_t>(layout.skin);
+			_out_info.position_offset = _in_packedMesh.position_offset;
+			_out_info.normal_offset = _in_packedMesh.normal_offset;
+			_out_info.color_offset = _in_packedMesh.color_offset;
+			_out_info.texcoord_offset = _in_packedMesh.texcoord_offset;
+			_out_info.skin_offset = _in_packedMesh.skin_offset;
+			memcpy(_out_info.position_min, _in_packedMesh.position_min, sizeof(_out_info.position_min));
+			memcpy(_out_info.position_extent, _in_packedMesh.position_extent, sizeof(_out_info.position_extent));
+			memcpy(_out_info.texcoord_min, _in_packedMesh.texcoord_min, sizeof(_out_info.texcoord_min));
+			memcpy(_out_info.texcoord_extent, _in_packedMesh.texcoord_extent, sizeof(_out_info.texcoord_extent));
 
-			result = 0;
+			return _in_packedMesh.vertices.data();
 		}
-		*/
 
-		return library::Result::SUCCESS;
+		// unpacked vertices are written as they are, which is the FLOAT layout of every element.
+		// Elements that were not extracted still take space, but hold zeros
+		_out_info.vertex_stride = sizeof(library::Vertex);
+		_out_info.elements = _in_elements & static_cast<uint32_t>(library::MeshElement::ALL);
+		_out_info.position_offset = (uint32_t)offsetof(library::Vertex, pos);
+		_out_info.normal_offset = (uint32_t)offsetof(library::Vertex, norm);
+		_out_info.color_offset = (uint32_t)offsetof(library::Vertex, color);
+		_out_info.texcoord_offset = (uint32_t)offsetof(library::Vertex, texCoord);
+		_out_info.skin_offset = (uint32_t)offsetof(library::Vertex, weights);
+
+		return _in_mesh.vertices.data();
 	}
-	library::Result ExportMaterials(
+	void GatherMeshParts(
+		const library::Mesh&			_in_mesh
+		, std::vector<runtime::MeshPartRecord>&	_out_parts
+		, std::string&					_out_strings
+	) {
+		_out_parts.assign(_in_mesh.parts.size(), runtime::MeshPartRecord());
+
+		for (size_t i = 0; i < _in_mesh.parts.size(); i++)
+		{
+			const library::MeshPart& part = _in_mesh.parts[i];
+
+			_out_parts[i].name_offset = (uint32_t)_out_strings.size();
+			_out_parts[i].name_length = (uint32_t)part.name.size();
+			_out_parts[i].material = part.material;
+			_out_parts[i].index_offset = part.index_offset;
+			_out_parts[i].index_count = part.index_count;
+			_out_parts[i].base_vertex = part.base_vertex;
+			_out_parts[i].vertex_count = part.vertex_count;
+			_out_parts[i].meshlet_offset = part.meshlet_offset;
+			_out_parts[i].meshlet_count = part.meshlet_count;
+			memcpy(_out_parts[i].transform, part.transform.values, sizeof(_out_parts[i].transform));
+
+			_out_strings += part.name;
+		}
+	}
+
+	library::Result BeginContainerFile(
 		const char*						_in_filepath
-		, library::MaterialList			_in_materials
+		, const uint32_t				_in_maxSections
+		, std::ofstream&				_out_file
 	) {
-		/*
-		// open or create output file for writing
-		std::fstream fout = std::fstream(_outputFilepath, std::ios_base::out | std::ios_base::binary);
+		_out_file.open(_in_filepath, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
 
 		// verify file is open
-		if (fout.is_open())
-		{
-			uint32_t numMats = (uint32_t)materials.size();
-			uint32_t numPaths = (uint32_t)filepaths.size();
-			uint32_t numBytes = sizeof(numMats) + sizeof(numPaths) + (numMats * sizeof(SIMPLE_MATERIAL)) + (numPaths * sizeof(filepath_t));
-
-			// write data to file with format:
-			//   uint32_t												: number of materials
-			//   { float3, float, uint64_t }[compType::COUNT][numMats]	: material data
-			//   uint32_t												: number of filepaths
-			//   filepath_t[numPaths]									: filepath data
-			fout.write((const char*)&numMats, sizeof(numMats));
-			fout.write((const char*)&materials[0], numMats * sizeof(SIMPLE_MATERIAL));
-			fout.write((const char*)&numPaths, sizeof(numPaths));
-			fout.write((const char*)&filepaths[0], numPaths * sizeof(filepath_t));
-
-
-			std::cout
-				<< "Number of components exported : " << filepaths.size() << std::endl
-				<< "Filepaths : " << std::endl;
-			for (uint8_t i = 0; i < filepaths.size(); i++)
+		if (!_out_file.is_open())
+			return library::Result::FAIL;
+
+		// the header and table are written last, once the sections are known
+		uint64_t tableOffset = (sizeof(runtime::ContainerHeader) + runtime::CONTAINER_TABLE_ALIGNMENT - 1)
+			& ~(uint64_t)(runtime::CONTAINER_TABLE_ALIGNMENT - 1);
+		std::vector<char> zeros((size_t)(tableOffset + _in_maxSections * sizeof(runtime::ContainerSection)), 0);
+		_out_file.write(zeros.data(), zeros.size());
+
+		return _out_file.good() ? library::Result::SUCCESS : library::Result::FAIL;
+	}
+	uint64_t AlignContainerFile(
+		std::ostream&					_out_file
+		, const uint32_t				_in_alignment
+	) {
+		static const char zeros[runtime::CONTAINER_BULK_ALIGNMENT] = {};
+
+		uint64_t offset = (uint64_t)_out_file.tellp();
+		uint64_t aligned = (offset + _in_alignment - 1) & ~(uint64_t)(_in_alignment - 1);
+		while (offset < aligned)
+		{
+			size_t size = (size_t)std::min<uint64_t>(sizeof(zeros), aligned - offset);
+			_out_file.write(zeros, size);
+			offset += size;
+		}
+
+		return aligned;
+	}
+	library::Result AppendContainerSections(
+		std::ostream&					_out_file
+		, const std::vector<ContainerSectionData>&	_in_sections
+		, std::vector<runtime::ContainerSection>&	_out_table
+	) {
+		for (const ContainerSectionData& section : _in_sections)
+		{
+			uint64_t size = 0;
+			for (const ContainerSpan& span : section.spans)
+				size += span.size;
+
+			if (section.alignment == 0 || (section.alignment & (section.alignment - 1)) != 0
+				|| section.alignment > runtime::CONTAINER_BULK_ALIGNMENT
+				|| size != (uint64_t)section.element_size * section.element_count)
+				return library::Result::INVALID_ARG;
+
+			runtime::ContainerSection entry;
+			entry.type = section.type;
+			entry.element_size = section.element_size;
+			entry.alignment = section.alignment;
+			entry.offset = AlignContainerFile(_out_file, section.alignment);
+			entry.element_count = section.element_count;
+
+			for (const ContainerSpan& span : section.spans)
+				_out_file.write((const char*)span.data_p, span.size);
+
+			_out_table.push_back(entry);
+		}
+
+		return _out_file.good() ? library::Result::SUCCESS : library::Result::FAIL;
+	}
+	library::Result EndContainerFile(
+		std::ofstream&					_out_file
+		, const runtime::ContainerType	_in_type
+		, const uint32_t				_in_maxSections
+		, const std::vector<runtime::ContainerSection>&	_in_table
+	) {
+		if (_in_table.size() > _in_maxSections)
+			return library::Result::INVALID_ARG;
+
+		runtime::ContainerHeader header;
+		header.type = _in_type;
+		header.section_count = (uint32_t)_in_table.size();
+		header.file_size = (uint64_t)_out_file.tellp();
+		header.section_table_offset = (sizeof(header) + runtime::CONTAINER_TABLE_ALIGNMENT - 1)
+			& ~(uint64_t)(runtime::CONTAINER_TABLE_ALIGNMENT - 1);
+
+		// unused table entries stay zeroed past section_count
+		_out_file.seekp(0);
+		_out_file.write((const char*)&header, sizeof(header));
+		_out_file.seekp((std::streamoff)header.section_table_offset);
+		_out_file.write((const char*)_in_table.data(), _in_table.size() * sizeof(runtime::ContainerSection));
+		_out_file.close();
+
+		return _out_file.good() ? library::Result::EXPORT : library::Result::FAIL;
+	}
+
+	library::Result ExportMesh(
+		const char*						_in_filepath
+		, const library::Mesh&			_in_mesh
+		, const uint32_t				_in_elements
+		, const library::PackedMesh&	_in_packedMesh
+	) {
+		uint32_t numVerts = (uint32_t)_in_mesh.vertices.size();
+		uint32_t numInds = (uint32_t)_in_mesh.indices.size();
+
+		if (_in_filepath == nullptr || numVerts == 0 || numInds == 0)
+			return library::Result::INVALID_ARG;
+
+		runtime::MeshInfo info;
+		const void* vertices_p = DescribeMeshVertices(_in_mesh, _in_elements, _in_packedMesh, info);
+		info.index_count = numInds;
+
+		// -- describe indices --
+
+		// 16-bit indices when every index fits, on its own or relative to its submesh
+		std::vector<uint16_t> shortIndices;
+		const void* indices_p = nullptr;
+
+		if (library::Succeeded(library::GetShortIndices(_in_mesh, shortIndices)))
+		{
+			indices_p = shortIndices.data();
+			info.index_size = sizeof(uint16_t);
+			info.index_base = _in_mesh.submeshes.empty() ? runtime::IndexBase::WHOLE_MESH : runtime::IndexBase::SUBMESH;
+		}
+		else
+		{
+			indices_p = _in_mesh.indices.data();
+			info.index_size = sizeof(uint32_t);
+		}
+
+		// -- /describe indices --
+
+		std::string strings;
+		std::vector<runtime::MeshPartRecord> parts;
+		GatherMeshParts(_in_mesh, parts, strings);
+
+		// write data to file with format:
+		//   ContainerHeader, ContainerSection[numSections]	: header and section table
+		//   MESH_INFO										: MeshInfo
+		//   VERTICES										: vertex_stride bytes per vertex
+		//   INDICES										: index_size bytes per index
+		//   SUBMESHES, LODS, PARTS, MESHLETS				: records, if the mesh has them
+		//   MESHLET_VERTICES, MESHLET_TRIANGLES			: meshlet data, if the mesh has meshlets
+		//   STRINGS										: part names
+		std::vector<ContainerSectionData> sections;
+		AddContainerSection(sections, runtime::SectionType::MESH_INFO, runtime::CONTAINER_TABLE_ALIGNMENT,
+			sizeof(info), 1, &info);
+		AddContainerSection(sections, runtime::SectionType::VERTICES, runtime::CONTAINER_BULK_ALIGNMENT,
+			info.vertex_stride, numVerts, vertices_p);
+		AddContainerSection(sections, runtime::SectionType::INDICES, runtime::CONTAINER_BULK_ALIGNMENT,
+			info.index_size, numInds, indices_p);
+		AddContainerSection(sections, runtime::SectionType::SUBMESHES, runtime::CONTAINER_TABLE_ALIGNMENT,
+			sizeof(library::Submesh), _in_mesh.submeshes.size(), _in_mesh.submeshes.data());
+		AddContainerSection(sections, runtime::SectionType::LODS, runtime::CONTAINER_TABLE_ALIGNMENT,
+			sizeof(library::MeshLod), _in_mesh.lods.size(), _in_mesh.lods.data());
+		AddContainerSection(sections, runtime::SectionType::PARTS, runtime::CONTAINER_TABLE_ALIGNMENT,
+			sizeof(runtime::MeshPartRecord), parts.size(), parts.data());
+		AddContainerSection(sections, runtime::SectionType::MESHLETS, runtime::CONTAINER_BULK_ALIGNMENT,
+			sizeof(library::Meshlet), _in_mesh.meshlets.size(), _in_mesh.meshlets.data());
+		AddContainerSection(sections, runtime::SectionType::MESHLET_VERTICES, runtime::CONTAINER_BULK_ALIGNMENT,
+			sizeof(uint32_t), _in_mesh.meshlet_vertices.size(), _in_mesh.meshlet_vertices.data());
+		AddContainerSection(sections, runtime::SectionType::MESHLET_TRIANGLES, runtime::CONTAINER_BULK_ALIGNMENT,
+			sizeof(uint8_t), _in_mesh.meshlet_triangles.size(), _in_mesh.meshlet_triangles.data());
+		AddContainerSection(sections, runtime::SectionType::STRINGS, runtime::CONTAINER_TABLE_ALIGNMENT,
+			sizeof(char), strings.size(), strings.data());
+
+		return WriteContainerFile(_in_filepath, runtime::ContainerType::MESH, sections);
+	}
+	library::Result ExportMaterials(
+		const char*						_in_filepath
+		, const library::MaterialList&	_in_materials
+	) {
+		if (_in_filepath == nullptr)
+			return library::Result::INVALID_ARG;
+
+		// write data to file with format:
+		//   ContainerHeader, ContainerSection[numSections]	: header and section table
+		//   MATERIALS										: MaterialRecord per material, if any
+		//   TEXTURES										: TexturePathRecord per texture, if any
+		//   STRINGS										: characters of the texture filepaths, if any
+		std::vector<ContainerSectionData> sections;
+		AddContainerSection(sections, runtime::SectionType::MATERIALS, runtime::CONTAINER_TABLE_ALIGNMENT,
+			sizeof(library::Material), _in_materials.materials.size(), _in_materials.materials.data());
+		AddContainerSection(sections, runtime::SectionType::TEXTURES, runtime::CONTAINER_TABLE_ALIGNMENT,
+			sizeof(library::TexturePath), _in_materials.textures.size(), _in_materials.textures.data());
+		AddContainerSection(sections, runtime::SectionType::STRINGS, runtime::CONTAINER_TABLE_ALIGNMENT,
+			sizeof(char), _in_materials.strings.size(), _in_materials.strings.data());
+
+		return WriteContainerFile(_in_filepath, runtime::ContainerType::MATERIALS, sections);
+	}
+	library::Result ExportTexture(
+		const char*						_in_filepath
+		, const library::CompressedTexture&	_in_texture
+	) {
+		if (_in_filepath == nullptr || _in_texture.block_size == 0 || _in_texture.blocks.empty())
+			return library::Result::INVALID_ARG;
+
+		runtime::TextureInfo info;
+		info.format = (uint32_t)_in_texture.format;
+		info.width = _in_texture.width;
+		info.height = _in_texture.height;
+		info.block_size = _in_texture.block_size;
+
+		// write data to file with format:
+		//   ContainerHeader, ContainerSection[numSections]	: header and section table
+		//   TEXTURE_INFO									: TextureInfo
+		//   TEXTURE_BLOCKS									: block_size bytes per block
+		std::vector<ContainerSectionData> sections;
+		AddContainerSection(sections, runtime::SectionType::TEXTURE_INFO, runtime::CONTAINER_TABLE_ALIGNMENT,
+			sizeof(info), 1, &info);
+		AddContainerSection(sections, runtime::SectionType::TEXTURE_BLOCKS, runtime::CONTAINER_BULK_ALIGNMENT,
+			info.block_size, _in_texture.blocks.size() / info.block_size, _in_texture.blocks.data());
+
+		return WriteContainerFile(_in_filepath, runtime::ContainerType::TEXTURE, sections);
+	}
+	library::TextureFormat SelectTextureFormat(
+		const library::Image&			_in_image
+		, const library::Material::ComponentType	_in_component
+		, const ExportSettings&			_in_settings
+	) {
+		// normal maps keep two full-precision channels; the shader rebuilds the third
+		if (_in_component == library::Material::ComponentType::NORMALMAP)
+			return library::TextureFormat::BC5;
+
+		if (_in_settings.color_texture_format != library::TextureFormat::BC1
+			|| _in_component != library::Material::ComponentType::DIFFUSE)
+			return _in_settings.color_texture_format;
+
+		for (size_t i = 3; i < _in_image.pixels.size(); i += 4)
+			if (_in_image.pixels[i] != 255)
+				return library::TextureFormat::BC3;
+
+		return library::TextureFormat::BC1;
+	}
+	void GatherAnimationKeys(
+		const library::SparseAnimationClip&	_in_sparseClip
+		, std::vector<runtime::AnimationTrackRecord>&	_out_records
+		, ContainerSectionData&			_out_times
+		, ContainerSectionData&			_out_values
+	) {
+		// key arrays are written straight from the tracks, one span per channel
+		for (const library::AnimationJointTracks& jointTracks : _in_sparseClip.tracks)
+		{
+			const library::AnimationTrack* tracks[3] = { &jointTracks.translation, &jointTracks.rotation, &jointTracks.scale };
+
+			for (uint32_t t = 0; t < 3; t++)
 			{
-				char path[260];
-				memcpy(path, &filepaths[i][0], 260);
-				std::cout << path << std::endl;
+				runtime::AnimationTrackRecord record = {};
+				record.key_count = (uint32_t)tracks[t]->times.size();
+				record.time_offset = (uint32_t)_out_times.element_count;
+				record.value_offset = (uint32_t)_out_values.element_count;
+				_out_records.push_back(record);
+
+				_out_times.spans.push_back({ tracks[t]->times.data(), tracks[t]->times.size() * sizeof(float) });
+				_out_values.spans.push_back({ tracks[t]->values.data(), tracks[t]->values.size() * sizeof(float) });
+				_out_times.element_count += tracks[t]->times.size();
+				_out_values.element_count += tracks[t]->values.size();
 			}
-			std::cout
-				<< "Wrote " << numBytes << " bytes to file" << std::endl
-				<< std::endl;
+		}
+	}
+	void GatherQuantizedAnimationKeys(
+		const library::QuantizedAnimationClip&	_in_quantizedClip
+		, std::vector<runtime::AnimationTrackRecord>&	_out_records
+		, ContainerSectionData&			_out_times
+		, ContainerSectionData&			_out_values
+	) {
+		auto addKeys = [&](runtime::AnimationTrackRecord& _out_record, const std::vector<uint16_t>& _in_times,
+			const std::vector<uint16_t>& _in_values)
+		{
+			_out_record.key_count = (uint32_t)_in_times.size();
+			_out_record.time_offset = (uint32_t)_out_times.element_count;
+			_out_record.value_offset = (uint32_t)_out_values.element_count;
 
+			_out_times.spans.push_back({ _in_times.data(), _in_times.size() * sizeof(uint16_t) });
+			_out_values.spans.push_back({ _in_values.data(), _in_values.size() * sizeof(uint16_t) });
+			_out_times.element_count += _in_times.size();
+			_out_values.element_count += _in_values.size();
+		};
+		auto addVectorKeys = [&](runtime::AnimationTrackRecord& _out_record, const library::QuantizedVectorTrack& _in_track)
+		{
+			memcpy(_out_record.min, _in_track.min, sizeof(_out_record.min));
+			memcpy(_out_record.extent, _in_track.extent, sizeof(_out_record.extent));
+			addKeys(_out_record, _in_track.times, _in_track.values);
+		};
 
-			result = 0;
+		// key arrays are written straight from the tracks, one span per channel
+		for (const library::QuantizedJointTracks& tracks : _in_quantizedClip.tracks)
+		{
+			runtime::AnimationTrackRecord records[3] = {};
+			addVectorKeys(records[0], tracks.translation);
+			addKeys(records[1], tracks.rotation.times, tracks.rotation.values);
+			addVectorKeys(records[2], tracks.scale);
+			_out_records.insert(_out_records.end(), records, records + 3);
 		}
-		*/
-
-		return library::Result::SUCCESS;
 	}
+
 	library::Result ExportAnimation(
 		const char*						_in_filepath
-		, library::AnimationClip		_in_animationClip
+		, const library::SparseAnimationClip&	_in_sparseClip
 	) {
-		/*
-		// open or create output file for writing
-		std::fstream fout = std::fstream(_outputFilepath, std::ios_base::out | std::ios_base::binary);
+		uint32_t numJoints = (uint32_t)_in_sparseClip.joints.size();
 
-		// verify file is open
-		if (fout.is_open())
-		{
-			uint32_t numJoints = (uint32_t)joints_out.size();
-			uint32_t frameSize = sizeof(double) + (numJoints * sizeof(SIMPLE_MATRIX));
-			uint32_t numFrames = (uint32_t)animClip.frames.size();
-			uint32_t numBytes = sizeof(numJoints) + sizeof(numFrames) + (numJoints * sizeof(SIMPLE_JOINT)) + sizeof(animClip.duration) + (numFrames * frameSize);
-
-			// write bind pose to file with format:
-			//   uint32_t										: number of joints
-			//   { float[16], int }[numJoints]					: joint data
-			fout.write((char*)&numJoints, sizeof(numJoints));
-			fout.write((char*)&joints_out[0], numJoints * sizeof(SIMPLE_JOINT));
-
-			// write animation clip to file with format:
-			//   double											: animation duration in seconds
-			//   uint32_t										: byte length of each frame
-			//   uint32_t										: number of frames
-			//   { double, float[16][numJoints] }[numFrames]	: frame data
-			fout.write((char*)&animClip.duration, sizeof(animClip.duration));
-			fout.write((char*)&frameSize, sizeof(frameSize));
-			fout.write((char*)&numFrames, sizeof(numFrames));
-			for (uint32_t i = 0; i < numFrames; i++)
+		// verify every joint has tracks
+		if (numJoints == 0 || _in_sparseClip.tracks.size() != numJoints)
+			return library::Result::INVALID_ARG;
+
+		runtime::AnimationInfo info;
+		info.format = runtime::AnimationFormat::FLOAT_KEYS;
+		info.joint_count = numJoints;
+		info.duration = _in_sparseClip.duration;
+
+		std::vector<runtime::AnimationTrackRecord> records;
+		ContainerSectionData times = { runtime::SectionType::KEY_TIMES, runtime::CONTAINER_BULK_ALIGNMENT, sizeof(float) };
+		ContainerSectionData values = { runtime::SectionType::KEY_VALUES, runtime::CONTAINER_BULK_ALIGNMENT, sizeof(float) };
+		records.reserve(numJoints * 3);
+		GatherAnimationKeys(_in_sparseClip, records, times, values);
+
+		// write data to file with format:
+		//   ContainerHeader, ContainerSection[numSections]	: header and section table
+		//   ANIMATION_INFO									: AnimationInfo with AnimationFormat::FLOAT_KEYS
+		//   JOINTS											: ContainerJoint per joint
+		//   TRACKS											: translation, rotation and scale AnimationTrackRecord per joint
+		//   KEY_TIMES										: float key times in seconds
+		//   KEY_VALUES										: float key values, xyz or quaternion xyzw
+		std::vector<ContainerSectionData> sections;
+		AddContainerSection(sections, runtime::SectionType::ANIMATION_INFO, runtime::CONTAINER_TABLE_ALIGNMENT,
+			sizeof(info), 1, &info);
+		AddContainerSection(sections, runtime::SectionType::JOINTS, runtime::CONTAINER_TABLE_ALIGNMENT,
+			sizeof(library::AnimationJoint), numJoints, _in_sparseClip.joints.data());
+		AddContainerSection(sections, runtime::SectionType::TRACKS, runtime::CONTAINER_TABLE_ALIGNMENT,
+			sizeof(runtime::AnimationTrackRecord), records.size(), records.data());
+		if (times.element_count > 0)
+		{
+			sections.push_back(times);
+			sections.push_back(values);
+		}
+
+		return WriteContainerFile(_in_filepath, runtime::ContainerType::ANIMATION, sections);
+	}
+
+	library::Result ExportQuantizedAnimation(
+		const char*						_in_filepath
+		, const library::QuantizedAnimationClip&	_in_quantizedClip
+	) {
+		uint32_t numJoints = (uint32_t)_in_quantizedClip.joints.size();
+
+		// verify every joint has tracks
+		if (numJoints == 0 || _in_quantizedClip.tracks.size() != numJoints)
+			return library::Result::INVALID_ARG;
+
+		runtime::AnimationInfo info;
+		info.format = runtime::AnimationFormat::QUANTIZED_KEYS;
+		info.joint_count = numJoints;
+		info.duration = _in_quantizedClip.duration;
+
+		std::vector<runtime::AnimationTrackRecord> records;
+		ContainerSectionData times = { runtime::SectionType::KEY_TIMES, runtime::CONTAINER_BULK_ALIGNMENT, sizeof(uint16_t) };
+		ContainerSectionData values = { runtime::SectionType::KEY_VALUES, runtime::CONTAINER_BULK_ALIGNMENT, sizeof(uint16_t) };
+		records.reserve(numJoints * 3);
+		GatherQuantizedAnimationKeys(_in_quantizedClip, records, times, values);
+
+		// write data to file with format:
+		//   ContainerHeader, ContainerSection[numSections]	: header and section table
+		//   ANIMATION_INFO									: AnimationInfo with AnimationFormat::QUANTIZED_KEYS
+		//   JOINTS											: ContainerJoint per joint
+		//   TRACKS											: translation, rotation and scale AnimationTrackRecord per joint
+		//   KEY_TIMES										: uint16_t key times as fractions of duration
+		//   KEY_VALUES										: uint16_t[3] per key, fractions of extent or
+		//													  smallest-three quaternions
+		std::vector<ContainerSectionData> sections;
+		AddContainerSection(sections, runtime::SectionType::ANIMATION_INFO, runtime::CONTAINER_TABLE_ALIGNMENT,
+			sizeof(info), 1, &info);
+		AddContainerSection(sections, runtime::SectionType::JOINTS, runtime::CONTAINER_TABLE_ALIGNMENT,
+			sizeof(library::AnimationJoint), numJoints, _in_quantizedClip.joints.data());
+		AddContainerSection(sections, runtime::SectionType::TRACKS, runtime::CONTAINER_TABLE_ALIGNMENT,
+			sizeof(runtime::AnimationTrackRecord), records.size(), records.data());
+		if (times.element_count > 0)
+		{
+			sections.push_back(times);
+			sections.push_back(values);
+		}
+
+		return WriteContainerFile(_in_filepath, runtime::ContainerType::ANIMATION, sections);
+	}
+
+	library::Result ReduceAnimationClipForExport(
+		const library::AnimationClip&	_in_animationClip
+		, const char*					_in_name
+		, const ExportSettings&			_in_settings
+		, library::SparseAnimationClip&	_out_sparseClip
+		, library::QuantizedAnimationClip&	_out_quantizedClip
+		, std::ostream&					_out_report
+	) {
+		library::Result ret_result = library::Result::FAIL;
+
+		// drop keys that can be interpolated within tolerance before export
+		library::AnimationReductionStats stats;
+		ret_result = library::ReduceAnimationClip(_in_animationClip, _in_settings.animation_tolerance,
+			_out_sparseClip, stats);
+		if (!library::Succeeded(ret_result))
+			return ret_result;
+
+		uint64_t denseBytes = _in_animationClip.frame_times.size() * sizeof(double)
+			+ _in_animationClip.transforms.size() * sizeof(library::Matrix);
+		uint64_t sparseBytes = 0;
+		for (const library::AnimationJointTracks& tracks : _out_sparseClip.tracks)
+			sparseBytes += 3 * sizeof(uint32_t) + (tracks.translation.times.size() + tracks.translation.values.size()
+				+ tracks.rotation.times.size() + tracks.rotation.values.size()
+				+ tracks.scale.times.size() + tracks.scale.values.size()) * sizeof(float);
+
+		_out_report
+			<< "Animation : " << _in_name << std::endl
+			<< "  Keys : " << stats.source_key_count << " -> " << stats.key_count << std::endl
+			<< "  Frame data : " << denseBytes << " -> " << sparseBytes << " bytes ("
+			<< (sparseBytes > 0 ? (double)denseBytes / sparseBytes : 0.0) << ":1)" << std::endl
+			<< "  Max error : " << stats.max_translation_error << " units, "
+			<< stats.max_rotation_error * 57.2957795 << " degrees, "
+			<< stats.max_scale_error << " scale" << std::endl;
+
+		if (_in_settings.animation_format != AnimationFormat::QUANTIZED_KEYS)
+			return ret_result;
+
+		library::SparseAnimationClip decodedClip;
+		library::AnimationReductionStats quantizedStats;
+
+		ret_result = library::QuantizeAnimationClip(_out_sparseClip, _out_quantizedClip);
+		if (!library::Succeeded(ret_result))
+			return ret_result;
+
+		// decode what will be written and measure it against the extracted clip
+		library::DecodeQuantizedAnimationClip(_out_quantizedClip, decodedClip);
+		library::MeasureAnimationClipError(_in_animationClip, decodedClip, quantizedStats);
+
+		uint64_t quantizedBytes = 0;
+		for (const library::QuantizedJointTracks& tracks : _out_quantizedClip.tracks)
+			quantizedBytes += 3 * sizeof(uint32_t) + 4 * sizeof(tracks.translation.min)
+				+ (tracks.translation.times.size() + tracks.translation.values.size()
+				+ tracks.rotation.times.size() + tracks.rotation.values.size()
+				+ tracks.scale.times.size() + tracks.scale.values.size()) * sizeof(uint16_t);
+
+		_out_report
+			<< "  Quantized frame data : " << quantizedBytes << " bytes ("
+			<< (quantizedBytes > 0 ? (double)denseBytes / quantizedBytes : 0.0) << ":1)" << std::endl
+			<< "  Quantized max error : " << quantizedStats.max_translation_error << " units, "
+			<< quantizedStats.max_rotation_error * 57.2957795 << " degrees, "
+			<< quantizedStats.max_scale_error << " scale" << std::endl;
+
+		return ret_result;
+	}
+
+	void ReportMeshParts(
+		const library::Mesh&			_in_mesh
+		, std::ostream&					_out_report
+	) {
+		if (_in_mesh.parts.empty())
+			return;
+
+		std::vector<uint32_t> materials;
+		for (const library::MeshPart& part : _in_mesh.parts)
+			materials.push_back(part.material);
+		std::sort(materials.begin(), materials.end());
+		size_t materialCount = std::unique(materials.begin(), materials.end()) - materials.begin();
+
+		_out_report
+			<< "  Parts : " << _in_mesh.parts.size() << " (" << materialCount << " materials, "
+			<< _in_mesh.vertex_count << " vertices, " << _in_mesh.index_count / 3 << " triangles)" << std::endl;
+	}
+	library::Result PackMeshForExport(
+		const library::Mesh&			_in_mesh
+		, const uint32_t				_in_elementsToExtract
+		, const ExportSettings&			_in_settings
+		, library::PackedMesh&			_out_packedMesh
+		, std::ostream&					_out_report
+	) {
+		library::Result ret_result = library::Result::FAIL;
+
+		library::VertexLayout layout = _in_settings.vertex_layout;
+		library::VertexPackingStats stats;
+
+		// leave out elements that were not extracted instead of storing zeros
+		layout.elements = _in_elementsToExtract;
+
+		// meshes without skin weights store none, and 8-bit joint indices widen when a
+		// skeleton has more joints than they can address
+		float maxWeight = 0.0f;
+		uint16_t maxJoint = 0;
+		for (const library::Vertex& vertex : _in_mesh.vertices)
+			for (uint32_t c = 0; c < 4; c++)
 			{
-				fout.write((char*)&animClip.frames[i].time, sizeof(SIMPLE_ANIM_FRAME::time));
-				fout.write((char*)&animClip.frames[i].transforms[0], frameSize - sizeof(SIMPLE_ANIM_FRAME::time));
+				maxWeight = std::max(maxWeight, vertex.weights[c]);
+				maxJoint = std::max(maxJoint, vertex.joints[c]);
 			}
+		if (maxWeight == 0.0f)
+			layout.elements &= ~static_cast<uint32_t>(library::MeshElement::SKIN);
+		if (layout.skin == library::VertexSkinFormat::UNORM8_UINT8 && maxJoint > 255)
+			layout.skin = library::VertexSkinFormat::UNORM8_UINT16;
+
+		ret_result = library::PackMeshVertices(_in_mesh, layout, _out_packedMesh, stats);
+		if (!library::Succeeded(ret_result))
+			return ret_result;
+
+		_out_report
+			<< "  Vertex size : " << stats.source_vertex_stride << " -> " << stats.vertex_stride << " bytes ("
+			<< (uint64_t)stats.source_vertex_stride * _out_packedMesh.vertex_count << " -> "
+			<< _out_packedMesh.vertices.size() << " bytes)" << std::endl
+			<< "  Max error : " << stats.max_position_error << " units, "
+			<< stats.max_normal_error * 57.2957795 << " degrees, "
+			<< stats.max_color_error << " color, " << stats.max_texcoord_error << " UV, "
+			<< stats.max_weight_error << " weight" << std::endl;
 
+		return ret_result;
+	}
+
+	library::Result GetStreamedMeshFromFbxSession(
+		const library::FbxSession*		_in_fbxSession_p
+		, const char*					_in_exportFilepath
+		, const uint32_t				_in_elementsToExtract
+		, const ExportSettings&			_in_settings
+		, library::Mesh&				_out_mesh
+		, library::PackedMesh&			_out_packedMesh
+	) {
+		library::Result ret_result = library::Result::FAIL;
 
-			std::cout
-				<< "Joint count : " << numJoints << std::endl
-				<< "Duration : " << animClip.duration << std::endl
-				<< "Frame byte length : " << frameSize << std::endl
-				<< "Frame count : " << numFrames << std::endl
-				<< "Wrote " << numBytes << " bytes to file" << std::endl
-				<< std::endl;
+		std::ofstream file;
+		std::vector<runtime::ContainerSection> table;
 
+		// write data to file with format:
+		//   ContainerHeader, ContainerSection[STREAMED_MESH_SECTION_COUNT]	: header and section table, written last
+		//   INDICES						: uint32_t indices, written while extracting
+		//   VERTICES						: vertex_stride bytes per vertex
+		//   MESH_INFO						: MeshInfo
+		//   PARTS, STRINGS					: part records and names, if the mesh has parts
+		ret_result = BeginContainerFile(_in_exportFilepath, STREAMED_MESH_SECTION_COUNT, file);
+		if (!library::Succeeded(ret_result))
+			return ret_result;
+
+		// once the file is begun, every failure removes it instead of leaving a partial file behind
+		auto discardFile = [&](const library::Result _in_result)
+		{
+			file.close();
+			std::remove(_in_exportFilepath);
+			return _in_result;
+		};
+
+		runtime::ContainerSection indexSection;
+		indexSection.type = runtime::SectionType::INDICES;
+		indexSection.element_size = sizeof(uint32_t);
+		indexSection.alignment = runtime::CONTAINER_BULK_ALIGNMENT;
+		indexSection.offset = AlignContainerFile(file, runtime::CONTAINER_BULK_ALIGNMENT);
 
-			result = 0;
+		if (_in_settings.all_meshes)
+			ret_result = library::StreamMeshesFromFbxSession(_in_fbxSession_p, _in_elementsToExtract, file, _out_mesh);
+		else
+			ret_result = library::StreamMeshFromFbxSession(_in_fbxSession_p, "", _in_elementsToExtract, file,
+				_out_mesh);
+		if (!library::Succeeded(ret_result))
+			return discardFile(ret_result);
+
+		indexSection.element_count = _out_mesh.index_count;
+		table.push_back(indexSection);
+
+		// build the report first so meshes converted in parallel do not interleave
+		std::ostringstream report;
+		report << "Mesh : " << _in_exportFilepath << std::endl;
+		ReportMeshParts(_out_mesh, report);
+		report
+			<< "  Indices : " << _out_mesh.index_count << " x 32-bit, streamed ("
+			<< (uint64_t)_out_mesh.index_count * sizeof(uint32_t) << " bytes never held in memory)" << std::endl;
+
+		if (_in_settings.pack_vertices)
+		{
+			ret_result = PackMeshForExport(_out_mesh, _in_elementsToExtract, _in_settings, _out_packedMesh, report);
+			if (!library::Succeeded(ret_result))
+				return discardFile(ret_result);
 		}
-		*/
 
-		return library::Result::SUCCESS;
+		std::cout << report.str();
+
+		runtime::MeshInfo info;
+		const void* vertices_p = DescribeMeshVertices(_out_mesh, _in_elementsToExtract, _out_packedMesh, info);
+		info.index_count = _out_mesh.index_count;
+		info.index_size = sizeof(uint32_t);
+
+		std::string strings;
+		std::vector<runtime::MeshPartRecord> parts;
+		GatherMeshParts(_out_mesh, parts, strings);
+
+		std::vector<ContainerSectionData> sections;
+		AddContainerSection(sections, runtime::SectionType::VERTICES, runtime::CONTAINER_BULK_ALIGNMENT,
+			info.vertex_stride, info.vertex_count, vertices_p);
+		AddContainerSection(sections, runtime::SectionType::MESH_INFO, runtime::CONTAINER_TABLE_ALIGNMENT,
+			sizeof(info), 1, &info);
+		AddContainerSection(sections, runtime::SectionType::PARTS, runtime::CONTAINER_TABLE_ALIGNMENT,
+			sizeof(runtime::MeshPartRecord), parts.size(), parts.data());
+		AddContainerSection(sections, runtime::SectionType::STRINGS, runtime::CONTAINER_TABLE_ALIGNMENT,
+			sizeof(char), strings.size(), strings.data());
+
+		ret_result = AppendContainerSections(file, sections, table);
+		if (!library::Succeeded(ret_result))
+			return discardFile(ret_result);
+
+		ret_result = EndContainerFile(file, runtime::ContainerType::MESH, STREAMED_MESH_SECTION_COUNT, table);
+		if (!library::Succeeded(ret_result))
+			return discardFile(ret_result);
+
+		return ret_result;
 	}
-#pragma endregion
 
-#pragma region Interface Functions
-	library::Result GetMeshFromFbxFile(
-		const char*						_in_fbxFilepath
+	library::Result GetMeshFromFbxSession(
+		const library::FbxSession*		_in_fbxSession_p
+		, const char*					_in_fbxFilepath
 		, const uint32_t				_in_elementsToExtract
 		, const FileReadMode			_in_readMode
+		, const ExportSettings&			_in_settings
+		, library::Mesh&				_out_mesh
+		, library::PackedMesh&			_out_packedMesh
 	) {
 		library::Result ret_result = library::Result::FAIL;
 
 		char exportFilepath[260];
 		ReplaceExtension(_in_fbxFilepath, ".mesh", exportFilepath);
 
-		ret_result = library::GetMeshFromFbxFile(_in_fbxFilepath, "", _in_elementsToExtract, mesh);
+		// a streamed mesh is written while it is extracted, and never holds its raw vertices or indices
+		if (_in_settings.stream_mesh && _in_readMode == FileReadMode::EXPORT)
+			return GetStreamedMeshFromFbxSession(_in_fbxSession_p, exportFilepath, _in_elementsToExtract,
+				_in_settings, _out_mesh, _out_packedMesh);
+
+		if (_in_settings.all_meshes)
+			ret_result = library::GetMeshesFromFbxSession(_in_fbxSession_p, _in_elementsToExtract, _out_mesh);
+		else
+			ret_result = library::GetMeshFromFbxSession(_in_fbxSession_p, "", _in_elementsToExtract,
+				_out_mesh);
+		if (!library::Succeeded(ret_result))
+			return ret_result;
+
+		// build the report first so meshes converted in parallel do not interleave
+		std::ostringstream report;
+		report << "Mesh : " << exportFilepath << std::endl;
+		ReportMeshParts(_out_mesh, report);
+
+		// levels of detail are simplified from the welded mesh, before reordering changes its vertices
+		if (!_in_settings.lod_ratios.empty() && _in_readMode == FileReadMode::EXPORT)
+		{
+			ret_result = library::GenerateMeshLods(_out_mesh, _in_settings.lod_ratios, _out_mesh);
+			if (!library::Succeeded(ret_result))
+				return ret_result;
+
+			uint32_t triangleCount = _out_mesh.lods[0].index_count / 3;
+			for (size_t level = 1; level < _out_mesh.lods.size(); level++)
+				report
+					<< "  LOD " << level << " : " << _out_mesh.lods[level].index_count / 3 << " triangles ("
+					<< 100.0 * _out_mesh.lods[level].index_count / 3 / triangleCount << "%), error "
+					<< _out_mesh.lods[level].error << " units" << std::endl;
+			if (_out_mesh.lods.size() <= _in_settings.lod_ratios.size())
+				report
+					<< "  LOD " << _out_mesh.lods.size() << " : no collapse left that keeps borders and seams" << std::endl;
+		}
+
+		// triangles are reordered before splitting, so each submesh keeps the optimized order
+		if (_in_settings.optimize_mesh && _in_readMode == FileReadMode::EXPORT)
+		{
+			library::MeshOptimizationStats stats;
+
+			ret_result = library::OptimizeMesh(_out_mesh, _out_mesh, stats);
+			if (!library::Succeeded(ret_result))
+				return ret_result;
+
+			report
+				<< "  ACMR : " << stats.source.acmr << " -> " << stats.optimized.acmr << std::endl
+				<< "  ATVR : " << stats.source.atvr << " -> " << stats.optimized.atvr << std::endl;
+		}
+
+		// split so every submesh can be drawn with 16-bit indices
+		library::IndexSplitStats splitStats;
+		ret_result = library::SplitMeshForShortIndices(_out_mesh, _out_mesh, splitStats);
 		if (!library::Succeeded(ret_result))
 			return ret_result;
 
+		if (_in_readMode != FileReadMode::EXPORT)
+			return ret_result;
+
+		// 16-bit indices halve index memory and the index fetch bandwidth of every draw
+		int64_t addedVertexBytes = ((int64_t)splitStats.vertex_count - splitStats.source_vertex_count)
+			* (int64_t)sizeof(library::Vertex);
+		report
+			<< "  Indices : " << _out_mesh.index_count << " x 16-bit in " << splitStats.submesh_count
+			<< (splitStats.submesh_count == 1 ? " submesh" : " submeshes") << " ("
+			<< splitStats.source_index_bytes << " -> " << splitStats.index_bytes << " bytes)" << std::endl;
+		if (addedVertexBytes > 0)
+			report
+				<< "  Vertices copied between submeshes : " << splitStats.vertex_count - splitStats.source_vertex_count
+				<< " (" << addedVertexBytes << " bytes)" << std::endl;
+		report
+			<< "  Net saving : " << (int64_t)(splitStats.source_index_bytes - splitStats.index_bytes) - addedVertexBytes
+			<< " bytes" << std::endl;
+
+		// meshlets index the final vertices, so they are built once splitting has copied any
+		if (_in_settings.build_meshlets)
+		{
+			library::MeshletBuildStats stats;
+
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			ret_result = library::BuildMeshlets(_out_mesh, _in_settings.meshlet_max_vertices,
+				_in_settings.meshlet_max_triangles, _out_mesh, stats);
+			if (!library::Succeeded(ret_result))
+				return ret_result;
+			double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+			report
+				<< "  Meshlets : " << stats.meshlet_count << " (" << stats.triangle_count << " triangles, "
+				<< stats.vertex_reference_count << " vertex references) in " << milliseconds << " ms" << std::endl
+				<< "  Meshlet fill : " << 100.0f * stats.vertex_fill << "% vertices, "
+				<< 100.0f * stats.triangle_fill << "% triangles" << std::endl;
+		}
+
+		if (_in_settings.pack_vertices)
+		{
+			ret_result = PackMeshForExport(_out_mesh, _in_elementsToExtract, _in_settings, _out_packedMesh, report);
+			if (!library::Succeeded(ret_result))
+				return ret_result;
+		}
+
+		std::cout << report.str();
+
 		if (_in_readMode == FileReadMode::EXPORT)
-			ret_result = ExportMesh(exportFilepath, mesh);
+			ret_result = ExportMesh(exportFilepath, _out_mesh, _in_elementsToExtract, _out_packedMesh);
 		return ret_result;
 	}
-	library::Result GetMaterialsFromFbxFile(
-		const char*						_in_fbxFilepath
+	library::Result GetMaterialsFromFbxSession(
+		const library::FbxSession*		_in_fbxSession_p
+		, const char*					_in_fbxFilepath
 		, const uint32_t				_in_elementsToExtract
 		, const FileReadMode			_in_readMode
+		, library::MaterialList&		_out_materialList
 	) {
 		library::Result ret_result = library::Result::FAIL;
 
 		char exportFilepath[260];
 		ReplaceExtension(_in_fbxFilepath, ".mat", exportFilepath);
 
-		ret_result = library::GetMaterialsFromFbxFile(_in_fbxFilepath, 0, _in_elementsToExtract, materials);
+		ret_result = library::GetMaterialsFromFbxSession(_in_fbxSession_p, _in_elementsToExtract,
+			_out_materialList);
 		if (!library::Succeeded(ret_result))
 			return ret_result;
 
 		if (_in_readMode == FileReadMode::EXPORT)
-			ret_result = ExportMaterials(exportFilepath, materials);
+			ret_result = ExportMaterials(exportFilepath, _out_materialList);
 		return ret_result;
 	}
-	library::Result GetAnimationFromFbxFile(
-		const char*						_in_fbxFilepath
+	library::Result GetAnimationFromFbxSession(
+		const library::FbxSession*		_in_fbxSession_p
+		, const char*					_in_fbxFilepath
 		, const uint32_t				_in_elementsToExtract
 		, const FileReadMode			_in_readMode
+		, const ExportSettings&			_in_settings
+		, library::AnimationClip&		_out_animationClip
+		, library::SparseAnimationClip&	_out_sparseClip
 	) {
 		library::Result ret_result = library::Result::FAIL;
 
 		char exportFilepath[260];
 		ReplaceExtension(_in_fbxFilepath, ".anim", exportFilepath);
 
-		ret_result = library::GetAnimationFromFbxFile(_in_fbxFilepath, _in_elementsToExtract, animation);
+		ret_result = library::GetAnimationFromFbxSession(_in_fbxSession_p, _in_elementsToExtract,
+			_out_animationClip);
+		if (!library::Succeeded(ret_result) || _in_readMode != FileReadMode::EXPORT)
+			return ret_result;
+
+		// build the report first so clips converted in parallel do not interleave
+		std::ostringstream report;
+		library::QuantizedAnimationClip quantizedClip;
+
+		ret_result = ReduceAnimationClipForExport(_out_animationClip, exportFilepath, _in_settings,
+			_out_sparseClip, quantizedClip, report);
 		if (!library::Succeeded(ret_result))
 			return ret_result;
 
-		if (_in_readMode == FileReadMode::EXPORT)
-			ret_result = ExportAnimation(exportFilepath, animation);
+		if (_in_settings.animation_format == AnimationFormat::QUANTIZED_KEYS)
+			ret_result = ExportQuantizedAnimation(exportFilepath, quantizedClip);
+		else
+			ret_result = ExportAnimation(exportFilepath, _out_sparseClip);
+
+		if (!library::Succeeded(ret_result))
+			return ret_result;
+
+		std::cout << report.str();
+
+		return ret_result;
+	}
+	library::Result GetAnimationClipsFromFbxSession(
+		const library::FbxSession*		_in_fbxSession_p
+		, const char*					_in_fbxFilepath
+		, const uint32_t				_in_elementsToExtract
+		, const ExportSettings&			_in_settings
+		, std::vector<AnimationLibraryClip>&	_out_clips
+	) {
+		library::Result ret_result = library::Result::FAIL;
+
+		std::vector<library::AnimationClip> animationClips;
+
+		ret_result = library::GetAnimationsFromFbxSession(_in_fbxSession_p, _in_elementsToExtract,
+			animationClips);
+		if (!library::Succeeded(ret_result))
+			return ret_result;
+
+		// name clips after the file, and the stack if the file has several
+		std::string filename = _in_fbxFilepath;
+		std::string::size_type nameStart = filename.find_last_of("/\\");
+		filename = filename.substr(nameStart == std::string::npos ? 0 : nameStart + 1);
+		filename = filename.substr(0, filename.rfind('.'));
+
+		std::ostringstream report;
+		std::vector<AnimationLibraryClip> clips(animationClips.size());
+
+		for (size_t i = 0; i < animationClips.size(); i++)
+		{
+			clips[i].name = animationClips.size() > 1 ? filename + "/" + animationClips[i].name : filename;
+			clips[i].skeleton_hash = animationClips[i].skeleton_hash;
+
+			ret_result = ReduceAnimationClipForExport(animationClips[i], clips[i].name.c_str(), _in_settings,
+				clips[i].sparse_clip, clips[i].quantized_clip, report);
+			if (!library::Succeeded(ret_result))
+				return ret_result;
+
+			// dense frames are no longer needed once reduced
+			animationClips[i] = library::AnimationClip();
+		}
+
+		_out_clips.insert(_out_clips.end(), std::make_move_iterator(clips.begin()), std::make_move_iterator(clips.end()));
+		std::cout << report.str();
+
+		return library::Result::EXTRACT;
+	}
+#pragma endregion
+
+#pragma region Interface Functions
+	library::Result GetMeshFromFbxFile(
+		const char*						_in_fbxFilepath
+		, const uint32_t				_in_elementsToExtract
+		, library::Mesh&				_out_mesh
+		, const FileReadMode			_in_readMode
+		, const ExportSettings&			_in_settings
+	) {
+		library::Result ret_result = library::Result::FAIL;
+
+		library::FbxSession* fbxSession_p = nullptr;
+
+		ret_result = library::CreateFbxSession(_in_fbxFilepath, fbxSession_p);
+		if (!library::Succeeded(ret_result))
+			return ret_result;
+
+		library::PackedMesh packedMesh;
+
+		ret_result = GetMeshFromFbxSession(fbxSession_p, _in_fbxFilepath, _in_elementsToExtract,
+			_in_readMode, _in_settings, _out_mesh, packedMesh);
+		library::DestroyFbxSession(fbxSession_p);
+		return ret_result;
+	}
+	library::Result GetMaterialsFromFbxFile(
+		const char*						_in_fbxFilepath
+		, const uint32_t				_in_elementsToExtract
+		, library::MaterialList&		_out_materialList
+		, const FileReadMode			_in_readMode
+	) {
+		library::Result ret_result = library::Result::FAIL;
+
+		library::FbxSession* fbxSession_p = nullptr;
+
+		ret_result = library::CreateFbxSession(_in_fbxFilepath, fbxSession_p);
+		if (!library::Succeeded(ret_result))
+			return ret_result;
+
+		ret_result = GetMaterialsFromFbxSession(fbxSession_p, _in_fbxFilepath,
+			_in_elementsToExtract, _in_readMode, _out_materialList);
+		library::DestroyFbxSession(fbxSession_p);
+		return ret_result;
+	}
+	library::Result GetAnimationFromFbxFile(
+		const char*						_in_fbxFilepath
+		, const uint32_t				_in_elementsToExtract
+		, library::AnimationClip&		_out_animationClip
+		, const FileReadMode			_in_readMode
+		, const ExportSettings&			_in_settings
+	) {
+		library::Result ret_result = library::Result::FAIL;
+
+		library::FbxSession* fbxSession_p = nullptr;
+		library::SparseAnimationClip sparseClip;
+
+		ret_result = library::CreateFbxSession(_in_fbxFilepath, fbxSession_p);
+		if (!library::Succeeded(ret_result))
+			return ret_result;
+
+		ret_result = GetAnimationFromFbxSession(fbxSession_p, _in_fbxFilepath,
+			_in_elementsToExtract, _in_readMode, _in_settings, _out_animationClip, sparseClip);
+		library::DestroyFbxSession(fbxSession_p);
 		return ret_result;
 	}
 	library::Result GetDataFromFbxFile(
 		const char*						_in_fbxFilepath
 		, const uint32_t*				_in_elementsToExtract
 		, const FileReadMode*			_in_readModes
+		, FbxFileData&					_out_data
+		, const ExportSettings&			_in_settings
 	) {
 		library::Result ret_result = library::Result::FAIL;
 
-		// animation must be extracted before mesh to include animation joint weights in mesh data
-		ret_result = GetAnimationFromFbxFile(_in_fbxFilepath,
-			_in_elementsToExtract[library::DataTypeIndex::ANIMATION],
-			_in_readModes[library::DataTypeIndex::ANIMATION]);
+		// import file once and extract all data types from the same scene
+		library::FbxSession* fbxSession_p = nullptr;
+
+		ret_result = library::CreateFbxSession(_in_fbxFilepath, fbxSession_p);
 		if (!library::Succeeded(ret_result))
 			return ret_result;
 
-		ret_result = GetMeshFromFbxFile(_in_fbxFilepath,
-			_in_elementsToExtract[library::DataTypeIndex::MESH],
-			_in_readModes[library::DataTypeIndex::MESH]);
+		// skin weights index joints in the order extracted animations store them, so either may come first
+		if (_in_readModes[library::DataTypeIndex::ANIMATION] != FileReadMode::SKIP
+			&& _in_settings.animation_library)
+		{
+			ret_result = GetAnimationClipsFromFbxSession(fbxSession_p, _in_fbxFilepath,
+				_in_elementsToExtract[library::DataTypeIndex::ANIMATION], _in_settings,
+				_out_data.animation_clips);
+			if (!library::Succeeded(ret_result))
+			{
+				library::DestroyFbxSession(fbxSession_p);
+				return ret_result;
+			}
+		}
+		else if (_in_readModes[library::DataTypeIndex::ANIMATION] != FileReadMode::SKIP)
+		{
+			ret_result = GetAnimationFromFbxSession(fbxSession_p, _in_fbxFilepath,
+				_in_elementsToExtract[library::DataTypeIndex::ANIMATION],
+				_in_readModes[library::DataTypeIndex::ANIMATION], _in_settings, _out_data.animation,
+				_out_data.sparse_animation);
+			if (!library::Succeeded(ret_result))
+			{
+				library::DestroyFbxSession(fbxSession_p);
+				return ret_result;
+			}
+		}
+
+		if (_in_readModes[library::DataTypeIndex::MESH] != FileReadMode::SKIP)
+		{
+			ret_result = GetMeshFromFbxSession(fbxSession_p, _in_fbxFilepath,
+				_in_elementsToExtract[library::DataTypeIndex::MESH],
+				_in_readModes[library::DataTypeIndex::MESH], _in_settings, _out_data.mesh,
+				_out_data.packed_mesh);
+			if (!library::Succeeded(ret_result))
+			{
+				library::DestroyFbxSession(fbxSession_p);
+				return ret_result;
+			}
+		}
+
+		if (_in_readModes[library::DataTypeIndex::MATERIAL] != FileReadMode::SKIP)
+		{
+			ret_result = GetMaterialsFromFbxSession(fbxSession_p, _in_fbxFilepath,
+				_in_elementsToExtract[library::DataTypeIndex::MATERIAL],
+				_in_readModes[library::DataTypeIndex::MATERIAL], _out_data.materials);
+		}
+
+		library::DestroyFbxSession(fbxSession_p);
+		return ret_result;
+	}
+	library::Result ExportAnimationLibrary(
+		const char*						_in_filepath
+		, const std::vector<AnimationLibraryClip>&	_in_clips
+		, const AnimationFormat			_in_format
+	) {
+		if (_in_filepath == nullptr || _in_clips.empty())
+			return library::Result::INVALID_ARG;
+
+		bool quantized = _in_format == AnimationFormat::QUANTIZED_KEYS;
+		uint32_t keySize = quantized ? sizeof(uint16_t) : sizeof(float);
+
+		// store each skeleton once, in order of first use
+		std::vector<runtime::AnimationSkeletonRecord> skeletons;
+		std::vector<uint32_t> clipSkeletons(_in_clips.size());
+		ContainerSectionData joints = { runtime::SectionType::JOINTS, runtime::CONTAINER_TABLE_ALIGNMENT, sizeof(library::AnimationJoint) };
+		for (size_t c = 0; c < _in_clips.size(); c++)
+		{
+			const AnimationLibraryClip& clip = _in_clips[c];
+			uint32_t numJoints = (uint32_t)clip.sparse_clip.joints.size();
+
+			uint32_t s = 0;
+			while (s < skeletons.size() && skeletons[s].hash != clip.skeleton_hash)
+				s++;
+
+			if (s == skeletons.size())
+			{
+				if (numJoints == 0)
+					return library::Result::INVALID_ARG;
+
+				runtime::AnimationSkeletonRecord skeleton;
+				skeleton.hash = clip.skeleton_hash;
+				skeleton.joint_offset = (uint32_t)joints.element_count;
+				skeleton.joint_count = numJoints;
+				skeletons.push_back(skeleton);
+
+				joints.spans.push_back({ clip.sparse_clip.joints.data(), numJoints * sizeof(library::AnimationJoint) });
+				joints.element_count += numJoints;
+			}
+			else if (skeletons[s].joint_count != numJoints)
+				return library::Result::INVALID_ARG;
+
+			// verify every joint has tracks
+			size_t numTracks = quantized ? clip.quantized_clip.tracks.size() : clip.sparse_clip.tracks.size();
+			if (numTracks != numJoints)
+				return library::Result::INVALID_ARG;
+
+			clipSkeletons[c] = s;
+		}
+
+		// clips share one set of channel and key sections, as in .anim files
+		std::vector<runtime::AnimationClipRecord> clips(_in_clips.size());
+		std::vector<runtime::AnimationTrackRecord> records;
+		ContainerSectionData times = { runtime::SectionType::KEY_TIMES, runtime::CONTAINER_BULK_ALIGNMENT, keySize };
+		ContainerSectionData values = { runtime::SectionType::KEY_VALUES, runtime::CONTAINER_BULK_ALIGNMENT, keySize };
+		ContainerSectionData strings = { runtime::SectionType::STRINGS, runtime::CONTAINER_TABLE_ALIGNMENT, sizeof(char) };
+		for (size_t c = 0; c < _in_clips.size(); c++)
+		{
+			const AnimationLibraryClip& clip = _in_clips[c];
+
+			clips[c].name_offset = (uint32_t)strings.element_count;
+			clips[c].name_length = (uint32_t)clip.name.size();
+			clips[c].skeleton = clipSkeletons[c];
+			clips[c].track_offset = (uint32_t)records.size();
+			clips[c].duration = quantized ? clip.quantized_clip.duration : clip.sparse_clip.duration;
+
+			strings.spans.push_back({ clip.name.data(), clip.name.size() });
+			strings.element_count += clip.name.size();
+
+			if (quantized)
+				GatherQuantizedAnimationKeys(clip.quantized_clip, records, times, values);
+			else
+				GatherAnimationKeys(clip.sparse_clip, records, times, values);
+		}
+
+		runtime::AnimationLibraryInfo info;
+		info.format = quantized ? runtime::AnimationFormat::QUANTIZED_KEYS : runtime::AnimationFormat::FLOAT_KEYS;
+		info.skeleton_count = (uint32_t)skeletons.size();
+		info.clip_count = (uint32_t)clips.size();
+
+		// write data to file with format:
+		//   ContainerHeader, ContainerSection[numSections]	: header and section table
+		//   ANIMATION_LIBRARY_INFO							: AnimationLibraryInfo
+		//   SKELETONS										: AnimationSkeletonRecord per skeleton
+		//   CLIPS											: AnimationClipRecord per clip
+		//   JOINTS											: ContainerJoint per joint of every skeleton
+		//   TRACKS											: translation, rotation and scale AnimationTrackRecord per
+		//													  joint of every clip
+		//   KEY_TIMES, KEY_VALUES							: keys of every clip, as in .anim files
+		//   STRINGS										: clip names
+		std::vector<ContainerSectionData> sections;
+		AddContainerSection(sections, runtime::SectionType::ANIMATION_LIBRARY_INFO, runtime::CONTAINER_TABLE_ALIGNMENT,
+			sizeof(info), 1, &info);
+		AddContainerSection(sections, runtime::SectionType::SKELETONS, runtime::CONTAINER_TABLE_ALIGNMENT,
+			sizeof(runtime::AnimationSkeletonRecord), skeletons.size(), skeletons.data());
+		AddContainerSection(sections, runtime::SectionType::CLIPS, runtime::CONTAINER_TABLE_ALIGNMENT,
+			sizeof(runtime::AnimationClipRecord), clips.size(), clips.data());
+		sections.push_back(joints);
+		AddContainerSection(sections, runtime::SectionType::TRACKS, runtime::CONTAINER_TABLE_ALIGNMENT,
+			sizeof(runtime::AnimationTrackRecord), records.size(), records.data());
+		if (times.element_count > 0)
+		{
+			sections.push_back(times);
+			sections.push_back(values);
+		}
+		if (strings.element_count > 0)
+			sections.push_back(strings);
+
+		library::Result ret_result = WriteContainerFile(_in_filepath, runtime::ContainerType::ANIMATION_LIBRARY, sections);
 		if (!library::Succeeded(ret_result))
 			return ret_result;
 
-		ret_result = GetMaterialsFromFbxFile(_in_fbxFilepath,
-			_in_elementsToExtract[library::DataTypeIndex::MATERIAL],
-			_in_readModes[library::DataTypeIndex::MATERIAL]);
+		// bind pose bytes saved by sharing skeletons
+		uint64_t jointBytes = 0, sharedJointBytes = joints.element_count * sizeof(library::AnimationJoint);
+		for (const AnimationLibraryClip& clip : _in_clips)
+			jointBytes += clip.sparse_clip.joints.size() * sizeof(library::AnimationJoint);
+
+		std::cout
+			<< "Animation library : " << _in_filepath << std::endl
+			<< "  Clips : " << info.clip_count << std::endl
+			<< "  Skeletons : " << info.skeleton_count << std::endl
+			<< "  Bind pose data : " << jointBytes << " -> " << sharedJointBytes << " bytes" << std::endl;
+
 		return ret_result;
 	}
+	void GatherMaterialTextures(
+		const char*						_in_fbxFilepath
+		, const library::MaterialList&	_in_materials
+		, std::vector<TextureExport>&	_out_textures
+	) {
+		std::error_code error;
+		std::filesystem::path directory = std::filesystem::path(_in_fbxFilepath).parent_path();
+
+		for (const library::Material& material : _in_materials.materials)
+			for (uint32_t c = 0; c < library::Material::ComponentType::COUNT; c++)
+			{
+				int32_t input = material[c].input;
+				if (input < 0 || (size_t)input >= _in_materials.textures.size())
+					continue;
+
+				// filepaths written on Windows keep their backslashes
+				const library::TexturePath& texture = _in_materials.textures[input];
+				std::string name = _in_materials.strings.substr(texture.offset, texture.length);
+				std::replace(name.begin(), name.end(), '\\', '/');
+
+				std::filesystem::path source = name;
+				if (source.is_relative())
+					source = directory / source;
+				if (!std::filesystem::exists(source, error) && std::filesystem::exists(directory / source.filename(), error))
+					source = directory / source.filename();
+				source = source.lexically_normal();
+
+				// a texture shared by several materials or files is compressed once, in the format of its first use
+				std::string sourceFilepath = source.string();
+				if (std::any_of(_out_textures.begin(), _out_textures.end(),
+					[&](const TextureExport& _in_other) { return _in_other.source_filepath == sourceFilepath; }))
+					continue;
+
+				TextureExport entry;
+				entry.source_filepath = sourceFilepath;
+				entry.export_filepath = source.replace_extension(".tex").string();
+				entry.component = (library::Material::ComponentType)c;
+				_out_textures.push_back(entry);
+			}
+	}
+	library::Result ExportTextures(
+		const std::vector<TextureExport>&	_in_textures
+		, const ExportSettings&			_in_settings
+	) {
+		using clock = std::chrono::steady_clock;
+		static const char* formatNames[] = { "", "BC1", "BC3", "BC5", "BC7" };
+
+		uint32_t workers = library::GetWorkerThreadCount() > 0
+			? library::GetWorkerThreadCount() : library::GetHardwareThreadCount();
+		uint32_t groupSize = std::max(workers, 1u);
+		uint32_t failedCount = 0;
+		clock::time_point start = clock::now();
+
+		for (size_t first = 0; first < _in_textures.size(); first += groupSize)
+		{
+			uint32_t count = (uint32_t)std::min((size_t)groupSize, _in_textures.size() - first);
+
+			// -- decode --
+			std::vector<library::Image> images(count);
+			std::vector<library::Result> decodeResults(count, library::Result::FAIL);
+			std::vector<double> decodeMilliseconds(count, 0.0);
+
+			library::ParallelFor(count, library::GetWorkerThreadCount(), [&](uint32_t _in_index, uint32_t)
+			{
+				clock::time_point decodeStart = clock::now();
+				decodeResults[_in_index] = library::LoadImageFile(
+					_in_textures[first + _in_index].source_filepath.c_str(), images[_in_index]);
+				decodeMilliseconds[_in_index] = std::chrono::duration<double, std::milli>(clock::now() - decodeStart).count();
+			});
+			// -- /decode --
+
+			// -- compress --
+			// only decoded images are compressed; slots map them back to the group
+			std::vector<library::Image> decoded;
+			std::vector<library::TextureFormat> formats;
+			std::vector<int32_t> slots(count, -1);
+			for (uint32_t i = 0; i < count; i++)
+				if (library::Succeeded(decodeResults[i]))
+				{
+					slots[i] = (int32_t)decoded.size();
+					formats.push_back(SelectTextureFormat(images[i], _in_textures[first + i].component, _in_settings));
+					decoded.push_back(std::move(images[i]));
+				}
+
+			std::vector<library::CompressedTexture> compressed;
+			std::vector<library::TextureCompressionStats> stats;
+			library::Result compressResult = decoded.empty() ? library::Result::SUCCESS
+				: library::CompressTextures(decoded, formats, compressed, stats);
+			// -- /compress --
+
+			for (uint32_t i = 0; i < count; i++)
+			{
+				const TextureExport& texture = _in_textures[first + i];
+				library::Result result = library::Succeeded(decodeResults[i]) ? compressResult : decodeResults[i];
+				if (library::Succeeded(result))
+					result = ExportTexture(texture.export_filepath.c_str(), compressed[slots[i]]);
+
+				if (!library::Succeeded(result))
+				{
+					failedCount++;
+					std::cout << "[FAIL] " << texture.source_filepath << " : "
+						<< (library::Succeeded(decodeResults[i]) ? "export failed" : "decode failed") << std::endl;
+					continue;
+				}
+
+				const library::CompressedTexture& output = compressed[slots[i]];
+				const library::TextureCompressionStats& stat = stats[slots[i]];
+				std::cout << "[ OK ] " << texture.export_filepath << " : " << formatNames[(uint32_t)output.format]
+					<< " " << output.width << "x" << output.height
+					<< ", decode " << decodeMilliseconds[i] << " ms"
+					<< ", encode " << stat.milliseconds << " ms"
+					<< ", PSNR ";
+				if (std::isinf(stat.psnr))
+					std::cout << "lossless" << std::endl;
+				else
+					std::cout << stat.psnr << " dB" << std::endl;
+			}
+		}
+
+		std::cout
+			<< "Textures : " << _in_textures.size() << std::endl
+			<< "  Failed : " << failedCount << std::endl
+			<< "  Wall time : " << std::chrono::duration<double, std::milli>(clock::now() - start).count()
+			<< " ms on " << workers << " threads" << std::endl;
+
+		return failedCount == 0 ? library::Result::EXPORT : library::Result::FAIL;
+	}
 #pragma endregion
 
 }
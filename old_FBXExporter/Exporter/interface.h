@@ -1,6 +1,8 @@
 #ifndef _FBXEXPORTER_EXPORTER_INTERFACE_H_
 #define _FBXEXPORTER_EXPORTER_INTERFACE_H_
 
+#include <vector>
+
 #include "defines.h"
 
 #include "../Library/defines.h"
@@ -12,8 +14,11 @@ namespace fbx_exporter
 	  PARAMETERS
 	    _in_fbxFilepath : The path to the .fbx file to read from.
 		_in_elementsToExtract : A bit-flag set indicating which vertex elements to store.
+		_out_mesh : The mesh container to store extracted data in.
 		_in_readMode : A value indicating how to use the data from the file.
 		  DEFAULT : FileReadMode::EXTRACT
+		_in_settings : The settings for stages run before export.
+		  DEFAULT : ExportSettings()
 	  RETURNS
 	    INVALID_ARG : An invalid argument was passed.
 		FAIL : File could not be opened.
@@ -22,13 +27,16 @@ namespace fbx_exporter
 	library::Result GetMeshFromFbxFile(
 		const char*						_in_fbxFilepath
 		, const uint32_t				_in_elementsToExtract
+		, library::Mesh&				_out_mesh
 		, const FileReadMode			_in_readMode = FileReadMode::EXTRACT
+		, const ExportSettings&			_in_settings = ExportSettings()
 	);
 
 	/* Extracts, stores, and optionally exports mesh data from a .fbx file.
 	  PARAMETERS
 		_in_fbxFilepath : The path to the .fbx file to read from.
 		_in_elementsToExtract : A bit-flag set indicating which texture elements to store.
+		_out_materialList : The material and filepath container to store extracted data in.
 		_in_readMode : A value indicating how to use the data from the file.
 		  DEFAULT : FileReadMode::EXTRACT
 	  RETURNS
@@ -39,6 +47,7 @@ namespace fbx_exporter
 	library::Result GetMaterialsFromFbxFile(
 		const char*						_in_fbxFilepath
 		, const uint32_t				_in_elementsToExtract
+		, library::MaterialList&		_out_materialList
 		, const FileReadMode			_in_readMode = FileReadMode::EXTRACT
 	);
 
@@ -46,8 +55,11 @@ namespace fbx_exporter
 	  PARAMETERS
 		_in_fbxFilepath : The path to the .fbx file to read from.
 		_in_elementsToExtract : A bit-flag set indicating which animation elements to store.
+		_out_animationClip : The animation container to store extracted data in.
 		_in_readMode : A value indicating how to use the data from the file.
 		  DEFAULT : FileReadMode::EXTRACT
+		_in_settings : The tolerances used to remove keys before export.
+		  DEFAULT : ExportSettings()
 	  RETURNS
 		INVALID_ARG : An invalid argument was passed.
 		FAIL : File could not be opened.
@@ -56,7 +68,9 @@ namespace fbx_exporter
 	library::Result GetAnimationFromFbxFile(
 		const char*						_in_fbxFilepath
 		, const uint32_t				_in_elementsToExtract
+		, library::AnimationClip&		_out_animationClip
 		, const FileReadMode			_in_readMode = FileReadMode::EXTRACT
+		, const ExportSettings&			_in_settings = ExportSettings()
 	);
 
 	/* Extracts, stores, and optionally exports mesh data from a .fbx file.
@@ -64,7 +78,10 @@ namespace fbx_exporter
 		_in_fbxFilepath : The path to the .fbx file to read from.
 		_in_elementsToExtract : A bit-flag set array indicating which data elements to store.
 		_in_readMode : A value array indicating how to use the data from the file.
-		  DEFAULT : FileReadMode::EXTRACT
+		  SKIP : The data type is not read.
+		_out_data : The containers to store extracted data in.
+		_in_settings : The settings for stages run before export.
+		  DEFAULT : ExportSettings()
 	  RETURNS
 		INVALID_ARG : An invalid argument was passed.
 		FAIL : File could not be opened.
@@ -74,6 +91,60 @@ namespace fbx_exporter
 		const char*						_in_fbxFilepath
 		, const uint32_t*				_in_elementsToExtract
 		, const FileReadMode*			_in_readModes
+		, FbxFileData&					_out_data
+		, const ExportSettings&			_in_settings = ExportSettings()
+	);
+
+	/* Exports clips from any number of files into one .animlib container file.
+	  PARAMETERS
+		_in_filepath : The filepath to export data to.
+		_in_clips : The clips to export, from FbxFileData::animation_clips.
+		_in_format : The layout of the clip keys. Must match the settings the clips were reduced with.
+	  RETURNS
+		INVALID_ARG : No clips were passed, a clip has no tracks for some joint, or clips with equal
+		  skeleton hashes have different joint counts.
+		FAIL : File could not be opened.
+		EXPORT : Data was successfully exported to file.
+	  NOTES
+		Each skeleton's joints are written once, and clips reference their skeleton by index.
+		Every clip's channels and keys share one TRACKS, KEY_TIMES and KEY_VALUES section, laid
+		out as in .anim files.
+	*/
+	library::Result ExportAnimationLibrary(
+		const char*						_in_filepath
+		, const std::vector<AnimationLibraryClip>&	_in_clips
+		, const AnimationFormat			_in_format
+	);
+
+	/* Adds the textures referenced by a file's materials to a list of textures to compress.
+	  PARAMETERS
+		_in_fbxFilepath : The .fbx file the materials were extracted from.
+		_in_materials : The extracted materials.
+		_out_textures : The list to add textures to. Textures already in the list are not added again.
+	  NOTES
+		Relative filepaths are resolved against the .fbx file's directory. A filepath that does not exist
+		is replaced by the file of the same name next to the .fbx file, if there is one.
+	*/
+	void GatherMaterialTextures(
+		const char*						_in_fbxFilepath
+		, const library::MaterialList&	_in_materials
+		, std::vector<TextureExport>&	_out_textures
+	);
+
+	/* Decodes, compresses and exports textures to .tex files, and reports their time and error.
+	  PARAMETERS
+		_in_textures : The textures to export, from GatherMaterialTextures.
+		_in_settings : The settings selecting color texture formats.
+	  RETURNS
+		FAIL : At least one texture could not be decoded or exported. The others were exported.
+		EXPORT : Every texture was exported.
+	  NOTES
+		Images are decoded in parallel a group at a time, and the blocks of a whole group are compressed
+		as one job list, so the decoded pixels held at once stay bounded by the group size.
+	*/
+	library::Result ExportTextures(
+		const std::vector<TextureExport>&	_in_textures
+		, const ExportSettings&			_in_settings
 	);
 
 }
@@ -1,6 +1,28 @@
 #include "interface.h"
 
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
 #include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <psapi.h>
+#pragma comment(lib, "psapi.lib")
+#else
+#include <sys/resource.h>
+#endif
+
+#include "../Library/parallel.h"
 
 #include "../Library/debug.h"
 
@@ -84,6 +106,8 @@ namespace
 				<< " - Colors; "
 				<< static_cast<int>(fbx_exporter::library::MeshElement::TEXCOORD)
 				<< " - Texture coordinates; "
+				<< static_cast<int>(fbx_exporter::library::MeshElement::SKIN)
+				<< " - Skin weights; "
 				<< static_cast<int>(fbx_exporter::library::MeshElement::ALL)
 				<< " - All"
 				<< std::endl
@@ -120,13 +144,580 @@ namespace
 		if (dataTypesToExport[fbx_exporter::library::DataTypeIndex::ANIMATION]
 			== fbx_exporter::FileReadMode::EXPORT)
 		{
-			std::cout << "No animation options supported"
-				<< std::endl;
+			std::cout << "Animation elements supported : "
+				<< static_cast<int>(fbx_exporter::library::AnimationElement::LOCAL_TRANSFORMS)
+				<< " - Parent-relative joint transforms; "
+				<< "0 - Model-space joint transforms"
+				<< std::endl
+				<< "Enter sum of selections : ";
+
+			// read animation options
+			std::cin.getline(buffer, 50);
+			elementOptions[fbx_exporter::library::DataTypeIndex::ANIMATION]
+				= strtol(buffer, nullptr, 10);
+			std::cout << std::endl;
 		}
 
 		// if valid selection was made, return true
 		return true;
 	}
+
+	// Result of converting one file in batch mode.
+	struct BatchJob
+	{
+		std::string						filepath;  // Path of the .fbx file to convert.
+		fbx_exporter::library::Result	result = fbx_exporter::library::Result::FAIL;  // Conversion result.
+		double							milliseconds = 0.0;  // Time spent converting the file.
+		std::vector<fbx_exporter::AnimationLibraryClip>	animation_clips;  // Clips for the animation library.
+		fbx_exporter::library::MaterialList	materials;  // Materials whose textures are compressed after every file is converted.
+	};
+
+	uint32_t							threadCount = 0;
+	bool								searchRecursively = false;
+	fbx_exporter::ExportSettings		exportSettings;
+	std::string							animationLibraryPath;
+	std::vector<std::string>			inputPaths;
+
+	/* Checks whether command line arguments request batch mode.
+	  PARAMETERS
+		_in_argc : The number of command line arguments.
+		_in_argv : The command line arguments.
+	  RETURNS
+		true : Arguments contain options, several paths, a directory, or a wildcard.
+		false : Arguments are a single dropped file.
+	*/
+	bool IsBatchMode(int _in_argc, char* _in_argv[])
+	{
+		if (_in_argc != 2)
+			return _in_argc > 2;
+
+		std::string arg = _in_argv[1];
+		std::error_code error;
+
+		return arg[0] == '-' || arg.find_first_of("*?") != std::string::npos
+			|| std::filesystem::is_directory(arg, error);
+	}
+
+	/* Reads and stores export options and input paths from the command line.
+	  PARAMETERS
+		_in_argc : The number of command line arguments.
+		_in_argv : The command line arguments.
+	  RETURNS
+		true : A valid export selection and at least one input path were given.
+		false : Arguments were invalid.
+	*/
+	bool ReadBatchOptions(int _in_argc, char* _in_argv[])
+	{
+		namespace lib = fbx_exporter::library;
+
+		for (uint32_t i = 0; i < lib::DataTypeIndex::COUNT; i++)
+			dataTypesToExport[i] = fbx_exporter::FileReadMode::SKIP;
+
+		for (int i = 1; i < _in_argc; i++)
+		{
+			std::string arg = _in_argv[i];
+
+			if (arg[0] != '-')
+			{
+				inputPaths.push_back(arg);
+				continue;
+			}
+
+			// split "-option=value"
+			std::string::size_type split = arg.find('=');
+			std::string option = arg.substr(1, split == std::string::npos ? std::string::npos : split - 1);
+			const char* value = split == std::string::npos ? nullptr : arg.c_str() + split + 1;
+
+			if (option == "mesh")
+			{
+				dataTypesToExport[lib::DataTypeIndex::MESH] = fbx_exporter::FileReadMode::EXPORT;
+				elementOptions[lib::DataTypeIndex::MESH] = value != nullptr
+					? strtol(value, nullptr, 10) : static_cast<int>(lib::MeshElement::ALL);
+			}
+			else if (option == "meshall")
+			{
+				exportSettings.all_meshes = true;
+			}
+			else if (option == "meshstream")
+			{
+				exportSettings.stream_mesh = true;
+			}
+			else if (option == "meshlod")
+			{
+				// "ratio[,ratio...]" of source triangles kept per level
+				exportSettings.lod_ratios.clear();
+				if (value == nullptr)
+					exportSettings.lod_ratios = { 0.5f, 0.25f, 0.125f };
+				else
+				{
+					std::stringstream ratios(value);
+					std::string ratio;
+					while (std::getline(ratios, ratio, ','))
+						exportSettings.lod_ratios.push_back(strtof(ratio.c_str(), nullptr));
+				}
+			}
+			else if (option == "meshopt")
+			{
+				exportSettings.optimize_mesh = true;
+			}
+			else if (option == "meshlets")
+			{
+				// "vertices[,triangles]" per meshlet
+				exportSettings.build_meshlets = true;
+				exportSettings.meshlet_max_vertices = lib::MESHLET_DEFAULT_VERTEX_COUNT;
+				exportSettings.meshlet_max_triangles = lib::MESHLET_DEFAULT_TRIANGLE_COUNT;
+				if (value != nullptr)
+				{
+					char* end = nullptr;
+					exportSettings.meshlet_max_vertices = (uint32_t)strtoul(value, &end, 10);
+					if (*end == ',')
+						exportSettings.meshlet_max_triangles = (uint32_t)strtoul(end + 1, nullptr, 10);
+				}
+			}
+			else if (option == "meshpack")
+			{
+				// "format[,format...]" packs only the elements named; others stay float
+				lib::VertexLayout& layout = exportSettings.vertex_layout;
+				exportSettings.pack_vertices = true;
+				layout = lib::VertexLayout();
+
+				if (value != nullptr)
+				{
+					layout.normal = lib::VertexNormalFormat::FLOAT;
+					layout.color = lib::VertexColorFormat::FLOAT;
+					layout.texcoord = lib::VertexTexCoordFormat::FLOAT;
+					layout.skin = lib::VertexSkinFormat::FLOAT;
+
+					std::stringstream formats(value);
+					std::string format;
+					while (std::getline(formats, format, ','))
+					{
+						if (format == "pos16")
+							layout.position = lib::VertexPositionFormat::UNORM16;
+						else if (format == "oct16")
+							layout.normal = lib::VertexNormalFormat::OCTAHEDRAL16;
+						else if (format == "rgba8")
+							layout.color = lib::VertexColorFormat::UNORM8;
+						else if (format == "uv16f")
+							layout.texcoord = lib::VertexTexCoordFormat::HALF;
+						else if (format == "uv16")
+							layout.texcoord = lib::VertexTexCoordFormat::UNORM16;
+						else if (format == "skin8")
+							layout.skin = lib::VertexSkinFormat::UNORM8_UINT8;
+						else if (format == "skin16")
+							layout.skin = lib::VertexSkinFormat::UNORM8_UINT16;
+						else
+						{
+							std::cout << "Unknown vertex format : " << format << std::endl;
+							return false;
+						}
+					}
+				}
+			}
+			else if (option == "mat")
+			{
+				dataTypesToExport[lib::DataTypeIndex::MATERIAL] = fbx_exporter::FileReadMode::EXPORT;
+				elementOptions[lib::DataTypeIndex::MATERIAL] = value != nullptr
+					? strtol(value, nullptr, 10) : static_cast<int>(lib::MaterialElement::ALL);
+			}
+			else if (option == "textures")
+			{
+				// "bc7" or "bc1" for color textures; normal maps are always BC5
+				exportSettings.compress_textures = true;
+				if (value != nullptr)
+				{
+					std::string format = value;
+					if (format == "bc7")
+						exportSettings.color_texture_format = lib::TextureFormat::BC7;
+					else if (format == "bc1")
+						exportSettings.color_texture_format = lib::TextureFormat::BC1;
+					else
+					{
+						std::cout << "Unknown texture format : " << format << std::endl;
+						return false;
+					}
+				}
+			}
+			else if (option == "anim")
+			{
+				dataTypesToExport[lib::DataTypeIndex::ANIMATION] = fbx_exporter::FileReadMode::EXPORT;
+			}
+			else if (option == "all")
+			{
+				for (uint32_t t = 0; t < lib::DataTypeIndex::COUNT; t++)
+					dataTypesToExport[t] = fbx_exporter::FileReadMode::EXPORT;
+				elementOptions[lib::DataTypeIndex::MESH] = static_cast<int>(lib::MeshElement::ALL);
+				elementOptions[lib::DataTypeIndex::MATERIAL] = static_cast<int>(lib::MaterialElement::ALL);
+			}
+			else if (option == "animerror" && value != nullptr)
+			{
+				// "position[,rotation degrees[,scale]]"
+				char* next_p = nullptr;
+				lib::AnimationTolerance& tolerance = exportSettings.animation_tolerance;
+
+				tolerance.translation = strtof(value, &next_p);
+				if (*next_p == ',')
+					tolerance.rotation = strtof(next_p + 1, &next_p) / 57.2957795f;
+				if (*next_p == ',')
+					tolerance.scale = strtof(next_p + 1, &next_p);
+			}
+			else if (option == "animlib" && value != nullptr)
+			{
+				dataTypesToExport[lib::DataTypeIndex::ANIMATION] = fbx_exporter::FileReadMode::EXPORT;
+				exportSettings.animation_library = true;
+				animationLibraryPath = value;
+			}
+			else if (option == "animlocal")
+			{
+				elementOptions[lib::DataTypeIndex::ANIMATION] |= static_cast<int>(lib::AnimationElement::LOCAL_TRANSFORMS);
+			}
+			else if (option == "animquantize")
+			{
+				exportSettings.animation_format = fbx_exporter::AnimationFormat::QUANTIZED_KEYS;
+			}
+			else if (option == "threads" && value != nullptr)
+			{
+				threadCount = strtoul(value, nullptr, 10);
+			}
+			else if (option == "recursive")
+			{
+				searchRecursively = true;
+			}
+			else
+			{
+				std::cout << "Unknown option : " << arg << std::endl;
+				return false;
+			}
+		}
+
+		// streamed meshes are written as they are extracted, so stages that need every index cannot run
+		if (exportSettings.stream_mesh
+			&& (!exportSettings.lod_ratios.empty() || exportSettings.optimize_mesh || exportSettings.build_meshlets))
+		{
+			std::cout << "-meshstream cannot be combined with -meshlod, -meshopt or -meshlets" << std::endl;
+			return false;
+		}
+
+		if (inputPaths.empty())
+		{
+			std::cout << "No file to import" << std::endl;
+			return false;
+		}
+
+		// textures are found through materials, which are extracted without a .mat file unless -mat was given
+		if (exportSettings.compress_textures)
+		{
+			if (dataTypesToExport[lib::DataTypeIndex::MATERIAL] == fbx_exporter::FileReadMode::SKIP)
+			{
+				dataTypesToExport[lib::DataTypeIndex::MATERIAL] = fbx_exporter::FileReadMode::EXTRACT;
+				elementOptions[lib::DataTypeIndex::MATERIAL] = static_cast<int>(lib::MaterialElement::ALL);
+			}
+			return true;
+		}
+
+		for (uint32_t i = 0; i < lib::DataTypeIndex::COUNT; i++)
+			if (dataTypesToExport[i] == fbx_exporter::FileReadMode::EXPORT)
+				return true;
+
+		std::cout << "Invalid selection" << std::endl;
+		return false;
+	}
+
+	/* Prints command line usage for batch mode. */
+	void PrintBatchUsage()
+	{
+		std::cout
+			<< "Usage : Exporter <file.fbx>" << std::endl
+			<< "        Exporter [options] <file | directory | wildcard>..." << std::endl
+			<< "  -mesh[=elements]  Export .mesh files (default elements: all)" << std::endl
+			<< "  -meshall          Export every mesh of a file into one .mesh, with a part per mesh and material" << std::endl
+			<< "  -meshstream       Write .mesh indices while extracting, to bound memory on very large meshes." << std::endl
+			<< "                    Indices stay 32-bit; cannot be combined with -meshlod, -meshopt or -meshlets" << std::endl
+			<< "  -meshlod[=R,...]  Add levels of detail keeping R of the .mesh triangles each, and report" << std::endl
+			<< "                    their error (default: 0.5,0.25,0.125)" << std::endl
+			<< "  -meshopt          Reorder .mesh triangles and vertices for GPU cache reuse" << std::endl
+			<< "                    and report ACMR/ATVR before and after" << std::endl
+			<< "  -meshlets[=V,T]   Split .mesh triangles into meshlets of at most V vertices and T triangles" << std::endl
+			<< "                    with bounds, and report build time and fill (default: 64,124)" << std::endl
+			<< "  -meshpack[=F,...] Pack .mesh vertices and report the error. Formats: pos16 (box-relative" << std::endl
+			<< "                    positions), oct16 (octahedral normals), rgba8, uv16f (half), uv16," << std::endl
+			<< "                    skin8 and skin16 (8-bit weights, 8/16-bit joints; skin8 widens to" << std::endl
+			<< "                    16-bit joints past 256 joints) (default: oct16,rgba8,uv16f,skin8)." << std::endl
+			<< "                    Without it, only skin is packed, as skin8" << std::endl
+			<< "  -mat[=elements]   Export .mat files (default elements: all)" << std::endl
+			<< "  -textures[=F]     Compress the textures materials reference into .tex files next to them," << std::endl
+			<< "                    and report time and PSNR. F is bc7 or bc1 for color textures; normal" << std::endl
+			<< "                    maps are BC5, and BC1 diffuse textures with alpha are BC3 (default: bc7)" << std::endl
+			<< "  -anim             Export .anim files" << std::endl
+			<< "  -animerror=P,R,S  Max key error at leaf joints in units, degrees, and scale" << std::endl
+			<< "                    (default: 0.01,0.0573,0.001; R and S are optional)" << std::endl
+			<< "  -animlocal        Store parent-relative joint tracks instead of model-space ones." << std::endl
+			<< "                    Root joints stay in model space" << std::endl
+			<< "  -animquantize     Store .anim keys as 16-bit values and 48-bit rotations" << std::endl
+			<< "  -animlib=FILE     Export every animation stack of every file into one library" << std::endl
+			<< "                    that stores each skeleton once, instead of .anim files" << std::endl
+			<< "  -all              Export all data types with all elements" << std::endl
+			<< "  -threads=N        Convert N files at once (default: one per hardware thread)" << std::endl
+			<< "  -recursive        Search directories recursively" << std::endl
+			<< std::endl;
+	}
+
+	/* Matches a filename against a wildcard pattern.
+	  PARAMETERS
+		_in_name : The filename to check.
+		_in_pattern : The pattern. '*' matches any run of characters, '?' matches one character.
+	  RETURNS
+		true : The filename matches.
+		false : The filename does not match.
+	*/
+	bool MatchesWildcard(const char* _in_name, const char* _in_pattern)
+	{
+		const char* starPattern_p = nullptr;
+		const char* starName_p = nullptr;
+
+		while (*_in_name != '\0')
+		{
+			if (*_in_pattern == '*')
+			{
+				starPattern_p = ++_in_pattern;
+				starName_p = _in_name;
+			}
+			else if (*_in_pattern == '?' || tolower(*_in_pattern) == tolower(*_in_name))
+			{
+				_in_pattern++;
+				_in_name++;
+			}
+			else if (starPattern_p != nullptr)
+			{
+				// let the last '*' absorb one more character and retry
+				_in_pattern = starPattern_p;
+				_in_name = ++starName_p;
+			}
+			else
+			{
+				return false;
+			}
+		}
+
+		while (*_in_pattern == '*')
+			_in_pattern++;
+
+		return *_in_pattern == '\0';
+	}
+
+	/* Adds .fbx files from a directory to the job list.
+	  PARAMETERS
+		_in_directory : The directory to search.
+		_in_pattern : The filename pattern to match.
+		_out_jobs : The job list to add files to.
+	*/
+	void AddBatchJobsFromDirectory(
+		const std::filesystem::path&	_in_directory
+		, const std::string&			_in_pattern
+		, std::vector<BatchJob>&		_out_jobs
+	) {
+		std::error_code error;
+
+		auto addEntry = [&](const std::filesystem::directory_entry& _in_entry)
+		{
+			if (_in_entry.is_regular_file(error)
+				&& MatchesWildcard(_in_entry.path().filename().string().c_str(), _in_pattern.c_str()))
+				_out_jobs.push_back({ _in_entry.path().string() });
+		};
+
+		if (searchRecursively)
+			for (auto& entry : std::filesystem::recursive_directory_iterator(_in_directory, error))
+				addEntry(entry);
+		else
+			for (auto& entry : std::filesystem::directory_iterator(_in_directory, error))
+				addEntry(entry);
+	}
+
+	/* Expands input paths into a sorted list of .fbx files to convert.
+	  PARAMETERS
+		_out_jobs : The job list to fill.
+	*/
+	void CollectBatchJobs(std::vector<BatchJob>& _out_jobs)
+	{
+		std::error_code error;
+
+		for (const std::string& inputPath : inputPaths)
+		{
+			std::filesystem::path path = inputPath;
+
+			if (std::filesystem::is_directory(path, error))
+			{
+				AddBatchJobsFromDirectory(path, "*.fbx", _out_jobs);
+			}
+			// wildcards are only supported in the filename
+			else if (path.filename().string().find_first_of("*?") != std::string::npos)
+			{
+				std::filesystem::path directory = path.parent_path();
+				if (directory.empty())
+					directory = ".";
+				AddBatchJobsFromDirectory(directory, path.filename().string(), _out_jobs);
+			}
+			else
+			{
+				_out_jobs.push_back({ inputPath });
+			}
+		}
+
+		std::sort(_out_jobs.begin(), _out_jobs.end(),
+			[](const BatchJob& _in_a, const BatchJob& _in_b) { return _in_a.filepath < _in_b.filepath; });
+		_out_jobs.erase(std::unique(_out_jobs.begin(), _out_jobs.end(),
+			[](const BatchJob& _in_a, const BatchJob& _in_b) { return _in_a.filepath == _in_b.filepath; }),
+			_out_jobs.end());
+	}
+
+	/* Gets the most memory the process has held in RAM since it started.
+	  RETURNS
+		uint64_t : The peak working set, or peak resident set size, in bytes. 0 if it is unavailable.
+	*/
+	uint64_t GetPeakMemoryBytes()
+	{
+#if defined(_WIN32)
+		PROCESS_MEMORY_COUNTERS counters = {};
+		if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+			return 0;
+
+		return (uint64_t)counters.PeakWorkingSetSize;
+#else
+		struct rusage usage = {};
+		if (getrusage(RUSAGE_SELF, &usage) != 0)
+			return 0;
+
+		// ru_maxrss is in bytes on macOS and in kilobytes elsewhere
+#if defined(__APPLE__)
+		return (uint64_t)usage.ru_maxrss;
+#else
+		return (uint64_t)usage.ru_maxrss * 1024;
+#endif
+#endif
+	}
+
+	/* Gets a printable name for a Result.
+	  PARAMETERS
+		_in_result : The result to name.
+	  RETURNS
+		const char* : The name of the result.
+	*/
+	const char* GetResultName(fbx_exporter::library::Result _in_result)
+	{
+		switch (_in_result)
+		{
+		case fbx_exporter::library::Result::INVALID_ARG: return "INVALID_ARG";
+		case fbx_exporter::library::Result::FAIL: return "FAIL";
+		case fbx_exporter::library::Result::SUCCESS: return "SUCCESS";
+		case fbx_exporter::library::Result::EXTRACT: return "EXTRACT";
+		case fbx_exporter::library::Result::EXPORT: return "EXPORT";
+		default: return "UNKNOWN";
+		}
+	}
+
+	/* Converts every file in the job list concurrently and prints a summary.
+	  PARAMETERS
+		_out_jobs : The files to convert. Results and timings are stored per job.
+	  RETURNS
+		int : The number of files that failed to convert, plus one if the animation library failed to export,
+		  plus one if any texture failed to export.
+	*/
+	int RunBatchJobs(std::vector<BatchJob>& _out_jobs)
+	{
+		using clock = std::chrono::steady_clock;
+
+		uint32_t workers = threadCount > 0 ? threadCount : fbx_exporter::library::GetHardwareThreadCount();
+		std::cout << "Converting " << _out_jobs.size() << " files on " << workers << " threads"
+			<< std::endl << std::endl;
+
+		// files are already converted in parallel, so each extraction stays on its own thread
+		if (workers > 1 && _out_jobs.size() > 1)
+			fbx_exporter::library::SetWorkerThreadCount(1);
+
+		clock::time_point batchStart = clock::now();
+
+		// each job owns its extracted data, so files share no state
+		fbx_exporter::library::ParallelFor((uint32_t)_out_jobs.size(), workers,
+			[&](uint32_t _in_job, uint32_t)
+		{
+			BatchJob& job = _out_jobs[_in_job];
+			fbx_exporter::FbxFileData data;
+
+			clock::time_point jobStart = clock::now();
+			job.result = fbx_exporter::GetDataFromFbxFile(job.filepath.c_str(), elementOptions,
+				dataTypesToExport, data, exportSettings);
+			job.milliseconds = std::chrono::duration<double, std::milli>(clock::now() - jobStart).count();
+			job.animation_clips = std::move(data.animation_clips);
+			if (exportSettings.compress_textures)
+				job.materials = std::move(data.materials);
+		});
+
+		double batchMilliseconds = std::chrono::duration<double, std::milli>(clock::now() - batchStart).count();
+
+		// print per-file results and totals
+		int failedCount = 0;
+		double jobMilliseconds = 0.0;
+
+		for (const BatchJob& job : _out_jobs)
+		{
+			bool succeeded = fbx_exporter::library::Succeeded(job.result);
+			if (!succeeded)
+				failedCount++;
+			jobMilliseconds += job.milliseconds;
+
+			std::cout << (succeeded ? "[ OK ] " : "[FAIL] ") << job.filepath
+				<< " : " << GetResultName(job.result) << ", " << job.milliseconds << " ms" << std::endl;
+		}
+
+		// clips from every file share one library, written in file order
+		bool libraryFailed = false;
+		if (exportSettings.animation_library)
+		{
+			std::vector<fbx_exporter::AnimationLibraryClip> clips;
+			for (BatchJob& job : _out_jobs)
+				for (fbx_exporter::AnimationLibraryClip& clip : job.animation_clips)
+					clips.push_back(std::move(clip));
+
+			std::cout << std::endl;
+			fbx_exporter::library::Result result = fbx_exporter::ExportAnimationLibrary(
+				animationLibraryPath.c_str(), clips, exportSettings.animation_format);
+			if (!fbx_exporter::library::Succeeded(result))
+			{
+				libraryFailed = true;
+				std::cout << "[FAIL] " << animationLibraryPath << " : " << GetResultName(result) << std::endl;
+			}
+		}
+
+		// textures are gathered from every file, so one shared by several is compressed once
+		bool texturesFailed = false;
+		if (exportSettings.compress_textures)
+		{
+			std::vector<fbx_exporter::TextureExport> textures;
+			for (const BatchJob& job : _out_jobs)
+				fbx_exporter::GatherMaterialTextures(job.filepath.c_str(), job.materials, textures);
+
+			// files are done, so every thread is free for blocks again
+			fbx_exporter::library::SetWorkerThreadCount(threadCount);
+
+			std::cout << std::endl;
+			if (!textures.empty())
+				texturesFailed = !fbx_exporter::library::Succeeded(fbx_exporter::ExportTextures(textures, exportSettings));
+			else
+				std::cout << "No textures referenced" << std::endl;
+		}
+
+		std::cout << std::endl
+			<< "Files : " << _out_jobs.size() << std::endl
+			<< "Succeeded : " << _out_jobs.size() - failedCount << std::endl
+			<< "Failed : " << failedCount << std::endl
+			<< "Wall time : " << batchMilliseconds << " ms" << std::endl
+			<< "Total conversion time : " << jobMilliseconds << " ms" << std::endl
+			<< "Parallel speedup : " << (batchMilliseconds > 0.0 ? jobMilliseconds / batchMilliseconds : 0.0)
+			<< "x" << std::endl
+			<< "Peak memory : " << GetPeakMemoryBytes() / (1024.0 * 1024.0) << " MB" << std::endl;
+
+		return failedCount + (libraryFailed ? 1 : 0) + (texturesFailed ? 1 : 0);
+	}
 }
 
 
@@ -135,6 +726,27 @@ int main(int argc, char* argv[])
 	// set automatic memory leak reporting on program exit
 	_CrtSetDbgFlag(_CRTDBG_ALLOC_MEM_DF | _CRTDBG_LEAK_CHECK_DF);
 
+	// convert many files without prompting if options, directories, or wildcards were given
+	if (IsBatchMode(argc, argv))
+	{
+		std::vector<BatchJob> jobs;
+
+		if (!ReadBatchOptions(argc, argv))
+		{
+			PrintBatchUsage();
+			return 1;
+		}
+
+		CollectBatchJobs(jobs);
+		if (jobs.empty())
+		{
+			std::cout << "No file to import" << std::endl;
+			return 1;
+		}
+
+		return RunBatchJobs(jobs) == 0 ? 0 : 1;
+	}
+
 	// read and act on input if filename was specified
 	if (argc > 1)
 	{
@@ -143,8 +755,11 @@ int main(int argc, char* argv[])
 
 		// read export and element selections
 		if (ReadOptions())
+		{
 			// if valid selection was made, extract and export data from .fbx file
-			fbx_exporter::GetDataFromFbxFile(filepath, elementOptions, dataTypesToExport);
+			fbx_exporter::FbxFileData data;
+			fbx_exporter::GetDataFromFbxFile(filepath, elementOptions, dataTypesToExport, data);
+		}
 	}
 	else
 	{
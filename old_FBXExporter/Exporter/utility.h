@@ -1,9 +1,15 @@
 #ifndef _FBXEXPORTER_EXPORTER_UTILITY_H_
 #define _FBXEXPORTER_EXPORTER_UTILITY_H_
 
+#include <fstream>
+#include <ostream>
+#include <string>
+#include <vector>
+
 #include "defines.h"
 
 #include "../Library/defines.h"
+#include "../Library/interface.h"
 
 namespace fbx_exporter
 {
@@ -19,21 +25,318 @@ namespace fbx_exporter
 		, char*							_out_filepath
 	);
 
-	/* Exports mesh data to a file.
+	/* Extracts, stores, and optionally exports mesh data from an imported session.
+	PARAMETERS
+	  _in_fbxSession_p : The session to read from.
+	  _in_fbxFilepath : The path of the .fbx file the session was imported from.
+	  _in_elementsToExtract : A bit-flag set indicating which vertex elements to store.
+	  _in_readMode : A value indicating how to use the data from the session.
+	  _in_settings : The settings for stages run before export.
+	  _out_mesh : The mesh container to store extracted data in.
+	  _out_packedMesh : The mesh container to store packed vertices in, with ExportSettings::pack_vertices.
+	RETURNS
+	  INVALID_ARG : An invalid argument was passed.
+	  FAIL : File could not be opened.
+	  EXTRACT : Data was extracted successfully.
+	*/
+	library::Result GetMeshFromFbxSession(
+		const library::FbxSession*		_in_fbxSession_p
+		, const char*					_in_fbxFilepath
+		, const uint32_t				_in_elementsToExtract
+		, const FileReadMode			_in_readMode
+		, const ExportSettings&			_in_settings
+		, library::Mesh&				_out_mesh
+		, library::PackedMesh&			_out_packedMesh
+	);
+
+	/* Extracts mesh data from an imported session while exporting it to a .mesh file.
+	PARAMETERS
+	  _in_fbxSession_p : The session to read from.
+	  _in_exportFilepath : The .mesh filepath to export to.
+	  _in_elementsToExtract : A bit-flag set indicating which vertex elements to store.
+	  _in_settings : The settings for stages run before export. Only all_meshes and pack_vertices apply.
+	  _out_mesh : The mesh container to store extracted vertices and parts in. Indices are not stored.
+	  _out_packedMesh : The mesh container to store packed vertices in, with ExportSettings::pack_vertices.
+	RETURNS
+	  INVALID_ARG : An invalid argument was passed.
+	  FAIL : File could not be opened or written, or the session has no mesh.
+	  EXPORT : Data was successfully exported to file.
+	NOTES
+	  Indices are written to the file as the library streams them, so peak memory is the
+	  unique vertices plus the library's chunk window. They are stored in 32 bits, as the
+	  mesh is never split for 16-bit indices. A file that fails after it was opened is removed.
+	*/
+	library::Result GetStreamedMeshFromFbxSession(
+		const library::FbxSession*		_in_fbxSession_p
+		, const char*					_in_exportFilepath
+		, const uint32_t				_in_elementsToExtract
+		, const ExportSettings&			_in_settings
+		, library::Mesh&				_out_mesh
+		, library::PackedMesh&			_out_packedMesh
+	);
+
+	/* Reports the number of parts and materials of a mesh. Meshes without parts report nothing.
+	PARAMETERS
+	  _in_mesh : The mesh to report.
+	  _out_report : The stream to write the report to.
+	*/
+	void ReportMeshParts(
+		const library::Mesh&			_in_mesh
+		, std::ostream&					_out_report
+	);
+
+	/* Packs mesh vertices into the layout of the settings, leaving out elements the mesh lacks.
+	PARAMETERS
+	  _in_mesh : The mesh to pack.
+	  _in_elementsToExtract : The vertex elements extracted. Others are not stored.
+	  _in_settings : The settings holding the vertex layout.
+	  _out_packedMesh : The packed vertices.
+	  _out_report : The stream to write sizes and errors to.
+	RETURNS
+	  INVALID_ARG : The mesh has no vertices, or a joint index does not fit the skin format.
+	  SUCCESS : The vertices were packed.
+	*/
+	library::Result PackMeshForExport(
+		const library::Mesh&			_in_mesh
+		, const uint32_t				_in_elementsToExtract
+		, const ExportSettings&			_in_settings
+		, library::PackedMesh&			_out_packedMesh
+		, std::ostream&					_out_report
+	);
+
+	/* Extracts, stores, and optionally exports material data from an imported session.
+	PARAMETERS
+	  _in_fbxSession_p : The session to read from.
+	  _in_fbxFilepath : The path of the .fbx file the session was imported from.
+	  _in_elementsToExtract : A bit-flag set indicating which texture elements to store.
+	  _in_readMode : A value indicating how to use the data from the session.
+	  _out_materialList : The material and filepath container to store extracted data in.
+	RETURNS
+	  INVALID_ARG : An invalid argument was passed.
+	  FAIL : File could not be opened.
+	  EXTRACT : Data was extracted successfully.
+	*/
+	library::Result GetMaterialsFromFbxSession(
+		const library::FbxSession*		_in_fbxSession_p
+		, const char*					_in_fbxFilepath
+		, const uint32_t				_in_elementsToExtract
+		, const FileReadMode			_in_readMode
+		, library::MaterialList&		_out_materialList
+	);
+
+	/* Extracts, stores, and optionally reduces and exports animation data from an imported session.
+	PARAMETERS
+	  _in_fbxSession_p : The session to read from.
+	  _in_fbxFilepath : The path of the .fbx file the session was imported from.
+	  _in_elementsToExtract : A bit-flag set indicating which animation elements to store.
+	  _in_readMode : A value indicating how to use the data from the session.
+	  _in_settings : The tolerances used to remove keys before export.
+	  _out_animationClip : The animation container to store extracted data in.
+	  _out_sparseClip : The animation container to store reduced data in. Only filled on export.
+	RETURNS
+	  INVALID_ARG : An invalid argument was passed.
+	  FAIL : File could not be opened.
+	  EXTRACT : Data was extracted successfully.
+	*/
+	library::Result GetAnimationFromFbxSession(
+		const library::FbxSession*		_in_fbxSession_p
+		, const char*					_in_fbxFilepath
+		, const uint32_t				_in_elementsToExtract
+		, const FileReadMode			_in_readMode
+		, const ExportSettings&			_in_settings
+		, library::AnimationClip&		_out_animationClip
+		, library::SparseAnimationClip&	_out_sparseClip
+	);
+
+	/* Extracts every animation stack from an imported session and reduces each for an animation library.
+	PARAMETERS
+	  _in_fbxSession_p : The session to read from.
+	  _in_fbxFilepath : The path of the .fbx file the session was imported from. Names the clips.
+	  _in_elementsToExtract : A bit-flag set indicating which animation elements to store.
+	  _in_settings : The tolerances and key format used to reduce the clips.
+	  _out_clips : The list to append the reduced clips to.
+	RETURNS
+	  INVALID_ARG : An invalid argument was passed.
+	  FAIL : The session has no skeleton or no animation stacks.
+	  EXTRACT : Data was extracted successfully.
+	*/
+	library::Result GetAnimationClipsFromFbxSession(
+		const library::FbxSession*		_in_fbxSession_p
+		, const char*					_in_fbxFilepath
+		, const uint32_t				_in_elementsToExtract
+		, const ExportSettings&			_in_settings
+		, std::vector<AnimationLibraryClip>&	_out_clips
+	);
+
+	/* Removes keys from a clip, and quantizes the keys kept if the settings ask for it.
+	PARAMETERS
+	  _in_animationClip : The densely sampled clip to reduce.
+	  _in_name : The name to report the clip under.
+	  _in_settings : The tolerances and key format to use.
+	  _out_sparseClip : The keys kept.
+	  _out_quantizedClip : The keys kept, quantized. Only filled for AnimationFormat::QUANTIZED_KEYS.
+	  _out_report : The stream to write key counts, sizes, and errors to.
+	RETURNS
+	  INVALID_ARG : The clip has no joints or frames.
+	  SUCCESS : The clip was reduced.
+	*/
+	library::Result ReduceAnimationClipForExport(
+		const library::AnimationClip&	_in_animationClip
+		, const char*					_in_name
+		, const ExportSettings&			_in_settings
+		, library::SparseAnimationClip&	_out_sparseClip
+		, library::QuantizedAnimationClip&	_out_quantizedClip
+		, std::ostream&					_out_report
+	);
+
+	/* Adds a section held in one span of memory to the sections of a container file.
+	PARAMETERS
+	  _out_sections : The sections to add to. Sections without elements are not added.
+	  _in_type : What the section holds.
+	  _in_alignment : The alignment of the section in the file.
+	  _in_elementSize : The bytes per element.
+	  _in_elementCount : The number of elements.
+	  _in_data_p : The elements. Must stay valid until the file is written.
+	*/
+	void AddContainerSection(
+		std::vector<ContainerSectionData>&	_out_sections
+		, const runtime::SectionType	_in_type
+		, const uint32_t				_in_alignment
+		, const uint32_t				_in_elementSize
+		, const uint64_t				_in_elementCount
+		, const void*					_in_data_p
+	);
+
+	/* Writes a container file: a header, a section table, and each section at its alignment.
+	PARAMETERS
+	  _in_filepath : The filepath to write to.
+	  _in_type : What the file holds.
+	  _in_sections : The sections to write, in file order.
+	RETURNS
+	  INVALID_ARG : A section's spans do not add up to its size, or its alignment is not a power of 2.
+	  FAIL : File could not be opened or written.
+	  EXPORT : The file was written.
+	NOTES
+	  Small spans and padding are gathered into one buffer that is written when full, and large
+	  spans are written straight from memory, so a file takes a handful of large writes.
+	*/
+	library::Result WriteContainerFile(
+		const char*						_in_filepath
+		, const runtime::ContainerType	_in_type
+		, const std::vector<ContainerSectionData>&	_in_sections
+	);
+
+	/* Opens a container file whose sections are written one after another, and reserves its header and section table.
+	PARAMETERS
+	  _in_filepath : The filepath to write to.
+	  _in_maxSections : The most sections the file will have.
+	  _out_file : The file, positioned after the reserved section table.
+	RETURNS
+	  FAIL : File could not be opened or written.
+	  SUCCESS : The file is open.
+	*/
+	library::Result BeginContainerFile(
+		const char*						_in_filepath
+		, const uint32_t				_in_maxSections
+		, std::ofstream&				_out_file
+	);
+
+	/* Pads a container file with zeros to an alignment.
+	PARAMETERS
+	  _out_file : The file to pad.
+	  _in_alignment : The alignment. A power of 2 no larger than CONTAINER_BULK_ALIGNMENT.
+	RETURNS
+	  uint64_t : The aligned offset, where the next section starts.
+	*/
+	uint64_t AlignContainerFile(
+		std::ostream&					_out_file
+		, const uint32_t				_in_alignment
+	);
+
+	/* Writes sections at the end of a container file opened with BeginContainerFile.
+	PARAMETERS
+	  _out_file : The file to write to.
+	  _in_sections : The sections to write, in file order.
+	  _out_table : The section table to add the sections' entries to.
+	RETURNS
+	  INVALID_ARG : A section's spans do not add up to its size, or its alignment is invalid.
+	  FAIL : File could not be written.
+	  SUCCESS : The sections were written.
+	*/
+	library::Result AppendContainerSections(
+		std::ostream&					_out_file
+		, const std::vector<ContainerSectionData>&	_in_sections
+		, std::vector<runtime::ContainerSection>&	_out_table
+	);
+
+	/* Writes the header and section table of a container file opened with BeginContainerFile, and closes it.
+	PARAMETERS
+	  _out_file : The file to finish.
+	  _in_type : What the file holds.
+	  _in_maxSections : The most sections passed to BeginContainerFile.
+	  _in_table : The entries of every section written.
+	RETURNS
+	  INVALID_ARG : More sections were written than were reserved.
+	  FAIL : File could not be written.
+	  EXPORT : The file was written.
+	*/
+	library::Result EndContainerFile(
+		std::ofstream&					_out_file
+		, const runtime::ContainerType	_in_type
+		, const uint32_t				_in_maxSections
+		, const std::vector<runtime::ContainerSection>&	_in_table
+	);
+
+	/* Fills the vertex layout of a .mesh file's MeshInfo.
+	PARAMETERS
+	  _in_mesh : The mesh to export.
+	  _in_elements : The MeshElement flags extracted. Reported for vertices stored as Vertex; packed vertices report their layout's.
+	  _in_packedMesh : The mesh's packed vertices, or an empty PackedMesh to store Vertex as is.
+	  _out_info : The info to fill. Index fields are left unchanged.
+	RETURNS
+	  const void* : The vertices to write, info.vertex_stride bytes each.
+	*/
+	const void* DescribeMeshVertices(
+		const library::Mesh&			_in_mesh
+		, const uint32_t				_in_elements
+		, const library::PackedMesh&	_in_packedMesh
+		, runtime::MeshInfo&			_out_info
+	);
+
+	/* Converts a mesh's parts to .mesh part records, gathering their names into one string.
+	PARAMETERS
+	  _in_mesh : The mesh to export.
+	  _out_parts : The part records.
+	  _out_strings : The names, which the records' name offsets index. Appended to.
+	*/
+	void GatherMeshParts(
+		const library::Mesh&			_in_mesh
+		, std::vector<runtime::MeshPartRecord>&	_out_parts
+		, std::string&					_out_strings
+	);
+
+	/* Exports mesh data to a .mesh container file.
 	PARAMETERS
 	  _in_filepath : The filepath to export data to.
 	  _in_mesh : The data to export.
+	  _in_elements : The MeshElement flags extracted into the mesh's vertices.
+	  _in_packedMesh : The mesh's packed vertices, or an empty PackedMesh to store Vertex as is.
 	RETURNS
 	  INVALID_ARG : An invalid argument was passed.
 	  FAIL : File could not be opened.
 	  EXPORT : Data was successfully exported to file.
+	NOTES
+	  Indices are stored in 16 bits when GetShortIndices can build them, relative to their
+	  submesh if the mesh was split.
 	*/
 	library::Result ExportMesh(
 		const char*						_in_filepath
-		, const library::Mesh			_in_mesh
+		, const library::Mesh&			_in_mesh
+		, const uint32_t				_in_elements
+		, const library::PackedMesh&	_in_packedMesh
 	);
 
-	/* Exports material data to a file.
+	/* Exports material data to a .mat container file.
 	PARAMETERS
 	  _in_filepath : The filepath to export data to.
 	  _in_materials : The data to export.
@@ -41,16 +344,75 @@ namespace fbx_exporter
 	  INVALID_ARG : An invalid argument was passed.
 	  FAIL : File could not be opened.
 	  EXPORT : Data was successfully exported to file.
+	NOTES
+	  A scene without materials exports a file without sections.
 	*/
 	library::Result ExportMaterials(
 		const char*						_in_filepath
-		, library::MaterialList			_in_materials
+		, const library::MaterialList&	_in_materials
 	);
 
-	/* Exports animation data to a file.
+	/* Exports a compressed texture to a .tex container file.
 	PARAMETERS
 	  _in_filepath : The filepath to export data to.
-	  _in_animationClip : The data to export.
+	  _in_texture : The data to export.
+	RETURNS
+	  INVALID_ARG : An invalid argument was passed.
+	  FAIL : File could not be opened.
+	  EXPORT : Data was successfully exported to file.
+	*/
+	library::Result ExportTexture(
+		const char*						_in_filepath
+		, const library::CompressedTexture&	_in_texture
+	);
+
+	/* Chooses the format of a texture from the component referencing it.
+	PARAMETERS
+	  _in_image : The decoded texture.
+	  _in_component : The material component that references the texture.
+	  _in_settings : The settings selecting color texture formats.
+	RETURNS
+	  library::TextureFormat : BC5 for normal maps, the color format otherwise. Diffuse textures with
+	    transparent pixels use BC3 instead of BC1, which has no alpha.
+	*/
+	library::TextureFormat SelectTextureFormat(
+		const library::Image&			_in_image
+		, const library::Material::ComponentType	_in_component
+		, const ExportSettings&			_in_settings
+	);
+
+	/* Adds the channel records of a reduced clip, and spans of its keys, to the key sections of a container.
+	PARAMETERS
+	  _in_sparseClip : The clip whose keys to add. Must outlive the sections, whose spans point into it.
+	  _out_records : The translation, rotation and scale record of each joint. Appended to.
+	  _out_times : The KEY_TIMES section, of float elements. Appended to.
+	  _out_values : The KEY_VALUES section, of float elements. Appended to.
+	*/
+	void GatherAnimationKeys(
+		const library::SparseAnimationClip&	_in_sparseClip
+		, std::vector<runtime::AnimationTrackRecord>&	_out_records
+		, ContainerSectionData&			_out_times
+		, ContainerSectionData&			_out_values
+	);
+
+	/* Adds the channel records of a quantized clip, and spans of its keys, to the key sections of a container.
+	PARAMETERS
+	  _in_quantizedClip : The clip whose keys to add. Must outlive the sections, whose spans point into it.
+	  _out_records : The translation, rotation and scale record of each joint. Appended to.
+	  _out_times : The KEY_TIMES section, of uint16_t elements. Appended to.
+	  _out_values : The KEY_VALUES section, of uint16_t elements. Appended to.
+	*/
+	void GatherQuantizedAnimationKeys(
+		const library::QuantizedAnimationClip&	_in_quantizedClip
+		, std::vector<runtime::AnimationTrackRecord>&	_out_records
+		, ContainerSectionData&			_out_times
+		, ContainerSectionData&			_out_values
+	);
+
+	/* Exports reduced animation data to a .anim container file.
+	PARAMETERS
+	  _in_filepath : The filepath to export data to.
+	  _in_sparseClip : The data to export.
 	RETURNS
 	  INVALID_ARG : An invalid argument was passed.
 	  FAIL : File could not be opened.
@@ -58,7 +420,21 @@ namespace fbx_exporter
 	*/
 	library::Result ExportAnimation(
 		const char*						_in_filepath
-		, library::AnimationClip		_in_animationClip
+		, const library::SparseAnimationClip&	_in_sparseClip
+	);
+
+	/* Exports quantized animation data to a .anim container file.
+	PARAMETERS
+	  _in_filepath : The filepath to export data to.
+	  _in_quantizedClip : The data to export.
+	RETURNS
+	  INVALID_ARG : An invalid argument was passed.
+	  FAIL : File could not be opened.
+	  EXPORT : Data was successfully exported to file.
+	*/
+	library::Result ExportQuantizedAnimation(
+		const char*						_in_filepath
+		, const library::QuantizedAnimationClip&	_in_quantizedClip
 	);
 
 }
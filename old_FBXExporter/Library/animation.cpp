@@ -0,0 +1,992 @@
+#include "animation.h"
+#include "interface.h"
+#include "parallel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+
+namespace fbx_exporter
+{
+	namespace library
+	{
+#pragma region Private Helper Functions
+		// Kinds of joint channel, which differ in how their error is measured.
+		enum struct AnimationChannel
+		{
+			TRANSLATION = 0
+			, ROTATION
+			, SCALE
+		};
+
+		// Passes of reduction and verification before falling back to lossless reduction.
+		const uint32_t MAX_REDUCTION_PASSES = 12;
+
+		uint32_t GetChannelComponentCount(const AnimationChannel _in_channel)
+		{
+			return _in_channel == AnimationChannel::ROTATION ? 4 : 3;
+		}
+
+		float GetChannelError(
+			const AnimationChannel		_in_channel
+			, const float*				_in_a_p
+			, const float*				_in_b_p
+		) {
+			switch (_in_channel)
+			{
+			case AnimationChannel::TRANSLATION:
+			{
+				float dx = _in_a_p[0] - _in_b_p[0];
+				float dy = _in_a_p[1] - _in_b_p[1];
+				float dz = _in_a_p[2] - _in_b_p[2];
+				return sqrtf(dx * dx + dy * dy + dz * dz);
+			}
+			case AnimationChannel::ROTATION:
+			{
+				// angle between the rotations, stable for small angles where acos is not
+				double lengthA = 0.0, lengthB = 0.0, dot = 0.0;
+				for (uint32_t i = 0; i < 4; i++)
+				{
+					lengthA += (double)_in_a_p[i] * _in_a_p[i];
+					lengthB += (double)_in_b_p[i] * _in_b_p[i];
+					dot += (double)_in_a_p[i] * _in_b_p[i];
+				}
+				if (lengthA == 0.0 || lengthB == 0.0)
+					return 3.14159265f;
+
+				// either quaternion sign represents the same rotation
+				double sign = dot < 0.0 ? -1.0 : 1.0;
+				lengthA = sqrt(lengthA);
+				lengthB = sqrt(lengthB) * sign;
+
+				double difference = 0.0, sum = 0.0;
+				for (uint32_t i = 0; i < 4; i++)
+				{
+					double a = _in_a_p[i] / lengthA;
+					double b = _in_b_p[i] / lengthB;
+					difference += (a - b) * (a - b);
+					sum += (a + b) * (a + b);
+				}
+
+				// atan2 of these lengths is half the angle between the quaternions, which is itself
+				// half the rotation angle
+				return (float)(4.0 * atan2(sqrt(difference), sqrt(sum)));
+			}
+			default:
+			{
+				float error = 0.0f;
+				for (uint32_t i = 0; i < 3; i++)
+					error = std::max(error, fabsf(_in_a_p[i] - _in_b_p[i]));
+				return error;
+			}
+			}
+		}
+
+		void AddAnimationKey(
+			const float					_in_time
+			, const float*				_in_values_p
+			, const uint32_t			_in_componentCount
+			, AnimationTrack&			_out_track
+		) {
+			_out_track.times.push_back(_in_time);
+			_out_track.values.insert(_out_track.values.end(), _in_values_p, _in_values_p + _in_componentCount);
+		}
+
+		/* Keeps the fewest samples of a channel that reproduce every sample within a tolerance.
+		  PARAMETERS
+			_in_channel : The kind of channel.
+			_in_times_p : The sample times in seconds.
+			_in_samples_p : The sample values, packed per sample.
+			_in_sampleCount : The number of samples.
+			_in_tolerance : The largest error allowed at any sample.
+			_out_track : The keys kept. Existing contents are discarded.
+		*/
+		void ReduceAnimationTrack(
+			const AnimationChannel		_in_channel
+			, const float*				_in_times_p
+			, const float*				_in_samples_p
+			, const uint32_t			_in_sampleCount
+			, const float				_in_tolerance
+			, AnimationTrack&			_out_track
+		) {
+			uint32_t componentCount = GetChannelComponentCount(_in_channel);
+
+			_out_track.times.clear();
+			_out_track.values.clear();
+
+			if (_in_sampleCount == 0)
+				return;
+
+			// constant channels keep a single key
+			bool constant = true;
+			for (uint32_t i = 1; i < _in_sampleCount && constant; i++)
+				constant = GetChannelError(_in_channel, &_in_samples_p[i * componentCount],
+					_in_samples_p) <= _in_tolerance;
+
+			AddAnimationKey(_in_times_p[0], _in_samples_p, componentCount, _out_track);
+			if (constant)
+				return;
+
+			// extend each segment from the last key until a skipped sample leaves the tolerance
+			float interpolated[4];
+			uint32_t anchor = 0;
+			uint32_t end = 2;
+
+			while (end < _in_sampleCount)
+			{
+				const float* first_p = &_in_samples_p[anchor * componentCount];
+				const float* last_p = &_in_samples_p[end * componentCount];
+				float span = _in_times_p[end] - _in_times_p[anchor];
+				bool fits = true;
+
+				for (uint32_t i = anchor + 1; i < end && fits; i++)
+				{
+					float u = span > 0.0f ? (_in_times_p[i] - _in_times_p[anchor]) / span : 0.0f;
+					for (uint32_t c = 0; c < componentCount; c++)
+						interpolated[c] = first_p[c] + (last_p[c] - first_p[c]) * u;
+
+					fits = GetChannelError(_in_channel, interpolated,
+						&_in_samples_p[i * componentCount]) <= _in_tolerance;
+				}
+
+				if (fits)
+				{
+					end++;
+				}
+				else
+				{
+					anchor = end - 1;
+					AddAnimationKey(_in_times_p[anchor], &_in_samples_p[anchor * componentCount],
+						componentCount, _out_track);
+					end = anchor + 2;
+				}
+			}
+
+			uint32_t last = _in_sampleCount - 1;
+			if (last > anchor)
+				AddAnimationKey(_in_times_p[last], &_in_samples_p[last * componentCount],
+					componentCount, _out_track);
+		}
+
+		/* Builds the model-space transform of every joint in every frame of a clip.
+		  PARAMETERS
+			_in_animationClip : The clip to read. It must hold one transform per joint per frame.
+			_out_globals : Storage for the transforms of a parent-relative clip. Left empty otherwise.
+		  RETURNS
+			const Matrix* : The transforms, frame by frame. Points into the clip if it is in model space.
+		*/
+		const Matrix* GetAnimationClipGlobals(
+			const AnimationClip&		_in_animationClip
+			, std::vector<Matrix>&		_out_globals
+		) {
+			uint32_t jointCount = (uint32_t)_in_animationClip.joints.size();
+			uint32_t frameCount = _in_animationClip.GetFrameCount();
+
+			// model-space clips already hold their globals in the same layout, and are borrowed
+			if (!_in_animationClip.local_space)
+				return _in_animationClip.transforms.data();
+
+			_out_globals.resize((size_t)frameCount * jointCount);
+
+			for (uint32_t f = 0; f < frameCount; f++)
+			{
+				AnimationFrame frame = _in_animationClip.GetFrame(f);
+				Matrix* frameGlobals_p = &_out_globals[(size_t)f * jointCount];
+
+				for (uint32_t j = 0; j < jointCount; j++)
+				{
+					int parent = _in_animationClip.joints[j].parent_index;
+
+					if (parent >= 0)
+						MultiplyMatrix(frame.transforms_p[j], frameGlobals_p[parent], frameGlobals_p[j]);
+					else
+						frameGlobals_p[j] = frame.transforms_p[j];
+				}
+			}
+
+			return _out_globals.data();
+		}
+
+		/* Rebuilds every frame from channel keys and compares leaf joints in model space.
+		  PARAMETERS
+			_in_joints : The joint hierarchy. Parents precede their children.
+			_in_globals_p : The expected model-space transforms, frame by frame.
+			_in_times_p : The frame times in seconds.
+			_in_frameCount : The number of frames.
+			_in_tracks : The channel keys per joint.
+			_in_tolerance : The largest errors allowed at leaf joints.
+			_out_stats : The largest errors measured.
+			_out_exceeded : Flags set for leaf joints with an error above _in_tolerance.
+		*/
+		void MeasureAnimationLeafErrors(
+			const std::vector<AnimationJoint>&			_in_joints
+			, const Matrix*								_in_globals_p
+			, const float*								_in_times_p
+			, const uint32_t							_in_frameCount
+			, const std::vector<AnimationJointTracks>&	_in_tracks
+			, const AnimationTolerance&					_in_tolerance
+			, AnimationReductionStats&					_out_stats
+			, std::vector<bool>&						_out_exceeded
+		) {
+			uint32_t jointCount = (uint32_t)_in_joints.size();
+
+			std::vector<bool> isLeaf(jointCount, true);
+			for (uint32_t j = 0; j < jointCount; j++)
+				if (_in_joints[j].parent_index >= 0)
+					isLeaf[_in_joints[j].parent_index] = false;
+
+			_out_stats.max_translation_error = 0.0f;
+			_out_stats.max_rotation_error = 0.0f;
+			_out_stats.max_scale_error = 0.0f;
+			_out_exceeded.assign(jointCount, false);
+
+			std::vector<Matrix> sampledGlobals(jointCount);
+
+			for (uint32_t f = 0; f < _in_frameCount; f++)
+			{
+				const Matrix* frameGlobals_p = &_in_globals_p[(size_t)f * jointCount];
+
+				for (uint32_t j = 0; j < jointCount; j++)
+				{
+					int parent = _in_joints[j].parent_index;
+
+					JointTransform sampled;
+					Matrix local;
+					SampleAnimationJoint(_in_tracks[j], _in_times_p[f], sampled);
+					ComposeMatrix(sampled, local);
+
+					if (parent < 0)
+						sampledGlobals[j] = local;
+					else
+						MultiplyMatrix(local, sampledGlobals[parent], sampledGlobals[j]);
+
+					if (!isLeaf[j])
+						continue;
+
+					JointTransform expected, actual;
+					DecomposeMatrix(frameGlobals_p[j], expected);
+					DecomposeMatrix(sampledGlobals[j], actual);
+
+					float translationError = GetChannelError(AnimationChannel::TRANSLATION,
+						expected.translation, actual.translation);
+					float rotationError = GetChannelError(AnimationChannel::ROTATION,
+						expected.rotation, actual.rotation);
+					float scaleError = GetChannelError(AnimationChannel::SCALE,
+						expected.scale, actual.scale);
+
+					_out_stats.max_translation_error = std::max(_out_stats.max_translation_error, translationError);
+					_out_stats.max_rotation_error = std::max(_out_stats.max_rotation_error, rotationError);
+					_out_stats.max_scale_error = std::max(_out_stats.max_scale_error, scaleError);
+
+					if (translationError > _in_tolerance.translation || rotationError > _in_tolerance.rotation
+						|| scaleError > _in_tolerance.scale)
+						_out_exceeded[j] = true;
+				}
+			}
+		}
+
+		uint16_t QuantizeKeyTime(
+			const float					_in_time
+			, const double				_in_duration
+		) {
+			double fraction = _in_duration > 0.0 ? _in_time / _in_duration : 0.0;
+			fraction = std::min(std::max(fraction, 0.0), 1.0);
+
+			return (uint16_t)(fraction * 65535.0 + 0.5);
+		}
+
+		float DecodeKeyTime(
+			const uint16_t				_in_time
+			, const double				_in_duration
+		) {
+			return (float)(_in_time / 65535.0 * _in_duration);
+		}
+
+		void QuantizeVectorTrack(
+			const AnimationTrack&		_in_track
+			, const double				_in_duration
+			, QuantizedVectorTrack&		_out_track
+		) {
+			uint32_t keyCount = (uint32_t)_in_track.times.size();
+
+			float max[3];
+			for (uint32_t c = 0; c < 3; c++)
+				_out_track.min[c] = max[c] = _in_track.values[c];
+
+			for (uint32_t k = 1; k < keyCount; k++)
+				for (uint32_t c = 0; c < 3; c++)
+				{
+					_out_track.min[c] = std::min(_out_track.min[c], _in_track.values[k * 3 + c]);
+					max[c] = std::max(max[c], _in_track.values[k * 3 + c]);
+				}
+
+			bool constant = true;
+			for (uint32_t c = 0; c < 3; c++)
+			{
+				_out_track.extent[c] = max[c] - _out_track.min[c];
+				constant = constant && _out_track.extent[c] == 0.0f;
+			}
+
+			_out_track.times.clear();
+			_out_track.values.clear();
+
+			// constant channels are fully described by min
+			if (constant)
+				return;
+
+			_out_track.times.reserve(keyCount);
+			_out_track.values.reserve(keyCount * 3);
+
+			for (uint32_t k = 0; k < keyCount; k++)
+			{
+				_out_track.times.push_back(QuantizeKeyTime(_in_track.times[k], _in_duration));
+
+				for (uint32_t c = 0; c < 3; c++)
+				{
+					float fraction = _out_track.extent[c] > 0.0f
+						? (_in_track.values[k * 3 + c] - _out_track.min[c]) / _out_track.extent[c] : 0.0f;
+					_out_track.values.push_back((uint16_t)(std::min(std::max(fraction, 0.0f), 1.0f) * 65535.0f + 0.5f));
+				}
+			}
+		}
+
+		void DecodeVectorTrack(
+			const QuantizedVectorTrack&	_in_track
+			, const double				_in_duration
+			, AnimationTrack&			_out_track
+		) {
+			uint32_t keyCount = (uint32_t)_in_track.times.size();
+
+			_out_track.times.clear();
+			_out_track.values.clear();
+
+			if (keyCount == 0)
+			{
+				_out_track.times.push_back(0.0f);
+				_out_track.values.insert(_out_track.values.end(), _in_track.min, _in_track.min + 3);
+				return;
+			}
+
+			for (uint32_t k = 0; k < keyCount; k++)
+			{
+				_out_track.times.push_back(DecodeKeyTime(_in_track.times[k], _in_duration));
+
+				for (uint32_t c = 0; c < 3; c++)
+					_out_track.values.push_back(_in_track.min[c]
+						+ _in_track.extent[c] * (_in_track.values[k * 3 + c] / 65535.0f));
+			}
+		}
+
+		/* Packs a unit quaternion into 48 bits as its three smallest components.
+		  PARAMETERS
+			_in_rotation_p : The quaternion as xyzw.
+			_out_words_p : Storage for three words, most significant first.
+		  NOTES
+			Bits 47-46 hold the index of the largest component, bits 45-1 hold the other three
+			components in 15 bits each, and bit 0 is unused. The largest component is made
+			positive, which leaves the others within +-1/sqrt(2).
+		*/
+		void PackQuaternion(
+			const float*				_in_rotation_p
+			, uint16_t*					_out_words_p
+		) {
+			uint32_t largest = 0;
+			for (uint32_t i = 1; i < 4; i++)
+				if (fabsf(_in_rotation_p[i]) > fabsf(_in_rotation_p[largest]))
+					largest = i;
+
+			float sign = _in_rotation_p[largest] < 0.0f ? -1.0f : 1.0f;
+			uint64_t packed = (uint64_t)largest << 46;
+			uint32_t shift = 31;
+
+			for (uint32_t i = 0; i < 4; i++)
+			{
+				if (i == largest)
+					continue;
+
+				float fraction = (_in_rotation_p[i] * sign * 1.41421356f + 1.0f) * 0.5f;
+				uint64_t value = (uint64_t)(std::min(std::max(fraction, 0.0f), 1.0f) * 32767.0f + 0.5f);
+
+				packed |= value << shift;
+				shift -= 15;
+			}
+
+			_out_words_p[0] = (uint16_t)(packed >> 32);
+			_out_words_p[1] = (uint16_t)(packed >> 16);
+			_out_words_p[2] = (uint16_t)packed;
+		}
+
+		void UnpackQuaternion(
+			const uint16_t*				_in_words_p
+			, float*					_out_rotation_p
+		) {
+			uint64_t packed = ((uint64_t)_in_words_p[0] << 32) | ((uint64_t)_in_words_p[1] << 16) | _in_words_p[2];
+			uint32_t largest = (uint32_t)(packed >> 46) & 3;
+			uint32_t shift = 31;
+			float sum = 0.0f;
+
+			for (uint32_t i = 0; i < 4; i++)
+			{
+				if (i == largest)
+					continue;
+
+				float fraction = ((packed >> shift) & 0x7FFF) / 32767.0f;
+				_out_rotation_p[i] = (fraction * 2.0f - 1.0f) * 0.70710678f;
+				sum += _out_rotation_p[i] * _out_rotation_p[i];
+				shift -= 15;
+			}
+
+			_out_rotation_p[largest] = sqrtf(std::max(1.0f - sum, 0.0f));
+		}
+#pragma endregion
+
+#pragma region Animation Function Definitions
+		void MultiplyMatrix(
+			const Matrix&				_in_a
+			, const Matrix&				_in_b
+			, Matrix&					_out_matrix
+		) {
+			for (int r = 0; r < 4; r++)
+				for (int c = 0; c < 4; c++)
+					_out_matrix.values[r * 4 + c] =
+						_in_a.values[r * 4 + 0] * _in_b.values[0 + c]
+						+ _in_a.values[r * 4 + 1] * _in_b.values[4 + c]
+						+ _in_a.values[r * 4 + 2] * _in_b.values[8 + c]
+						+ _in_a.values[r * 4 + 3] * _in_b.values[12 + c];
+		}
+
+		bool InvertAffineMatrix(
+			const Matrix&				_in_matrix
+			, Matrix&					_out_matrix
+		) {
+			const float* m = _in_matrix.values;
+
+			// cofactors of the upper 3x3 block
+			double c00 = (double)m[5] * m[10] - (double)m[6] * m[9];
+			double c01 = (double)m[6] * m[8] - (double)m[4] * m[10];
+			double c02 = (double)m[4] * m[9] - (double)m[5] * m[8];
+			double det = m[0] * c00 + m[1] * c01 + m[2] * c02;
+
+			for (int i = 0; i < 16; i++)
+				_out_matrix.values[i] = (i % 5 == 0) ? 1.0f : 0.0f;
+
+			if (det == 0.0)
+				return false;
+
+			double invDet = 1.0 / det;
+			double inv[9] =
+			{
+				c00 * invDet
+				, ((double)m[2] * m[9] - (double)m[1] * m[10]) * invDet
+				, ((double)m[1] * m[6] - (double)m[2] * m[5]) * invDet
+				, c01 * invDet
+				, ((double)m[0] * m[10] - (double)m[2] * m[8]) * invDet
+				, ((double)m[2] * m[4] - (double)m[0] * m[6]) * invDet
+				, c02 * invDet
+				, ((double)m[1] * m[8] - (double)m[0] * m[9]) * invDet
+				, ((double)m[0] * m[5] - (double)m[1] * m[4]) * invDet
+			};
+
+			for (int r = 0; r < 3; r++)
+				for (int c = 0; c < 3; c++)
+					_out_matrix.values[r * 4 + c] = (float)inv[r * 3 + c];
+
+			// translation row moves to -t x inverse
+			for (int c = 0; c < 3; c++)
+				_out_matrix.values[12 + c] = (float)-(m[12] * inv[c] + m[13] * inv[3 + c] + m[14] * inv[6 + c]);
+
+			return true;
+		}
+
+		void DecomposeMatrix(
+			const Matrix&				_in_matrix
+			, JointTransform&			_out_transform
+		) {
+			const float* m = _in_matrix.values;
+
+			_out_transform.translation[0] = m[12];
+			_out_transform.translation[1] = m[13];
+			_out_transform.translation[2] = m[14];
+
+			// basis rows carry scale, normalized rows carry rotation
+			float axes[3][3];
+			for (int r = 0; r < 3; r++)
+			{
+				float length = sqrtf(m[r * 4 + 0] * m[r * 4 + 0] + m[r * 4 + 1] * m[r * 4 + 1]
+					+ m[r * 4 + 2] * m[r * 4 + 2]);
+
+				_out_transform.scale[r] = length;
+				for (int c = 0; c < 3; c++)
+					axes[r][c] = length > 0.0f ? m[r * 4 + c] / length : (r == c ? 1.0f : 0.0f);
+			}
+
+			// a mirrored basis is kept as a negative x scale
+			float det = axes[0][0] * (axes[1][1] * axes[2][2] - axes[1][2] * axes[2][1])
+				- axes[0][1] * (axes[1][0] * axes[2][2] - axes[1][2] * axes[2][0])
+				+ axes[0][2] * (axes[1][0] * axes[2][1] - axes[1][1] * axes[2][0]);
+			if (det < 0.0f)
+			{
+				_out_transform.scale[0] = -_out_transform.scale[0];
+				for (int c = 0; c < 3; c++)
+					axes[0][c] = -axes[0][c];
+			}
+
+			float* q = _out_transform.rotation;
+			float trace = axes[0][0] + axes[1][1] + axes[2][2];
+
+			if (trace > 0.0f)
+			{
+				float w = sqrtf(trace + 1.0f) * 0.5f;
+				float k = 0.25f / w;
+				q[0] = (axes[1][2] - axes[2][1]) * k;
+				q[1] = (axes[2][0] - axes[0][2]) * k;
+				q[2] = (axes[0][1] - axes[1][0]) * k;
+				q[3] = w;
+			}
+			else if (axes[0][0] >= axes[1][1] && axes[0][0] >= axes[2][2])
+			{
+				float x = sqrtf(1.0f + axes[0][0] - axes[1][1] - axes[2][2]) * 0.5f;
+				float k = 0.25f / x;
+				q[0] = x;
+				q[1] = (axes[0][1] + axes[1][0]) * k;
+				q[2] = (axes[0][2] + axes[2][0]) * k;
+				q[3] = (axes[1][2] - axes[2][1]) * k;
+			}
+			else if (axes[1][1] >= axes[2][2])
+			{
+				float y = sqrtf(1.0f + axes[1][1] - axes[0][0] - axes[2][2]) * 0.5f;
+				float k = 0.25f / y;
+				q[0] = (axes[0][1] + axes[1][0]) * k;
+				q[1] = y;
+				q[2] = (axes[1][2] + axes[2][1]) * k;
+				q[3] = (axes[2][0] - axes[0][2]) * k;
+			}
+			else
+			{
+				float z = sqrtf(1.0f + axes[2][2] - axes[0][0] - axes[1][1]) * 0.5f;
+				float k = 0.25f / z;
+				q[0] = (axes[0][2] + axes[2][0]) * k;
+				q[1] = (axes[1][2] + axes[2][1]) * k;
+				q[2] = z;
+				q[3] = (axes[0][1] - axes[1][0]) * k;
+			}
+
+			float length = sqrtf(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+			for (int i = 0; i < 4; i++)
+				q[i] /= length;
+		}
+
+		void ComposeMatrix(
+			const JointTransform&		_in_transform
+			, Matrix&					_out_matrix
+		) {
+			const float* q = _in_transform.rotation;
+			const float* s = _in_transform.scale;
+			float* m = _out_matrix.values;
+
+			float xx = q[0] * q[0], yy = q[1] * q[1], zz = q[2] * q[2];
+			float xy = q[0] * q[1], xz = q[0] * q[2], yz = q[1] * q[2];
+			float wx = q[3] * q[0], wy = q[3] * q[1], wz = q[3] * q[2];
+
+			m[0] = (1.0f - 2.0f * (yy + zz)) * s[0];
+			m[1] = 2.0f * (xy + wz) * s[0];
+			m[2] = 2.0f * (xz - wy) * s[0];
+			m[3] = 0.0f;
+
+			m[4] = 2.0f * (xy - wz) * s[1];
+			m[5] = (1.0f - 2.0f * (xx + zz)) * s[1];
+			m[6] = 2.0f * (yz + wx) * s[1];
+			m[7] = 0.0f;
+
+			m[8] = 2.0f * (xz + wy) * s[2];
+			m[9] = 2.0f * (yz - wx) * s[2];
+			m[10] = (1.0f - 2.0f * (xx + yy)) * s[2];
+			m[11] = 0.0f;
+
+			m[12] = _in_transform.translation[0];
+			m[13] = _in_transform.translation[1];
+			m[14] = _in_transform.translation[2];
+			m[15] = 1.0f;
+		}
+
+		void SampleAnimationTrack(
+			const AnimationTrack&		_in_track
+			, const uint32_t			_in_componentCount
+			, const float				_in_time
+			, float*					_out_values_p
+		) {
+			const std::vector<float>& times = _in_track.times;
+			const float* values_p = _in_track.values.data();
+
+			// find the first key after the sample time
+			uint32_t next = (uint32_t)(std::upper_bound(times.begin(), times.end(), _in_time) - times.begin());
+
+			if (next == 0 || next == times.size())
+			{
+				uint32_t key = next == 0 ? 0 : next - 1;
+				for (uint32_t c = 0; c < _in_componentCount; c++)
+					_out_values_p[c] = values_p[key * _in_componentCount + c];
+				return;
+			}
+
+			uint32_t previous = next - 1;
+			float span = times[next] - times[previous];
+			float u = span > 0.0f ? (_in_time - times[previous]) / span : 0.0f;
+
+			for (uint32_t c = 0; c < _in_componentCount; c++)
+			{
+				float a = values_p[previous * _in_componentCount + c];
+				float b = values_p[next * _in_componentCount + c];
+				_out_values_p[c] = a + (b - a) * u;
+			}
+		}
+
+		void SampleAnimationJoint(
+			const AnimationJointTracks&	_in_tracks
+			, const float				_in_time
+			, JointTransform&			_out_transform
+		) {
+			SampleAnimationTrack(_in_tracks.translation, 3, _in_time, _out_transform.translation);
+			SampleAnimationTrack(_in_tracks.rotation, 4, _in_time, _out_transform.rotation);
+			SampleAnimationTrack(_in_tracks.scale, 3, _in_time, _out_transform.scale);
+
+			float* q = _out_transform.rotation;
+			float length = sqrtf(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+			for (int i = 0; i < 4; i++)
+				q[i] = length > 0.0f ? q[i] / length : (i == 3 ? 1.0f : 0.0f);
+		}
+#pragma endregion
+
+#pragma region Interface Function Definitions
+		Result ReduceAnimationClip(
+			const AnimationClip&		_in_animationClip
+			, const AnimationTolerance&	_in_tolerance
+			, SparseAnimationClip&		_out_sparseClip
+			, AnimationReductionStats&	_out_stats
+		) {
+			uint32_t jointCount = (uint32_t)_in_animationClip.joints.size();
+			uint32_t frameCount = _in_animationClip.GetFrameCount();
+
+			// verify every frame holds one transform per joint
+			if (jointCount == 0 || frameCount == 0
+				|| _in_animationClip.transforms.size() != (size_t)frameCount * jointCount)
+				return Result::INVALID_ARG;
+
+
+			// -- split source transforms into parent-relative channels --
+
+			// channel samples are stored joint by joint so each channel is contiguous
+			std::vector<float> times(frameCount);
+			std::vector<Matrix> globalStorage;
+			std::vector<float> translations((size_t)jointCount * frameCount * 3);
+			std::vector<float> rotations((size_t)jointCount * frameCount * 4);
+			std::vector<float> scales((size_t)jointCount * frameCount * 3);
+
+			const Matrix* globals_p = GetAnimationClipGlobals(_in_animationClip, globalStorage);
+
+			for (uint32_t f = 0; f < frameCount; f++)
+			{
+				AnimationFrame frame = _in_animationClip.GetFrame(f);
+				const Matrix* frameGlobals_p = &globals_p[(size_t)f * jointCount];
+
+				times[f] = (float)frame.time;
+
+				for (uint32_t j = 0; j < jointCount; j++)
+				{
+					int parent = _in_animationClip.joints[j].parent_index;
+					Matrix local = frame.transforms_p[j];
+
+					// model-space transforms are made parent-relative
+					if (parent >= 0 && !_in_animationClip.local_space)
+					{
+						Matrix parentInverse;
+						InvertAffineMatrix(frameGlobals_p[parent], parentInverse);
+						MultiplyMatrix(frameGlobals_p[j], parentInverse, local);
+					}
+
+					JointTransform transform;
+					DecomposeMatrix(local, transform);
+
+					size_t sample = (size_t)j * frameCount + f;
+					memcpy(&translations[sample * 3], transform.translation, sizeof(transform.translation));
+					memcpy(&rotations[sample * 4], transform.rotation, sizeof(transform.rotation));
+					memcpy(&scales[sample * 3], transform.scale, sizeof(transform.scale));
+
+					// keep quaternions in one hemisphere so interpolation takes the short path
+					if (f > 0)
+					{
+						float* q = &rotations[sample * 4];
+						const float* previous_p = q - 4;
+						if (q[0] * previous_p[0] + q[1] * previous_p[1] + q[2] * previous_p[2] + q[3] * previous_p[3] < 0.0f)
+							for (int i = 0; i < 4; i++)
+								q[i] = -q[i];
+					}
+				}
+			}
+
+			// -- /split source transforms into parent-relative channels --
+
+
+			// -- measure joint reach in bind pose --
+
+			// a local rotation or scale error moves descendants by up to the length of the chain below
+			std::vector<float> reach(jointCount, 0.0f);
+
+			for (uint32_t j = jointCount; j > 0; j--)
+			{
+				int parent = _in_animationClip.joints[j - 1].parent_index;
+				if (parent < 0)
+					continue;
+
+				const float* child_p = &_in_animationClip.joints[j - 1].global_transform.values[12];
+				const float* parent_p = &_in_animationClip.joints[parent].global_transform.values[12];
+				float dx = child_p[0] - parent_p[0];
+				float dy = child_p[1] - parent_p[1];
+				float dz = child_p[2] - parent_p[2];
+
+				reach[parent] = std::max(reach[parent], sqrtf(dx * dx + dy * dy + dz * dz) + reach[j - 1]);
+			}
+
+			// -- /measure joint reach in bind pose --
+
+
+			// -- reduce channels until every leaf joint is within tolerance --
+
+			_out_sparseClip.duration = _in_animationClip.duration;
+			_out_sparseClip.joints = _in_animationClip.joints;
+			_out_sparseClip.tracks.assign(jointCount, AnimationJointTracks());
+
+			std::vector<float> toleranceScales(jointCount, 1.0f);
+			std::vector<bool> dirty(jointCount, true);
+			std::vector<bool> exceeded;
+
+			for (uint32_t pass = 0; pass < MAX_REDUCTION_PASSES; pass++)
+			{
+				bool lastPass = pass + 1 == MAX_REDUCTION_PASSES;
+
+				// joints are independent, so channels are reduced in parallel
+				ParallelFor(jointCount, GetWorkerThreadCount(), [&](uint32_t _in_joint, uint32_t)
+				{
+					if (!dirty[_in_joint])
+						return;
+
+					// the last pass only drops keys that interpolate exactly
+					float scale = lastPass ? 0.0f : toleranceScales[_in_joint];
+					float chain = reach[_in_joint];
+
+					float translationTolerance = _in_tolerance.translation * scale;
+					float rotationTolerance = _in_tolerance.rotation * scale;
+					float scaleTolerance = _in_tolerance.scale * scale;
+					if (chain > 0.0f)
+					{
+						rotationTolerance = std::min(rotationTolerance, translationTolerance / chain);
+						scaleTolerance = std::min(scaleTolerance, translationTolerance / chain);
+					}
+
+					size_t first = (size_t)_in_joint * frameCount;
+					AnimationJointTracks& tracks = _out_sparseClip.tracks[_in_joint];
+
+					ReduceAnimationTrack(AnimationChannel::TRANSLATION, times.data(), &translations[first * 3],
+						frameCount, translationTolerance, tracks.translation);
+					ReduceAnimationTrack(AnimationChannel::ROTATION, times.data(), &rotations[first * 4],
+						frameCount, rotationTolerance, tracks.rotation);
+					ReduceAnimationTrack(AnimationChannel::SCALE, times.data(), &scales[first * 3],
+						frameCount, scaleTolerance, tracks.scale);
+				});
+
+				// rebuild every frame from the kept keys and compare leaf joints in model space
+				MeasureAnimationLeafErrors(_in_animationClip.joints, globals_p, times.data(), frameCount,
+					_out_sparseClip.tracks, _in_tolerance, _out_stats, exceeded);
+
+				// tighten the tolerance of every joint above a leaf that was out of tolerance
+				std::fill(dirty.begin(), dirty.end(), false);
+				bool anyExceeded = false;
+
+				for (uint32_t j = 0; j < jointCount; j++)
+				{
+					if (!exceeded[j])
+						continue;
+
+					anyExceeded = true;
+					for (int n = (int)j; n >= 0; n = _in_animationClip.joints[n].parent_index)
+					{
+						if (!dirty[n])
+							toleranceScales[n] *= 0.5f;
+						dirty[n] = true;
+					}
+				}
+
+				if (!anyExceeded)
+					break;
+			}
+
+			// -- /reduce channels until every leaf joint is within tolerance --
+
+
+			_out_stats.source_key_count = jointCount * frameCount * 3;
+			_out_stats.key_count = 0;
+			for (uint32_t j = 0; j < jointCount; j++)
+			{
+				const AnimationJointTracks& tracks = _out_sparseClip.tracks[j];
+				_out_stats.key_count += (uint32_t)(tracks.translation.times.size()
+					+ tracks.rotation.times.size() + tracks.scale.times.size());
+			}
+
+			return Result::SUCCESS;
+		}
+
+		Result MeasureAnimationClipError(
+			const AnimationClip&		_in_animationClip
+			, const SparseAnimationClip&	_in_sparseClip
+			, AnimationReductionStats&	_out_stats
+		) {
+			uint32_t jointCount = (uint32_t)_in_animationClip.joints.size();
+			uint32_t frameCount = _in_animationClip.GetFrameCount();
+
+			// verify both clips describe the same joints
+			if (jointCount == 0 || _in_sparseClip.tracks.size() != jointCount
+				|| _in_animationClip.transforms.size() != (size_t)frameCount * jointCount)
+				return Result::INVALID_ARG;
+
+			std::vector<float> times(frameCount);
+			for (uint32_t f = 0; f < frameCount; f++)
+				times[f] = (float)_in_animationClip.frame_times[f];
+
+			std::vector<Matrix> globalStorage;
+			std::vector<bool> exceeded;
+			const Matrix* globals_p = GetAnimationClipGlobals(_in_animationClip, globalStorage);
+			MeasureAnimationLeafErrors(_in_animationClip.joints, globals_p, times.data(), frameCount,
+				_in_sparseClip.tracks, AnimationTolerance(), _out_stats, exceeded);
+
+			return Result::SUCCESS;
+		}
+
+		Result QuantizeAnimationClip(
+			const SparseAnimationClip&	_in_sparseClip
+			, QuantizedAnimationClip&	_out_quantizedClip
+		) {
+			uint32_t jointCount = (uint32_t)_in_sparseClip.joints.size();
+
+			// verify every channel has keys
+			if (_in_sparseClip.tracks.size() != jointCount)
+				return Result::INVALID_ARG;
+			for (uint32_t j = 0; j < jointCount; j++)
+			{
+				const AnimationJointTracks& tracks = _in_sparseClip.tracks[j];
+				if (tracks.translation.times.empty() || tracks.rotation.times.empty() || tracks.scale.times.empty())
+					return Result::INVALID_ARG;
+			}
+
+			_out_quantizedClip.duration = _in_sparseClip.duration;
+			_out_quantizedClip.joints = _in_sparseClip.joints;
+			_out_quantizedClip.tracks.assign(jointCount, QuantizedJointTracks());
+
+			for (uint32_t j = 0; j < jointCount; j++)
+			{
+				const AnimationJointTracks& tracks = _in_sparseClip.tracks[j];
+				QuantizedJointTracks& quantized = _out_quantizedClip.tracks[j];
+
+				QuantizeVectorTrack(tracks.translation, _in_sparseClip.duration, quantized.translation);
+				QuantizeVectorTrack(tracks.scale, _in_sparseClip.duration, quantized.scale);
+
+				uint32_t keyCount = (uint32_t)tracks.rotation.times.size();
+				quantized.rotation.times.resize(keyCount);
+				quantized.rotation.values.resize(keyCount * 3);
+
+				for (uint32_t k = 0; k < keyCount; k++)
+				{
+					quantized.rotation.times[k] = QuantizeKeyTime(tracks.rotation.times[k], _in_sparseClip.duration);
+
+					// normalize in case keys were not written by the reducer
+					float q[4];
+					float length = sqrtf(tracks.rotation.values[k * 4 + 0] * tracks.rotation.values[k * 4 + 0]
+						+ tracks.rotation.values[k * 4 + 1] * tracks.rotation.values[k * 4 + 1]
+						+ tracks.rotation.values[k * 4 + 2] * tracks.rotation.values[k * 4 + 2]
+						+ tracks.rotation.values[k * 4 + 3] * tracks.rotation.values[k * 4 + 3]);
+					for (uint32_t c = 0; c < 4; c++)
+						q[c] = length > 0.0f ? tracks.rotation.values[k * 4 + c] / length : (c == 3 ? 1.0f : 0.0f);
+
+					PackQuaternion(q, &quantized.rotation.values[k * 3]);
+				}
+			}
+
+			return Result::SUCCESS;
+		}
+
+		Result DecodeQuantizedAnimationClip(
+			const QuantizedAnimationClip&	_in_quantizedClip
+			, SparseAnimationClip&		_out_sparseClip
+		) {
+			uint32_t jointCount = (uint32_t)_in_quantizedClip.tracks.size();
+
+			_out_sparseClip.duration = _in_quantizedClip.duration;
+			_out_sparseClip.joints = _in_quantizedClip.joints;
+			_out_sparseClip.tracks.assign(jointCount, AnimationJointTracks());
+
+			for (uint32_t j = 0; j < jointCount; j++)
+			{
+				const QuantizedJointTracks& quantized = _in_quantizedClip.tracks[j];
+				AnimationJointTracks& tracks = _out_sparseClip.tracks[j];
+
+				DecodeVectorTrack(quantized.translation, _in_quantizedClip.duration, tracks.translation);
+				DecodeVectorTrack(quantized.scale, _in_quantizedClip.duration, tracks.scale);
+
+				uint32_t keyCount = (uint32_t)quantized.rotation.times.size();
+				tracks.rotation.times.resize(keyCount);
+				tracks.rotation.values.resize(keyCount * 4);
+
+				for (uint32_t k = 0; k < keyCount; k++)
+				{
+					float* q = &tracks.rotation.values[k * 4];
+
+					tracks.rotation.times[k] = DecodeKeyTime(quantized.rotation.times[k], _in_quantizedClip.duration);
+					UnpackQuaternion(&quantized.rotation.values[k * 3], q);
+
+					// packing made the largest component positive, so restore the short path between keys
+					if (k > 0 && q[0] * q[-4] + q[1] * q[-3] + q[2] * q[-2] + q[3] * q[-1] < 0.0f)
+						for (uint32_t c = 0; c < 4; c++)
+							q[c] = -q[c];
+				}
+			}
+
+			return Result::SUCCESS;
+		}
+
+		uint64_t GetSkeletonHash(
+			const std::vector<AnimationJoint>&	_in_joints
+		) {
+			// FNV-1a over the hierarchy and the bind pose snapped to 1/1024 units, so exports of the
+			// same rig with float noise in their bind pose hash alike
+			uint64_t hash = 14695981039346656037ull;
+			auto addBytes = [&](const void* _in_data_p, size_t _in_byteCount)
+			{
+				const uint8_t* bytes_p = (const uint8_t*)_in_data_p;
+				for (size_t i = 0; i < _in_byteCount; i++)
+				{
+					hash ^= bytes_p[i];
+					hash *= 1099511628211ull;
+				}
+			};
+
+			uint32_t jointCount = (uint32_t)_in_joints.size();
+			addBytes(&jointCount, sizeof(jointCount));
+
+			for (const AnimationJoint& joint : _in_joints)
+			{
+				int32_t parentIndex = joint.parent_index;
+				addBytes(&parentIndex, sizeof(parentIndex));
+
+				for (int i = 0; i < 16; i++)
+				{
+					int64_t value = (int64_t)llround(joint.global_transform.values[i] * 1024.0);
+					addBytes(&value, sizeof(value));
+				}
+			}
+
+			return hash;
+		}
+#pragma endregion
+
+	}
+}
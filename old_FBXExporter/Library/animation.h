@@ -0,0 +1,100 @@
+#ifndef _FBXEXPORTER_LIBRARY_ANIMATION_H_
+#define _FBXEXPORTER_LIBRARY_ANIMATION_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "defines.h"
+
+namespace fbx_exporter
+{
+	namespace library
+	{
+		// Joint transformation split into translation, rotation, and scale.
+		struct JointTransform
+		{
+			float	translation[3] = { 0.0f, 0.0f, 0.0f };  // Position vector.
+			float	rotation[4] = { 0.0f, 0.0f, 0.0f, 1.0f };  // Unit quaternion as xyzw.
+			float	scale[3] = { 1.0f, 1.0f, 1.0f };  // Scale vector. Negative x indicates a mirrored basis.
+		};
+
+
+		/* Multiplies two row-major 4x4 matrices.
+		  PARAMETERS
+			_in_a : The left matrix.
+			_in_b : The right matrix.
+			_out_matrix : The product _in_a x _in_b. Must not alias either input.
+		  NOTES
+			With row-vector matrices, as stored in Matrix, the product applies _in_a first.
+		*/
+		void MultiplyMatrix(
+			const Matrix&				_in_a
+			, const Matrix&				_in_b
+			, Matrix&					_out_matrix
+		);
+
+		/* Inverts an affine transformation matrix.
+		  PARAMETERS
+			_in_matrix : The matrix to invert. The last column must be (0, 0, 0, 1).
+			_out_matrix : The inverse matrix.
+		  RETURNS
+			true : The matrix was inverted.
+			false : The matrix is singular. _out_matrix is set to identity.
+		*/
+		bool InvertAffineMatrix(
+			const Matrix&				_in_matrix
+			, Matrix&					_out_matrix
+		);
+
+		/* Splits a transformation matrix into translation, rotation, and scale.
+		  PARAMETERS
+			_in_matrix : The matrix to split. Shear is discarded.
+			_out_transform : The components of the matrix.
+		*/
+		void DecomposeMatrix(
+			const Matrix&				_in_matrix
+			, JointTransform&			_out_transform
+		);
+
+		/* Builds a transformation matrix from translation, rotation, and scale.
+		  PARAMETERS
+			_in_transform : The components to combine. The rotation must be normalized.
+			_out_matrix : The matrix built.
+		*/
+		void ComposeMatrix(
+			const JointTransform&		_in_transform
+			, Matrix&					_out_matrix
+		);
+
+		/* Interpolates a channel at a point in time.
+		  PARAMETERS
+			_in_track : The channel keys. Must contain at least one key.
+			_in_componentCount : The number of values per key.
+			_in_time : The time to sample, in seconds. Clamped to the first and last key.
+			_out_values_p : Storage for _in_componentCount interpolated values.
+		  NOTES
+			Values are interpolated linearly. Rotations must be normalized by the caller.
+		*/
+		void SampleAnimationTrack(
+			const AnimationTrack&		_in_track
+			, const uint32_t			_in_componentCount
+			, const float				_in_time
+			, float*					_out_values_p
+		);
+
+		/* Samples the parent-relative transformation of a joint at a point in time.
+		  PARAMETERS
+			_in_tracks : The channel keys of the joint.
+			_in_time : The time to sample, in seconds.
+			_out_transform : The transformation sampled. The rotation is normalized.
+		*/
+		void SampleAnimationJoint(
+			const AnimationJointTracks&	_in_tracks
+			, const float				_in_time
+			, JointTransform&			_out_transform
+		);
+
+	}
+}
+
+#endif // _FBXEXPORTER_LIBRARY_ANIMATION_H_
@@ -1,15 +1,16 @@
 #ifndef _FBXEXPORTER_LIBRARY_DEFINES_H_
 #define _FBXEXPORTER_LIBRARY_DEFINES_H_
 
-#include <array>
+#include <cstdint>
+#include <string>
 #include <vector>
 
 namespace fbx_exporter
 {
 	namespace library
 	{
-		// Char array of maximum allowed Windows filepath length.
-		using filepath_t = std::array<char, 260>;
+		// Material index of a mesh part whose polygons have no material.
+		const uint32_t NO_MATERIAL = 0xFFFFFFFF;
 
 
 		// Named index values for array access.
@@ -31,7 +32,54 @@ namespace fbx_exporter
 			, NORMAL = 0x00000002  // Model-space normal vector.
 			, COLOR = 0x00000004  // RGBA color.
 			, TEXCOORD = 0x00000008  // UV texcure coordinate.
-			, ALL = POSITION | NORMAL | COLOR | TEXCOORD  // All supported elements.
+			, SKIN = 0x00000010  // Skin weights and animation joint indices of the four strongest influences.
+			, ALL = POSITION | NORMAL | COLOR | TEXCOORD | SKIN  // All supported elements.
+		};
+
+		// Indicates how positions are stored in a packed vertex.
+		enum struct VertexPositionFormat : uint32_t
+		{
+			FLOAT = 0  // 32-bit floats.
+			, UNORM16  // 16-bit unsigned integers spanning the mesh bounding box.
+		};
+
+		// Indicates how normals are stored in a packed vertex.
+		enum struct VertexNormalFormat : uint32_t
+		{
+			FLOAT = 0  // 32-bit floats.
+			, OCTAHEDRAL16  // Octahedral projection in two 16-bit signed integers.
+		};
+
+		// Indicates how colors are stored in a packed vertex.
+		enum struct VertexColorFormat : uint32_t
+		{
+			FLOAT = 0  // 32-bit floats.
+			, UNORM8  // 8-bit unsigned integers spanning 0 to 1.
+		};
+
+		// Indicates how texture coordinates are stored in a packed vertex.
+		enum struct VertexTexCoordFormat : uint32_t
+		{
+			FLOAT = 0  // 32-bit floats.
+			, HALF  // 16-bit floats.
+			, UNORM16  // 16-bit unsigned integers spanning the mesh texture coordinate bounds.
+		};
+
+		// Indicates how skin weights and joint indices are stored in a packed vertex.
+		enum struct VertexSkinFormat : uint32_t
+		{
+			FLOAT = 0  // 32-bit float weights and 16-bit joint indices, as in Vertex.
+			, UNORM8_UINT8  // 8-bit unsigned normalized weights summing to 1, and 8-bit joint indices.
+			, UNORM8_UINT16  // 8-bit unsigned normalized weights summing to 1, and 16-bit joint indices.
+		};
+
+		// Indicates how a compressed texture stores each 4x4 pixel block.
+		enum struct TextureFormat : uint32_t
+		{
+			BC1 = 1  // 8 bytes: two 5:6:5 colors and 2-bit indices. Opaque RGB.
+			, BC3  // 16 bytes: BC4 alpha followed by a BC1 color block. RGBA.
+			, BC5  // 16 bytes: BC4 red followed by BC4 green. Two-channel data such as tangent-space normals.
+			, BC7  // 16 bytes: 7-bit RGBA endpoints with shared low bits and 4-bit indices. High-quality RGBA.
 		};
 
 		// Indicates textures to store when extracting a material.
@@ -47,6 +95,7 @@ namespace fbx_exporter
 		// Indicates animation elements to store when extracting an animation.
 		enum struct AnimationElement
 		{
+			LOCAL_TRANSFORMS = 0x00000001  // Parent-relative joint transforms instead of model-space.
 		};
 
 		// Indicates the result of a function or operation.
@@ -87,8 +136,10 @@ namespace fbx_exporter
 			float norm[3] = { 0.0f, 0.0f, 0.0f };  // Model-space normal vector.
 			float color[4] = { 0.0f, 0.0f, 0.0f, 0.0f };  // RGBA color.
 			float texCoord[2] = { 0.0f, 0.0f };  // UV texture coordinate.
+			float weights[4] = { 0.0f, 0.0f, 0.0f, 0.0f };  // Skin weights of the strongest joint influences, largest first. Sum to 1 if skinned.
+			uint16_t joints[4] = { 0, 0, 0, 0 };  // Animation joint index of each weight.
 
-			bool operator==(const Vertex rhs)
+			bool operator==(const Vertex& rhs) const
 			{
 				return
 				{
@@ -97,10 +148,63 @@ namespace fbx_exporter
 					&& (color[0] == rhs.color[0] && color[1] == rhs.color[1]
 					&& color[2] == rhs.color[2] && color[3] == rhs.color[3])
 					&& (texCoord[0] == rhs.texCoord[0] && texCoord[1] == rhs.texCoord[1])
+					&& (weights[0] == rhs.weights[0] && weights[1] == rhs.weights[1]
+					&& weights[2] == rhs.weights[2] && weights[3] == rhs.weights[3])
+					&& (joints[0] == rhs.joints[0] && joints[1] == rhs.joints[1]
+					&& joints[2] == rhs.joints[2] && joints[3] == rhs.joints[3])
 				};
 			}
 		};
 
+		// Range of a mesh's indices whose vertices lie in one contiguous range.
+		struct Submesh
+		{
+			uint32_t	index_offset = 0;  // First index of the submesh.
+			uint32_t	index_count = 0;  // Number of indices in the submesh.
+			uint32_t	base_vertex = 0;  // First vertex of the submesh. Subtracted from its indices for 16-bit index buffers.
+			uint32_t	vertex_count = 0;  // Number of vertices in the submesh, starting at base_vertex.
+		};
+
+		// Range of a mesh's indices extracted from one mesh geometry of a scene and drawn with one material.
+		struct MeshPart
+		{
+			std::string	name;  // Name of the mesh geometry.
+			uint32_t	material = NO_MATERIAL;  // Index of the part's material among the scene's materials. NO_MATERIAL if it has none.
+			uint32_t	index_offset = 0;  // First index of the part.
+			uint32_t	index_count = 0;  // Number of indices in the part.
+			uint32_t	base_vertex = 0;  // Smallest vertex the part's indices use.
+			uint32_t	vertex_count = 0;  // Number of vertices from base_vertex to the largest vertex the part's indices use.
+			uint32_t	meshlet_offset = 0;  // First meshlet of the part.
+			uint32_t	meshlet_count = 0;  // Number of meshlets in the part. 0 if meshlets were not built.
+			Matrix		transform = {};  // Global transform of the geometry's node. Vertices stay in the geometry's space.
+		};
+
+		// Range of a mesh's indices drawing one level of detail.
+		struct MeshLod
+		{
+			uint32_t	index_offset = 0;  // First index of the level.
+			uint32_t	index_count = 0;  // Number of indices in the level.
+			float		error = 0.0f;  // Largest distance from the first level's surface, in mesh units. 0 for the first level.
+			uint32_t	meshlet_offset = 0;  // First meshlet of the level.
+			uint32_t	meshlet_count = 0;  // Number of meshlets in the level. 0 if meshlets were not built.
+			uint32_t	part_offset = 0;  // First part of the level.
+			uint32_t	part_count = 0;  // Number of parts in the level. 0 if the mesh has no parts.
+		};
+
+		// Small cluster of a mesh's triangles with its own local vertex list, for mesh shaders and cluster culling.
+		struct Meshlet
+		{
+			uint32_t	vertex_offset = 0;  // First entry of the meshlet in meshlet_vertices.
+			uint32_t	vertex_count = 0;  // Number of vertices in the meshlet.
+			uint32_t	triangle_offset = 0;  // First byte of the meshlet in meshlet_triangles. A multiple of 4.
+			uint32_t	triangle_count = 0;  // Number of triangles in the meshlet, three local vertex indices each.
+			float		center[3] = { 0.0f, 0.0f, 0.0f };  // Center of the bounding sphere.
+			float		radius = 0.0f;  // Radius of the bounding sphere.
+			float		cone_apex[3] = { 0.0f, 0.0f, 0.0f };  // Apex of the normal cone.
+			float		cone_axis[3] = { 0.0f, 0.0f, 0.0f };  // Average facing direction of the triangles.
+			float		cone_cutoff = 1.0f;  // The meshlet faces away when dot(normalize(cone_apex - eye), cone_axis) >= cone_cutoff. 1 if it never does.
+		};
+
 		// Mesh data container.
 		struct Mesh
 		{
@@ -108,6 +212,95 @@ namespace fbx_exporter
 			uint32_t					index_count = 0;  // Number of indices in mesh.
 			std::vector<Vertex>			vertices;  // List of vertices in mesh.
 			std::vector<uint32_t>		indices;  // List of indices in mesh.
+			std::vector<Submesh>		submeshes;  // Index ranges that fit 16-bit index buffers. Empty if the mesh was not split.
+			std::vector<MeshPart>		parts;  // Index ranges of each scene mesh and material, per level in level order. Empty if one mesh without materials was extracted.
+			std::vector<MeshLod>		lods;  // Index ranges of levels of detail, finest first. Empty if no levels were generated.
+			std::vector<Meshlet>		meshlets;  // Meshlets of every level, in level order. Empty if meshlets were not built.
+			std::vector<uint32_t>		meshlet_vertices;  // Mesh vertex of each meshlet's local vertices.
+			std::vector<uint8_t>		meshlet_triangles;  // Local vertex indices of each meshlet's triangles, padded to 4 bytes per meshlet.
+		};
+
+		// Elements and formats of a packed vertex.
+		struct VertexLayout
+		{
+			uint32_t				elements = static_cast<uint32_t>(MeshElement::ALL);  // MeshElement flags of the elements stored.
+			VertexPositionFormat	position = VertexPositionFormat::FLOAT;  // Format of positions.
+			VertexNormalFormat		normal = VertexNormalFormat::OCTAHEDRAL16;  // Format of normals.
+			VertexColorFormat		color = VertexColorFormat::UNORM8;  // Format of colors.
+			VertexTexCoordFormat	texcoord = VertexTexCoordFormat::HALF;  // Format of texture coordinates.
+			VertexSkinFormat		skin = VertexSkinFormat::UNORM8_UINT8;  // Format of skin weights and joint indices.
+		};
+
+		// Mesh with vertices packed into a compact layout.
+		struct PackedMesh
+		{
+			VertexLayout				layout;  // Elements stored and their formats.
+			uint32_t					vertex_stride = 0;  // Bytes per vertex. A multiple of 4.
+			uint32_t					position_offset = 0;  // Byte offset of the position in a vertex.
+			uint32_t					normal_offset = 0;  // Byte offset of the normal in a vertex.
+			uint32_t					color_offset = 0;  // Byte offset of the color in a vertex.
+			uint32_t					texcoord_offset = 0;  // Byte offset of the texture coordinate in a vertex.
+			uint32_t					skin_offset = 0;  // Byte offset of the skin weights in a vertex. Joint indices follow them.
+			float						position_min[3] = { 0.0f, 0.0f, 0.0f };  // Bounding box minimum. Dequantizes UNORM16 positions.
+			float						position_extent[3] = { 0.0f, 0.0f, 0.0f };  // Bounding box size. Dequantizes UNORM16 positions.
+			float						texcoord_min[2] = { 0.0f, 0.0f };  // Texture coordinate minimum. Dequantizes UNORM16 texture coordinates.
+			float						texcoord_extent[2] = { 0.0f, 0.0f };  // Texture coordinate range. Dequantizes UNORM16 texture coordinates.
+			uint32_t					vertex_count = 0;  // Number of vertices in mesh.
+			uint32_t					index_count = 0;  // Number of indices in mesh.
+			std::vector<uint8_t>		vertices;  // Packed vertices, vertex_stride bytes each.
+			std::vector<uint32_t>		indices;  // List of indices in mesh.
+			std::vector<Submesh>		submeshes;  // Index ranges that fit 16-bit index buffers. Empty if the mesh was not split.
+			std::vector<MeshPart>		parts;  // Index ranges of each scene mesh and material, per level in level order. Empty if one mesh without materials was extracted.
+			std::vector<MeshLod>		lods;  // Index ranges of levels of detail, finest first. Empty if no levels were generated.
+			std::vector<Meshlet>		meshlets;  // Meshlets of every level, in level order. Empty if meshlets were not built.
+			std::vector<uint32_t>		meshlet_vertices;  // Mesh vertex of each meshlet's local vertices.
+			std::vector<uint8_t>		meshlet_triangles;  // Local vertex indices of each meshlet's triangles, padded to 4 bytes per meshlet.
+		};
+
+		// Results of packing mesh vertices.
+		struct VertexPackingStats
+		{
+			uint32_t	source_vertex_stride = 0;  // Bytes per vertex before packing.
+			uint32_t	vertex_stride = 0;  // Bytes per vertex after packing.
+			float		max_position_error = 0.0f;  // Largest position error, in units.
+			float		max_normal_error = 0.0f;  // Largest normal direction error, in radians.
+			float		max_color_error = 0.0f;  // Largest color channel error.
+			float		max_texcoord_error = 0.0f;  // Largest texture coordinate error.
+			float		max_weight_error = 0.0f;  // Largest skin weight error.
+		};
+
+		// Results of splitting a mesh into submeshes that fit 16-bit index buffers.
+		struct IndexSplitStats
+		{
+			uint32_t	submesh_count = 0;  // Number of submeshes.
+			uint32_t	source_vertex_count = 0;  // Number of vertices before splitting.
+			uint32_t	vertex_count = 0;  // Number of vertices after splitting. Vertices shared between submeshes are copied.
+			uint64_t	source_index_bytes = 0;  // Size of the index list with 32-bit indices.
+			uint64_t	index_bytes = 0;  // Size of the index list with 16-bit indices.
+		};
+
+		// Results of splitting a mesh into meshlets.
+		struct MeshletBuildStats
+		{
+			uint32_t	meshlet_count = 0;  // Number of meshlets.
+			uint32_t	triangle_count = 0;  // Number of triangles in all meshlets.
+			uint32_t	vertex_reference_count = 0;  // Number of local vertices in all meshlets.
+			float		vertex_fill = 0.0f;  // Average vertex count over the vertex limit.
+			float		triangle_fill = 0.0f;  // Average triangle count over the triangle limit.
+		};
+
+		// Post-transform vertex cache efficiency of an index list.
+		struct VertexCacheStats
+		{
+			float	acmr = 0.0f;  // Average cache miss ratio: vertices transformed per triangle. 0.5 at best, 3 at worst.
+			float	atvr = 0.0f;  // Average transform to vertex ratio: vertices transformed per vertex. 1 at best.
+		};
+
+		// Results of reordering a mesh for GPU cache locality.
+		struct MeshOptimizationStats
+		{
+			VertexCacheStats	source;  // Cache efficiency of the mesh as extracted.
+			VertexCacheStats	optimized;  // Cache efficiency of the reordered mesh.
 		};
 
 		// Material data container.
@@ -126,7 +319,7 @@ namespace fbx_exporter
 			{
 				float	value[3] = { 0.0f, 0.0f, 0.0f };  // Color value.
 				float	factor = 0.0f;  // Texture strength factor.
-				int64_t	input = -1;  // Index of texture filepath in list.
+				int32_t	input = -1;  // Index of the texture filepath in MaterialList::textures. -1 if the component has no texture.
 			};
 
 			Component& operator[](int i) { return components[i]; }
@@ -136,11 +329,45 @@ namespace fbx_exporter
 			Component components[ComponentType::COUNT];
 		};
 
-		// Paired material list and filepath list.
+		// Texture filepath of a MaterialList, stored in the list's strings.
+		struct TexturePath
+		{
+			uint32_t	offset = 0;  // First character of the filepath in MaterialList::strings.
+			uint32_t	length = 0;  // Number of characters in the filepath.
+		};
+
+		// Materials and the texture filepaths they reference. Each filepath is stored once.
 		struct MaterialList
 		{
-			std::vector<Material>		materials;
-			std::vector<filepath_t>		filepaths;
+			std::vector<Material>		materials;  // Materials, in the scene's material order.
+			std::vector<TexturePath>	textures;  // Unique texture filepaths. Material::Component::input indexes them.
+			std::string					strings;  // Characters of every texture filepath, not null-terminated.
+		};
+
+		// Decoded image with 8-bit RGBA pixels.
+		struct Image
+		{
+			uint32_t				width = 0;  // Width in pixels.
+			uint32_t				height = 0;  // Height in pixels.
+			std::vector<uint8_t>	pixels;  // RGBA pixels in row-major order, top row first. 4 bytes per pixel.
+		};
+
+		// Block-compressed texture with one level of detail.
+		struct CompressedTexture
+		{
+			TextureFormat			format = TextureFormat::BC1;  // Layout of each block.
+			uint32_t				width = 0;  // Width in pixels.
+			uint32_t				height = 0;  // Height in pixels.
+			uint32_t				block_size = 0;  // Bytes per block: 8 for BC1, 16 otherwise.
+			std::vector<uint8_t>	blocks;  // 4x4 pixel blocks in row-major order. Edge blocks repeat the last row and column.
+		};
+
+		// Results of block-compressing a texture.
+		struct TextureCompressionStats
+		{
+			uint32_t	block_count = 0;  // Number of blocks encoded.
+			double		milliseconds = 0.0;  // Encoding time summed over every thread that encoded the texture's blocks.
+			float		psnr = 0.0f;  // Peak signal-to-noise ratio of the channels the format stores, in dB. Infinite if lossless.
 		};
 
 		// Animation joint data container.
@@ -150,18 +377,99 @@ namespace fbx_exporter
 			int		parent_index = -1;  // Index of parent joint. -1 indicates no parent.
 		};
 
-		// Animation frame data container.
+		// View of one frame of an AnimationClip. Points into the clip, and is valid while the clip is unchanged.
 		struct AnimationFrame
 		{
 			double						time;  // Trigger time for frame.
-			std::vector<Matrix>			transforms;  // List of joint transformations.
+			const Matrix*				transforms_p;  // Joint transformations, one per clip joint.
 		};
 
 		// Animation clip data container.
 		struct AnimationClip
 		{
+			std::string					name;  // Name of the animation stack the clip was sampled from.
 			double						duration;  // Animation length in seconds.
-			std::vector<AnimationFrame>	frames;  // List of keyframes.
+			bool						local_space = false;  // Whether frame transforms are parent-relative.
+			uint64_t					skeleton_hash = 0;  // Hash of joints. Clips with equal hashes share a skeleton.
+			std::vector<AnimationJoint>	joints;  // Bind pose joints. Parents precede their children.
+			std::vector<double>			frame_times;  // Trigger time of each keyframe.
+			std::vector<Matrix>			transforms;  // Joint transformations of every keyframe, frame by frame: frame_times.size() x joints.size().
+
+			uint32_t GetFrameCount() const { return (uint32_t)frame_times.size(); }
+			AnimationFrame GetFrame(uint32_t i) const { return { frame_times[i], transforms.data() + (size_t)i * joints.size() }; }
+		};
+
+		// Keys of one joint channel. Values between keys are linearly interpolated.
+		struct AnimationTrack
+		{
+			std::vector<float>			times;  // Key times in seconds.
+			std::vector<float>			values;  // Key values, packed per key.
+		};
+
+		// Parent-relative channels of one joint.
+		struct AnimationJointTracks
+		{
+			AnimationTrack				translation;  // Position vector. 3 values per key.
+			AnimationTrack				rotation;  // Unit quaternion as xyzw. 4 values per key.
+			AnimationTrack				scale;  // Scale vector. 3 values per key.
+		};
+
+		// Animation clip data container storing only the keys needed to stay within a tolerance.
+		struct SparseAnimationClip
+		{
+			double								duration;  // Animation length in seconds.
+			std::vector<AnimationJoint>			joints;  // Bind pose joints. Parents precede their children.
+			std::vector<AnimationJointTracks>	tracks;  // Channel keys per joint.
+		};
+
+		// Vector channel with values range-quantized to 16 bits per component.
+		struct QuantizedVectorTrack
+		{
+			float						min[3] = { 0.0f, 0.0f, 0.0f };  // Smallest value, or the value of a constant channel.
+			float						extent[3] = { 0.0f, 0.0f, 0.0f };  // Largest value minus smallest value.
+			std::vector<uint16_t>		times;  // Key times as a fraction of clip duration, scaled to 65535. Empty if constant.
+			std::vector<uint16_t>		values;  // Key values as fractions of extent, scaled to 65535. 3 per key.
+		};
+
+		// Rotation channel with smallest-three quaternions packed into 48 bits per key.
+		struct QuantizedRotationTrack
+		{
+			std::vector<uint16_t>		times;  // Key times as a fraction of clip duration, scaled to 65535.
+			std::vector<uint16_t>		values;  // Packed quaternions, most significant word first. 3 per key.
+		};
+
+		// Quantized parent-relative channels of one joint.
+		struct QuantizedJointTracks
+		{
+			QuantizedVectorTrack		translation;  // Position vector.
+			QuantizedRotationTrack		rotation;  // Unit quaternion.
+			QuantizedVectorTrack		scale;  // Scale vector.
+		};
+
+		// Compact variant of SparseAnimationClip for storage.
+		struct QuantizedAnimationClip
+		{
+			double								duration;  // Animation length in seconds.
+			std::vector<AnimationJoint>			joints;  // Bind pose joints. Parents precede their children.
+			std::vector<QuantizedJointTracks>	tracks;  // Quantized channel keys per joint.
+		};
+
+		// Maximum errors allowed when removing animation keys, measured in model space at leaf joints.
+		struct AnimationTolerance
+		{
+			float	translation = 0.01f;  // Position error in scene units.
+			float	rotation = 0.001f;  // Rotation error in radians.
+			float	scale = 0.001f;  // Scale error per axis.
+		};
+
+		// Results of removing keys from an animation clip.
+		struct AnimationReductionStats
+		{
+			uint32_t	source_key_count = 0;  // Number of channel keys before reduction.
+			uint32_t	key_count = 0;  // Number of channel keys after reduction.
+			float		max_translation_error = 0.0f;  // Largest position error at a leaf joint.
+			float		max_rotation_error = 0.0f;  // Largest rotation error at a leaf joint, in radians.
+			float		max_scale_error = 0.0f;  // Largest scale error at a leaf joint.
 		};
 
 	}
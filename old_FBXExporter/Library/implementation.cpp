@@ -1,6 +1,11 @@
 #include "interface.h"
+#include "parallel.h"
+#include "simd.h"
 #include "utility.h"
+#include "weld.h"
 
+#include <algorithm>
+#include <cstddef>
 #include <cstring>
 #include <iostream>
 
@@ -29,8 +34,8 @@ namespace fbx_exporter
 				if (fbx_geometry_p->GetAttributeType() == FbxNodeAttribute::eMesh)
 					// keep first mesh with a matching name,
 					// or keep first mesh in scene if no name is specified
-					if ((_in_meshName != nullptr && fbx_geometry_p->GetName() == _in_meshName)
-						|| _in_meshName == nullptr)
+					if (_in_meshName == nullptr || _in_meshName[0] == '\0'
+						|| strcmp(fbx_geometry_p->GetName(), _in_meshName) == 0)
 					{
 						_out_fbxMesh_p = (FbxMesh*)fbx_geometry_p;
 						break;
@@ -44,119 +49,331 @@ namespace fbx_exporter
 			return ret_result;
 		}
 
-		void GetPositionFromFbxControlPoint(
-			const FbxVector4*			_in_fbxControlPoints_p
-			, const int					_in_controlPointIndex
-			, Vertex&					_out_vertex
+		// Number of polygon vertices GetVerticesFromFbxMesh resolves before converting them to floats.
+		const int VERTEX_CHUNK_SIZE = 1024;
+
+		// Number of floats a Vertex spans. Vertices are filled as arrays of floats; the joint
+		// indices at the end come out zero and are set from the skin influences afterwards.
+		const uint32_t VERTEX_FLOAT_COUNT = sizeof(Vertex) / sizeof(float);
+		static_assert(sizeof(Vertex) % sizeof(float) == 0, "Vertex must span a whole number of floats");
+
+		// Layer element of a mesh, locked for reading, with its mapping and reference modes read once.
+		struct FbxLayerStream
+		{
+			FbxLayerElementArray*			direct_array_p = nullptr;  // Array of element values. nullptr if nothing is locked.
+			FbxLayerElementArray*			index_array_p = nullptr;  // Array of indices into the values. nullptr for direct reference.
+			const double*					direct_p = nullptr;  // Element values. Each is stride doubles.
+			const int*						index_p = nullptr;  // Indices into the values. nullptr for direct reference.
+			int								direct_count = 0;  // Number of element values.
+			int								index_count = 0;  // Number of indices.
+			uint32_t						stride = 0;  // Doubles from one element value to the next.
+			FbxLayerElement::EMappingMode	mapping_mode = FbxLayerElement::EMappingMode::eByPolygonVertex;  // What values are indexed by.
+		};
+
+		template <typename T>
+		bool OpenFbxLayerStream(
+			FbxLayerElementTemplate<T>*	_in_fbxElement_p
+			, FbxLayerStream&			_out_stream
 		) {
-			FbxVector4 pos = _in_fbxControlPoints_p[_in_controlPointIndex];
-			_out_vertex.pos[0] = (float)pos[0];
-			_out_vertex.pos[1] = (float)pos[1];
-			_out_vertex.pos[2] = (float)pos[2];
+			// verify element exists
+			if (_in_fbxElement_p == nullptr)
+				return false;
+
+			// FbxVector4, FbxVector2, and FbxColor store their components as consecutive doubles
+			FbxLayerElementArrayTemplate<T>& fbx_directArray = _in_fbxElement_p->GetDirectArray();
+			_out_stream.direct_p = (const double*)fbx_directArray.GetLocked((T*)nullptr, FbxLayerElementArray::eReadLock);
+			_out_stream.direct_array_p = _out_stream.direct_p != nullptr ? &fbx_directArray : nullptr;
+			_out_stream.direct_count = fbx_directArray.GetCount();
+			_out_stream.stride = sizeof(T) / sizeof(double);
+			_out_stream.mapping_mode = _in_fbxElement_p->GetMappingMode();
+
+			if (_in_fbxElement_p->GetReferenceMode() == FbxLayerElement::EReferenceMode::eIndexToDirect)
+			{
+				FbxLayerElementArrayTemplate<int>& fbx_indexArray = _in_fbxElement_p->GetIndexArray();
+				_out_stream.index_p = fbx_indexArray.GetLocked((int*)nullptr, FbxLayerElementArray::eReadLock);
+				_out_stream.index_array_p = _out_stream.index_p != nullptr ? &fbx_indexArray : nullptr;
+				_out_stream.index_count = fbx_indexArray.GetCount();
+
+				if (_out_stream.index_p == nullptr)
+					_out_stream.direct_p = nullptr;
+			}
+
+			return _out_stream.direct_p != nullptr;
 		}
-		void GetNormalFromFbxControlPoint(
-			const FbxMesh*				_in_fbxMesh_p
-			, const int					_in_polygonVertexIndex
-			, const int					_in_polygonVertex
-			, Vertex&					_out_vertex
-		) {
-			FbxGeometryElementNormal* fbx_normalElement_p =
-				((FbxMesh*)_in_fbxMesh_p)->GetElementNormal();
 
-			// verify normal element exists
-			if (fbx_normalElement_p != nullptr)
+		void CloseFbxLayerStream(FbxLayerStream& _out_stream)
+		{
+			if (_out_stream.direct_array_p != nullptr)
 			{
-				// determine normal index
-				int normalIndex = _in_polygonVertexIndex;
-				if (fbx_normalElement_p->GetMappingMode() == FbxLayerElement::EMappingMode::eByControlPoint)
-					normalIndex = _in_polygonVertex;
-				if (fbx_normalElement_p->GetReferenceMode() == FbxLayerElement::EReferenceMode::eIndexToDirect)
-					normalIndex = fbx_normalElement_p->GetIndexArray()[normalIndex];
-
-				FbxVector4 norm = fbx_normalElement_p->GetDirectArray()[normalIndex];
-				_out_vertex.norm[0] = (float)norm[0];
-				_out_vertex.norm[1] = (float)norm[1];
-				_out_vertex.norm[2] = (float)norm[2];
+				void* direct_p = (void*)_out_stream.direct_p;
+				_out_stream.direct_array_p->Release(&direct_p);
 			}
+			if (_out_stream.index_array_p != nullptr)
+			{
+				void* index_p = (void*)_out_stream.index_p;
+				_out_stream.index_array_p->Release(&index_p);
+			}
+
+			_out_stream = FbxLayerStream();
 		}
-		void GetColorFromFbxControlPoint(
-			const FbxMesh*				_in_fbxMesh_p
-			, const int					_in_polygonVertexIndex
-			, const int					_in_polygonVertex
-			, Vertex&					_out_vertex
-		) {
-			FbxGeometryElementVertexColor* fbx_colorElement_p =
-				((FbxMesh*)_in_fbxMesh_p)->GetElementVertexColor();
 
-			// verify color element exists
-			if (fbx_colorElement_p != nullptr)
+		void ResolveFbxLayerStream(
+			const FbxLayerStream&		_in_stream
+			, const int*				_in_polygonVertices_p
+			, const int					_in_firstPolygonVertexIndex
+			, const int					_in_polygonVertexIndexCount
+			, const uint32_t			_in_componentCount
+			, const uint32_t			_in_componentOffset
+			, double*					_out_vertices_p
+		) {
+			for (int i = 0; i < _in_polygonVertexIndexCount; i++)
 			{
-				// determine color index
-				int colorIndex = _in_polygonVertexIndex;
-				if (fbx_colorElement_p->GetMappingMode() == FbxLayerElement::EMappingMode::eByControlPoint)
-					colorIndex = _in_polygonVertex;
-				if (fbx_colorElement_p->GetReferenceMode() == FbxLayerElement::EReferenceMode::eIndexToDirect)
-					colorIndex = fbx_colorElement_p->GetIndexArray()[colorIndex];
-
-				FbxColor color = fbx_colorElement_p->GetDirectArray()[colorIndex];
-				_out_vertex.color[0] = (float)color[0];
-				_out_vertex.color[1] = (float)color[1];
-				_out_vertex.color[2] = (float)color[2];
-				_out_vertex.color[3] = (float)color[3];
+				// position of vertex's index in index list
+				int polygonVertexIndex = _in_firstPolygonVertexIndex + i;
+
+				// determine element index
+				int elementIndex = polygonVertexIndex;
+				switch (_in_stream.mapping_mode)
+				{
+				case FbxLayerElement::EMappingMode::eByControlPoint:
+					elementIndex = _in_polygonVertices_p[polygonVertexIndex];
+					break;
+				case FbxLayerElement::EMappingMode::eByPolygon:
+					elementIndex = polygonVertexIndex / 3;
+					break;
+				case FbxLayerElement::EMappingMode::eAllSame:
+					elementIndex = 0;
+					break;
+				default:
+					break;
+				}
+				if (_in_stream.index_p != nullptr)
+					elementIndex = elementIndex < _in_stream.index_count ? _in_stream.index_p[elementIndex] : -1;
+
+				double* vertex_p = _out_vertices_p + (size_t)i * VERTEX_FLOAT_COUNT + _in_componentOffset;
+
+				// leave elements without a value zeroed
+				if (elementIndex < 0 || elementIndex >= _in_stream.direct_count)
+				{
+					for (uint32_t c = 0; c < _in_componentCount; c++)
+						vertex_p[c] = 0.0;
+					continue;
+				}
+
+				const double* value_p = _in_stream.direct_p + (size_t)elementIndex * _in_stream.stride;
+				for (uint32_t c = 0; c < _in_componentCount; c++)
+					vertex_p[c] = value_p[c];
 			}
 		}
-		void GetTexCoordFromFbxControlPoint(
+
+		// Strongest joint influences on one control point, largest weight first.
+		struct SkinInfluences
+		{
+			float		weights[4] = { 0.0f, 0.0f, 0.0f, 0.0f };  // Weights of the influences. 0 in unused slots.
+			uint16_t	joints[4] = { 0, 0, 0, 0 };  // Animation joint index of each influence.
+		};
+
+		bool GetSkinInfluencesFromFbxMesh(
 			const FbxMesh*				_in_fbxMesh_p
-			, const int					_in_polygonVertexIndex
-			, const int					_in_polygonVertex
-			, Vertex&					_out_vertex
+			, const std::vector<AnimationJointFbx>&	_in_jointsFbx
+			, std::vector<SkinInfluences>&	_out_influences
 		) {
-			FbxGeometryElementUV* fbx_uvElement_p = ((FbxMesh*)_in_fbxMesh_p)->GetElementUV();
+			FbxMesh* fbxMesh_p = (FbxMesh*)_in_fbxMesh_p;
+			int controlPointCount = fbxMesh_p->GetControlPointsCount();
+			bool hasInfluence = false;
+
+			_out_influences.assign(controlPointCount, SkinInfluences());
 
-			// verify UV element exists
-			if (fbx_uvElement_p != nullptr)
+			// -- invert clusters --
+			// each cluster lists the control points one joint moves. Weights are inserted into their
+			// control point's sorted slots as the lists are walked, so the lists are inverted in one
+			// pass and the weakest influences fall off the end
+			for (int d = 0; d < fbxMesh_p->GetDeformerCount(FbxDeformer::eSkin); d++)
 			{
-				// determine texture coordinate index
-				int texCoordIndex = _in_polygonVertexIndex;
-				if (fbx_uvElement_p->GetMappingMode() == FbxLayerElement::EMappingMode::eByControlPoint)
-					texCoordIndex = _in_polygonVertex;
-				if (fbx_uvElement_p->GetReferenceMode() == FbxLayerElement::EReferenceMode::eIndexToDirect)
-					texCoordIndex = fbx_uvElement_p->GetIndexArray()[texCoordIndex];
-
-				FbxVector2 texCoord = fbx_uvElement_p->GetDirectArray()[texCoordIndex];
-				_out_vertex.texCoord[0] = (float)texCoord[0];
-				_out_vertex.texCoord[1] = (float)(1.0f - texCoord[1]);
+				FbxSkin* fbxSkin_p = (FbxSkin*)fbxMesh_p->GetDeformer(d, FbxDeformer::eSkin);
+
+				for (int c = 0; c < fbxSkin_p->GetClusterCount(); c++)
+				{
+					FbxCluster* fbxCluster_p = fbxSkin_p->GetCluster(c);
+
+					// clusters linked to nodes outside the skeleton cannot be animated, and
+					// joints past the 16-bit range cannot be indexed by a vertex
+					int joint = -1;
+					for (size_t j = 0; j < _in_jointsFbx.size() && j <= UINT16_MAX && joint < 0; j++)
+						if (_in_jointsFbx[j].fbx_node_p == fbxCluster_p->GetLink())
+							joint = (int)j;
+					if (joint < 0)
+						continue;
+
+					const int* controlPoints_p = fbxCluster_p->GetControlPointIndices();
+					const double* weights_p = fbxCluster_p->GetControlPointWeights();
+					if (controlPoints_p == nullptr || weights_p == nullptr)
+						continue;
+
+					for (int i = 0; i < fbxCluster_p->GetControlPointIndicesCount(); i++)
+					{
+						int controlPoint = controlPoints_p[i];
+						float weight = (float)weights_p[i];
+						if (controlPoint < 0 || controlPoint >= controlPointCount || !(weight > 0.0f))
+							continue;
+
+						SkinInfluences& influences = _out_influences[controlPoint];
+
+						int slot = 4;
+						while (slot > 0 && influences.weights[slot - 1] < weight)
+							slot--;
+						if (slot == 4)
+							continue;
+
+						for (int k = 3; k > slot; k--)
+						{
+							influences.weights[k] = influences.weights[k - 1];
+							influences.joints[k] = influences.joints[k - 1];
+						}
+						influences.weights[slot] = weight;
+						influences.joints[slot] = (uint16_t)joint;
+						hasInfluence = true;
+					}
+				}
+			}
+			// -- /invert clusters --
+
+			// renormalize so the influences dropped do not pull vertices toward the origin
+			for (SkinInfluences& influences : _out_influences)
+			{
+				float sum = influences.weights[0] + influences.weights[1] + influences.weights[2] + influences.weights[3];
+				if (sum > 0.0f)
+					for (int k = 0; k < 4; k++)
+						influences.weights[k] /= sum;
 			}
+
+			return hasInfluence;
 		}
 
-		void GetElementsFromFbxControlPoint(
-			const FbxVector4*			_in_fbxControlPoints_p
-			, const FbxMesh*			_in_fbxMesh_p
-			, const int					_in_polygonVertexIndex
-			, const int					_in_polygonVertex
+		// Vertex elements of a mesh, locked for reading so polygon vertices can be resolved a range at a time.
+		struct FbxVertexStream
+		{
+			const int*					polygon_vertices_p = nullptr;  // Control point of each polygon vertex.
+			int							polygon_vertex_count = 0;  // Number of polygon vertices, three per triangle.
+			FbxLayerStream				position;  // Control point positions. Nothing is locked for them.
+			FbxLayerStream				normal;  // Normal layer.
+			FbxLayerStream				color;  // Vertex color layer.
+			FbxLayerStream				texcoord;  // UV layer.
+			std::vector<SkinInfluences>	influences;  // Skin influences per control point. Empty without skin weights.
+			bool						has_position = false;  // Whether positions are resolved.
+			bool						has_normal = false;  // Whether normals are resolved.
+			bool						has_color = false;  // Whether colors are resolved.
+			bool						has_texcoord = false;  // Whether texture coordinates are resolved.
+		};
+
+		void OpenFbxVertexStream(
+			const FbxMesh*				_in_fbxMesh_p
 			, const uint32_t			_in_elementsToExtract
-			, Vertex&					_out_vertex
+			, const std::vector<AnimationJointFbx>&	_in_jointsFbx
+			, FbxVertexStream&			_out_stream
 		) {
+			FbxMesh* fbxMesh_p = (FbxMesh*)_in_fbxMesh_p;
+
+			// array of FBX polygon vertices (equivalent to vertex indices)
+			_out_stream.polygon_vertices_p = fbxMesh_p->GetPolygonVertices();
+			_out_stream.polygon_vertex_count = fbxMesh_p->GetPolygonCount() * 3;
+
+			// each requested layer is looked up and locked once, rather than once per vertex.
+			// FBX control points (equivalent to vertices) are a stream indexed by polygon vertex
 			if (_in_elementsToExtract & static_cast<int>(MeshElement::POSITION))
-				GetPositionFromFbxControlPoint(_in_fbxControlPoints_p, _in_polygonVertex,
-					_out_vertex);
+			{
+				_out_stream.position.direct_p = (const double*)fbxMesh_p->GetControlPoints();
+				_out_stream.position.direct_count = fbxMesh_p->GetControlPointsCount();
+				_out_stream.position.stride = sizeof(FbxVector4) / sizeof(double);
+				_out_stream.position.mapping_mode = FbxLayerElement::EMappingMode::eByControlPoint;
+				_out_stream.has_position = _out_stream.position.direct_p != nullptr;
+			}
+
+			_out_stream.has_normal = (_in_elementsToExtract & static_cast<int>(MeshElement::NORMAL))
+				&& OpenFbxLayerStream(fbxMesh_p->GetElementNormal(), _out_stream.normal);
+			_out_stream.has_color = (_in_elementsToExtract & static_cast<int>(MeshElement::COLOR))
+				&& OpenFbxLayerStream(fbxMesh_p->GetElementVertexColor(), _out_stream.color);
+			_out_stream.has_texcoord = (_in_elementsToExtract & static_cast<int>(MeshElement::TEXCOORD))
+				&& OpenFbxLayerStream(fbxMesh_p->GetElementUV(), _out_stream.texcoord);
+
+			// skin weights are stored per control point
+			if (!(_in_elementsToExtract & static_cast<int>(MeshElement::SKIN))
+				|| !GetSkinInfluencesFromFbxMesh(fbxMesh_p, _in_jointsFbx, _out_stream.influences))
+				_out_stream.influences.clear();
+		}
+
+		void CloseFbxVertexStream(FbxVertexStream& _out_stream)
+		{
+			CloseFbxLayerStream(_out_stream.normal);
+			CloseFbxLayerStream(_out_stream.color);
+			CloseFbxLayerStream(_out_stream.texcoord);
+
+			_out_stream = FbxVertexStream();
+		}
+
+		/* Resolves a range of polygon vertices into vertices.
+		  PARAMETERS
+			_in_stream : The open vertex stream of the mesh.
+			_in_firstPolygonVertexIndex : The first polygon vertex to resolve.
+			_in_polygonVertexIndexCount : The number of polygon vertices to resolve. At most VERTEX_CHUNK_SIZE.
+			_out_chunk_p : Scratch space of VERTEX_CHUNK_SIZE * VERTEX_FLOAT_COUNT doubles, zeroed before the first call.
+			_out_vertices_p : The vertices resolved, one per polygon vertex.
+		*/
+		void ResolveFbxVertexStream(
+			const FbxVertexStream&		_in_stream
+			, const int					_in_firstPolygonVertexIndex
+			, const int					_in_polygonVertexIndexCount
+			, double*					_out_chunk_p
+			, Vertex*					_out_vertices_p
+		) {
+			const uint32_t positionOffset = (uint32_t)(offsetof(Vertex, pos) / sizeof(float));
+			const uint32_t normalOffset = (uint32_t)(offsetof(Vertex, norm) / sizeof(float));
+			const uint32_t colorOffset = (uint32_t)(offsetof(Vertex, color) / sizeof(float));
+			const uint32_t texCoordOffset = (uint32_t)(offsetof(Vertex, texCoord) / sizeof(float));
+
+			const int* polygonVertices_p = _in_stream.polygon_vertices_p;
+			int first = _in_firstPolygonVertexIndex;
+			int count = _in_polygonVertexIndexCount;
+
+			// vertices are resolved as doubles, then converted to floats in one pass.
+			// elements not extracted stay zeroed, as in a default Vertex
+			if (_in_stream.has_position)
+				ResolveFbxLayerStream(_in_stream.position, polygonVertices_p, first, count, 3, positionOffset, _out_chunk_p);
+			if (_in_stream.has_normal)
+				ResolveFbxLayerStream(_in_stream.normal, polygonVertices_p, first, count, 3, normalOffset, _out_chunk_p);
+			if (_in_stream.has_color)
+				ResolveFbxLayerStream(_in_stream.color, polygonVertices_p, first, count, 4, colorOffset, _out_chunk_p);
+			if (_in_stream.has_texcoord)
+			{
+				ResolveFbxLayerStream(_in_stream.texcoord, polygonVertices_p, first, count, 2, texCoordOffset, _out_chunk_p);
+
+				// flip V from FBX's bottom-left origin to a top-left origin
+				for (int i = 0; i < count; i++)
+				{
+					double& v = _out_chunk_p[(size_t)i * VERTEX_FLOAT_COUNT + texCoordOffset + 1];
+					v = 1.0 - v;
+				}
+			}
 
-			if (_in_elementsToExtract & static_cast<int>(MeshElement::NORMAL))
-				GetNormalFromFbxControlPoint((FbxMesh*)_in_fbxMesh_p, _in_polygonVertexIndex,
-					_in_polygonVertex, _out_vertex);
+			ConvertDoublesToFloats(_out_chunk_p, (size_t)count * VERTEX_FLOAT_COUNT, (float*)_out_vertices_p);
 
-			if (_in_elementsToExtract & static_cast<int>(MeshElement::COLOR))
-				GetColorFromFbxControlPoint((FbxMesh*)_in_fbxMesh_p, _in_polygonVertexIndex,
-					_in_polygonVertex, _out_vertex);
+			if (!_in_stream.influences.empty())
+				for (int i = 0; i < count; i++)
+				{
+					int controlPoint = polygonVertices_p[first + i];
+					if (controlPoint < 0 || controlPoint >= (int)_in_stream.influences.size())
+						continue;
 
-			if (_in_elementsToExtract & static_cast<int>(MeshElement::TEXCOORD))
-				GetTexCoordFromFbxControlPoint((FbxMesh*)_in_fbxMesh_p, _in_polygonVertexIndex,
-					_in_polygonVertex, _out_vertex);
+					Vertex& vertex = _out_vertices_p[i];
+					memcpy(vertex.weights, _in_stream.influences[controlPoint].weights, sizeof(vertex.weights));
+					memcpy(vertex.joints, _in_stream.influences[controlPoint].joints, sizeof(vertex.joints));
+				}
 		}
 
 		Result GetVerticesFromFbxMesh(
 			const FbxMesh*				_in_fbxMesh_p
 			, const uint32_t			_in_elementsToExtract
+			, const std::vector<AnimationJointFbx>&	_in_jointsFbx
 			, std::vector<Vertex>&		_out_vertices
 		) {
 			Result ret_result = Result::FAIL;
@@ -164,83 +381,355 @@ namespace fbx_exporter
 			// verify that fbx mesh is initialized
 			if (_in_fbxMesh_p != nullptr)
 			{
-				int polygonCount = _in_fbxMesh_p->GetPolygonCount();
+				FbxVertexStream stream;
+				OpenFbxVertexStream(_in_fbxMesh_p, _in_elementsToExtract, _in_jointsFbx, stream);
 
-				// array of FBX polygon vertices (equivalent to vertex indices)
-				int* polygonVertices_p = _in_fbxMesh_p->GetPolygonVertices();
+				// -- fill vertices --
+				size_t firstVertex = _out_vertices.size();
+				_out_vertices.resize(firstVertex + stream.polygon_vertex_count);
 
-				// array of FBX control points (equivalent to vertices)
-				const FbxVector4* fbx_controlPoints_p = _in_fbxMesh_p->GetControlPoints();
+				std::vector<double> chunk((size_t)VERTEX_CHUNK_SIZE * VERTEX_FLOAT_COUNT, 0.0);
+				for (int first = 0; first < stream.polygon_vertex_count; first += VERTEX_CHUNK_SIZE)
+					ResolveFbxVertexStream(stream, first, std::min(VERTEX_CHUNK_SIZE, stream.polygon_vertex_count - first),
+						chunk.data(), &_out_vertices[firstVertex + first]);
+				// -- /fill vertices --
 
+				CloseFbxVertexStream(stream);
 
-				// for each polygon in mesh
-				for (int i = 0; i < polygonCount; i++)
-				{
-					// for each vertex in polygon
-					for (int v = 0; v < 3; v++)
-					{
-						Vertex vertex;
+				// verify vertices were extracted from mesh
+				if (_out_vertices.size() > 0)
+					ret_result = Result::SUCCESS;
+			}
 
-						// position of vertex's index in index list
-						int polygonVertexIndex = i * 3 + v;
+			return ret_result;
+		}
 
-						// vertex's index from index list
-						int polygonVertex = polygonVertices_p[polygonVertexIndex];
+		// Material layer of a mesh, locked for reading so polygon materials can be looked up one at a time.
+		struct FbxMaterialStream
+		{
+			FbxLayerElementArray*			index_array_p = nullptr;  // Array of node material slots. nullptr if nothing is locked.
+			const int*						index_p = nullptr;  // Node material slot per polygon, or one for the whole mesh.
+			int								index_count = 0;  // Number of slots in index_p.
+			FbxLayerElement::EMappingMode	mapping_mode = FbxLayerElement::EMappingMode::eAllSame;  // What slots are indexed by.
+			std::vector<uint32_t>			slot_materials;  // Index among the scene's materials per node material slot.
+		};
+
+		void OpenFbxMaterialStream(
+			const FbxScene*				_in_fbxScene_p
+			, const FbxMesh*			_in_fbxMesh_p
+			, FbxMaterialStream&		_out_stream
+		) {
+			FbxScene* fbxScene_p = (FbxScene*)_in_fbxScene_p;
+			FbxMesh* fbxMesh_p = (FbxMesh*)_in_fbxMesh_p;
 
-						GetElementsFromFbxControlPoint(fbx_controlPoints_p, _in_fbxMesh_p, polygonVertexIndex, polygonVertex, _in_elementsToExtract, vertex);
-						_out_vertices.push_back(vertex);
+			// material layer indices select among the materials of the mesh's node
+			FbxGeometryElementMaterial* fbxElement_p = fbxMesh_p->GetElementMaterial();
+			FbxNode* fbxNode_p = fbxMesh_p->GetNode();
+			if (fbxElement_p == nullptr || fbxNode_p == nullptr)
+				return;
+
+			// map each node material to its index among the scene's materials
+			_out_stream.slot_materials.assign(fbxNode_p->GetMaterialCount(), NO_MATERIAL);
+			for (int slot = 0; slot < (int)_out_stream.slot_materials.size(); slot++)
+			{
+				FbxSurfaceMaterial* fbxMaterial_p = fbxNode_p->GetMaterial(slot);
+				for (int m = 0; m < fbxScene_p->GetMaterialCount(); m++)
+					if (fbxScene_p->GetMaterial(m) == fbxMaterial_p)
+					{
+						_out_stream.slot_materials[slot] = (uint32_t)m;
+						break;
 					}
-				}
+			}
 
-				// verify vertices were extracted from mesh
-				if (_out_vertices.size() > 0)
-					ret_result = Result::SUCCESS;
+			FbxLayerElementArrayTemplate<int>& fbx_indexArray = fbxElement_p->GetIndexArray();
+			_out_stream.index_p = fbx_indexArray.GetLocked((int*)nullptr, FbxLayerElementArray::eReadLock);
+			_out_stream.index_array_p = _out_stream.index_p != nullptr ? &fbx_indexArray : nullptr;
+			_out_stream.index_count = fbx_indexArray.GetCount();
+			_out_stream.mapping_mode = fbxElement_p->GetMappingMode();
+		}
+
+		void CloseFbxMaterialStream(FbxMaterialStream& _out_stream)
+		{
+			if (_out_stream.index_array_p != nullptr)
+			{
+				void* index_p = (void*)_out_stream.index_p;
+				_out_stream.index_array_p->Release(&index_p);
 			}
 
-			return ret_result;
+			_out_stream = FbxMaterialStream();
+		}
+
+		uint32_t GetFbxMaterialStreamPolygon(
+			const FbxMaterialStream&	_in_stream
+			, const int					_in_polygonIndex
+		) {
+			if (_in_stream.index_p == nullptr)
+				return NO_MATERIAL;
+
+			// one index for the whole mesh, or one per polygon
+			int i = _in_stream.mapping_mode == FbxLayerElement::EMappingMode::eAllSame ? 0
+				: _in_stream.mapping_mode == FbxLayerElement::EMappingMode::eByPolygon ? _in_polygonIndex : -1;
+			if (i < 0 || i >= _in_stream.index_count)
+				return NO_MATERIAL;
+
+			int slot = _in_stream.index_p[i];
+			if (slot < 0 || slot >= (int)_in_stream.slot_materials.size())
+				return NO_MATERIAL;
+
+			return _in_stream.slot_materials[slot];
 		}
 
-		Result CompactifyVertices(
-			const std::vector<Vertex>&	_in_vertices
+		void GetPolygonMaterialsFromFbxMesh(
+			const FbxScene*				_in_fbxScene_p
+			, const FbxMesh*			_in_fbxMesh_p
+			, std::vector<uint32_t>&	_out_materials
+		) {
+			FbxMaterialStream stream;
+			OpenFbxMaterialStream(_in_fbxScene_p, _in_fbxMesh_p, stream);
+
+			int polygonCount = ((FbxMesh*)_in_fbxMesh_p)->GetPolygonCount();
+			_out_materials.resize(polygonCount);
+			for (int p = 0; p < polygonCount; p++)
+				_out_materials[p] = GetFbxMaterialStreamPolygon(stream, p);
+
+			CloseFbxMaterialStream(stream);
+		}
+
+		void GetMaterialComponentFromFbxProperty(
+			const FbxPropertyT<FbxDouble3>&	_in_fbxColor
+			, const double				_in_factor
+			, MaterialList&				_out_materialList
+			, Material::Component&		_out_component
+		) {
+			FbxDouble3 color = _in_fbxColor.Get();
+
+			_out_component.value[0] = (float)color[0];
+			_out_component.value[1] = (float)color[1];
+			_out_component.value[2] = (float)color[2];
+			_out_component.factor = (float)_in_factor;
+
+			// components sharing a texture share its filepath
+			FbxFileTexture* fbx_fileTexture_p = _in_fbxColor.GetSrcObject<FbxFileTexture>();
+			if (fbx_fileTexture_p != nullptr)
+			{
+				const char* textureFilepath = fbx_fileTexture_p->GetRelativeFileName();
+				_out_component.input = InternTexturePath(textureFilepath, (uint32_t)strlen(textureFilepath),
+					_out_materialList);
+			}
+		}
+
+		void ConvertFbxAMatrixToDoubles(
+			const FbxAMatrix&			_in_fbxMatrix
+			, double*					_out_values_p
+		) {
+			for (int r = 0; r < 4; r++)
+				for (int c = 0; c < 4; c++)
+					_out_values_p[r * 4 + c] = _in_fbxMatrix.Get(r, c);
+		}
+
+		Matrix ConvertDoublesToMatrix(const double* _in_values_p)
+		{
+			Matrix matrix;
+			for (int i = 0; i < 16; i++)
+				matrix.values[i] = (float)_in_values_p[i];
+
+			return matrix;
+		}
+		void GetSkinJointsFromFbxScene(
+			const FbxScene*				_in_fbxScene_p
+			, const uint32_t			_in_elementsToExtract
+			, std::vector<AnimationJointFbx>&	_out_jointsFbx
+		) {
+			_out_jointsFbx.clear();
+			if ((_in_elementsToExtract & static_cast<int>(MeshElement::SKIN)) == 0)
+				return;
+
+			// skin weights index joints in the order extracted animations store them.
+			// a scene without a bind pose has no joints, and its meshes get no weights
+			std::vector<AnimationJoint> joints;
+			if (!Succeeded(GetAnimationJointsFromFbxScene(_in_fbxScene_p, _out_jointsFbx, joints)))
+				_out_jointsFbx.clear();
+		}
+
+		Result GetPartsFromFbxMesh(
+			const FbxScene*				_in_fbxScene_p
+			, const FbxMesh*			_in_fbxMesh_p
+			, const uint32_t			_in_elementsToExtract
+			, const std::vector<AnimationJointFbx>&	_in_jointsFbx
 			, std::vector<Vertex>&		_out_vertices
 			, std::vector<uint32_t>&	_out_indices
+			, std::vector<MeshPart>&	_out_parts
 		) {
 			Result ret_result = Result::FAIL;
 
-			// for all raw vertices
-			for (uint32_t i = 0; i < _in_vertices.size(); i++)
+			FbxMesh* fbxMesh_p = (FbxMesh*)_in_fbxMesh_p;
+
+			std::vector<Vertex> rawVertices;
+			ret_result = GetVerticesFromFbxMesh(fbxMesh_p, _in_elementsToExtract, _in_jointsFbx, rawVertices);
+			if (!Succeeded(ret_result))
+				return ret_result;
+
+			std::vector<uint32_t> polygonMaterials;
+			GetPolygonMaterialsFromFbxMesh(_in_fbxScene_p, fbxMesh_p, polygonMaterials);
+
+			// stable sort keeps each material's triangles in the order they were authored
+			std::vector<uint32_t> triangles(polygonMaterials.size());
+			for (uint32_t t = 0; t < (uint32_t)triangles.size(); t++)
+				triangles[t] = t;
+			std::stable_sort(triangles.begin(), triangles.end(),
+				[&polygonMaterials](uint32_t a, uint32_t b) { return polygonMaterials[a] < polygonMaterials[b]; });
+
+			// a geometry instanced by several nodes takes the transform of the first
+			FbxNode* fbxNode_p = fbxMesh_p->GetNode();
+			Matrix transform = ConvertFbxAMatrixToMatrix(fbxNode_p != nullptr
+				? fbxNode_p->EvaluateGlobalTransform() : FbxAMatrix());
+
+			std::vector<Vertex> runVertices;
+			std::vector<Vertex> partVertices;
+			std::vector<uint32_t> partIndices;
+
+			for (size_t first = 0; first < triangles.size();)
 			{
-				Vertex vertex = _in_vertices[i];
-				uint32_t index = 0;
+				uint32_t material = polygonMaterials[triangles[first]];
+
+				runVertices.clear();
+				size_t last = first;
+				for (; last < triangles.size() && polygonMaterials[triangles[last]] == material; last++)
+					runVertices.insert(runVertices.end(), rawVertices.begin() + (size_t)triangles[last] * 3,
+						rawVertices.begin() + (size_t)triangles[last] * 3 + 3);
+				first = last;
+
+				// each part is welded alone so parts never share vertices
+				partVertices.clear();
+				partIndices.clear();
+				ret_result = CompactifyVertices(runVertices, partVertices, partIndices);
+				if (!Succeeded(ret_result))
+					return ret_result;
+
+				MeshPart part;
+				part.name = fbxMesh_p->GetName();
+				part.material = material;
+				part.index_offset = (uint32_t)_out_indices.size();
+				part.index_count = (uint32_t)partIndices.size();
+				part.base_vertex = (uint32_t)_out_vertices.size();
+				part.vertex_count = (uint32_t)partVertices.size();
+				part.transform = transform;
+
+				for (uint32_t index : partIndices)
+					_out_indices.push_back(part.base_vertex + index);
+				_out_vertices.insert(_out_vertices.end(), partVertices.begin(), partVertices.end());
+				_out_parts.push_back(part);
+			}
 
-				bool vertexIsUnique = true;
+			return ret_result;
+		}
+
+		Result StreamPartsFromFbxMesh(
+			const FbxScene*				_in_fbxScene_p
+			, const FbxMesh*			_in_fbxMesh_p
+			, const uint32_t			_in_elementsToExtract
+			, const std::vector<AnimationJointFbx>&	_in_jointsFbx
+			, std::ostream&				_out_indexStream
+			, uint32_t&					_out_indexCount
+			, std::vector<Vertex>&		_out_vertices
+			, std::vector<MeshPart>&	_out_parts
+		) {
+			FbxMesh* fbxMesh_p = (FbxMesh*)_in_fbxMesh_p;
+			int polygonCount = fbxMesh_p->GetPolygonCount();
+
+			// verify mesh has polygons
+			if (polygonCount <= 0)
+				return Result::FAIL;
 
-				// compare current vertex against each unique vertex
-				for (uint32_t v = 0; v < _out_vertices.size(); v++)
+			FbxMaterialStream materialStream;
+			OpenFbxMaterialStream(_in_fbxScene_p, fbxMesh_p, materialStream);
+
+			// parts are ordered by material, as GetPartsFromFbxMesh's stable sort orders them.
+			// a mesh has few materials, so they are found with one pass and no per-polygon storage
+			std::vector<uint32_t> materials;
+			for (int p = 0; p < polygonCount; p++)
+			{
+				uint32_t material = GetFbxMaterialStreamPolygon(materialStream, p);
+				if (std::find(materials.begin(), materials.end(), material) == materials.end())
+					materials.push_back(material);
+			}
+			std::sort(materials.begin(), materials.end());
+
+			FbxVertexStream vertexStream;
+			OpenFbxVertexStream(fbxMesh_p, _in_elementsToExtract, _in_jointsFbx, vertexStream);
+
+			// a geometry instanced by several nodes takes the transform of the first
+			FbxNode* fbxNode_p = fbxMesh_p->GetNode();
+			Matrix transform = ConvertFbxAMatrixToMatrix(fbxNode_p != nullptr
+				? fbxNode_p->EvaluateGlobalTransform() : FbxAMatrix());
+
+			// the only memory beyond the unique vertices is one chunk of raw vertices and indices
+			std::vector<double> chunk((size_t)VERTEX_CHUNK_SIZE * VERTEX_FLOAT_COUNT, 0.0);
+			std::vector<Vertex> chunkVertices(VERTEX_CHUNK_SIZE);
+			std::vector<uint32_t> chunkIndices(VERTEX_CHUNK_SIZE);
+			std::vector<Vertex> partVertices;
+			VertexWeldTable table;
+
+			// unique vertices rarely outnumber control points by much, so that sizes the table
+			uint32_t vertexCapacity = (uint32_t)std::min(fbxMesh_p->GetControlPointsCount(), polygonCount * 3);
+
+			Result ret_result = Result::SUCCESS;
+			for (size_t m = 0; m < materials.size() && Succeeded(ret_result); m++)
+			{
+				// each part is welded alone so parts never share vertices
+				partVertices.clear();
+				InitializeVertexWeldTable(vertexCapacity, table);
+
+				MeshPart part;
+				part.name = fbxMesh_p->GetName();
+				part.material = materials[m];
+				part.index_offset = _out_indexCount;
+				part.base_vertex = (uint32_t)_out_vertices.size();
+				part.transform = transform;
+
+				// resolve runs of consecutive polygons with the part's material a chunk at a time
+				for (int p = 0; p < polygonCount && Succeeded(ret_result);)
 				{
-					if (vertex == _out_vertices[v])
+					if (GetFbxMaterialStreamPolygon(materialStream, p) != materials[m])
 					{
-						vertexIsUnique = false;
-						index = v;
-						break;
+						p++;
+						continue;
 					}
-				}
 
-				if (vertexIsUnique)
-				{
-					index = (uint32_t)_out_vertices.size();
-					_out_vertices.push_back(vertex);
+					int first = p;
+					int maxCount = std::min(polygonCount - first, VERTEX_CHUNK_SIZE / 3);
+					for (; p < first + maxCount && GetFbxMaterialStreamPolygon(materialStream, p) == materials[m]; p++);
+					int count = (p - first) * 3;
+
+					ResolveFbxVertexStream(vertexStream, first * 3, count, chunk.data(), chunkVertices.data());
+					for (int i = 0; i < count; i++)
+						chunkIndices[i] = part.base_vertex + WeldVertex(chunkVertices[i], table, partVertices);
+
+					// indices go to the stream as they are made, and are never held whole
+					_out_indexStream.write((const char*)chunkIndices.data(), (std::streamsize)count * sizeof(uint32_t));
+					if (!_out_indexStream)
+						ret_result = Result::FAIL;
+
+					part.index_count += (uint32_t)count;
 				}
 
-				_out_indices.push_back(index);
+				part.vertex_count = (uint32_t)partVertices.size();
+				_out_indexCount += part.index_count;
+
+				// the first part's vertices are moved rather than copied
+				if (_out_vertices.empty())
+					_out_vertices.swap(partVertices);
+				else
+					_out_vertices.insert(_out_vertices.end(), partVertices.begin(), partVertices.end());
+				_out_parts.push_back(part);
 			}
 
-			// verify vertices and indices were generated
-			if (_out_vertices.size() > 0 && _out_indices.size() > 0)
-				ret_result = Result::SUCCESS;
+			CloseFbxVertexStream(vertexStream);
+			CloseFbxMaterialStream(materialStream);
 
 			return ret_result;
 		}
+
 #pragma endregion
 
 #pragma region Utility Function Definitions
@@ -319,181 +808,228 @@ namespace fbx_exporter
 			FbxScene* fbxScene_p = (FbxScene*)_in_fbxScene_p;
 			FbxMesh* fbxMesh_p = nullptr;
 
-			std::vector<Vertex> rawVertices;
+			std::vector<MeshPart> parts;
+			std::vector<AnimationJointFbx> jointsFbx;
 
 			ret_result = GetFbxMeshFromFbxScene(fbxScene_p, _in_meshName, fbxMesh_p);
 			if (!Succeeded(ret_result))
 				return ret_result;
 
-			ret_result = GetVerticesFromFbxMesh(fbxMesh_p, _in_elementsToExtract, rawVertices);
-			if (!Succeeded(ret_result))
-				return ret_result;
+			GetSkinJointsFromFbxScene(fbxScene_p, _in_elementsToExtract, jointsFbx);
 
-			ret_result = CompactifyVertices(rawVertices, _out_mesh.vertices, _out_mesh.indices);
+			ret_result = GetPartsFromFbxMesh(fbxScene_p, fbxMesh_p, _in_elementsToExtract, jointsFbx,
+				_out_mesh.vertices, _out_mesh.indices, parts);
 			if (!Succeeded(ret_result))
 				return ret_result;
 
+			// a mesh without materials is one range, and needs no part table
+			if (parts.size() > 1 || parts[0].material != NO_MATERIAL)
+				_out_mesh.parts.swap(parts);
+
 			_out_mesh.vertex_count = (uint32_t)_out_mesh.vertices.size();
 			_out_mesh.index_count = (uint32_t)_out_mesh.indices.size();
 
 			return ret_result;
 		}
-		Result GetMaterialsFromFbxScene(
+		Result GetMeshesFromFbxScene(
 			const FbxScene*				_in_fbxScene_p
-			, const uint32_t			_in_materialNum
 			, const uint32_t			_in_elementsToExtract
-			, MaterialList&				_out_materialList
+			, Mesh&						_out_mesh
 		) {
 			Result ret_result = Result::FAIL;
 
 			FbxScene* fbxScene_p = (FbxScene*)_in_fbxScene_p;
-			FbxSurfaceMaterial* fbxMaterial_p = nullptr;
-			std::vector<Material> materials;
-			std::vector<filepath_t> filepaths;
 
-			// TODO: split function into subfunctions (see GetMeshFromFbxScene)
+			// build into locals so a failed extraction leaves _out_mesh unchanged
+			std::vector<Vertex> vertices;
+			std::vector<uint32_t> indices;
+			std::vector<MeshPart> parts;
 
+			std::vector<AnimationJointFbx> jointsFbx;
+			GetSkinJointsFromFbxScene(fbxScene_p, _in_elementsToExtract, jointsFbx);
 
-			// -- extract material from scene --
+			for (int i = 0; i < fbxScene_p->GetGeometryCount(); i++)
+			{
+				FbxGeometry* fbx_geometry_p = fbxScene_p->GetGeometry(i);
 
-			// if material number is specified and scene has a material with that index
-			if (_in_materialNum > 0 && fbxScene_p->GetGeometryCount() > (int)_in_materialNum)
-				fbxMaterial_p = fbxScene_p->GetMaterial(_in_materialNum);
-			// if material number is unspecified or scene does not have a material with that index
-			else
-				fbxMaterial_p = fbxScene_p->GetMaterial(0);
+				// skip non-mesh geometries
+				if (fbx_geometry_p->GetAttributeType() != FbxNodeAttribute::eMesh)
+					continue;
+
+				// skip meshes without polygons
+				FbxMesh* fbxMesh_p = (FbxMesh*)fbx_geometry_p;
+				if (fbxMesh_p->GetPolygonCount() == 0)
+					continue;
+
+				ret_result = GetPartsFromFbxMesh(fbxScene_p, fbxMesh_p, _in_elementsToExtract, jointsFbx,
+					vertices, indices, parts);
+				if (!Succeeded(ret_result))
+					return ret_result;
+			}
 
-			// material to copy data into from FBX material
-			Material material;
+			// verify that a mesh was extracted
+			if (parts.empty())
+				return Result::FAIL;
 
-			// skip non-standard materials
-			if (fbxMaterial_p->Is<FbxSurfaceLambert>() == false)
-				return ret_result;
+			_out_mesh = Mesh();
+			_out_mesh.vertices.swap(vertices);
+			_out_mesh.indices.swap(indices);
+			_out_mesh.parts.swap(parts);
+			_out_mesh.vertex_count = (uint32_t)_out_mesh.vertices.size();
+			_out_mesh.index_count = (uint32_t)_out_mesh.indices.size();
 
-			FbxSurfaceLambert* fbx_lambert_p = (FbxSurfaceLambert*)fbxMaterial_p;
-			FbxFileTexture* fbx_fileTexture_p = nullptr;
-			const char* textureFilepath = "";
+			return Result::SUCCESS;
+		}
+		Result StreamMeshFromFbxScene(
+			const FbxScene*				_in_fbxScene_p
+			, const char*				_in_meshName
+			, const uint32_t			_in_elementsToExtract
+			, std::ostream&				_out_indexStream
+			, Mesh&						_out_mesh
+		) {
+			Result ret_result = Result::FAIL;
 
-			if (_in_elementsToExtract & static_cast<int>(MaterialElement::DIFFUSE))
-			{
-				FbxDouble3 diffuseColor = fbx_lambert_p->Diffuse.Get();
-				FbxDouble diffuseFactor = fbx_lambert_p->DiffuseFactor.Get();
+			FbxScene* fbxScene_p = (FbxScene*)_in_fbxScene_p;
+			FbxMesh* fbxMesh_p = nullptr;
 
-				material[Material::ComponentType::DIFFUSE].value[0] = (float)diffuseColor[0];
-				material[Material::ComponentType::DIFFUSE].value[1] = (float)diffuseColor[1];
-				material[Material::ComponentType::DIFFUSE].value[2] = (float)diffuseColor[2];
+			ret_result = GetFbxMeshFromFbxScene(fbxScene_p, _in_meshName, fbxMesh_p);
+			if (!Succeeded(ret_result))
+				return ret_result;
 
-				material[Material::ComponentType::DIFFUSE].factor = (float)diffuseFactor;
+			std::vector<AnimationJointFbx> jointsFbx;
+			GetSkinJointsFromFbxScene(fbxScene_p, _in_elementsToExtract, jointsFbx);
 
-				fbx_fileTexture_p = fbx_lambert_p->Diffuse.GetSrcObject<FbxFileTexture>();
+			std::vector<Vertex> vertices;
+			std::vector<MeshPart> parts;
+			uint32_t indexCount = 0;
 
-				if (fbx_fileTexture_p != nullptr)
-				{
-					textureFilepath = fbx_fileTexture_p->GetRelativeFileName();
-					filepath_t filepath;
-					strcpy_s(filepath.data(), filepath.max_size(), textureFilepath);
+			ret_result = StreamPartsFromFbxMesh(fbxScene_p, fbxMesh_p, _in_elementsToExtract, jointsFbx,
+				_out_indexStream, indexCount, vertices, parts);
+			if (!Succeeded(ret_result))
+				return ret_result;
 
-					material[Material::ComponentType::DIFFUSE].input = filepaths.size();
-					filepaths.push_back(filepath);
-				}
-			}
+			_out_mesh = Mesh();
+			_out_mesh.vertices.swap(vertices);
 
-			if (_in_elementsToExtract & static_cast<int>(MaterialElement::EMISSIVE))
-			{
-				FbxDouble3 emissiveColor = fbx_lambert_p->Emissive.Get();
-				FbxDouble emissiveFactor = fbx_lambert_p->EmissiveFactor.Get();
+			// a mesh without materials is one range, and needs no part table
+			if (parts.size() > 1 || parts[0].material != NO_MATERIAL)
+				_out_mesh.parts.swap(parts);
 
-				material[Material::ComponentType::EMISSIVE].value[0] = (float)emissiveColor[0];
-				material[Material::ComponentType::EMISSIVE].value[1] = (float)emissiveColor[1];
-				material[Material::ComponentType::EMISSIVE].value[2] = (float)emissiveColor[2];
+			_out_mesh.vertex_count = (uint32_t)_out_mesh.vertices.size();
+			_out_mesh.index_count = indexCount;
 
-				material[Material::ComponentType::EMISSIVE].factor = (float)emissiveFactor;
+			return ret_result;
+		}
+		Result StreamMeshesFromFbxScene(
+			const FbxScene*				_in_fbxScene_p
+			, const uint32_t			_in_elementsToExtract
+			, std::ostream&				_out_indexStream
+			, Mesh&						_out_mesh
+		) {
+			Result ret_result = Result::FAIL;
 
-				fbx_fileTexture_p = fbx_lambert_p->Emissive.GetSrcObject<FbxFileTexture>();
+			FbxScene* fbxScene_p = (FbxScene*)_in_fbxScene_p;
 
-				if (fbx_fileTexture_p != nullptr)
-				{
-					textureFilepath = fbx_fileTexture_p->GetRelativeFileName();
-					filepath_t filepath;
-					strcpy_s(filepath.data(), filepath.max_size(), textureFilepath);
+			std::vector<Vertex> vertices;
+			std::vector<MeshPart> parts;
+			uint32_t indexCount = 0;
 
-					material[Material::ComponentType::EMISSIVE].input = filepaths.size();
-					filepaths.push_back(filepath);
-				}
-			}
+			std::vector<AnimationJointFbx> jointsFbx;
+			GetSkinJointsFromFbxScene(fbxScene_p, _in_elementsToExtract, jointsFbx);
 
-			if (_in_elementsToExtract & static_cast<int>(MaterialElement::SPECULAR))
+			for (int i = 0; i < fbxScene_p->GetGeometryCount(); i++)
 			{
-				if (fbxMaterial_p->Is<FbxSurfacePhong>())
-				{
-					FbxSurfacePhong* fbx_phong_p = (FbxSurfacePhong*)fbxMaterial_p;
+				FbxGeometry* fbx_geometry_p = fbxScene_p->GetGeometry(i);
 
-					FbxDouble3 specularColor = fbx_phong_p->Specular.Get();
-					FbxDouble specularFactor = fbx_phong_p->SpecularFactor.Get();
+				// skip non-mesh geometries
+				if (fbx_geometry_p->GetAttributeType() != FbxNodeAttribute::eMesh)
+					continue;
+
+				// skip meshes without polygons
+				FbxMesh* fbxMesh_p = (FbxMesh*)fbx_geometry_p;
+				if (fbxMesh_p->GetPolygonCount() == 0)
+					continue;
+
+				ret_result = StreamPartsFromFbxMesh(fbxScene_p, fbxMesh_p, _in_elementsToExtract, jointsFbx,
+					_out_indexStream, indexCount, vertices, parts);
+				if (!Succeeded(ret_result))
+					return ret_result;
+			}
 
-					material[Material::ComponentType::SPECULAR].value[0] = (float)specularColor[0];
-					material[Material::ComponentType::SPECULAR].value[1] = (float)specularColor[1];
-					material[Material::ComponentType::SPECULAR].value[2] = (float)specularColor[2];
+			// verify that a mesh was extracted
+			if (parts.empty())
+				return Result::FAIL;
 
-					material[Material::ComponentType::SPECULAR].factor = (float)specularFactor;
+			_out_mesh = Mesh();
+			_out_mesh.vertices.swap(vertices);
+			_out_mesh.parts.swap(parts);
+			_out_mesh.vertex_count = (uint32_t)_out_mesh.vertices.size();
+			_out_mesh.index_count = indexCount;
 
-					fbx_fileTexture_p = fbx_phong_p->Specular.GetSrcObject<FbxFileTexture>();
+			return Result::SUCCESS;
+		}
+		Result GetMaterialsFromFbxScene(
+			const FbxScene*				_in_fbxScene_p
+			, const uint32_t			_in_elementsToExtract
+			, MaterialList&				_out_materialList
+		) {
+			FbxScene* fbxScene_p = (FbxScene*)_in_fbxScene_p;
+			int materialCount = fbxScene_p->GetMaterialCount();
 
-					if (fbx_fileTexture_p != nullptr)
-					{
-						textureFilepath = fbx_fileTexture_p->GetRelativeFileName();
-						filepath_t filepath;
-						strcpy_s(filepath.data(), filepath.max_size(), textureFilepath);
+			// verify scene has materials
+			if (materialCount <= 0)
+				return Result::FAIL;
 
-						material[Material::ComponentType::SPECULAR].input = filepaths.size();
-						filepaths.push_back(filepath);
-					}
-				}
-			}
+			// build into a local list so a failed extraction leaves _out_materialList unchanged
+			MaterialList materialList;
+			materialList.materials.resize(materialCount);
 
-			if (_in_elementsToExtract & static_cast<int>(MaterialElement::NORMALMAP))
+			// every material keeps its scene index, so mesh parts can reference it
+			for (int m = 0; m < materialCount; m++)
 			{
-				FbxDouble3 normalColor = fbx_lambert_p->NormalMap.Get();
+				FbxSurfaceMaterial* fbxMaterial_p = fbxScene_p->GetMaterial(m);
+				Material& material = materialList.materials[m];
 
-				material[Material::ComponentType::NORMALMAP].value[0] = (float)normalColor[0];
-				material[Material::ComponentType::NORMALMAP].value[1] = (float)normalColor[1];
-				material[Material::ComponentType::NORMALMAP].value[2] = (float)normalColor[2];
+				// non-standard materials keep default components
+				if (fbxMaterial_p == nullptr || fbxMaterial_p->Is<FbxSurfaceLambert>() == false)
+					continue;
 
-				material[Material::ComponentType::NORMALMAP].factor = 1.0f;
+				FbxSurfaceLambert* fbx_lambert_p = (FbxSurfaceLambert*)fbxMaterial_p;
 
-				FbxFileTexture* fileTexture = fbx_lambert_p->NormalMap.GetSrcObject<FbxFileTexture>();
-				if (fileTexture != nullptr)
-				{
-					textureFilepath = fileTexture->GetRelativeFileName();
-					filepath_t filepath;
-					strcpy_s(filepath.data(), filepath.max_size(), textureFilepath);
+				if (_in_elementsToExtract & static_cast<int>(MaterialElement::DIFFUSE))
+					GetMaterialComponentFromFbxProperty(fbx_lambert_p->Diffuse, fbx_lambert_p->DiffuseFactor.Get(),
+						materialList, material[Material::ComponentType::DIFFUSE]);
 
-					material[Material::ComponentType::NORMALMAP].input = filepaths.size();
-					filepaths.push_back(filepath);
-				}
-			}
+				if (_in_elementsToExtract & static_cast<int>(MaterialElement::EMISSIVE))
+					GetMaterialComponentFromFbxProperty(fbx_lambert_p->Emissive, fbx_lambert_p->EmissiveFactor.Get(),
+						materialList, material[Material::ComponentType::EMISSIVE]);
 
-			materials.push_back(material);
+				if ((_in_elementsToExtract & static_cast<int>(MaterialElement::SPECULAR))
+					&& fbxMaterial_p->Is<FbxSurfacePhong>())
+				{
+					FbxSurfacePhong* fbx_phong_p = (FbxSurfacePhong*)fbxMaterial_p;
+					GetMaterialComponentFromFbxProperty(fbx_phong_p->Specular, fbx_phong_p->SpecularFactor.Get(),
+						materialList, material[Material::ComponentType::SPECULAR]);
+				}
 
-			// -- /extract material from scene --
+				if (_in_elementsToExtract & static_cast<int>(MaterialElement::NORMALMAP))
+					GetMaterialComponentFromFbxProperty(fbx_lambert_p->NormalMap, 1.0,
+						materialList, material[Material::ComponentType::NORMALMAP]);
+			}
 
+			_out_materialList = std::move(materialList);
 
-			return ret_result;
+			return Result::EXTRACT;
 		}
-		Result GetAnimationFromFbxScene(
+		Result GetAnimationJointsFromFbxScene(
 			const FbxScene*				_in_fbxScene_p
-			, const uint32_t			_in_elementsToExtract
-			, AnimationClip&			_out_animationClip
+			, std::vector<AnimationJointFbx>&	_out_jointsFbx
+			, std::vector<AnimationJoint>&	_out_joints
 		) {
-			Result result = Result::FAIL;
-
 			FbxScene* fbxScene_p = (FbxScene*)_in_fbxScene_p;
-			FbxMesh* fbxMesh_p = nullptr;
 			FbxPose* fbxBindPose_p = nullptr;
 			uint32_t poseCount = fbxScene_p->GetPoseCount();
 
-			// TODO: split into subfunctions (see GetMeshFromFbxScene)
-
 			// -- extract bind pose from scene --
 
 			for (uint32_t i = 0; i < poseCount; i++)
@@ -517,7 +1053,7 @@ namespace fbx_exporter
 
 			if (fbxBindPose_p == nullptr)
 			{
-				return result;
+				return Result::FAIL;
 			}
 			else
 			{
@@ -546,7 +1082,12 @@ namespace fbx_exporter
 
 			// -- create list of joints from skeleton root --
 
-			std::vector<AnimationJointFbx> jointsFbx;
+			// verify a skeleton was found
+			if (fbxNodeRoot_p == nullptr)
+				return Result::FAIL;
+
+			std::vector<AnimationJointFbx>& jointsFbx = _out_jointsFbx;
+			jointsFbx.clear();
 
 			AnimationJointFbx jointRoot = { fbxNodeRoot_p, -1 };
 			jointsFbx.push_back(jointRoot);
@@ -578,7 +1119,7 @@ namespace fbx_exporter
 
 			// -- convert bind pose joint data --
 
-			std::vector<AnimationJoint> joints_out;
+			_out_joints.clear();
 
 			for (uint32_t i = 0; i < jointsFbx.size(); i++)
 			{
@@ -586,15 +1127,27 @@ namespace fbx_exporter
 
 				AnimationJoint joint = { ConvertFbxAMatrixToMatrix(transform), jointsFbx[i].parent_index };
 
-				joints_out.push_back(joint);
+				_out_joints.push_back(joint);
 			}
 
 			// -- /convert bind pose joint data --
 
+			return Result::SUCCESS;
+		}
+		Result GetAnimationFromFbxAnimStack(
+			const FbxScene*				_in_fbxScene_p
+			, const FbxAnimStack*		_in_fbxAnimStack_p
+			, const std::vector<AnimationJointFbx>&	_in_jointsFbx
+			, const std::vector<AnimationJoint>&	_in_joints
+			, const uint32_t			_in_elementsToExtract
+			, AnimationClip&			_out_animationClip
+		) {
+			Result result = Result::FAIL;
 
-			// -- get animation data from scene --
+			FbxScene* fbxScene_p = (FbxScene*)_in_fbxScene_p;
+			FbxAnimStack* fbxAnimStack_p = (FbxAnimStack*)_in_fbxAnimStack_p;
 
-			FbxAnimStack* fbxAnimStack_p = fbxScene_p->GetCurrentAnimationStack();
+			// -- get animation data from scene --
 
 			// verify animation stack was extracted
 			if (fbxAnimStack_p == nullptr)
@@ -604,40 +1157,300 @@ namespace fbx_exporter
 			else
 			{
 				FbxTime::EMode mode = FbxTime::EMode::eFrames30;
-				FbxTime animDuration = fbxAnimStack_p->GetLocalTimeSpan().GetDuration();
+				FbxTimeSpan animSpan = fbxAnimStack_p->GetLocalTimeSpan();
+				FbxTime animStart = animSpan.GetStart();
+				FbxTime animDuration = animSpan.GetDuration();
 				int64_t frameCount = animDuration.GetFrameCount(mode);
 
 				// store duration in seconds
+				_out_animationClip.name = fbxAnimStack_p->GetName();
 				_out_animationClip.duration = animDuration.GetSecondDouble();
+				_out_animationClip.joints = _in_joints;
+				_out_animationClip.skeleton_hash = GetSkeletonHash(_in_joints);
+
+				// frame 0 is the bind pose and is skipped
+				uint32_t sampleCount = frameCount > 1 ? (uint32_t)(frameCount - 1) : 0;
+				uint32_t jointCount = (uint32_t)_in_jointsFbx.size();
+
+				// one buffer holds every frame, sized up front so workers write into their own slots
+				_out_animationClip.frame_times.assign(sampleCount, 0.0);
+				_out_animationClip.transforms.assign((size_t)sampleCount * jointCount, Matrix());
+
+				uint32_t threadCount = GetWorkerThreadCount();
+				if (threadCount == 0)
+					threadCount = GetHardwareThreadCount();
+				if (threadCount > sampleCount)
+					threadCount = sampleCount > 0 ? sampleCount : 1;
+
+				// one evaluator per worker so evaluation caches are not shared between threads,
+				// created up front because adding objects to a scene is not thread-safe
+				std::vector<FbxAnimEvaluator*> evaluators(threadCount, nullptr);
+				evaluators[0] = fbxScene_p->GetAnimationEvaluator();
+				for (uint32_t t = 1; t < threadCount; t++)
+					evaluators[t] = FbxAnimEvalClassic::Create(fbxScene_p, "");
+
+				bool storeLocal =
+					(_in_elementsToExtract & static_cast<int>(AnimationElement::LOCAL_TRANSFORMS)) != 0;
+				_out_animationClip.local_space = storeLocal;
+
+				// global = local x parent global only holds for the default inherit type;
+				// other joints fall back to global evaluation
+				std::vector<bool> composable(jointCount, false);
+				for (uint32_t n = 0; n < jointCount; n++)
+				{
+					FbxTransform::EInheritType inheritType = FbxTransform::eInheritRSrs;
+					_in_jointsFbx[n].fbx_node_p->GetTransformationInheritType(inheritType);
+					composable[n] = _in_jointsFbx[n].parent_index >= 0 && inheritType == FbxTransform::eInheritRSrs;
+				}
+
+				// split frames into more blocks than workers so uneven blocks can be stolen
+				uint32_t blockCount = threadCount > 1 ? threadCount * 4 : 1;
+				if (blockCount > sampleCount)
+					blockCount = sampleCount;
 
-				for (int64_t i = 1; i < frameCount; i++)  // starts at 1 to skip bind pose at frame 0
+				ParallelFor(blockCount, threadCount, [&](uint32_t _in_block, uint32_t _in_worker)
 				{
-					AnimationFrame frame;
+					FbxAnimEvaluator* evaluator_p = evaluators[_in_worker];
+					uint32_t first = (uint32_t)((uint64_t)sampleCount * _in_block / blockCount);
+					uint32_t last = (uint32_t)((uint64_t)sampleCount * (_in_block + 1) / blockCount);
 
-					// get keytime for current frame
-					FbxTime frameTime;
-					frameTime.SetFrame(i, mode);
+					// model-space and parent-relative transforms of every joint in the current frame
+					std::vector<double> globals(jointCount * 16);
+					double local[16];
 
-					// store keytime in seconds
-					frame.time = frameTime.GetSecondDouble();
+					for (uint32_t i = first; i < last; i++)
+					{
+						Matrix* frameTransforms_p = &_out_animationClip.transforms[(size_t)i * jointCount];
 
-					// get node transforms for current frame
-					for (uint32_t n = 0; n < jointsFbx.size(); n++)
-						frame.transforms.push_back({ ConvertFbxAMatrixToMatrix(jointsFbx[n].fbx_node_p->EvaluateGlobalTransform(frameTime)) });
+						// get keytime for current frame
+						FbxTime frameOffset;
+						frameOffset.SetFrame(i + 1, mode);
+						FbxTime frameTime = animStart + frameOffset;
 
-					_out_animationClip.frames.push_back(frame);
-				}
+						// store keytime in seconds from the start of the stack
+						_out_animationClip.frame_times[i] = frameOffset.GetSecondDouble();
+
+						// get node transforms for current frame, parents are always composed first
+						for (uint32_t n = 0; n < jointCount; n++)
+						{
+							FbxNode* fbxNode_p = _in_jointsFbx[n].fbx_node_p;
+							int parent = _in_jointsFbx[n].parent_index;
+							double* global_p = &globals[n * 16];
+
+							if (composable[n])
+							{
+								ConvertFbxAMatrixToDoubles(
+									evaluator_p->GetNodeLocalTransform(fbxNode_p, frameTime), local);
+								MultiplyMatrix4x4(local, &globals[parent * 16], global_p);
+							}
+							else
+							{
+								FbxAMatrix global = evaluator_p->GetNodeGlobalTransform(fbxNode_p, frameTime);
+								ConvertFbxAMatrixToDoubles(global, global_p);
+
+								// effective parent-relative transform of a joint that does not compose
+								if (storeLocal && parent >= 0)
+								{
+									FbxAMatrix parentGlobal = evaluator_p->GetNodeGlobalTransform(
+										_in_jointsFbx[parent].fbx_node_p, frameTime);
+									ConvertFbxAMatrixToDoubles(parentGlobal.Inverse() * global, local);
+								}
+							}
+
+							frameTransforms_p[n] = ConvertDoublesToMatrix(
+								storeLocal && parent >= 0 ? local : global_p);
+						}
+					}
+				});
+
+				for (uint32_t t = 1; t < threadCount; t++)
+					evaluators[t]->Destroy();
+
+				result = Result::EXTRACT;
 			}
 
 			// -- /get animation data from scene --
 
+			return result;
+		}
+		Result GetAnimationFromFbxScene(
+			const FbxScene*				_in_fbxScene_p
+			, const uint32_t			_in_elementsToExtract
+			, AnimationClip&			_out_animationClip
+		) {
+			Result result = Result::FAIL;
+
+			FbxScene* fbxScene_p = (FbxScene*)_in_fbxScene_p;
+			std::vector<AnimationJointFbx> jointsFbx;
+			std::vector<AnimationJoint> joints;
+
+			result = GetAnimationJointsFromFbxScene(_in_fbxScene_p, jointsFbx, joints);
+			if (!Succeeded(result))
+				return result;
+
+			return GetAnimationFromFbxAnimStack(_in_fbxScene_p, fbxScene_p->GetCurrentAnimationStack(),
+				jointsFbx, joints, _in_elementsToExtract, _out_animationClip);
+		}
+		Result GetAnimationsFromFbxScene(
+			const FbxScene*				_in_fbxScene_p
+			, const uint32_t			_in_elementsToExtract
+			, std::vector<AnimationClip>&	_out_animationClips
+		) {
+			Result result = Result::FAIL;
+
+			FbxScene* fbxScene_p = (FbxScene*)_in_fbxScene_p;
+			std::vector<AnimationJointFbx> jointsFbx;
+			std::vector<AnimationJoint> joints;
+
+			// the skeleton is shared by every stack in the scene, so it is read once
+			result = GetAnimationJointsFromFbxScene(_in_fbxScene_p, jointsFbx, joints);
+			if (!Succeeded(result))
+				return result;
+
+			int stackCount = fbxScene_p->GetSrcObjectCount<FbxAnimStack>();
+			if (stackCount == 0)
+				return Result::FAIL;
+
+			FbxAnimStack* fbxCurrentStack_p = fbxScene_p->GetCurrentAnimationStack();
+			FbxAnimEvaluator* evaluator_p = fbxScene_p->GetAnimationEvaluator();
+
+			_out_animationClips.resize(stackCount);
+			for (int i = 0; i < stackCount && Succeeded(result); i++)
+			{
+				FbxAnimStack* fbxAnimStack_p = fbxScene_p->GetSrcObject<FbxAnimStack>(i);
+
+				// evaluators sample the current stack and cache results from the previous one
+				fbxScene_p->SetCurrentAnimationStack(fbxAnimStack_p);
+				evaluator_p->Reset();
+
+				result = GetAnimationFromFbxAnimStack(_in_fbxScene_p, fbxAnimStack_p, jointsFbx, joints,
+					_in_elementsToExtract, _out_animationClips[i]);
+			}
+
+			fbxScene_p->SetCurrentAnimationStack(fbxCurrentStack_p);
+			evaluator_p->Reset();
+
 			return result;
 		}
 #pragma endregion
 
 #pragma region Interface Function Definitions
-		bool inline Succeeded(Result _in_r) {
-			return static_cast<int>(_in_r) >= static_cast<int>(Result::SUCCESS);
+		Result CreateFbxSession(
+			const char*					_in_fbxFilepath
+			, FbxSession*&				_out_fbxSession_p
+		) {
+			Result ret_result = Result::FAIL;
+
+			// ensure session is uninitialized
+			if (_in_fbxFilepath == nullptr || _out_fbxSession_p != nullptr)
+				return Result::INVALID_ARG;
+
+			FbxSession* fbxSession_p = NEW FbxSession;
+
+			ret_result = CreateFbxManagerAndImportFbxScene(_in_fbxFilepath,
+				fbxSession_p->fbx_manager_p, fbxSession_p->fbx_scene_p);
+			if (!Succeeded(ret_result))
+			{
+				DestroyFbxSession(fbxSession_p);
+				return ret_result;
+			}
+
+			_out_fbxSession_p = fbxSession_p;
+			return ret_result;
+		}
+		void DestroyFbxSession(
+			FbxSession*&				_out_fbxSession_p
+		) {
+			if (_out_fbxSession_p == nullptr)
+				return;
+
+			// destroying the manager also destroys the scene it owns
+			if (_out_fbxSession_p->fbx_manager_p != nullptr)
+				_out_fbxSession_p->fbx_manager_p->Destroy();
+
+			delete _out_fbxSession_p;
+			_out_fbxSession_p = nullptr;
+		}
+
+		Result GetMeshFromFbxSession(
+			const FbxSession*			_in_fbxSession_p
+			, const char*				_in_meshName
+			, const uint32_t			_in_elementsToExtract
+			, Mesh&						_out_mesh
+		) {
+			if (_in_fbxSession_p == nullptr)
+				return Result::INVALID_ARG;
+
+			return GetMeshFromFbxScene(_in_fbxSession_p->fbx_scene_p, _in_meshName,
+				_in_elementsToExtract, _out_mesh);
+		}
+		Result GetMeshesFromFbxSession(
+			const FbxSession*			_in_fbxSession_p
+			, const uint32_t			_in_elementsToExtract
+			, Mesh&						_out_mesh
+		) {
+			if (_in_fbxSession_p == nullptr)
+				return Result::INVALID_ARG;
+
+			return GetMeshesFromFbxScene(_in_fbxSession_p->fbx_scene_p, _in_elementsToExtract, _out_mesh);
+		}
+		Result StreamMeshFromFbxSession(
+			const FbxSession*			_in_fbxSession_p
+			, const char*				_in_meshName
+			, const uint32_t			_in_elementsToExtract
+			, std::ostream&				_out_indexStream
+			, Mesh&						_out_mesh
+		) {
+			if (_in_fbxSession_p == nullptr)
+				return Result::INVALID_ARG;
+
+			return StreamMeshFromFbxScene(_in_fbxSession_p->fbx_scene_p, _in_meshName,
+				_in_elementsToExtract, _out_indexStream, _out_mesh);
+		}
+		Result StreamMeshesFromFbxSession(
+			const FbxSession*			_in_fbxSession_p
+			, const uint32_t			_in_elementsToExtract
+			, std::ostream&				_out_indexStream
+			, Mesh&						_out_mesh
+		) {
+			if (_in_fbxSession_p == nullptr)
+				return Result::INVALID_ARG;
+
+			return StreamMeshesFromFbxScene(_in_fbxSession_p->fbx_scene_p, _in_elementsToExtract,
+				_out_indexStream, _out_mesh);
+		}
+		Result GetMaterialsFromFbxSession(
+			const FbxSession*			_in_fbxSession_p
+			, const uint32_t			_in_elementsToExtract
+			, MaterialList&				_out_materialList
+		) {
+			if (_in_fbxSession_p == nullptr)
+				return Result::INVALID_ARG;
+
+			return GetMaterialsFromFbxScene(_in_fbxSession_p->fbx_scene_p, _in_elementsToExtract,
+				_out_materialList);
+		}
+		Result GetAnimationFromFbxSession(
+			const FbxSession*			_in_fbxSession_p
+			, const uint32_t			_in_elementsToExtract
+			, AnimationClip&			_out_animationClip
+		) {
+			if (_in_fbxSession_p == nullptr)
+				return Result::INVALID_ARG;
+
+			return GetAnimationFromFbxScene(_in_fbxSession_p->fbx_scene_p, _in_elementsToExtract,
+				_out_animationClip);
+		}
+		Result GetAnimationsFromFbxSession(
+			const FbxSession*			_in_fbxSession_p
+			, const uint32_t			_in_elementsToExtract
+			, std::vector<AnimationClip>&	_out_animationClips
+		) {
+			if (_in_fbxSession_p == nullptr)
+				return Result::INVALID_ARG;
+
+			return GetAnimationsFromFbxScene(_in_fbxSession_p->fbx_scene_p, _in_elementsToExtract,
+				_out_animationClips);
 		}
 
 		Result GetMeshFromFbxFile(
@@ -648,42 +1461,50 @@ namespace fbx_exporter
 		) {
 			Result ret_result = Result::FAIL;
 
-			FbxScene* fbxScene_p = nullptr;
-			FbxManager* fbxManager_p = nullptr;
+			FbxSession* fbxSession_p = nullptr;
 
-			ret_result = CreateFbxManagerAndImportFbxScene(_in_fbxFilepath, fbxManager_p,
-				fbxScene_p);
+			ret_result = CreateFbxSession(_in_fbxFilepath, fbxSession_p);
 			if (!Succeeded(ret_result))
-			{
-				fbxManager_p->Destroy();
 				return ret_result;
-			}
 
-			ret_result = GetMeshFromFbxScene(fbxScene_p, _in_meshName, _in_elementsToExtract,
+			ret_result = GetMeshFromFbxSession(fbxSession_p, _in_meshName, _in_elementsToExtract,
 				_out_mesh);
-			fbxManager_p->Destroy();
+			DestroyFbxSession(fbxSession_p);
+			return ret_result;
+		}
+		Result GetMeshesFromFbxFile(
+			const char*					_in_fbxFilepath
+			, const uint32_t			_in_elementsToExtract
+			, Mesh&						_out_mesh
+		) {
+			Result ret_result = Result::FAIL;
+
+			FbxSession* fbxSession_p = nullptr;
+
+			ret_result = CreateFbxSession(_in_fbxFilepath, fbxSession_p);
+			if (!Succeeded(ret_result))
+				return ret_result;
+
+			ret_result = GetMeshesFromFbxSession(fbxSession_p, _in_elementsToExtract, _out_mesh);
+			DestroyFbxSession(fbxSession_p);
 			return ret_result;
 		}
 		Result GetMaterialsFromFbxFile(
 			const char*					_in_fbxFilepath
-			, const uint32_t			_in_materialNum
 			, const uint32_t			_in_elementsToExtract
 			, MaterialList&				_out_materialList
 		) {
 			Result ret_result = Result::FAIL;
 
-			FbxScene* fbxScene_p = nullptr;
-			FbxManager* fbxManager_p = nullptr;
+			FbxSession* fbxSession_p = nullptr;
 
-			ret_result = CreateFbxManagerAndImportFbxScene(_in_fbxFilepath, fbxManager_p, fbxScene_p);
+			ret_result = CreateFbxSession(_in_fbxFilepath, fbxSession_p);
 			if (!Succeeded(ret_result))
-			{
-				fbxManager_p->Destroy();
 				return ret_result;
-			}
 
-			ret_result = GetMaterialsFromFbxScene(fbxScene_p, _in_materialNum, _in_elementsToExtract, _out_materialList);
-			fbxManager_p->Destroy();
+			ret_result = GetMaterialsFromFbxSession(fbxSession_p, _in_elementsToExtract,
+				_out_materialList);
+			DestroyFbxSession(fbxSession_p);
 			return ret_result;
 		}
 		Result GetAnimationFromFbxFile(
@@ -693,18 +1514,33 @@ namespace fbx_exporter
 		) {
 			Result ret_result = Result::FAIL;
 
-			FbxScene* fbxScene_p = nullptr;
-			FbxManager* fbxManager_p = nullptr;
+			FbxSession* fbxSession_p = nullptr;
 
-			ret_result = CreateFbxManagerAndImportFbxScene(_in_fbxFilepath, fbxManager_p, fbxScene_p);
+			ret_result = CreateFbxSession(_in_fbxFilepath, fbxSession_p);
+			if (!Succeeded(ret_result))
+				return ret_result;
+
+			ret_result = GetAnimationFromFbxSession(fbxSession_p, _in_elementsToExtract,
+				_out_animationClip);
+			DestroyFbxSession(fbxSession_p);
+			return ret_result;
+		}
+		Result GetAnimationsFromFbxFile(
+			const char*					_in_fbxFilepath
+			, const uint32_t			_in_elementsToExtract
+			, std::vector<AnimationClip>&	_out_animationClips
+		) {
+			Result ret_result = Result::FAIL;
+
+			FbxSession* fbxSession_p = nullptr;
+
+			ret_result = CreateFbxSession(_in_fbxFilepath, fbxSession_p);
 			if (!Succeeded(ret_result))
-			{
-				fbxManager_p->Destroy();
 				return ret_result;
-			}
 
-			ret_result = GetAnimationFromFbxScene(fbxScene_p, _in_elementsToExtract, _out_animationClip);
-			fbxManager_p->Destroy();
+			ret_result = GetAnimationsFromFbxSession(fbxSession_p, _in_elementsToExtract,
+				_out_animationClips);
+			DestroyFbxSession(fbxSession_p);
 			return ret_result;
 		}
 #pragma endregion
@@ -2,10 +2,14 @@
 #define _FBXEXPORTER_LIBRARY_INTERFACE_H_
 
 #include <cstdint>
+#include <iosfwd>
+#include <vector>
 
 #include "defines.h"
 
-#ifdef FBXLIB_EXPORTS
+#if !defined(_WIN32)
+#define FBXLIB_INTERFACE
+#elif defined(FBXLIB_EXPORTS)
 #define FBXLIB_INTERFACE __declspec(dllexport)
 #else
 #define FBXLIB_INTERFACE __declspec(dllimport)
@@ -15,6 +19,10 @@ namespace fbx_exporter
 {
 	namespace library
 	{
+		// Opaque handle to a .fbx file imported once and shared between extractions.
+		struct FbxSession;
+
+
 		/* Converts a Result into a boolean value.
 		  PARAMETERS
 			_in_r : The Result to check.
@@ -22,7 +30,199 @@ namespace fbx_exporter
 			true : The Result is a succeeding value
 			false : The Result is a failing value
 		*/
-		FBXLIB_INTERFACE bool inline Succeeded(Result _in_r);
+		inline bool Succeeded(Result _in_r)
+		{
+			return static_cast<int>(_in_r) >= static_cast<int>(Result::SUCCESS);
+		}
+
+		/* Sets the number of threads used by parallel extraction stages.
+		  PARAMETERS
+			_in_threadCount : The maximum number of threads per extraction.
+				Pass 0 to use one thread per hardware thread. This is the default.
+		  NOTES
+			Callers that already extract several files at once should pass 1.
+		*/
+		FBXLIB_INTERFACE void SetWorkerThreadCount(
+			const uint32_t				_in_threadCount
+		);
+
+		/* Imports a .fbx file into a session that data can be extracted from repeatedly.
+		  PARAMETERS
+			_in_fbxFilepath : The path to the .fbx file to import.
+			_out_fbxSession_p : Pointer to the session created. Must be nullptr when passed.
+		  RETURNS
+			INVALID_ARG : An invalid argument was passed.
+			FAIL : The file could not be imported.
+			SUCCESS : The file was imported and the session was created.
+		  NOTES
+			Sessions must be released with DestroyFbxSession.
+		*/
+		FBXLIB_INTERFACE Result CreateFbxSession(
+			const char*					_in_fbxFilepath
+			, FbxSession*&				_out_fbxSession_p
+		);
+
+		/* Releases a session and all scene data it owns.
+		  PARAMETERS
+			_out_fbxSession_p : The session to release. Set to nullptr on return.
+		*/
+		FBXLIB_INTERFACE void DestroyFbxSession(
+			FbxSession*&				_out_fbxSession_p
+		);
+
+		/* Extracts mesh data from an imported session and stores it in a Mesh.
+		  PARAMETERS
+			_in_fbxSession_p : The session to extract data from.
+			_in_meshName : The mesh name to search the session for, if desired.
+				Pass "" to get the first mesh from the file.
+			_in_elementsToExtract : A bit-flag set indicating which vertex elements to store.
+			_out_mesh : The mesh container to store extracted data in.
+		  RETURNS
+			INVALID_ARG : An invalid argument was passed.
+			EXTRACT : Data was successfully extracted.
+		  NOTES
+			Triangles are grouped by material, stably, and parts holds each material's index range
+			and index among the scene's materials. A mesh without a material layer gets no parts.
+			With MeshElement::SKIN, each vertex keeps its four strongest skin influences,
+			renormalized, indexing joints in the order extracted animations store them.
+		*/
+		FBXLIB_INTERFACE Result GetMeshFromFbxSession(
+			const FbxSession*			_in_fbxSession_p
+			, const char*				_in_meshName
+			, const uint32_t			_in_elementsToExtract
+			, Mesh&						_out_mesh
+		);
+
+		/* Extracts every mesh of an imported session into one Mesh, with a part per mesh and material.
+		  PARAMETERS
+			_in_fbxSession_p : The session to extract data from.
+			_in_elementsToExtract : A bit-flag set indicating which vertex elements to store.
+			_out_mesh : The mesh container to store extracted data in.
+		  RETURNS
+			INVALID_ARG : An invalid argument was passed.
+			FAIL : The session has no mesh with polygons.
+			SUCCESS : Data was successfully extracted.
+		  NOTES
+			The vertices and indices of every mesh geometry are stored one after another, so the
+			whole model draws from one vertex and one index buffer. Each mesh's triangles are
+			grouped by material, stably, and parts holds each group's mesh name, material, index
+			range, vertex range and the global transform of its node; vertices stay in the mesh's
+			own space. Indices are absolute. Parts are welded separately and never share vertices.
+			A geometry used by several nodes is extracted once, with its first node's transform.
+			Skin weights are extracted as by GetMeshFromFbxSession.
+		*/
+		FBXLIB_INTERFACE Result GetMeshesFromFbxSession(
+			const FbxSession*			_in_fbxSession_p
+			, const uint32_t			_in_elementsToExtract
+			, Mesh&						_out_mesh
+		);
+
+		/* Extracts mesh data from an imported session, writing indices to a stream as they are made.
+		  PARAMETERS
+			_in_fbxSession_p : The session to extract data from.
+			_in_meshName : The mesh name to search the session for, if desired.
+				Pass "" to get the first mesh from the file.
+			_in_elementsToExtract : A bit-flag set indicating which vertex elements to store.
+			_out_indexStream : The binary stream uint32_t indices are written to.
+			_out_mesh : The mesh container to store extracted vertices and parts in.
+		  RETURNS
+			INVALID_ARG : An invalid argument was passed.
+			FAIL : The mesh has no polygons, or the stream failed.
+			SUCCESS : Data was successfully extracted.
+		  NOTES
+			Produces the vertices, parts and indices GetMeshFromFbxSession does, but never holds
+			the raw vertices or the whole index list: polygons are resolved a chunk at a time and
+			welded straight into the unique vertex list, and each chunk's indices are written to
+			the stream. Peak memory is the unique vertices plus a fixed chunk window. indices is
+			left empty and index_count holds the number written. Each material takes one pass
+			over the mesh's polygons.
+		*/
+		FBXLIB_INTERFACE Result StreamMeshFromFbxSession(
+			const FbxSession*			_in_fbxSession_p
+			, const char*				_in_meshName
+			, const uint32_t			_in_elementsToExtract
+			, std::ostream&				_out_indexStream
+			, Mesh&						_out_mesh
+		);
+
+		/* Extracts every mesh of an imported session, writing indices to a stream as they are made.
+		  PARAMETERS
+			_in_fbxSession_p : The session to extract data from.
+			_in_elementsToExtract : A bit-flag set indicating which vertex elements to store.
+			_out_indexStream : The binary stream uint32_t indices are written to.
+			_out_mesh : The mesh container to store extracted vertices and parts in.
+		  RETURNS
+			INVALID_ARG : An invalid argument was passed.
+			FAIL : The session has no mesh with polygons, or the stream failed.
+			SUCCESS : Data was successfully extracted.
+		  NOTES
+			Produces the mesh GetMeshesFromFbxSession does, with indices streamed as by
+			StreamMeshFromFbxSession.
+		*/
+		FBXLIB_INTERFACE Result StreamMeshesFromFbxSession(
+			const FbxSession*			_in_fbxSession_p
+			, const uint32_t			_in_elementsToExtract
+			, std::ostream&				_out_indexStream
+			, Mesh&						_out_mesh
+		);
+
+		/* Extracts every material of an imported session and stores them in a MaterialList.
+		  PARAMETERS
+			_in_fbxSession_p : The session to extract data from.
+			_in_elementsToExtract : A bit-flag set indicating which texture elements to store.
+			_out_materialList : The material and filepath container to store extracted data in.
+		  RETURNS
+			INVALID_ARG : An invalid argument was passed.
+			FAIL : The session has no materials.
+			EXTRACT : Data was successfully extracted.
+		  NOTES
+			Materials are stored in the scene's order, so MeshPart::material indexes them.
+			Materials that are not Lambert or Phong keep default components. Texture filepaths
+			are interned with InternTexturePath, so a texture several components or materials
+			use is stored once.
+		*/
+		FBXLIB_INTERFACE Result GetMaterialsFromFbxSession(
+			const FbxSession*			_in_fbxSession_p
+			, const uint32_t			_in_elementsToExtract
+			, MaterialList&				_out_materialList
+		);
+
+		/* Extracts animation data from an imported session and stores it in an AnimationClip.
+		  PARAMETERS
+			_in_fbxSession_p : The session to extract data from.
+			_in_elementsToExtract : A bit-flag set indicating which animation elements to store.
+			_out_animationClip : The animation container to store extracted data in.
+		  RETURNS
+			INVALID_ARG : An invalid argument was passed.
+			EXTRACT : Data was successfully extracted.
+		  NOTES
+			Extracts animations at 30 frames per second. Every frame's joint transforms are stored
+			in the clip's one transforms buffer, sized once from the frame count.
+		*/
+		FBXLIB_INTERFACE Result GetAnimationFromFbxSession(
+			const FbxSession*			_in_fbxSession_p
+			, const uint32_t			_in_elementsToExtract
+			, AnimationClip&			_out_animationClip
+		);
+
+		/* Extracts every animation stack from an imported session.
+		  PARAMETERS
+			_in_fbxSession_p : The session to extract data from.
+			_in_elementsToExtract : A bit-flag set indicating which animation elements to store.
+			_out_animationClips : The animation containers to store extracted data in, one per stack.
+		  RETURNS
+			INVALID_ARG : An invalid argument was passed.
+			FAIL : The session has no skeleton or no animation stacks.
+			EXTRACT : Data was successfully extracted.
+		  NOTES
+			Extracts animations at 30 frames per second. Each clip is named after its stack, and
+			all clips share the skeleton, bind pose, and skeleton hash of the session.
+		*/
+		FBXLIB_INTERFACE Result GetAnimationsFromFbxSession(
+			const FbxSession*			_in_fbxSession_p
+			, const uint32_t			_in_elementsToExtract
+			, std::vector<AnimationClip>&	_out_animationClips
+		);
 
 		/* Extracts mesh data from a .fbx file and stores it in a Mesh.
 		  PARAMETERS
@@ -42,19 +242,38 @@ namespace fbx_exporter
 			, Mesh&						_out_mesh
 		);
 
-		/* Extracts material data from a .fbx file and stores it in a Material.
+		/* Extracts every mesh of a .fbx file into one Mesh, with a part per mesh and material.
+		  PARAMETERS
+			_in_fbxFilepath : The path to the .fbx file to read from.
+			_in_elementsToExtract : A bit-flag set indicating which vertex elements to store.
+			_out_mesh : The mesh container to store extracted data in.
+		  RETURNS
+			INVALID_ARG : An invalid argument was passed.
+			FAIL : The file has no mesh with polygons.
+			SUCCESS : Data was successfully extracted.
+		  NOTES
+			See GetMeshesFromFbxSession.
+		*/
+		FBXLIB_INTERFACE Result GetMeshesFromFbxFile(
+			const char*					_in_fbxFilepath
+			, const uint32_t			_in_elementsToExtract
+			, Mesh&						_out_mesh
+		);
+
+		/* Extracts every material of a .fbx file and stores them in a MaterialList.
 		  PARAMETERS
 			_in_fbxFilepath : The path to the .fbx file to read from.
-			_in_materialNum : The material number to get from the .fbx file.
 			_in_elementsToExtract : A bit-flag set indicating which texture elements to store.
 			_out_materialList : The material and filepath container to store extracted data in.
 		  RETURNS
 			INVALID_ARG : An invalid argument was passed.
+			FAIL : The file has no materials.
 			EXTRACT : Data was successfully extracted.
+		  NOTES
+			See GetMaterialsFromFbxSession.
 		*/
 		FBXLIB_INTERFACE Result GetMaterialsFromFbxFile(
 			const char*					_in_fbxFilepath
-			, const uint32_t			_in_materialNum
 			, const uint32_t			_in_elementsToExtract
 			, MaterialList&				_out_materialList
 		);
@@ -76,6 +295,367 @@ namespace fbx_exporter
 			, AnimationClip&			_out_animationClip
 		);
 
+		/* Extracts every animation stack from a .fbx file.
+		  PARAMETERS
+			_in_fbxFilepath : The path to the .fbx file to read from.
+			_in_elementsToExtract : A bit-flag set indicating which animation elements to store.
+			_out_animationClips : The animation containers to store extracted data in, one per stack.
+		  RETURNS
+			INVALID_ARG : An invalid argument was passed.
+			FAIL : File could not be opened, or has no skeleton or no animation stacks.
+			EXTRACT : Data was successfully extracted.
+		  NOTES
+			Extracts animations at 30 frames per second.
+		*/
+		FBXLIB_INTERFACE Result GetAnimationsFromFbxFile(
+			const char*					_in_fbxFilepath
+			, const uint32_t			_in_elementsToExtract
+			, std::vector<AnimationClip>&	_out_animationClips
+		);
+
+		/* Extracts mesh data from a binary .fbx file without the FBX SDK and stores it in a Mesh.
+		  PARAMETERS
+			_in_fbxFilepath : The path to the binary .fbx file to read from.
+			_in_meshName : The mesh name to search the .fbx file for, if desired.
+				Pass "" to get the first mesh from the file.
+			_in_elementsToExtract : A bit-flag set indicating which vertex elements to store.
+			_out_mesh : The mesh container to store extracted data in.
+		  RETURNS
+			INVALID_ARG : An invalid argument was passed.
+			FAIL : File is not a binary .fbx file, or contains no matching mesh.
+			EXTRACT : Data was successfully extracted.
+		  NOTES
+			The file is memory-mapped and only the arrays needed for the requested elements
+			are read. Polygons with more than three vertices are fan-triangulated.
+			As with GetMeshFromFbxFile, a mesh with materials is split into one MeshPart per
+			material, ordered by material index and welded separately. Part transforms compose
+			the node's local translation, rotation, scaling, pivots and pre/post rotations up
+			the parent chain, without the SDK's inherit-type variants.
+		*/
+		FBXLIB_INTERFACE Result GetMeshFromFbxBinaryFile(
+			const char*					_in_fbxFilepath
+			, const char*				_in_meshName
+			, const uint32_t			_in_elementsToExtract
+			, Mesh&						_out_mesh
+		);
+
+		/* Extracts every material of a binary .fbx file without the FBX SDK and stores them in a MaterialList.
+		  PARAMETERS
+			_in_fbxFilepath : The path to the binary .fbx file to read from.
+			_in_elementsToExtract : A bit-flag set indicating which texture elements to store.
+			_out_materialList : The material and filepath container to store extracted data in.
+		  RETURNS
+			INVALID_ARG : An invalid argument was passed.
+			FAIL : File is not a binary .fbx file, or contains no materials.
+			EXTRACT : Data was successfully extracted.
+		  NOTES
+			Materials are stored in the order of the file's Material objects. Texture filepaths
+			are interned as by GetMaterialsFromFbxSession.
+		*/
+		FBXLIB_INTERFACE Result GetMaterialsFromFbxBinaryFile(
+			const char*					_in_fbxFilepath
+			, const uint32_t			_in_elementsToExtract
+			, MaterialList&				_out_materialList
+		);
+
+		/* Adds a texture filepath to a material list unless the list already holds it.
+		  PARAMETERS
+			_in_filepath_p : The characters of the filepath. Need not be null-terminated.
+			_in_length : The number of characters in the filepath.
+			_out_materialList : The list to add the filepath to.
+		  RETURNS
+			int32_t : The index of the filepath in _out_materialList.textures.
+		  NOTES
+			Filepaths are compared character for character. A scene has few textures, so the
+			list is searched rather than hashed.
+		*/
+		FBXLIB_INTERFACE int32_t InternTexturePath(
+			const char*					_in_filepath_p
+			, const uint32_t			_in_length
+			, MaterialList&				_out_materialList
+		);
+
+		/* Reads and decodes an image file referenced by a material.
+		  PARAMETERS
+			_in_filepath : The path to the .png or .tga file to read.
+			_out_image : The decoded image, converted to 8-bit RGBA.
+		  RETURNS
+			INVALID_ARG : An invalid argument was passed.
+			FAIL : File could not be read, or is not a supported image.
+			SUCCESS : The image was decoded.
+		  NOTES
+			PNG files of any color type and bit depth are supported, except interlaced ones;
+			16-bit channels keep their high byte. TGA files may be true-color or grayscale, and
+			run-length encoded. Palette transparency is kept, color-key transparency is not.
+		*/
+		FBXLIB_INTERFACE Result LoadImageFile(
+			const char*					_in_filepath
+			, Image&					_out_image
+		);
+
+		/* Block-compresses a set of images for the GPU.
+		  PARAMETERS
+			_in_images : The images to compress.
+			_in_formats : The format of each image's texture.
+			_out_textures : The compressed texture of each image.
+			_out_stats : Encoding time and PSNR of each texture.
+		  RETURNS
+			INVALID_ARG : The counts differ, an image is empty or its pixels do not match its size,
+			  or a format is unknown.
+			SUCCESS : Every image was compressed.
+		  NOTES
+			Every row of blocks of every image becomes part of one job list, cut into jobs of about
+			TEXTURE_JOB_BLOCK_COUNT blocks, so the set is encoded in parallel across textures and
+			across blocks on up to GetWorkerThreadCount() threads. Block endpoints start on the
+			principal axis of the block's colors and are refined by least squares against the
+			chosen indices. BC1 blocks always use four colors and BC7 blocks use mode 6. PSNR
+			compares the decoded blocks with the image over the channels the format stores.
+		*/
+		FBXLIB_INTERFACE Result CompressTextures(
+			const std::vector<Image>&	_in_images
+			, const std::vector<TextureFormat>&	_in_formats
+			, std::vector<CompressedTexture>&	_out_textures
+			, std::vector<TextureCompressionStats>&	_out_stats
+		);
+
+		/* Builds a chain of coarser levels of detail of a mesh by quadric error edge collapse.
+		  PARAMETERS
+			_in_mesh : The mesh to simplify, such as one from GetMeshFromFbxSession. If it already has
+			  levels of detail, they are rebuilt from its first level.
+			_in_triangleRatios : The fraction of the mesh's triangles to keep in each level, each
+			  between 0 and 1 and smaller than the last.
+			_out_mesh : The mesh with its levels of detail. May be the same mesh as _in_mesh.
+		  RETURNS
+			INVALID_ARG : The mesh has no triangles, an index is out of range, its parts do not
+			  cover its levels in order, or a ratio is invalid.
+			SUCCESS : The levels of detail were built.
+		  NOTES
+			The indices of every level are stored one after another, and lods holds the range and
+			error of each, starting with the source mesh. All levels use the source vertices.
+			Vertices on open borders only collapse along the border, and vertices split by a normal,
+			color, or UV seam only collapse along the seam, with both sides together, so seams and
+			attribute discontinuities keep their shape. Each level continues from the last, and the
+			chain stops early when no allowed collapse is left. To select a level at runtime, project
+			its error: pixels = error * viewport height / (2 * distance * tan(vertical fov / 2)).
+			Each part is simplified alone, in parallel, and every level lists a copy of each part
+			with its own range; a level's error is the largest of its parts'. Submeshes and
+			meshlets are not kept; split the mesh and build meshlets again.
+		*/
+		FBXLIB_INTERFACE Result GenerateMeshLods(
+			const Mesh&					_in_mesh
+			, const std::vector<float>&	_in_triangleRatios
+			, Mesh&						_out_mesh
+		);
+
+		/* Reorders a mesh for GPU post-transform vertex cache reuse and vertex fetch locality.
+		  PARAMETERS
+			_in_mesh : The mesh to reorder, such as one from GetMeshFromFbxSession.
+			_out_mesh : The reordered mesh. May be the same mesh as _in_mesh.
+			_out_stats : Vertex cache efficiency before and after reordering.
+		  RETURNS
+			INVALID_ARG : The mesh has no triangles, an index is out of range, or its levels of
+			  detail or parts do not cover its indices in order.
+			SUCCESS : The mesh was reordered.
+		  NOTES
+			Triangles are reordered first, then vertices are renumbered in the order the reordered
+			triangles first use them. Vertices no triangle uses are removed. The triangles drawn
+			and their winding are unchanged. Triangles of each level of detail and each part are
+			reordered within it, and efficiency is measured on the first level with a FIFO cache of
+			VERTEX_CACHE_MEASURE_SIZE entries. Submeshes and meshlets are not kept; split the mesh
+			and build meshlets again.
+		*/
+		FBXLIB_INTERFACE Result OptimizeMesh(
+			const Mesh&					_in_mesh
+			, Mesh&						_out_mesh
+			, MeshOptimizationStats&	_out_stats
+		);
+
+		/* Splits a mesh into submeshes whose vertices can be addressed with 16-bit indices.
+		  PARAMETERS
+			_in_mesh : The mesh to split. Any existing submeshes are ignored.
+			_out_mesh : The split mesh. May be the same mesh as _in_mesh.
+			_out_stats : Vertex counts and index list sizes before and after splitting.
+		  RETURNS
+			INVALID_ARG : The mesh has no triangles, an index is out of range, or its levels of
+			  detail or parts do not cover its indices in order.
+			SUCCESS : The mesh was split.
+		  NOTES
+			Meshes of up to SHORT_INDEX_VERTEX_LIMIT vertices keep their vertices and get one
+			submesh per level of detail and part. Larger meshes are cut in triangle order, each
+			submesh taking triangles until one more would need too many vertices or a new level or
+			part starts. Each submesh gets its own contiguous vertex range in order of first use,
+			so vertices shared with earlier submeshes are copied. Indices stay absolute; subtract
+			Submesh::base_vertex to get 16-bit indices, as GetShortIndices does. Part vertex ranges
+			are updated. Meshlets are not kept; build them again with BuildMeshlets.
+		*/
+		FBXLIB_INTERFACE Result SplitMeshForShortIndices(
+			const Mesh&					_in_mesh
+			, Mesh&						_out_mesh
+			, IndexSplitStats&			_out_stats
+		);
+
+		/* Builds the 16-bit index list of a split mesh.
+		  PARAMETERS
+			_in_mesh : The mesh to read indices from.
+			_out_indices : The indices, each relative to the base vertex of its submesh.
+		  RETURNS
+			INVALID_ARG : A submesh has too many vertices for 16-bit indices, or the mesh was not
+			  split and has too many vertices.
+			SUCCESS : The index list was built.
+		  NOTES
+			Draw each submesh with its index_offset and index_count, and base_vertex as the base
+			vertex location.
+		*/
+		FBXLIB_INTERFACE Result GetShortIndices(
+			const Mesh&					_in_mesh
+			, std::vector<uint16_t>&	_out_indices
+		);
+
+		/* Splits each level of detail of a mesh into meshlets for mesh shaders and cluster culling.
+		  PARAMETERS
+			_in_mesh : The mesh to split, after its indices and vertices are final.
+			_in_maxVertices : Most vertices per meshlet, such as MESHLET_DEFAULT_VERTEX_COUNT.
+			_in_maxTriangles : Most triangles per meshlet, such as MESHLET_DEFAULT_TRIANGLE_COUNT.
+			_out_mesh : The mesh with its meshlets. May be the same mesh as _in_mesh.
+			_out_stats : Meshlet counts and how full the meshlets are.
+		  RETURNS
+			INVALID_ARG : The mesh has no triangles, an index is out of range, its levels of detail
+			  or parts do not cover its indices in order, or a limit is outside 3 to MESHLET_VERTEX_LIMIT
+			  vertices or 1 to MESHLET_TRIANGLE_LIMIT triangles.
+			SUCCESS : The meshlets were built.
+		  NOTES
+			Triangles of each level and part are sorted along a Z-order curve and cut into runs of
+			MESHLET_JOB_TRIANGLE_COUNT, which are split into meshlets in parallel on up to
+			GetWorkerThreadCount() threads. Each meshlet lists the mesh vertices it uses, and its
+			triangles index that list with 8-bit values. Each meshlet gets a bounding sphere and a
+			normal cone; skip drawing it when dot(normalize(cone_apex - eye), cone_axis) is at least
+			cone_cutoff. Indices, vertices and submeshes are unchanged, and each level of detail and
+			part records the range of its meshlets.
+		*/
+		FBXLIB_INTERFACE Result BuildMeshlets(
+			const Mesh&					_in_mesh
+			, const uint32_t			_in_maxVertices
+			, const uint32_t			_in_maxTriangles
+			, Mesh&						_out_mesh
+			, MeshletBuildStats&		_out_stats
+		);
+
+		/* Packs mesh vertices into a compact layout.
+		  PARAMETERS
+			_in_mesh : The mesh to pack.
+			_in_layout : The elements to store and their formats. Elements left out take no space.
+			_out_packedMesh : The packed mesh.
+			_out_stats : Vertex sizes before and after packing, and the largest errors measured.
+		  RETURNS
+			INVALID_ARG : The mesh has no vertices, the layout has no elements, or a joint index
+			  does not fit the skin format.
+			SUCCESS : The vertices were packed.
+		  NOTES
+			Four vertices are encoded by each SIMD operation. UNORM16 positions and texture
+			coordinates span the bounds of the mesh, which are stored in the packed mesh. Colors
+			are clamped to 0 to 1 for UNORM8. UNORM8 skin weights are rounded so each vertex's
+			weights still sum to 1. Errors are measured by unpacking the result.
+		*/
+		FBXLIB_INTERFACE Result PackMeshVertices(
+			const Mesh&					_in_mesh
+			, const VertexLayout&		_in_layout
+			, PackedMesh&				_out_packedMesh
+			, VertexPackingStats&		_out_stats
+		);
+
+		/* Unpacks the vertices of a packed mesh.
+		  PARAMETERS
+			_in_packedMesh : The mesh to unpack.
+			_out_mesh : The unpacked mesh. Elements missing from the layout are zero.
+		  RETURNS
+			INVALID_ARG : The packed mesh holds fewer bytes than its vertex count and stride require.
+			SUCCESS : The vertices were unpacked.
+		*/
+		FBXLIB_INTERFACE Result UnpackMeshVertices(
+			const PackedMesh&			_in_packedMesh
+			, Mesh&						_out_mesh
+		);
+
+		/* Hashes a skeleton so clips exported from different files can share one bind pose.
+		  PARAMETERS
+			_in_joints : The bind pose joints to hash.
+		  RETURNS
+			uint64_t : The hash of the joint hierarchy and bind pose.
+		  NOTES
+			Bind pose values are rounded to 1/1024 units before hashing, so re-exports of the same
+			skeleton hash alike despite float noise.
+		*/
+		FBXLIB_INTERFACE uint64_t GetSkeletonHash(
+			const std::vector<AnimationJoint>&	_in_joints
+		);
+
+		/* Removes animation keys that can be interpolated from their neighbours within a tolerance.
+		  PARAMETERS
+			_in_animationClip : The densely sampled clip to reduce.
+			_in_tolerance : The largest errors allowed at leaf joints, in model space.
+			_out_sparseClip : The parent-relative channel keys kept per joint.
+			_out_stats : Key counts before and after reduction, and the largest errors measured.
+		  RETURNS
+			INVALID_ARG : The clip has no joints or frames, or transforms does not hold one per joint per frame.
+			SUCCESS : The clip was reduced.
+		  NOTES
+			Each joint's translation, rotation, and scale channels are reduced separately. Rotation
+			and scale tolerances are tightened by the length of the joint chain below each joint.
+			Every frame is then rebuilt from the kept keys and compared at the leaf joints; chains
+			that exceed the tolerance are reduced again with tighter tolerances. Error reported
+			above the tolerance comes from shear, which translation, rotation, and scale cannot hold.
+		*/
+		FBXLIB_INTERFACE Result ReduceAnimationClip(
+			const AnimationClip&		_in_animationClip
+			, const AnimationTolerance&	_in_tolerance
+			, SparseAnimationClip&		_out_sparseClip
+			, AnimationReductionStats&	_out_stats
+		);
+
+		/* Measures the error of channel keys against the clip they were built from.
+		  PARAMETERS
+			_in_animationClip : The densely sampled reference clip.
+			_in_sparseClip : The channel keys to check, such as a decoded QuantizedAnimationClip.
+			_out_stats : The largest errors measured at leaf joints, in model space.
+		  RETURNS
+			INVALID_ARG : The clips have different joint counts, or the reference clip is invalid.
+			SUCCESS : The error was measured.
+		*/
+		FBXLIB_INTERFACE Result MeasureAnimationClipError(
+			const AnimationClip&		_in_animationClip
+			, const SparseAnimationClip&	_in_sparseClip
+			, AnimationReductionStats&	_out_stats
+		);
+
+		/* Quantizes channel keys into a compact clip.
+		  PARAMETERS
+			_in_sparseClip : The channel keys to quantize.
+			_out_quantizedClip : The quantized clip.
+		  RETURNS
+			INVALID_ARG : A joint is missing tracks, or a track has no keys.
+			SUCCESS : The clip was quantized.
+		  NOTES
+			Rotations are stored as the three smallest quaternion components in 15 bits each,
+			plus the index of the largest component. Translation and scale are quantized to
+			16 bits within the range of each track, and constant tracks keep no keys.
+		*/
+		FBXLIB_INTERFACE Result QuantizeAnimationClip(
+			const SparseAnimationClip&	_in_sparseClip
+			, QuantizedAnimationClip&	_out_quantizedClip
+		);
+
+		/* Decodes a quantized clip back into channel keys.
+		  PARAMETERS
+			_in_quantizedClip : The clip to decode.
+			_out_sparseClip : The decoded channel keys.
+		  RETURNS
+			SUCCESS : The clip was decoded.
+		*/
+		FBXLIB_INTERFACE Result DecodeQuantizedAnimationClip(
+			const QuantizedAnimationClip&	_in_quantizedClip
+			, SparseAnimationClip&		_out_sparseClip
+		);
+
 	}
 }
 
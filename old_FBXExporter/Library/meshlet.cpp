@@ -0,0 +1,633 @@
+#include "interface.h"
+#include "meshlet.h"
+#include "optimize.h"
+#include "parallel.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+
+namespace fbx_exporter
+{
+	namespace library
+	{
+#pragma region Private Helper Functions
+		enum : uint32_t
+		{
+			NO_MESHLET_TRIANGLE = 0xFFFFFFFF  // Marks that no neighbouring triangle fits the open meshlet.
+			, EMPTY_VERTEX_ENTRY = 0xFFFFFFFF  // Marks an unused entry in a job's vertex table.
+			, MORTON_AXIS_BITS = 10  // Bits of each centroid coordinate interleaved into a Z-order key.
+		};
+
+		// Marks a job-local vertex that is not in the open meshlet.
+		const uint16_t NO_MESHLET_SLOT = 0xFFFF;
+
+		// Normals of a meshlet must all lie within about 84 degrees of the axis for the cone to cull anything.
+		const float MESHLET_CONE_MIN_DOT = 0.1f;
+
+		uint32_t SpreadMortonBits(
+			uint32_t					_in_value
+		) {
+			// insert two zero bits between each of the low ten bits
+			uint32_t x = _in_value & 0x000003FF;
+			x = (x | (x << 16)) & 0xFF0000FF;
+			x = (x | (x << 8)) & 0x0300F00F;
+			x = (x | (x << 4)) & 0x030C30C3;
+			x = (x | (x << 2)) & 0x09249249;
+			return x;
+		}
+
+		bool GetFaceNormal(
+			const float*				_in_p0_p
+			, const float*				_in_p1_p
+			, const float*				_in_p2_p
+			, float*					_out_normal_p
+		) {
+			float e1[3] = { _in_p1_p[0] - _in_p0_p[0], _in_p1_p[1] - _in_p0_p[1], _in_p1_p[2] - _in_p0_p[2] };
+			float e2[3] = { _in_p2_p[0] - _in_p0_p[0], _in_p2_p[1] - _in_p0_p[1], _in_p2_p[2] - _in_p0_p[2] };
+
+			float n[3] =
+			{
+				e1[1] * e2[2] - e1[2] * e2[1]
+				, e1[2] * e2[0] - e1[0] * e2[2]
+				, e1[0] * e2[1] - e1[1] * e2[0]
+			};
+			float length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+
+			// degenerate triangles face no direction
+			if (length == 0.0f)
+				return false;
+
+			for (int c = 0; c < 3; c++)
+				_out_normal_p[c] = n[c] / length;
+			return true;
+		}
+
+		uint32_t CountNewMeshletVertices(
+			const uint32_t*				_in_corners_p
+			, const std::vector<uint16_t>&	_in_slots
+		) {
+			return (_in_slots[_in_corners_p[0]] == NO_MESHLET_SLOT ? 1 : 0)
+				+ (_in_slots[_in_corners_p[1]] == NO_MESHLET_SLOT && _in_corners_p[1] != _in_corners_p[0] ? 1 : 0)
+				+ (_in_slots[_in_corners_p[2]] == NO_MESHLET_SLOT && _in_corners_p[2] != _in_corners_p[0] && _in_corners_p[2] != _in_corners_p[1] ? 1 : 0);
+		}
+
+		void CloseMeshlet(
+			const std::vector<uint32_t>&	_in_jobVertices
+			, std::vector<uint32_t>&	_out_openVertices
+			, std::vector<uint16_t>&	_out_slots
+			, Meshlet&					_out_meshlet
+			, std::vector<Meshlet>&		_out_meshlets
+			, std::vector<uint32_t>&	_out_meshletVertices
+			, std::vector<uint8_t>&		_out_meshletTriangles
+		) {
+			_out_meshlet.vertex_offset = (uint32_t)_out_meshletVertices.size();
+			_out_meshlet.vertex_count = (uint32_t)_out_openVertices.size();
+
+			// translate job-local vertices back to mesh vertices and free their slots
+			for (uint32_t v : _out_openVertices)
+			{
+				_out_meshletVertices.push_back(_in_jobVertices[v]);
+				_out_slots[v] = NO_MESHLET_SLOT;
+			}
+			_out_openVertices.clear();
+
+			// keep every meshlet's triangles 4-byte aligned for 32-bit loads
+			while (_out_meshletTriangles.size() % 4 != 0)
+				_out_meshletTriangles.push_back(0);
+
+			_out_meshlets.push_back(_out_meshlet);
+			_out_meshlet = Meshlet();
+			_out_meshlet.triangle_offset = (uint32_t)_out_meshletTriangles.size();
+		}
+#pragma endregion
+
+#pragma region Meshlet Function Definitions
+		void SortTrianglesSpatially(
+			const std::vector<Vertex>&	_in_vertices
+			, const uint32_t*			_in_indices_p
+			, const uint32_t			_in_triangleCount
+			, std::vector<uint32_t>&	_out_triangles
+		) {
+			std::vector<float> centroids(_in_triangleCount * 3);
+			float minimum[3] = { FLT_MAX, FLT_MAX, FLT_MAX };
+			float maximum[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+
+			for (uint32_t t = 0; t < _in_triangleCount; t++)
+			{
+				const float* p0 = _in_vertices[_in_indices_p[t * 3 + 0]].pos;
+				const float* p1 = _in_vertices[_in_indices_p[t * 3 + 1]].pos;
+				const float* p2 = _in_vertices[_in_indices_p[t * 3 + 2]].pos;
+
+				for (int c = 0; c < 3; c++)
+				{
+					float centroid = (p0[c] + p1[c] + p2[c]) / 3.0f;
+					centroids[t * 3 + c] = centroid;
+					minimum[c] = std::min(minimum[c], centroid);
+					maximum[c] = std::max(maximum[c], centroid);
+				}
+			}
+
+			// one scale for all axes so the curve's cells stay cubes
+			float extent = std::max(maximum[0] - minimum[0], std::max(maximum[1] - minimum[1], maximum[2] - minimum[2]));
+			float scale = extent > 0.0f ? (float)((1 << MORTON_AXIS_BITS) - 1) / extent : 0.0f;
+
+			// sort keys hold the Z-order code above the triangle number
+			std::vector<uint64_t> keys(_in_triangleCount);
+			for (uint32_t t = 0; t < _in_triangleCount; t++)
+			{
+				uint32_t code = 0;
+				for (int c = 0; c < 3; c++)
+					code |= SpreadMortonBits((uint32_t)((centroids[t * 3 + c] - minimum[c]) * scale + 0.5f)) << c;
+				keys[t] = ((uint64_t)code << 32) | t;
+			}
+			std::sort(keys.begin(), keys.end());
+
+			_out_triangles.resize(_in_triangleCount);
+			for (uint32_t t = 0; t < _in_triangleCount; t++)
+				_out_triangles[t] = (uint32_t)keys[t];
+		}
+
+		void BuildMeshletsForTriangles(
+			const std::vector<Vertex>&	_in_vertices
+			, const uint32_t*			_in_indices_p
+			, const uint32_t*			_in_triangles_p
+			, const uint32_t			_in_triangleCount
+			, const uint32_t			_in_maxVertices
+			, const uint32_t			_in_maxTriangles
+			, std::vector<Meshlet>&		_out_meshlets
+			, std::vector<uint32_t>&	_out_meshletVertices
+			, std::vector<uint8_t>&		_out_meshletTriangles
+		) {
+			// -- job-local vertices --
+			// number the job's vertices densely so per-vertex state stays proportional to the job,
+			// looking them up in an open-addressing table at least twice the size of the corner count
+			uint32_t tableSize = 1;
+			while (tableSize < _in_triangleCount * 6)
+				tableSize *= 2;
+			std::vector<uint32_t> tableKeys(tableSize, EMPTY_VERTEX_ENTRY);
+			std::vector<uint32_t> tableValues(tableSize);
+
+			std::vector<uint32_t> jobVertices;
+			std::vector<uint32_t> corners(_in_triangleCount * 3);
+			std::vector<float> centroids(_in_triangleCount * 3, 0.0f);
+			for (uint32_t t = 0; t < _in_triangleCount; t++)
+			{
+				for (int c = 0; c < 3; c++)
+				{
+					uint32_t index = _in_indices_p[_in_triangles_p[t] * 3 + c];
+					uint32_t slot = (index * 2654435761u) & (tableSize - 1);
+					while (tableKeys[slot] != index && tableKeys[slot] != EMPTY_VERTEX_ENTRY)
+						slot = (slot + 1) & (tableSize - 1);
+					if (tableKeys[slot] != index)
+					{
+						tableKeys[slot] = index;
+						tableValues[slot] = (uint32_t)jobVertices.size();
+						jobVertices.push_back(index);
+					}
+
+					corners[t * 3 + c] = tableValues[slot];
+					for (int k = 0; k < 3; k++)
+						centroids[t * 3 + k] += _in_vertices[index].pos[k] / 3.0f;
+				}
+			}
+			uint32_t vertexCount = (uint32_t)jobVertices.size();
+			// -- /job-local vertices --
+
+			// -- vertex adjacency --
+			// triangles of each vertex, packed by vertex
+			std::vector<uint32_t> adjacencyOffsets(vertexCount + 1, 0);
+			for (uint32_t corner : corners)
+				adjacencyOffsets[corner + 1]++;
+			for (uint32_t v = 0; v < vertexCount; v++)
+				adjacencyOffsets[v + 1] += adjacencyOffsets[v];
+
+			// emitted triangles are moved past the live count so they are never scanned again
+			std::vector<uint32_t> adjacency(corners.size());
+			std::vector<uint32_t> liveCounts(vertexCount, 0);
+			for (uint32_t i = 0; i < (uint32_t)corners.size(); i++)
+				adjacency[adjacencyOffsets[corners[i]] + liveCounts[corners[i]]++] = i / 3;
+			// -- /vertex adjacency --
+
+			std::vector<uint8_t> emitted(_in_triangleCount, 0);
+			std::vector<uint16_t> slots(vertexCount, NO_MESHLET_SLOT);
+			std::vector<uint32_t> openVertices;
+			openVertices.reserve(_in_maxVertices);
+
+			Meshlet meshlet;
+			meshlet.triangle_offset = (uint32_t)_out_meshletTriangles.size();
+			float centerSum[3] = { 0.0f, 0.0f, 0.0f };
+			uint32_t seed = 0;
+			std::vector<uint32_t> freeTriangles;
+
+			for (uint32_t emittedCount = 0; emittedCount < _in_triangleCount; emittedCount++)
+			{
+				uint32_t best = NO_MESHLET_TRIANGLE;
+
+				// -- pick neighbour --
+				// triangles that add no vertices cost nothing, so they are taken without a search
+				while (!freeTriangles.empty() && best == NO_MESHLET_TRIANGLE)
+				{
+					if (!emitted[freeTriangles.back()])
+						best = freeTriangles.back();
+					freeTriangles.pop_back();
+				}
+
+				if (meshlet.triangle_count > 0 && best == NO_MESHLET_TRIANGLE)
+				{
+					float center[3] =
+					{
+						centerSum[0] / meshlet.triangle_count
+						, centerSum[1] / meshlet.triangle_count
+						, centerSum[2] / meshlet.triangle_count
+					};
+					uint32_t bestNewVertices = 4;
+					float bestDistance = FLT_MAX;
+
+					for (uint32_t v : openVertices)
+					{
+						for (uint32_t a = adjacencyOffsets[v]; a < adjacencyOffsets[v] + liveCounts[v]; a++)
+						{
+							uint32_t t = adjacency[a];
+							uint32_t newVertices = CountNewMeshletVertices(&corners[t * 3], slots);
+							if (openVertices.size() + newVertices > _in_maxVertices || newVertices > bestNewVertices)
+								continue;
+
+							float d[3] =
+							{
+								centroids[t * 3 + 0] - center[0]
+								, centroids[t * 3 + 1] - center[1]
+								, centroids[t * 3 + 2] - center[2]
+							};
+							float distance = d[0] * d[0] + d[1] * d[1] + d[2] * d[2];
+							if (newVertices < bestNewVertices || distance < bestDistance)
+							{
+								best = t;
+								bestNewVertices = newVertices;
+								bestDistance = distance;
+							}
+						}
+					}
+
+					// no neighbour fits, so continue with the first triangle left in spatial order,
+					// starting the next meshlet only once that one does not fit either
+					if (best == NO_MESHLET_TRIANGLE)
+					{
+						while (emitted[seed])
+							seed++;
+
+						if (openVertices.size() + CountNewMeshletVertices(&corners[seed * 3], slots) <= _in_maxVertices)
+							best = seed;
+						else
+						{
+							CloseMeshlet(jobVertices, openVertices, slots, meshlet,
+								_out_meshlets, _out_meshletVertices, _out_meshletTriangles);
+							centerSum[0] = centerSum[1] = centerSum[2] = 0.0f;
+						}
+					}
+				}
+
+				// start from the first triangle left in spatial order
+				if (best == NO_MESHLET_TRIANGLE)
+				{
+					while (emitted[seed])
+						seed++;
+					best = seed;
+				}
+				// -- /pick neighbour --
+
+				// -- add triangle --
+				uint32_t firstNewVertex = (uint32_t)openVertices.size();
+				for (int c = 0; c < 3; c++)
+				{
+					uint32_t v = corners[best * 3 + c];
+					if (slots[v] == NO_MESHLET_SLOT)
+					{
+						slots[v] = (uint16_t)openVertices.size();
+						openVertices.push_back(v);
+					}
+					_out_meshletTriangles.push_back((uint8_t)slots[v]);
+				}
+				for (int k = 0; k < 3; k++)
+					centerSum[k] += centroids[best * 3 + k];
+				emitted[best] = 1;
+
+				for (int c = 0; c < 3; c++)
+				{
+					uint32_t v = corners[best * 3 + c];
+					uint32_t* live = &adjacency[adjacencyOffsets[v]];
+					for (uint32_t a = 0; a < liveCounts[v]; a++)
+					{
+						if (live[a] == best)
+						{
+							live[a] = live[--liveCounts[v]];
+							break;
+						}
+					}
+				}
+
+				// a triangle adds no vertices once its last vertex joins the meshlet
+				for (uint32_t n = firstNewVertex; n < (uint32_t)openVertices.size(); n++)
+				{
+					uint32_t v = openVertices[n];
+					for (uint32_t a = adjacencyOffsets[v]; a < adjacencyOffsets[v] + liveCounts[v]; a++)
+					{
+						const uint32_t* corner = &corners[adjacency[a] * 3];
+						if (slots[corner[0]] != NO_MESHLET_SLOT && slots[corner[1]] != NO_MESHLET_SLOT && slots[corner[2]] != NO_MESHLET_SLOT)
+							freeTriangles.push_back(adjacency[a]);
+					}
+				}
+				meshlet.triangle_count++;
+
+				if (meshlet.triangle_count == _in_maxTriangles)
+				{
+					CloseMeshlet(jobVertices, openVertices, slots, meshlet,
+						_out_meshlets, _out_meshletVertices, _out_meshletTriangles);
+					centerSum[0] = centerSum[1] = centerSum[2] = 0.0f;
+					freeTriangles.clear();
+				}
+				// -- /add triangle --
+			}
+
+			if (meshlet.triangle_count > 0)
+				CloseMeshlet(jobVertices, openVertices, slots, meshlet,
+					_out_meshlets, _out_meshletVertices, _out_meshletTriangles);
+		}
+
+		void ComputeMeshletBounds(
+			const std::vector<Vertex>&	_in_vertices
+			, const uint32_t*			_in_meshletVertices_p
+			, const uint8_t*			_in_meshletTriangles_p
+			, Meshlet&					_out_meshlet
+		) {
+			const uint32_t vertexCount = _out_meshlet.vertex_count;
+			const uint32_t triangleCount = _out_meshlet.triangle_count;
+			auto position = [&](uint32_t _in_local) { return _in_vertices[_in_meshletVertices_p[_in_local]].pos; };
+
+			// -- bounding sphere --
+			// the vertices with the smallest and largest coordinate on each axis
+			uint32_t extremes[3][2] = { { 0, 0 }, { 0, 0 }, { 0, 0 } };
+			for (uint32_t v = 1; v < vertexCount; v++)
+			{
+				const float* p = position(v);
+				for (int c = 0; c < 3; c++)
+				{
+					if (p[c] < position(extremes[c][0])[c])
+						extremes[c][0] = v;
+					if (p[c] > position(extremes[c][1])[c])
+						extremes[c][1] = v;
+				}
+			}
+
+			// start from the axis whose extremes are farthest apart
+			float widest = -1.0f;
+			float center[3] = { 0.0f, 0.0f, 0.0f };
+			float radius = 0.0f;
+			for (int c = 0; c < 3; c++)
+			{
+				const float* a = position(extremes[c][0]);
+				const float* b = position(extremes[c][1]);
+				float d2 = (b[0] - a[0]) * (b[0] - a[0]) + (b[1] - a[1]) * (b[1] - a[1]) + (b[2] - a[2]) * (b[2] - a[2]);
+				if (d2 > widest)
+				{
+					widest = d2;
+					for (int k = 0; k < 3; k++)
+						center[k] = (a[k] + b[k]) * 0.5f;
+					radius = std::sqrt(d2) * 0.5f;
+				}
+			}
+
+			// grow the sphere just enough to hold each vertex outside it
+			for (uint32_t v = 0; v < vertexCount; v++)
+			{
+				const float* p = position(v);
+				float d[3] = { p[0] - center[0], p[1] - center[1], p[2] - center[2] };
+				float distance = std::sqrt(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]);
+				if (distance > radius)
+				{
+					float grown = (radius + distance) * 0.5f;
+					float shift = (grown - radius) / distance;
+					for (int k = 0; k < 3; k++)
+						center[k] += d[k] * shift;
+					radius = grown;
+				}
+			}
+
+			for (int k = 0; k < 3; k++)
+				_out_meshlet.center[k] = center[k];
+			_out_meshlet.radius = radius;
+			// -- /bounding sphere --
+
+			// -- normal cone --
+			std::vector<float> normals(triangleCount * 3);
+			std::vector<uint8_t> facing(triangleCount, 0);
+			float axis[3] = { 0.0f, 0.0f, 0.0f };
+			for (uint32_t t = 0; t < triangleCount; t++)
+			{
+				const uint8_t* corner = &_in_meshletTriangles_p[t * 3];
+				facing[t] = GetFaceNormal(position(corner[0]), position(corner[1]), position(corner[2]), &normals[t * 3]);
+				if (facing[t])
+					for (int k = 0; k < 3; k++)
+						axis[k] += normals[t * 3 + k];
+			}
+
+			// a cutoff of 1 never culls
+			for (int k = 0; k < 3; k++)
+				_out_meshlet.cone_apex[k] = center[k], _out_meshlet.cone_axis[k] = 0.0f;
+			_out_meshlet.cone_cutoff = 1.0f;
+
+			float axisLength = std::sqrt(axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2]);
+			if (axisLength == 0.0f)
+				return;
+			for (int k = 0; k < 3; k++)
+				axis[k] /= axisLength;
+
+			float minimumDot = 1.0f;
+			for (uint32_t t = 0; t < triangleCount; t++)
+				if (facing[t])
+					minimumDot = std::min(minimumDot,
+						normals[t * 3 + 0] * axis[0] + normals[t * 3 + 1] * axis[1] + normals[t * 3 + 2] * axis[2]);
+
+			for (int k = 0; k < 3; k++)
+				_out_meshlet.cone_axis[k] = axis[k];
+			if (minimumDot <= MESHLET_CONE_MIN_DOT)
+				return;
+
+			// move the apex back along the axis until it is behind every triangle's plane
+			float apexDistance = 0.0f;
+			for (uint32_t t = 0; t < triangleCount; t++)
+			{
+				if (!facing[t])
+					continue;
+
+				const float* n = &normals[t * 3];
+				const float* p0 = position(_in_meshletTriangles_p[t * 3]);
+				float planeDistance = (center[0] - p0[0]) * n[0] + (center[1] - p0[1]) * n[1] + (center[2] - p0[2]) * n[2];
+				float along = axis[0] * n[0] + axis[1] * n[1] + axis[2] * n[2];
+				apexDistance = std::max(apexDistance, planeDistance / along);
+			}
+
+			for (int k = 0; k < 3; k++)
+				_out_meshlet.cone_apex[k] = center[k] - axis[k] * apexDistance;
+
+			// the cone's half-angle is acos(minimumDot), and back-facing starts at its sine
+			_out_meshlet.cone_cutoff = std::sqrt(1.0f - minimumDot * minimumDot);
+			// -- /normal cone --
+		}
+#pragma endregion
+
+#pragma region Interface Function Definitions
+		Result BuildMeshlets(
+			const Mesh&					_in_mesh
+			, const uint32_t			_in_maxVertices
+			, const uint32_t			_in_maxTriangles
+			, Mesh&						_out_mesh
+			, MeshletBuildStats&		_out_stats
+		) {
+			uint32_t vertexCount = (uint32_t)_in_mesh.vertices.size();
+
+			// verify limits fit a triangle and 8-bit local indices
+			if (_in_maxVertices < 3 || _in_maxVertices > MESHLET_VERTEX_LIMIT
+				|| _in_maxTriangles == 0 || _in_maxTriangles > MESHLET_TRIANGLE_LIMIT)
+				return Result::INVALID_ARG;
+
+			// verify mesh holds whole triangles that reference its vertices
+			if (_in_mesh.indices.empty() || _in_mesh.indices.size() % 3 != 0)
+				return Result::INVALID_ARG;
+			for (uint32_t index : _in_mesh.indices)
+				if (index >= vertexCount)
+					return Result::INVALID_ARG;
+
+			// meshlets never span two levels or two parts, so each draws and culls alone
+			std::vector<uint32_t> boundaries;
+			if (!GetPartBoundaries(_in_mesh, boundaries))
+				return Result::INVALID_ARG;
+			uint32_t rangeCount = (uint32_t)boundaries.size() - 1;
+
+			// level of each range; ranges are levels when the mesh has no parts
+			std::vector<uint32_t> rangeLevels(rangeCount, 0);
+			for (uint32_t range = 0; range < rangeCount; range++)
+				if (_in_mesh.parts.empty())
+					rangeLevels[range] = range;
+			for (uint32_t level = 0; level < (uint32_t)_in_mesh.lods.size() && !_in_mesh.parts.empty(); level++)
+				for (uint32_t p = 0; p < _in_mesh.lods[level].part_count; p++)
+					rangeLevels[_in_mesh.lods[level].part_offset + p] = level;
+
+			// -- spatial order --
+			// each range is ordered on its own, then cut into jobs that never span two ranges
+			std::vector<std::vector<uint32_t>> rangeTriangles(rangeCount);
+			std::vector<uint32_t> jobRanges;
+			std::vector<uint32_t> jobFirsts;
+			uint32_t threadCount = GetWorkerThreadCount();
+
+			ParallelFor(rangeCount, threadCount, [&](uint32_t _in_range, uint32_t)
+			{
+				uint32_t first = boundaries[_in_range];
+				SortTrianglesSpatially(_in_mesh.vertices, _in_mesh.indices.data() + first,
+					(boundaries[_in_range + 1] - first) / 3, rangeTriangles[_in_range]);
+			});
+
+			for (uint32_t range = 0; range < rangeCount; range++)
+			{
+				for (uint32_t t = 0; t < (uint32_t)rangeTriangles[range].size(); t += MESHLET_JOB_TRIANGLE_COUNT)
+				{
+					jobRanges.push_back(range);
+					jobFirsts.push_back(t);
+				}
+			}
+			// -- /spatial order --
+
+			// -- meshlets --
+			uint32_t jobCount = (uint32_t)jobRanges.size();
+			std::vector<std::vector<Meshlet>> jobMeshlets(jobCount);
+			std::vector<std::vector<uint32_t>> jobMeshletVertices(jobCount);
+			std::vector<std::vector<uint8_t>> jobMeshletTriangles(jobCount);
+
+			ParallelFor(jobCount, threadCount, [&](uint32_t _in_job, uint32_t)
+			{
+				const std::vector<uint32_t>& triangles = rangeTriangles[jobRanges[_in_job]];
+				uint32_t first = jobFirsts[_in_job];
+				uint32_t count = std::min(MESHLET_JOB_TRIANGLE_COUNT, (uint32_t)triangles.size() - first);
+
+				BuildMeshletsForTriangles(_in_mesh.vertices, &_in_mesh.indices[boundaries[jobRanges[_in_job]]],
+					&triangles[first], count, _in_maxVertices, _in_maxTriangles,
+					jobMeshlets[_in_job], jobMeshletVertices[_in_job], jobMeshletTriangles[_in_job]);
+
+				for (Meshlet& meshlet : jobMeshlets[_in_job])
+					ComputeMeshletBounds(_in_mesh.vertices, &jobMeshletVertices[_in_job][meshlet.vertex_offset],
+						&jobMeshletTriangles[_in_job][meshlet.triangle_offset], meshlet);
+			});
+
+			// jobs are in range order, so appending them keeps each level's and part's meshlets contiguous
+			std::vector<Meshlet> meshlets;
+			std::vector<uint32_t> meshletVertices;
+			std::vector<uint8_t> meshletTriangles;
+			std::vector<uint32_t> rangeMeshletCounts(rangeCount, 0);
+
+			for (uint32_t job = 0; job < jobCount; job++)
+			{
+				for (Meshlet meshlet : jobMeshlets[job])
+				{
+					meshlet.vertex_offset += (uint32_t)meshletVertices.size();
+					meshlet.triangle_offset += (uint32_t)meshletTriangles.size();
+					meshlets.push_back(meshlet);
+				}
+				rangeMeshletCounts[jobRanges[job]] += (uint32_t)jobMeshlets[job].size();
+
+				meshletVertices.insert(meshletVertices.end(), jobMeshletVertices[job].begin(), jobMeshletVertices[job].end());
+				meshletTriangles.insert(meshletTriangles.end(), jobMeshletTriangles[job].begin(), jobMeshletTriangles[job].end());
+			}
+
+			std::vector<MeshLod> lods = _in_mesh.lods;
+			std::vector<MeshPart> parts = _in_mesh.parts;
+			for (MeshLod& lod : lods)
+				lod.meshlet_offset = lod.meshlet_count = 0;
+
+			uint32_t meshletOffset = 0;
+			for (uint32_t range = 0; range < rangeCount; range++)
+			{
+				if (!lods.empty())
+				{
+					MeshLod& lod = lods[rangeLevels[range]];
+					if (lod.meshlet_count == 0)
+						lod.meshlet_offset = meshletOffset;
+					lod.meshlet_count += rangeMeshletCounts[range];
+				}
+				if (!parts.empty())
+				{
+					parts[range].meshlet_offset = meshletOffset;
+					parts[range].meshlet_count = rangeMeshletCounts[range];
+				}
+				meshletOffset += rangeMeshletCounts[range];
+			}
+			// -- /meshlets --
+
+			_out_stats = MeshletBuildStats();
+			_out_stats.meshlet_count = (uint32_t)meshlets.size();
+			_out_stats.triangle_count = (uint32_t)_in_mesh.indices.size() / 3;
+			_out_stats.vertex_reference_count = (uint32_t)meshletVertices.size();
+			_out_stats.vertex_fill = (float)((double)meshletVertices.size() / ((double)meshlets.size() * _in_maxVertices));
+			_out_stats.triangle_fill = (float)((double)_out_stats.triangle_count / ((double)meshlets.size() * _in_maxTriangles));
+
+			// vertices and indices are unchanged, so they are only copied into a different mesh
+			if (&_out_mesh != &_in_mesh)
+			{
+				_out_mesh.vertices = _in_mesh.vertices;
+				_out_mesh.indices = _in_mesh.indices;
+				_out_mesh.submeshes = _in_mesh.submeshes;
+				_out_mesh.vertex_count = _in_mesh.vertex_count;
+				_out_mesh.index_count = _in_mesh.index_count;
+			}
+			_out_mesh.lods.swap(lods);
+			_out_mesh.parts.swap(parts);
+			_out_mesh.meshlets.swap(meshlets);
+			_out_mesh.meshlet_vertices.swap(meshletVertices);
+			_out_mesh.meshlet_triangles.swap(meshletTriangles);
+
+			return Result::SUCCESS;
+		}
+#pragma endregion
+
+	}
+}
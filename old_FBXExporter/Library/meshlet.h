@@ -0,0 +1,95 @@
+#ifndef _FBXEXPORTER_LIBRARY_MESHLET_H_
+#define _FBXEXPORTER_LIBRARY_MESHLET_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "defines.h"
+
+namespace fbx_exporter
+{
+	namespace library
+	{
+		// Most vertices a meshlet can hold. Local vertex indices are 8-bit.
+		const uint32_t MESHLET_VERTEX_LIMIT = 256;
+
+		// Most triangles a meshlet can hold.
+		const uint32_t MESHLET_TRIANGLE_LIMIT = 512;
+
+		// Vertex limit suggested for mesh shaders. Fits a 64-thread workgroup with one vertex per thread.
+		const uint32_t MESHLET_DEFAULT_VERTEX_COUNT = 64;
+
+		// Triangle limit suggested for mesh shaders. Keeps the 8-bit triangle data of a meshlet under 384 bytes.
+		const uint32_t MESHLET_DEFAULT_TRIANGLE_COUNT = 124;
+
+		// Triangles split into meshlets by one parallel job. Jobs cover neighbouring triangles in spatial order.
+		const uint32_t MESHLET_JOB_TRIANGLE_COUNT = 16384;
+
+
+		/* Orders triangles along a Z-order curve through their centroids.
+		  PARAMETERS
+			_in_vertices : The vertices of the mesh.
+			_in_indices_p : The index list, three indices per triangle.
+			_in_triangleCount : The number of triangles in the index list.
+			_out_triangles : The triangle numbers in spatial order.
+		*/
+		void SortTrianglesSpatially(
+			const std::vector<Vertex>&	_in_vertices
+			, const uint32_t*			_in_indices_p
+			, const uint32_t			_in_triangleCount
+			, std::vector<uint32_t>&	_out_triangles
+		);
+
+		/* Groups triangles into meshlets with bounded vertex and triangle counts.
+		  PARAMETERS
+			_in_vertices : The vertices of the mesh.
+			_in_indices_p : The index list, three indices per triangle.
+			_in_triangles_p : The triangle numbers to group, in spatial order.
+			_in_triangleCount : The number of triangle numbers.
+			_in_maxVertices : Most vertices per meshlet. At least 3 and at most MESHLET_VERTEX_LIMIT.
+			_in_maxTriangles : Most triangles per meshlet. At least 1 and at most MESHLET_TRIANGLE_LIMIT.
+			_out_meshlets : Receives the meshlets. Bounds are not computed.
+			_out_meshletVertices : Receives the mesh vertex of each local vertex.
+			_out_meshletTriangles : Receives the local vertex indices of each triangle.
+		  NOTES
+			A meshlet grows by the neighbouring triangle that adds the fewest new vertices, ties
+			going to the one nearest the meshlet's centroid. When no neighbour fits, it takes the
+			first triangle left in spatial order instead, and is closed only once that does not fit
+			either. The next meshlet starts at that triangle. Offsets in the meshlets are relative
+			to the lists received.
+		*/
+		void BuildMeshletsForTriangles(
+			const std::vector<Vertex>&	_in_vertices
+			, const uint32_t*			_in_indices_p
+			, const uint32_t*			_in_triangles_p
+			, const uint32_t			_in_triangleCount
+			, const uint32_t			_in_maxVertices
+			, const uint32_t			_in_maxTriangles
+			, std::vector<Meshlet>&		_out_meshlets
+			, std::vector<uint32_t>&	_out_meshletVertices
+			, std::vector<uint8_t>&		_out_meshletTriangles
+		);
+
+		/* Computes the bounding sphere and normal cone of a meshlet.
+		  PARAMETERS
+			_in_vertices : The vertices of the mesh.
+			_in_meshletVertices_p : The mesh vertex of each of the meshlet's local vertices.
+			_in_meshletTriangles_p : The local vertex indices of the meshlet's triangles.
+			_out_meshlet : The meshlet to compute bounds for. Its counts are read.
+		  NOTES
+			The sphere is Ritter's: it starts from the farthest pair of axis extremes and grows to
+			hold every vertex. The cone axis is the normalized sum of the triangle normals, and its
+			apex lies on the axis behind the sphere center so that it is behind every triangle's
+			plane. A meshlet whose normals spread too far to ever face away gets a cutoff of 1.
+		*/
+		void ComputeMeshletBounds(
+			const std::vector<Vertex>&	_in_vertices
+			, const uint32_t*			_in_meshletVertices_p
+			, const uint8_t*			_in_meshletTriangles_p
+			, Meshlet&					_out_meshlet
+		);
+
+	}
+}
+
+#endif // _FBXEXPORTER_LIBRARY_MESHLET_H_
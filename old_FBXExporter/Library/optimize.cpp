@@ -0,0 +1,583 @@
+#include "interface.h"
+#include "optimize.h"
+
+#include <algorithm>
+#include <cmath>
+
+
+namespace fbx_exporter
+{
+	namespace library
+	{
+#pragma region Private Helper Functions
+		enum : uint32_t
+		{
+			NO_TRIANGLE = 0xFFFFFFFF  // Marks that no triangle has been chosen.
+			, UNUSED_VERTEX = 0xFFFFFFFF  // Marks a vertex no index has used yet.
+			, MAX_SCORED_VALENCE = 32  // Remaining valences above this score the same.
+		};
+
+		// Scores of vertices by position in the modeled cache, and by remaining valence.
+		struct VertexScoreTables
+		{
+			float	cache[VERTEX_CACHE_MODEL_SIZE + 1];  // Score by cache position. The last entry is for vertices not in the cache.
+			float	valence[MAX_SCORED_VALENCE + 1];  // Score by number of triangles still to be emitted.
+		};
+
+		void InitializeVertexScoreTables(VertexScoreTables& _out_tables)
+		{
+			for (uint32_t i = 0; i < VERTEX_CACHE_MODEL_SIZE; i++)
+			{
+				// the last triangle's vertices get a fixed score, so the triangles around
+				// them are not favored purely by which of the three was emitted last
+				if (i < 3)
+					_out_tables.cache[i] = 0.75f;
+				else
+					_out_tables.cache[i] = powf(1.0f - (float)(i - 3) / (VERTEX_CACHE_MODEL_SIZE - 3), 1.5f);
+			}
+			_out_tables.cache[VERTEX_CACHE_MODEL_SIZE] = 0.0f;
+
+			// vertices with few triangles left are boosted so they can leave the cache for good
+			_out_tables.valence[0] = 0.0f;
+			for (uint32_t i = 1; i <= MAX_SCORED_VALENCE; i++)
+				_out_tables.valence[i] = 2.0f / sqrtf((float)i);
+		}
+
+		float GetVertexScore(
+			const VertexScoreTables&	_in_tables
+			, const uint32_t			_in_cachePosition
+			, const uint32_t			_in_remainingValence
+		) {
+			// vertices no remaining triangle uses add nothing to any triangle
+			if (_in_remainingValence == 0)
+				return -1.0f;
+
+			uint32_t valence = _in_remainingValence < MAX_SCORED_VALENCE ? _in_remainingValence : MAX_SCORED_VALENCE;
+			return _in_tables.cache[_in_cachePosition] + _in_tables.valence[valence];
+		}
+
+#pragma endregion
+
+#pragma region Optimize Function Definitions
+		void GetVertexCacheStats(
+			const std::vector<uint32_t>&	_in_indices
+			, const uint32_t			_in_vertexCount
+			, const uint32_t			_in_cacheSize
+			, VertexCacheStats&			_out_stats
+		) {
+			_out_stats = VertexCacheStats();
+			if (_in_indices.size() < 3 || _in_vertexCount == 0)
+				return;
+
+			// a vertex is in the FIFO cache if fewer than _in_cacheSize misses happened since it was loaded
+			std::vector<uint32_t> loadTimes(_in_vertexCount, 0);
+			uint32_t time = _in_cacheSize + 1;
+			uint32_t missCount = 0;
+
+			for (uint32_t index : _in_indices)
+			{
+				if (index >= _in_vertexCount)
+					continue;
+
+				if (time - loadTimes[index] > _in_cacheSize)
+				{
+					loadTimes[index] = time++;
+					missCount++;
+				}
+			}
+
+			_out_stats.acmr = (float)missCount / (_in_indices.size() / 3);
+			_out_stats.atvr = (float)missCount / _in_vertexCount;
+		}
+
+		void OptimizeVertexCache(
+			const std::vector<uint32_t>&	_in_indices
+			, const uint32_t			_in_vertexCount
+			, std::vector<uint32_t>&	_out_indices
+		) {
+			uint32_t triangleCount = (uint32_t)(_in_indices.size() / 3);
+
+			_out_indices.clear();
+			_out_indices.reserve(triangleCount * 3);
+
+			VertexScoreTables tables;
+			InitializeVertexScoreTables(tables);
+
+			// -- build adjacency --
+			// triangles using each vertex, packed per vertex. The first remainingValence
+			// entries of each vertex's range are the triangles not yet emitted
+			std::vector<uint32_t> remainingValence(_in_vertexCount, 0);
+			std::vector<uint32_t> adjacencyOffsets(_in_vertexCount + 1, 0);
+			std::vector<uint32_t> adjacentTriangles(triangleCount * 3);
+
+			for (uint32_t i = 0; i < triangleCount * 3; i++)
+				remainingValence[_in_indices[i]]++;
+			for (uint32_t v = 0; v < _in_vertexCount; v++)
+				adjacencyOffsets[v + 1] = adjacencyOffsets[v] + remainingValence[v];
+
+			std::vector<uint32_t> fillCounts(_in_vertexCount, 0);
+			for (uint32_t i = 0; i < triangleCount * 3; i++)
+			{
+				uint32_t v = _in_indices[i];
+				adjacentTriangles[adjacencyOffsets[v] + fillCounts[v]++] = i / 3;
+			}
+			// -- /build adjacency --
+
+			// -- initial scores --
+			std::vector<float> vertexScores(_in_vertexCount);
+			std::vector<float> triangleScores(triangleCount, 0.0f);
+			std::vector<uint8_t> emitted(triangleCount, 0);
+
+			for (uint32_t v = 0; v < _in_vertexCount; v++)
+				vertexScores[v] = GetVertexScore(tables, VERTEX_CACHE_MODEL_SIZE, remainingValence[v]);
+
+			uint32_t bestTriangle = NO_TRIANGLE;
+			float bestScore = 0.0f;
+			for (uint32_t t = 0; t < triangleCount; t++)
+			{
+				triangleScores[t] = vertexScores[_in_indices[t * 3 + 0]]
+					+ vertexScores[_in_indices[t * 3 + 1]] + vertexScores[_in_indices[t * 3 + 2]];
+
+				if (bestTriangle == NO_TRIANGLE || triangleScores[t] > bestScore)
+				{
+					bestTriangle = t;
+					bestScore = triangleScores[t];
+				}
+			}
+			// -- /initial scores --
+
+			// cache holds up to three extra vertices between inserting a triangle and evicting
+			uint32_t cache[VERTEX_CACHE_MODEL_SIZE + 3];
+			uint32_t cacheCount = 0;
+			uint32_t nextUnemitted = 0;
+
+			for (uint32_t emittedCount = 0; emittedCount < triangleCount; emittedCount++)
+			{
+				// no triangle touches the cache; continue with the next one in source order
+				if (bestTriangle == NO_TRIANGLE)
+				{
+					while (emitted[nextUnemitted])
+						nextUnemitted++;
+					bestTriangle = nextUnemitted;
+				}
+
+				const uint32_t* triangle_p = &_in_indices[bestTriangle * 3];
+				_out_indices.insert(_out_indices.end(), triangle_p, triangle_p + 3);
+				emitted[bestTriangle] = 1;
+
+				// -- update cache --
+				// the triangle's vertices move to the front, and the rest keep their order behind them
+				uint32_t newCache[VERTEX_CACHE_MODEL_SIZE + 3];
+				uint32_t newCacheCount = 0;
+
+				for (uint32_t c = 0; c < 3; c++)
+				{
+					uint32_t v = triangle_p[c];
+
+					// remove the triangle from the vertex's remaining triangles
+					uint32_t first = adjacencyOffsets[v];
+					uint32_t last = first + remainingValence[v] - 1;
+					for (uint32_t a = first; a <= last; a++)
+						if (adjacentTriangles[a] == bestTriangle)
+						{
+							adjacentTriangles[a] = adjacentTriangles[last];
+							adjacentTriangles[last] = bestTriangle;
+							break;
+						}
+					remainingValence[v]--;
+
+					// degenerate triangles repeat a vertex
+					bool inCache = false;
+					for (uint32_t n = 0; n < newCacheCount; n++)
+						inCache = inCache || newCache[n] == v;
+					if (!inCache)
+						newCache[newCacheCount++] = v;
+				}
+
+				for (uint32_t n = 0; n < cacheCount; n++)
+				{
+					uint32_t v = cache[n];
+					if (v != triangle_p[0] && v != triangle_p[1] && v != triangle_p[2])
+						newCache[newCacheCount++] = v;
+				}
+				// -- /update cache --
+
+				// -- update scores --
+				// rescore every vertex that was or is in the cache, and find the best triangle touching the cache
+				bestTriangle = NO_TRIANGLE;
+				bestScore = 0.0f;
+
+				for (uint32_t n = 0; n < newCacheCount; n++)
+				{
+					uint32_t v = newCache[n];
+					uint32_t cachePosition = n < VERTEX_CACHE_MODEL_SIZE ? n : VERTEX_CACHE_MODEL_SIZE;
+
+					float score = GetVertexScore(tables, cachePosition, remainingValence[v]);
+					float scoreChange = score - vertexScores[v];
+					vertexScores[v] = score;
+
+					for (uint32_t a = adjacencyOffsets[v]; a < adjacencyOffsets[v] + remainingValence[v]; a++)
+					{
+						uint32_t t = adjacentTriangles[a];
+						triangleScores[t] += scoreChange;
+
+						if (bestTriangle == NO_TRIANGLE || triangleScores[t] > bestScore)
+						{
+							bestTriangle = t;
+							bestScore = triangleScores[t];
+						}
+					}
+				}
+				// -- /update scores --
+
+				cacheCount = newCacheCount < VERTEX_CACHE_MODEL_SIZE ? newCacheCount : VERTEX_CACHE_MODEL_SIZE;
+				for (uint32_t n = 0; n < cacheCount; n++)
+					cache[n] = newCache[n];
+			}
+		}
+
+		void OptimizeVertexFetch(
+			std::vector<Vertex>&		_out_vertices
+			, std::vector<uint32_t>&	_out_indices
+		) {
+			std::vector<uint32_t> remap(_out_vertices.size(), UNUSED_VERTEX);
+			uint32_t vertexCount = 0;
+
+			// number vertices in order of first use
+			for (uint32_t& index : _out_indices)
+			{
+				if (remap[index] == UNUSED_VERTEX)
+					remap[index] = vertexCount++;
+				index = remap[index];
+			}
+
+			std::vector<Vertex> vertices(vertexCount);
+			for (size_t v = 0; v < _out_vertices.size(); v++)
+				if (remap[v] != UNUSED_VERTEX)
+					vertices[remap[v]] = _out_vertices[v];
+
+			_out_vertices.swap(vertices);
+		}
+
+		bool GetLevelBoundaries(
+			const Mesh&					_in_mesh
+			, std::vector<uint32_t>&	_out_boundaries
+		) {
+			// a mesh without levels of detail is one level of every index
+			_out_boundaries.assign(1, 0);
+			if (_in_mesh.lods.empty())
+				_out_boundaries.push_back((uint32_t)_in_mesh.indices.size());
+
+			for (const MeshLod& lod : _in_mesh.lods)
+			{
+				if (lod.index_offset != _out_boundaries.back() || lod.index_count == 0 || lod.index_count % 3 != 0)
+					return false;
+				_out_boundaries.push_back(lod.index_offset + lod.index_count);
+			}
+
+			return _out_boundaries.back() == _in_mesh.indices.size();
+		}
+
+		bool GetPartBoundaries(
+			const Mesh&					_in_mesh
+			, std::vector<uint32_t>&	_out_boundaries
+		) {
+			std::vector<uint32_t> levelBoundaries;
+			if (!GetLevelBoundaries(_in_mesh, levelBoundaries))
+				return false;
+
+			// a mesh without parts is split by level only
+			if (_in_mesh.parts.empty())
+			{
+				_out_boundaries.swap(levelBoundaries);
+				return true;
+			}
+
+			_out_boundaries.assign(1, 0);
+			uint32_t partEnd = 0;
+			for (size_t level = 0; level + 1 < levelBoundaries.size(); level++)
+			{
+				uint32_t partOffset = _in_mesh.lods.empty() ? 0 : _in_mesh.lods[level].part_offset;
+				uint32_t partCount = _in_mesh.lods.empty() ? (uint32_t)_in_mesh.parts.size() : _in_mesh.lods[level].part_count;
+
+				// levels list their parts in level order
+				if (partOffset != partEnd || partCount == 0 || (size_t)partOffset + partCount > _in_mesh.parts.size())
+					return false;
+				partEnd = partOffset + partCount;
+
+				for (uint32_t p = partOffset; p < partEnd; p++)
+				{
+					const MeshPart& part = _in_mesh.parts[p];
+					if (part.index_offset != _out_boundaries.back() || part.index_count % 3 != 0)
+						return false;
+					_out_boundaries.push_back(part.index_offset + part.index_count);
+				}
+
+				if (_out_boundaries.back() != levelBoundaries[level + 1])
+					return false;
+			}
+
+			return partEnd == _in_mesh.parts.size();
+		}
+
+		void UpdatePartVertexRanges(
+			Mesh&						_out_mesh
+		) {
+			for (MeshPart& part : _out_mesh.parts)
+			{
+				uint32_t first = UNUSED_VERTEX;
+				uint32_t last = 0;
+				for (uint32_t i = part.index_offset; i < part.index_offset + part.index_count; i++)
+				{
+					first = std::min(first, _out_mesh.indices[i]);
+					last = std::max(last, _out_mesh.indices[i]);
+				}
+
+				part.base_vertex = part.index_count > 0 ? first : 0;
+				part.vertex_count = part.index_count > 0 ? last - first + 1 : 0;
+			}
+		}
+
+		void ClearMeshlets(
+			Mesh&						_out_mesh
+		) {
+			_out_mesh.meshlets.clear();
+			_out_mesh.meshlet_vertices.clear();
+			_out_mesh.meshlet_triangles.clear();
+
+			for (MeshLod& lod : _out_mesh.lods)
+				lod.meshlet_offset = lod.meshlet_count = 0;
+			for (MeshPart& part : _out_mesh.parts)
+				part.meshlet_offset = part.meshlet_count = 0;
+		}
+#pragma endregion
+
+#pragma region Interface Function Definitions
+		Result OptimizeMesh(
+			const Mesh&					_in_mesh
+			, Mesh&						_out_mesh
+			, MeshOptimizationStats&	_out_stats
+		) {
+			uint32_t vertexCount = (uint32_t)_in_mesh.vertices.size();
+
+			// verify mesh holds whole triangles that reference its vertices
+			if (_in_mesh.indices.empty() || _in_mesh.indices.size() % 3 != 0)
+				return Result::INVALID_ARG;
+			for (uint32_t index : _in_mesh.indices)
+				if (index >= vertexCount)
+					return Result::INVALID_ARG;
+
+			std::vector<uint32_t> levelBoundaries;
+			std::vector<uint32_t> boundaries;
+			if (!GetLevelBoundaries(_in_mesh, levelBoundaries) || !GetPartBoundaries(_in_mesh, boundaries))
+				return Result::INVALID_ARG;
+
+			std::vector<uint32_t> firstLevel(_in_mesh.indices.begin(), _in_mesh.indices.begin() + levelBoundaries[1]);
+			GetVertexCacheStats(firstLevel, vertexCount, VERTEX_CACHE_MEASURE_SIZE, _out_stats.source);
+
+			// build into locals so _in_mesh and _out_mesh may be the same mesh
+			std::vector<Vertex> vertices = _in_mesh.vertices;
+			std::vector<uint32_t> indices;
+			std::vector<MeshLod> lods = _in_mesh.lods;
+			std::vector<MeshPart> parts = _in_mesh.parts;
+
+			// levels and parts are drawn alone, so each is reordered alone
+			indices.reserve(_in_mesh.indices.size());
+			for (size_t range = 0; range + 1 < boundaries.size(); range++)
+			{
+				std::vector<uint32_t> rangeIndices(_in_mesh.indices.begin() + boundaries[range],
+					_in_mesh.indices.begin() + boundaries[range + 1]);
+				std::vector<uint32_t> optimizedIndices;
+
+				OptimizeVertexCache(rangeIndices, vertexCount, optimizedIndices);
+				indices.insert(indices.end(), optimizedIndices.begin(), optimizedIndices.end());
+			}
+
+			// coarser levels use a subset of the first level's vertices, so its order decides fetch locality
+			OptimizeVertexFetch(vertices, indices);
+
+			_out_mesh.vertices.swap(vertices);
+			_out_mesh.indices.swap(indices);
+			_out_mesh.lods.swap(lods);
+			_out_mesh.submeshes.clear();
+			_out_mesh.parts.swap(parts);
+			UpdatePartVertexRanges(_out_mesh);
+			ClearMeshlets(_out_mesh);
+			_out_mesh.vertex_count = (uint32_t)_out_mesh.vertices.size();
+			_out_mesh.index_count = (uint32_t)_out_mesh.indices.size();
+
+			firstLevel.assign(_out_mesh.indices.begin(), _out_mesh.indices.begin() + levelBoundaries[1]);
+			GetVertexCacheStats(firstLevel, _out_mesh.vertex_count, VERTEX_CACHE_MEASURE_SIZE, _out_stats.optimized);
+
+			return Result::SUCCESS;
+		}
+
+		Result SplitMeshForShortIndices(
+			const Mesh&					_in_mesh
+			, Mesh&						_out_mesh
+			, IndexSplitStats&			_out_stats
+		) {
+			uint32_t vertexCount = (uint32_t)_in_mesh.vertices.size();
+			uint32_t indexCount = (uint32_t)_in_mesh.indices.size();
+
+			// verify mesh holds whole triangles that reference its vertices
+			if (indexCount == 0 || indexCount % 3 != 0)
+				return Result::INVALID_ARG;
+			for (uint32_t index : _in_mesh.indices)
+				if (index >= vertexCount)
+					return Result::INVALID_ARG;
+
+			// submeshes never span two levels of detail or two parts, so each draws alone
+			std::vector<uint32_t> boundaries;
+			if (!GetPartBoundaries(_in_mesh, boundaries))
+				return Result::INVALID_ARG;
+
+			// build into locals so _in_mesh and _out_mesh may be the same mesh
+			std::vector<Vertex> vertices;
+			std::vector<uint32_t> indices;
+			std::vector<Submesh> submeshes;
+			std::vector<MeshLod> lods = _in_mesh.lods;
+			std::vector<MeshPart> parts = _in_mesh.parts;
+
+			if (vertexCount <= SHORT_INDEX_VERTEX_LIMIT)
+			{
+				// the whole mesh fits; keep it as it is
+				vertices = _in_mesh.vertices;
+				indices = _in_mesh.indices;
+
+				for (size_t range = 0; range + 1 < boundaries.size(); range++)
+				{
+					if (boundaries[range + 1] == boundaries[range])
+						continue;
+
+					Submesh submesh;
+					submesh.index_offset = boundaries[range];
+					submesh.index_count = boundaries[range + 1] - boundaries[range];
+					submesh.vertex_count = vertexCount;
+					submeshes.push_back(submesh);
+				}
+			}
+			else
+			{
+				// position of each source vertex within the current submesh
+				std::vector<uint32_t> localIndices(vertexCount, UNUSED_VERTEX);
+				std::vector<uint32_t> submeshVertices;
+
+				vertices.reserve(vertexCount);
+				indices.reserve(indexCount);
+
+				for (size_t range = 0; range + 1 < boundaries.size(); range++)
+				{
+					if (boundaries[range + 1] == boundaries[range])
+						continue;
+
+					Submesh submesh;
+					submesh.index_offset = boundaries[range];
+					submesh.base_vertex = (uint32_t)vertices.size();
+
+					for (uint32_t i = boundaries[range]; i < boundaries[range + 1]; i += 3)
+					{
+						const uint32_t* triangle_p = &_in_mesh.indices[i];
+
+						uint32_t newVertexCount = 0;
+						for (uint32_t c = 0; c < 3; c++)
+							if (localIndices[triangle_p[c]] == UNUSED_VERTEX
+								&& (c == 0 || triangle_p[c] != triangle_p[0])
+								&& (c < 2 || triangle_p[c] != triangle_p[1]))
+								newVertexCount++;
+
+						// start a new submesh when the triangle's vertices would not fit
+						if (submeshVertices.size() + newVertexCount > SHORT_INDEX_VERTEX_LIMIT)
+						{
+							for (uint32_t v : submeshVertices)
+							{
+								vertices.push_back(_in_mesh.vertices[v]);
+								localIndices[v] = UNUSED_VERTEX;
+							}
+							submesh.vertex_count = (uint32_t)submeshVertices.size();
+							submeshes.push_back(submesh);
+
+							submesh = Submesh();
+							submesh.index_offset = i;
+							submesh.base_vertex = (uint32_t)vertices.size();
+							submeshVertices.clear();
+						}
+
+						for (uint32_t c = 0; c < 3; c++)
+						{
+							uint32_t& localIndex = localIndices[triangle_p[c]];
+							if (localIndex == UNUSED_VERTEX)
+							{
+								localIndex = (uint32_t)submeshVertices.size();
+								submeshVertices.push_back(triangle_p[c]);
+							}
+							indices.push_back(submesh.base_vertex + localIndex);
+						}
+						submesh.index_count += 3;
+					}
+
+					for (uint32_t v : submeshVertices)
+					{
+						vertices.push_back(_in_mesh.vertices[v]);
+						localIndices[v] = UNUSED_VERTEX;
+					}
+					submesh.vertex_count = (uint32_t)submeshVertices.size();
+					submeshes.push_back(submesh);
+					submeshVertices.clear();
+				}
+			}
+
+			_out_stats = IndexSplitStats();
+			_out_stats.submesh_count = (uint32_t)submeshes.size();
+			_out_stats.source_vertex_count = vertexCount;
+			_out_stats.vertex_count = (uint32_t)vertices.size();
+			_out_stats.source_index_bytes = (uint64_t)indexCount * sizeof(uint32_t);
+			_out_stats.index_bytes = (uint64_t)indexCount * sizeof(uint16_t);
+
+			_out_mesh.vertices.swap(vertices);
+			_out_mesh.indices.swap(indices);
+			_out_mesh.submeshes.swap(submeshes);
+			_out_mesh.lods.swap(lods);
+			_out_mesh.parts.swap(parts);
+			UpdatePartVertexRanges(_out_mesh);
+			ClearMeshlets(_out_mesh);
+			_out_mesh.vertex_count = (uint32_t)_out_mesh.vertices.size();
+			_out_mesh.index_count = (uint32_t)_out_mesh.indices.size();
+
+			return Result::SUCCESS;
+		}
+
+		Result GetShortIndices(
+			const Mesh&					_in_mesh
+			, std::vector<uint16_t>&	_out_indices
+		) {
+			// an unsplit mesh is one submesh of every vertex
+			std::vector<Submesh> wholeMesh(1);
+			wholeMesh[0].index_count = (uint32_t)_in_mesh.indices.size();
+			wholeMesh[0].vertex_count = (uint32_t)_in_mesh.vertices.size();
+
+			const std::vector<Submesh>& submeshes = _in_mesh.submeshes.empty() ? wholeMesh : _in_mesh.submeshes;
+
+			_out_indices.resize(_in_mesh.indices.size());
+			for (const Submesh& submesh : submeshes)
+			{
+				if (submesh.vertex_count > SHORT_INDEX_VERTEX_LIMIT
+					|| (size_t)submesh.index_offset + submesh.index_count > _in_mesh.indices.size())
+					return Result::INVALID_ARG;
+
+				for (uint32_t i = submesh.index_offset; i < submesh.index_offset + submesh.index_count; i++)
+				{
+					uint32_t localIndex = _in_mesh.indices[i] - submesh.base_vertex;
+					if (_in_mesh.indices[i] < submesh.base_vertex || localIndex >= submesh.vertex_count)
+						return Result::INVALID_ARG;
+
+					_out_indices[i] = (uint16_t)localIndex;
+				}
+			}
+
+			return Result::SUCCESS;
+		}
+#pragma endregion
+
+	}
+}
@@ -0,0 +1,112 @@
+#ifndef _FBXEXPORTER_LIBRARY_OPTIMIZE_H_
+#define _FBXEXPORTER_LIBRARY_OPTIMIZE_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "defines.h"
+
+namespace fbx_exporter
+{
+	namespace library
+	{
+		// Number of entries in the FIFO cache used to measure vertex cache efficiency.
+		const uint32_t VERTEX_CACHE_MEASURE_SIZE = 16;
+
+		// Number of entries in the LRU cache modeled when reordering triangles.
+		const uint32_t VERTEX_CACHE_MODEL_SIZE = 32;
+
+		// Number of vertices a 16-bit index can address.
+		const uint32_t SHORT_INDEX_VERTEX_LIMIT = 65536;
+
+
+		/* Measures how often a GPU post-transform cache would miss while drawing an index list.
+		  PARAMETERS
+			_in_indices : The index list, three indices per triangle.
+			_in_vertexCount : The number of vertices the indices reference.
+			_in_cacheSize : The number of entries in the simulated FIFO cache.
+			_out_stats : The miss ratios measured.
+		*/
+		void GetVertexCacheStats(
+			const std::vector<uint32_t>&	_in_indices
+			, const uint32_t			_in_vertexCount
+			, const uint32_t			_in_cacheSize
+			, VertexCacheStats&			_out_stats
+		);
+
+		/* Reorders triangles so that vertices are reused while they are still in the post-transform cache.
+		  PARAMETERS
+			_in_indices : The index list to reorder, three indices per triangle.
+			_in_vertexCount : The number of vertices the indices reference.
+			_out_indices : The reordered index list. Must not alias _in_indices.
+		  NOTES
+			Uses Forsyth's linear-speed algorithm. Each vertex is scored by its position in a
+			modeled LRU cache of VERTEX_CACHE_MODEL_SIZE entries and by how many triangles still
+			use it, and the triangle with the highest total score among those touching the cache
+			is emitted next. Triangle winding is kept.
+		*/
+		void OptimizeVertexCache(
+			const std::vector<uint32_t>&	_in_indices
+			, const uint32_t			_in_vertexCount
+			, std::vector<uint32_t>&	_out_indices
+		);
+
+		/* Reorders vertices into the order the index list first uses them, and remaps the indices.
+		  PARAMETERS
+			_out_vertices : The vertex list to reorder. Vertices no index uses are removed.
+			_out_indices : The index list to remap.
+		*/
+		void OptimizeVertexFetch(
+			std::vector<Vertex>&		_out_vertices
+			, std::vector<uint32_t>&	_out_indices
+		);
+
+		/* Gets the index ranges of a mesh's levels of detail.
+		  PARAMETERS
+			_in_mesh : The mesh to read levels of detail from.
+			_out_boundaries : The first index of each level, followed by the total index count.
+			  A mesh without levels of detail is one level of every index.
+		  RETURNS
+			true : The levels cover the indices in order, in whole triangles.
+			false : The levels leave gaps, overlap, or split a triangle.
+		*/
+		bool GetLevelBoundaries(
+			const Mesh&					_in_mesh
+			, std::vector<uint32_t>&	_out_boundaries
+		);
+
+		/* Gets the index ranges of a mesh's parts, level by level.
+		  PARAMETERS
+			_in_mesh : The mesh to read parts from.
+			_out_boundaries : The first index of each part, followed by the total index count.
+			  A mesh without parts gets the boundaries of its levels of detail. Parts left
+			  empty by simplification give equal boundaries.
+		  RETURNS
+			true : The levels are valid, and each level's parts cover its indices in order.
+			false : The parts leave gaps, overlap, split a triangle, or are not in level order.
+		*/
+		bool GetPartBoundaries(
+			const Mesh&					_in_mesh
+			, std::vector<uint32_t>&	_out_boundaries
+		);
+
+		/* Sets the vertex range of each part of a mesh from the indices it uses.
+		  PARAMETERS
+			_out_mesh : The mesh whose parts to update.
+		*/
+		void UpdatePartVertexRanges(
+			Mesh&						_out_mesh
+		);
+
+		/* Removes a mesh's meshlets and the meshlet ranges of its levels and parts.
+		  PARAMETERS
+			_out_mesh : The mesh whose meshlets to remove.
+		*/
+		void ClearMeshlets(
+			Mesh&						_out_mesh
+		);
+
+	}
+}
+
+#endif // _FBXEXPORTER_LIBRARY_OPTIMIZE_H_
@@ -0,0 +1,787 @@
+#include "interface.h"
+#include "pack.h"
+#include "simd.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+
+
+namespace fbx_exporter
+{
+	namespace library
+	{
+#pragma region Private Helper Functions
+		// Number of vertices each encoding kernel processes at once.
+		const uint32_t PACK_LANES = 4;
+
+		// Largest values of 8-bit and 16-bit unsigned and 16-bit signed normalized integers.
+		const float UNORM8_MAX = 255.0f;
+		const float UNORM16_MAX = 65535.0f;
+		const float SNORM16_MAX = 32767.0f;
+
+		// Offsets of vertex elements within Vertex, in floats.
+		const uint32_t POSITION_FLOAT_OFFSET = (uint32_t)(offsetof(Vertex, pos) / sizeof(float));
+		const uint32_t NORMAL_FLOAT_OFFSET = (uint32_t)(offsetof(Vertex, norm) / sizeof(float));
+		const uint32_t COLOR_FLOAT_OFFSET = (uint32_t)(offsetof(Vertex, color) / sizeof(float));
+		const uint32_t TEXCOORD_FLOAT_OFFSET = (uint32_t)(offsetof(Vertex, texCoord) / sizeof(float));
+
+		// Largest joint index of 8-bit skin formats. The other formats hold every 16-bit index of a Vertex.
+		const uint16_t JOINT8_MAX = 255;
+
+		// FLOAT skin is copied straight from a Vertex, so its joint indices must follow its weights.
+		static_assert(offsetof(Vertex, joints) == offsetof(Vertex, weights) + sizeof(Vertex::weights),
+			"Vertex joint indices must follow its skin weights");
+
+		bool HasMeshElement(
+			const VertexLayout&			_in_layout
+			, const MeshElement			_in_element
+		) {
+			return (_in_layout.elements & static_cast<uint32_t>(_in_element)) != 0;
+		}
+
+		void GatherVertexComponents(
+			const std::vector<Vertex>&	_in_vertices
+			, const size_t				_in_firstVertex
+			, const uint32_t			_in_floatOffset
+			, const uint32_t			_in_componentCount
+			, float						_out_lanes[4][PACK_LANES]
+		) {
+			size_t lastVertex = _in_vertices.size() - 1;
+
+			for (uint32_t lane = 0; lane < PACK_LANES; lane++)
+			{
+				// lanes past the last vertex repeat it, and their results are discarded
+				size_t v = std::min(_in_firstVertex + lane, lastVertex);
+				const float* components_p = (const float*)&_in_vertices[v] + _in_floatOffset;
+
+				for (uint32_t c = 0; c < _in_componentCount; c++)
+					_out_lanes[c][lane] = components_p[c];
+			}
+		}
+
+		/* Maps four values from a range onto unsigned integers, rounding to nearest even.
+		  Values below _in_min become 0, and values above the range become _in_max. */
+		void QuantizeUnorm4(
+			const float*				_in_values_p
+			, const float				_in_min
+			, const float				_in_scale
+			, const float				_in_max
+			, uint32_t*					_out_values_p
+		) {
+#ifdef FBXLIB_SSE2
+			__m128 values = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(_in_values_p), _mm_set1_ps(_in_min)),
+				_mm_set1_ps(_in_scale));
+			values = _mm_min_ps(_mm_max_ps(values, _mm_setzero_ps()), _mm_set1_ps(_in_max));
+
+			_mm_storeu_si128((__m128i*)_out_values_p, _mm_cvtps_epi32(values));
+#else
+			for (uint32_t i = 0; i < PACK_LANES; i++)
+			{
+				// same comparisons as _mm_max_ps and _mm_min_ps, so NaN becomes 0
+				float value = (_in_values_p[i] - _in_min) * _in_scale;
+				value = value > 0.0f ? value : 0.0f;
+				value = value < _in_max ? value : _in_max;
+
+				_out_values_p[i] = (uint32_t)lrintf(value);
+			}
+#endif
+		}
+
+		void ConvertFloatsToHalves4(
+			const float*				_in_values_p
+			, uint16_t*					_out_halves_p
+		) {
+#ifdef FBXLIB_SSE2
+			const __m128 signMask = _mm_set1_ps(-0.0f);
+
+			__m128 values = _mm_loadu_ps(_in_values_p);
+			__m128 sign = _mm_and_ps(values, signMask);
+			__m128i absolute = _mm_castps_si128(_mm_xor_ps(values, sign));
+
+			// values at or above 65520 round to infinity, and NaN keeps a mantissa bit
+			__m128i isFinite = _mm_cmpgt_epi32(_mm_set1_epi32((127 + 16) << 23), absolute);
+			__m128i isNan = _mm_castps_si128(_mm_cmpunord_ps(values, values));
+			__m128i special = _mm_or_si128(_mm_set1_epi32(0x7C00), _mm_and_si128(isNan, _mm_set1_epi32(0x0200)));
+
+			// subnormal results: adding 0.5 aligns the mantissa so the FPU rounds it
+			__m128i isSubnormal = _mm_cmpgt_epi32(_mm_set1_epi32((127 - 14) << 23), absolute);
+			__m128i subnormalMagic = _mm_set1_epi32(126 << 23);
+			__m128i subnormal = _mm_sub_epi32(_mm_castps_si128(
+				_mm_add_ps(_mm_castsi128_ps(absolute), _mm_castsi128_ps(subnormalMagic))), subnormalMagic);
+
+			// normal results: rebias the exponent and round the mantissa to nearest even
+			__m128i mantissaOdd = _mm_srai_epi32(_mm_slli_epi32(absolute, 31 - 13), 31);
+			__m128i normal = _mm_add_epi32(absolute, _mm_set1_epi32(0x0FFF - ((127 - 15) << 23)));
+			normal = _mm_srli_epi32(_mm_sub_epi32(normal, mantissaOdd), 13);
+
+			__m128i finite = _mm_or_si128(_mm_and_si128(isSubnormal, subnormal), _mm_andnot_si128(isSubnormal, normal));
+			__m128i halves = _mm_or_si128(_mm_and_si128(isFinite, finite), _mm_andnot_si128(isFinite, special));
+			halves = _mm_or_si128(halves, _mm_srli_epi32(_mm_castps_si128(sign), 16));
+
+			uint32_t lanes[PACK_LANES];
+			_mm_storeu_si128((__m128i*)lanes, halves);
+			for (uint32_t i = 0; i < PACK_LANES; i++)
+				_out_halves_p[i] = (uint16_t)lanes[i];
+#else
+			for (uint32_t i = 0; i < PACK_LANES; i++)
+				_out_halves_p[i] = ConvertFloatToHalf(_in_values_p[i]);
+#endif
+		}
+
+		void EncodeOctahedralNormals4(
+			const float*				_in_x_p
+			, const float*				_in_y_p
+			, const float*				_in_z_p
+			, int16_t*					_out_u_p
+			, int16_t*					_out_v_p
+		) {
+#ifdef FBXLIB_SSE2
+			const __m128 signMask = _mm_set1_ps(-0.0f);
+			const __m128 one = _mm_set1_ps(1.0f);
+
+			__m128 x = _mm_loadu_ps(_in_x_p), y = _mm_loadu_ps(_in_y_p), z = _mm_loadu_ps(_in_z_p);
+
+			// project onto the octahedron |x| + |y| + |z| = 1
+			__m128 length = _mm_add_ps(_mm_add_ps(_mm_andnot_ps(signMask, x), _mm_andnot_ps(signMask, y)),
+				_mm_andnot_ps(signMask, z));
+			__m128 scale = _mm_div_ps(one, _mm_max_ps(length, _mm_set1_ps(1.0e-20f)));
+			__m128 u = _mm_mul_ps(x, scale), v = _mm_mul_ps(y, scale);
+
+			// fold the lower half over the diagonals, keeping the signs of u and v
+			__m128 foldedU = _mm_or_ps(_mm_sub_ps(one, _mm_andnot_ps(signMask, v)), _mm_and_ps(signMask, u));
+			__m128 foldedV = _mm_or_ps(_mm_sub_ps(one, _mm_andnot_ps(signMask, u)), _mm_and_ps(signMask, v));
+			__m128 isLower = _mm_cmplt_ps(z, _mm_setzero_ps());
+			u = _mm_or_ps(_mm_and_ps(isLower, foldedU), _mm_andnot_ps(isLower, u));
+			v = _mm_or_ps(_mm_and_ps(isLower, foldedV), _mm_andnot_ps(isLower, v));
+
+			__m128 minusOne = _mm_set1_ps(-1.0f), snormMax = _mm_set1_ps(SNORM16_MAX);
+			__m128i quantizedU = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(u, minusOne), one), snormMax));
+			__m128i quantizedV = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(v, minusOne), one), snormMax));
+
+			int32_t lanes[2][PACK_LANES];
+			_mm_storeu_si128((__m128i*)lanes[0], quantizedU);
+			_mm_storeu_si128((__m128i*)lanes[1], quantizedV);
+			for (uint32_t i = 0; i < PACK_LANES; i++)
+			{
+				_out_u_p[i] = (int16_t)lanes[0][i];
+				_out_v_p[i] = (int16_t)lanes[1][i];
+			}
+#else
+			for (uint32_t i = 0; i < PACK_LANES; i++)
+			{
+				float normal[3] = { _in_x_p[i], _in_y_p[i], _in_z_p[i] };
+				int16_t octahedral[2];
+
+				EncodeOctahedralNormal(normal, octahedral);
+				_out_u_p[i] = octahedral[0];
+				_out_v_p[i] = octahedral[1];
+			}
+#endif
+		}
+
+		void PackPositions(
+			const std::vector<Vertex>&	_in_vertices
+			, PackedMesh&				_out_packedMesh
+		) {
+			uint8_t* vertices_p = _out_packedMesh.vertices.data() + _out_packedMesh.position_offset;
+			uint32_t stride = _out_packedMesh.vertex_stride;
+			size_t vertexCount = _in_vertices.size();
+
+			if (_out_packedMesh.layout.position == VertexPositionFormat::FLOAT)
+			{
+				for (size_t v = 0; v < vertexCount; v++)
+					memcpy(vertices_p + v * stride, _in_vertices[v].pos, sizeof(_in_vertices[v].pos));
+				return;
+			}
+
+			float scale[3];
+			for (uint32_t c = 0; c < 3; c++)
+				scale[c] = _out_packedMesh.position_extent[c] > 0.0f ? UNORM16_MAX / _out_packedMesh.position_extent[c] : 0.0f;
+
+			for (size_t first = 0; first < vertexCount; first += PACK_LANES)
+			{
+				float lanes[4][PACK_LANES];
+				uint32_t quantized[3][PACK_LANES];
+
+				GatherVertexComponents(_in_vertices, first, POSITION_FLOAT_OFFSET, 3, lanes);
+				for (uint32_t c = 0; c < 3; c++)
+					QuantizeUnorm4(lanes[c], _out_packedMesh.position_min[c], scale[c], UNORM16_MAX, quantized[c]);
+
+				for (size_t lane = 0; lane < PACK_LANES && first + lane < vertexCount; lane++)
+				{
+					uint16_t position[3] = { (uint16_t)quantized[0][lane], (uint16_t)quantized[1][lane], (uint16_t)quantized[2][lane] };
+					memcpy(vertices_p + (first + lane) * stride, position, sizeof(position));
+				}
+			}
+		}
+
+		void PackNormals(
+			const std::vector<Vertex>&	_in_vertices
+			, PackedMesh&				_out_packedMesh
+		) {
+			uint8_t* vertices_p = _out_packedMesh.vertices.data() + _out_packedMesh.normal_offset;
+			uint32_t stride = _out_packedMesh.vertex_stride;
+			size_t vertexCount = _in_vertices.size();
+
+			if (_out_packedMesh.layout.normal == VertexNormalFormat::FLOAT)
+			{
+				for (size_t v = 0; v < vertexCount; v++)
+					memcpy(vertices_p + v * stride, _in_vertices[v].norm, sizeof(_in_vertices[v].norm));
+				return;
+			}
+
+			for (size_t first = 0; first < vertexCount; first += PACK_LANES)
+			{
+				float lanes[4][PACK_LANES];
+				int16_t octahedral[2][PACK_LANES];
+
+				GatherVertexComponents(_in_vertices, first, NORMAL_FLOAT_OFFSET, 3, lanes);
+				EncodeOctahedralNormals4(lanes[0], lanes[1], lanes[2], octahedral[0], octahedral[1]);
+
+				for (size_t lane = 0; lane < PACK_LANES && first + lane < vertexCount; lane++)
+				{
+					int16_t normal[2] = { octahedral[0][lane], octahedral[1][lane] };
+					memcpy(vertices_p + (first + lane) * stride, normal, sizeof(normal));
+				}
+			}
+		}
+
+		void PackColors(
+			const std::vector<Vertex>&	_in_vertices
+			, PackedMesh&				_out_packedMesh
+		) {
+			uint8_t* vertices_p = _out_packedMesh.vertices.data() + _out_packedMesh.color_offset;
+			uint32_t stride = _out_packedMesh.vertex_stride;
+			size_t vertexCount = _in_vertices.size();
+
+			if (_out_packedMesh.layout.color == VertexColorFormat::FLOAT)
+			{
+				for (size_t v = 0; v < vertexCount; v++)
+					memcpy(vertices_p + v * stride, _in_vertices[v].color, sizeof(_in_vertices[v].color));
+				return;
+			}
+
+			for (size_t first = 0; first < vertexCount; first += PACK_LANES)
+			{
+				float lanes[4][PACK_LANES];
+				uint32_t quantized[4][PACK_LANES];
+
+				GatherVertexComponents(_in_vertices, first, COLOR_FLOAT_OFFSET, 4, lanes);
+				for (uint32_t c = 0; c < 4; c++)
+					QuantizeUnorm4(lanes[c], 0.0f, UNORM8_MAX, UNORM8_MAX, quantized[c]);
+
+				for (size_t lane = 0; lane < PACK_LANES && first + lane < vertexCount; lane++)
+				{
+					uint8_t* color_p = vertices_p + (first + lane) * stride;
+					for (uint32_t c = 0; c < 4; c++)
+						color_p[c] = (uint8_t)quantized[c][lane];
+				}
+			}
+		}
+
+		void PackTexCoords(
+			const std::vector<Vertex>&	_in_vertices
+			, PackedMesh&				_out_packedMesh
+		) {
+			uint8_t* vertices_p = _out_packedMesh.vertices.data() + _out_packedMesh.texcoord_offset;
+			uint32_t stride = _out_packedMesh.vertex_stride;
+			size_t vertexCount = _in_vertices.size();
+
+			if (_out_packedMesh.layout.texcoord == VertexTexCoordFormat::FLOAT)
+			{
+				for (size_t v = 0; v < vertexCount; v++)
+					memcpy(vertices_p + v * stride, _in_vertices[v].texCoord, sizeof(_in_vertices[v].texCoord));
+				return;
+			}
+
+			float scale[2];
+			for (uint32_t c = 0; c < 2; c++)
+				scale[c] = _out_packedMesh.texcoord_extent[c] > 0.0f ? UNORM16_MAX / _out_packedMesh.texcoord_extent[c] : 0.0f;
+
+			for (size_t first = 0; first < vertexCount; first += PACK_LANES)
+			{
+				float lanes[4][PACK_LANES];
+				uint16_t packed[2][PACK_LANES];
+
+				GatherVertexComponents(_in_vertices, first, TEXCOORD_FLOAT_OFFSET, 2, lanes);
+				for (uint32_t c = 0; c < 2; c++)
+				{
+					if (_out_packedMesh.layout.texcoord == VertexTexCoordFormat::HALF)
+					{
+						ConvertFloatsToHalves4(lanes[c], packed[c]);
+					}
+					else
+					{
+						uint32_t quantized[PACK_LANES];
+						QuantizeUnorm4(lanes[c], _out_packedMesh.texcoord_min[c], scale[c], UNORM16_MAX, quantized);
+						for (uint32_t lane = 0; lane < PACK_LANES; lane++)
+							packed[c][lane] = (uint16_t)quantized[lane];
+					}
+				}
+
+				for (size_t lane = 0; lane < PACK_LANES && first + lane < vertexCount; lane++)
+				{
+					uint16_t texCoord[2] = { packed[0][lane], packed[1][lane] };
+					memcpy(vertices_p + (first + lane) * stride, texCoord, sizeof(texCoord));
+				}
+			}
+		}
+
+		void PackSkins(
+			const std::vector<Vertex>&	_in_vertices
+			, PackedMesh&				_out_packedMesh
+		) {
+			uint8_t* vertices_p = _out_packedMesh.vertices.data() + _out_packedMesh.skin_offset;
+			uint32_t stride = _out_packedMesh.vertex_stride;
+			size_t vertexCount = _in_vertices.size();
+
+			if (_out_packedMesh.layout.skin == VertexSkinFormat::FLOAT)
+			{
+				// the FLOAT layout is the one a Vertex holds, weights followed by joint indices
+				for (size_t v = 0; v < vertexCount; v++)
+					memcpy(vertices_p + v * stride, _in_vertices[v].weights,
+						sizeof(_in_vertices[v].weights) + sizeof(_in_vertices[v].joints));
+				return;
+			}
+
+			for (size_t v = 0; v < vertexCount; v++)
+			{
+				const Vertex& vertex = _in_vertices[v];
+				uint8_t* skin_p = vertices_p + v * stride;
+
+				// a vertex's four weights fill the four lanes
+				uint32_t quantized[4];
+				QuantizeUnorm4(vertex.weights, 0.0f, UNORM8_MAX, UNORM8_MAX, quantized);
+
+				// the rounding error goes to the largest weight so the stored weights still sum to 1
+				int sum = (int)(quantized[0] + quantized[1] + quantized[2] + quantized[3]);
+				if (sum > 0)
+					quantized[0] = (uint32_t)std::min(std::max((int)quantized[0] + (int)UNORM8_MAX - sum, 0), (int)UNORM8_MAX);
+
+				for (uint32_t c = 0; c < 4; c++)
+					skin_p[c] = (uint8_t)quantized[c];
+
+				if (_out_packedMesh.layout.skin == VertexSkinFormat::UNORM8_UINT8)
+				{
+					for (uint32_t c = 0; c < 4; c++)
+						skin_p[4 + c] = (uint8_t)vertex.joints[c];
+				}
+				else
+					memcpy(skin_p + 4, vertex.joints, sizeof(vertex.joints));
+			}
+		}
+
+		void MeasurePackingError(
+			const Mesh&					_in_mesh
+			, const Mesh&				_in_unpackedMesh
+			, const VertexLayout&		_in_layout
+			, VertexPackingStats&		_out_stats
+		) {
+			for (size_t v = 0; v < _in_mesh.vertices.size(); v++)
+			{
+				const Vertex& source = _in_mesh.vertices[v];
+				const Vertex& unpacked = _in_unpackedMesh.vertices[v];
+
+				if (HasMeshElement(_in_layout, MeshElement::POSITION))
+					for (uint32_t c = 0; c < 3; c++)
+						_out_stats.max_position_error = std::max(_out_stats.max_position_error, fabsf(source.pos[c] - unpacked.pos[c]));
+
+				if (HasMeshElement(_in_layout, MeshElement::NORMAL))
+				{
+					// angle between directions, from atan2 so small angles keep their precision
+					float cross[3] =
+					{
+						source.norm[1] * unpacked.norm[2] - source.norm[2] * unpacked.norm[1]
+						, source.norm[2] * unpacked.norm[0] - source.norm[0] * unpacked.norm[2]
+						, source.norm[0] * unpacked.norm[1] - source.norm[1] * unpacked.norm[0]
+					};
+					float sine = sqrtf(cross[0] * cross[0] + cross[1] * cross[1] + cross[2] * cross[2]);
+					float cosine = source.norm[0] * unpacked.norm[0] + source.norm[1] * unpacked.norm[1]
+						+ source.norm[2] * unpacked.norm[2];
+
+					// zero-length normals have no direction to lose
+					if (sine > 0.0f || cosine != 0.0f)
+						_out_stats.max_normal_error = std::max(_out_stats.max_normal_error, atan2f(sine, cosine));
+				}
+
+				if (HasMeshElement(_in_layout, MeshElement::COLOR))
+					for (uint32_t c = 0; c < 4; c++)
+						_out_stats.max_color_error = std::max(_out_stats.max_color_error, fabsf(source.color[c] - unpacked.color[c]));
+
+				if (HasMeshElement(_in_layout, MeshElement::TEXCOORD))
+					for (uint32_t c = 0; c < 2; c++)
+						_out_stats.max_texcoord_error = std::max(_out_stats.max_texcoord_error, fabsf(source.texCoord[c] - unpacked.texCoord[c]));
+
+				if (HasMeshElement(_in_layout, MeshElement::SKIN))
+					for (uint32_t c = 0; c < 4; c++)
+						_out_stats.max_weight_error = std::max(_out_stats.max_weight_error, fabsf(source.weights[c] - unpacked.weights[c]));
+			}
+		}
+#pragma endregion
+
+#pragma region Pack Function Definitions
+		uint16_t ConvertFloatToHalf(const float _in_value)
+		{
+			uint32_t bits = 0;
+			memcpy(&bits, &_in_value, sizeof(bits));
+
+			uint32_t sign = bits & 0x80000000;
+			bits ^= sign;
+
+			uint32_t half = 0;
+			if (bits >= ((127 + 16) << 23))
+			{
+				// too large for 16 bits, infinity, or NaN
+				half = bits > 0x7F800000 ? 0x7E00 : 0x7C00;
+			}
+			else if (bits < ((127 - 14) << 23))
+			{
+				// subnormal: adding 0.5 aligns the mantissa so the FPU rounds it
+				const uint32_t subnormalMagic = 126 << 23;
+				float magic = 0.0f, value = 0.0f;
+				memcpy(&magic, &subnormalMagic, sizeof(magic));
+				memcpy(&value, &bits, sizeof(value));
+
+				value += magic;
+				memcpy(&bits, &value, sizeof(bits));
+				half = bits - subnormalMagic;
+			}
+			else
+			{
+				// rebias the exponent and round the mantissa to nearest even
+				uint32_t mantissaOdd = (bits >> 13) & 1;
+				bits += 0x0FFF - ((127 - 15) << 23) + mantissaOdd;
+				half = bits >> 13;
+			}
+
+			return (uint16_t)(half | (sign >> 16));
+		}
+
+		float ConvertHalfToFloat(const uint16_t _in_half)
+		{
+			const uint32_t exponentMask = 0x7C00 << 13;
+
+			uint32_t bits = (uint32_t)(_in_half & 0x7FFF) << 13;
+			uint32_t exponent = bits & exponentMask;
+			bits += (127 - 15) << 23;
+
+			if (exponent == exponentMask)
+			{
+				// infinity or NaN
+				bits += (128 - 16) << 23;
+			}
+			else if (exponent == 0)
+			{
+				// subnormal: renormalize through the FPU
+				const uint32_t subnormalMagic = 113 << 23;
+				float magic = 0.0f, value = 0.0f;
+				memcpy(&magic, &subnormalMagic, sizeof(magic));
+
+				bits += 1 << 23;
+				memcpy(&value, &bits, sizeof(value));
+				value -= magic;
+				memcpy(&bits, &value, sizeof(bits));
+			}
+
+			bits |= (uint32_t)(_in_half & 0x8000) << 16;
+
+			float value = 0.0f;
+			memcpy(&value, &bits, sizeof(value));
+			return value;
+		}
+
+		void EncodeOctahedralNormal(
+			const float*				_in_normal_p
+			, int16_t*					_out_octahedral_p
+		) {
+			// project onto the octahedron |x| + |y| + |z| = 1
+			float length = (fabsf(_in_normal_p[0]) + fabsf(_in_normal_p[1])) + fabsf(_in_normal_p[2]);
+			float scale = 1.0f / std::max(length, 1.0e-20f);
+			float u = _in_normal_p[0] * scale;
+			float v = _in_normal_p[1] * scale;
+
+			// fold the lower half over the diagonals, keeping the signs of u and v
+			if (_in_normal_p[2] < 0.0f)
+			{
+				float foldedU = copysignf(1.0f - fabsf(v), u);
+				float foldedV = copysignf(1.0f - fabsf(u), v);
+				u = foldedU;
+				v = foldedV;
+			}
+
+			_out_octahedral_p[0] = (int16_t)lrintf(std::min(std::max(u, -1.0f), 1.0f) * SNORM16_MAX);
+			_out_octahedral_p[1] = (int16_t)lrintf(std::min(std::max(v, -1.0f), 1.0f) * SNORM16_MAX);
+		}
+
+		void DecodeOctahedralNormal(
+			const int16_t*				_in_octahedral_p
+			, float*					_out_normal_p
+		) {
+			float u = std::max(_in_octahedral_p[0] / SNORM16_MAX, -1.0f);
+			float v = std::max(_in_octahedral_p[1] / SNORM16_MAX, -1.0f);
+			float z = 1.0f - fabsf(u) - fabsf(v);
+
+			// unfold the lower half
+			if (z < 0.0f)
+			{
+				float unfoldedU = copysignf(1.0f - fabsf(v), u);
+				float unfoldedV = copysignf(1.0f - fabsf(u), v);
+				u = unfoldedU;
+				v = unfoldedV;
+			}
+
+			float length = sqrtf(u * u + v * v + z * z);
+			_out_normal_p[0] = u / length;
+			_out_normal_p[1] = v / length;
+			_out_normal_p[2] = z / length;
+		}
+
+		void SetPackedVertexLayout(PackedMesh& _out_packedMesh)
+		{
+			const VertexLayout& layout = _out_packedMesh.layout;
+			uint32_t offset = 0;
+
+			_out_packedMesh.position_offset = 0;
+			_out_packedMesh.normal_offset = 0;
+			_out_packedMesh.color_offset = 0;
+			_out_packedMesh.texcoord_offset = 0;
+			_out_packedMesh.skin_offset = 0;
+
+			// element sizes are rounded up to 4 bytes so every element stays aligned
+			if (HasMeshElement(layout, MeshElement::POSITION))
+			{
+				_out_packedMesh.position_offset = offset;
+				offset += layout.position == VertexPositionFormat::UNORM16 ? 8 : 12;
+			}
+			if (HasMeshElement(layout, MeshElement::NORMAL))
+			{
+				_out_packedMesh.normal_offset = offset;
+				offset += layout.normal == VertexNormalFormat::OCTAHEDRAL16 ? 4 : 12;
+			}
+			if (HasMeshElement(layout, MeshElement::COLOR))
+			{
+				_out_packedMesh.color_offset = offset;
+				offset += layout.color == VertexColorFormat::UNORM8 ? 4 : 16;
+			}
+			if (HasMeshElement(layout, MeshElement::TEXCOORD))
+			{
+				_out_packedMesh.texcoord_offset = offset;
+				offset += layout.texcoord == VertexTexCoordFormat::FLOAT ? 8 : 4;
+			}
+			if (HasMeshElement(layout, MeshElement::SKIN))
+			{
+				_out_packedMesh.skin_offset = offset;
+				offset += layout.skin == VertexSkinFormat::FLOAT ? 24 : layout.skin == VertexSkinFormat::UNORM8_UINT16 ? 12 : 8;
+			}
+
+			_out_packedMesh.vertex_stride = offset;
+		}
+#pragma endregion
+
+#pragma region Interface Function Definitions
+		Result PackMeshVertices(
+			const Mesh&					_in_mesh
+			, const VertexLayout&		_in_layout
+			, PackedMesh&				_out_packedMesh
+			, VertexPackingStats&		_out_stats
+		) {
+			if (_in_mesh.vertices.empty() || (_in_layout.elements & static_cast<uint32_t>(MeshElement::ALL)) == 0)
+				return Result::INVALID_ARG;
+
+			PackedMesh packedMesh;
+			packedMesh.layout = _in_layout;
+			packedMesh.layout.elements &= static_cast<uint32_t>(MeshElement::ALL);
+			SetPackedVertexLayout(packedMesh);
+
+			// -- find bounds --
+			// quantized elements span the range the mesh uses
+			if (HasMeshElement(packedMesh.layout, MeshElement::POSITION)
+				&& packedMesh.layout.position == VertexPositionFormat::UNORM16)
+			{
+				float max[3];
+				for (uint32_t c = 0; c < 3; c++)
+					packedMesh.position_min[c] = max[c] = _in_mesh.vertices[0].pos[c];
+				for (const Vertex& vertex : _in_mesh.vertices)
+					for (uint32_t c = 0; c < 3; c++)
+					{
+						packedMesh.position_min[c] = std::min(packedMesh.position_min[c], vertex.pos[c]);
+						max[c] = std::max(max[c], vertex.pos[c]);
+					}
+				for (uint32_t c = 0; c < 3; c++)
+					packedMesh.position_extent[c] = max[c] - packedMesh.position_min[c];
+			}
+
+			if (HasMeshElement(packedMesh.layout, MeshElement::TEXCOORD)
+				&& packedMesh.layout.texcoord == VertexTexCoordFormat::UNORM16)
+			{
+				float max[2];
+				for (uint32_t c = 0; c < 2; c++)
+					packedMesh.texcoord_min[c] = max[c] = _in_mesh.vertices[0].texCoord[c];
+				for (const Vertex& vertex : _in_mesh.vertices)
+					for (uint32_t c = 0; c < 2; c++)
+					{
+						packedMesh.texcoord_min[c] = std::min(packedMesh.texcoord_min[c], vertex.texCoord[c]);
+						max[c] = std::max(max[c], vertex.texCoord[c]);
+					}
+				for (uint32_t c = 0; c < 2; c++)
+					packedMesh.texcoord_extent[c] = max[c] - packedMesh.texcoord_min[c];
+			}
+			// -- /find bounds --
+
+			// joint indices must fit the format, since a wrapped index would bind the wrong joint.
+			// Only 8-bit indices can be too small for the 16-bit indices of a Vertex
+			if (HasMeshElement(packedMesh.layout, MeshElement::SKIN) && packedMesh.layout.skin == VertexSkinFormat::UNORM8_UINT8)
+			{
+				for (const Vertex& vertex : _in_mesh.vertices)
+					for (uint32_t c = 0; c < 4; c++)
+						if (vertex.joints[c] > JOINT8_MAX)
+							return Result::INVALID_ARG;
+			}
+
+			packedMesh.vertex_count = (uint32_t)_in_mesh.vertices.size();
+			packedMesh.vertices.assign((size_t)packedMesh.vertex_count * packedMesh.vertex_stride, 0);
+
+			if (HasMeshElement(packedMesh.layout, MeshElement::POSITION))
+				PackPositions(_in_mesh.vertices, packedMesh);
+			if (HasMeshElement(packedMesh.layout, MeshElement::NORMAL))
+				PackNormals(_in_mesh.vertices, packedMesh);
+			if (HasMeshElement(packedMesh.layout, MeshElement::COLOR))
+				PackColors(_in_mesh.vertices, packedMesh);
+			if (HasMeshElement(packedMesh.layout, MeshElement::TEXCOORD))
+				PackTexCoords(_in_mesh.vertices, packedMesh);
+			if (HasMeshElement(packedMesh.layout, MeshElement::SKIN))
+				PackSkins(_in_mesh.vertices, packedMesh);
+
+			packedMesh.indices = _in_mesh.indices;
+			packedMesh.submeshes = _in_mesh.submeshes;
+			packedMesh.lods = _in_mesh.lods;
+			packedMesh.parts = _in_mesh.parts;
+			packedMesh.meshlets = _in_mesh.meshlets;
+			packedMesh.meshlet_vertices = _in_mesh.meshlet_vertices;
+			packedMesh.meshlet_triangles = _in_mesh.meshlet_triangles;
+			packedMesh.index_count = (uint32_t)packedMesh.indices.size();
+
+			// decode what was packed and measure it against the source
+			Mesh unpackedMesh;
+			UnpackMeshVertices(packedMesh, unpackedMesh);
+
+			_out_stats = VertexPackingStats();
+			_out_stats.source_vertex_stride = sizeof(Vertex);
+			_out_stats.vertex_stride = packedMesh.vertex_stride;
+			MeasurePackingError(_in_mesh, unpackedMesh, packedMesh.layout, _out_stats);
+
+			_out_packedMesh = std::move(packedMesh);
+
+			return Result::SUCCESS;
+		}
+
+		Result UnpackMeshVertices(
+			const PackedMesh&			_in_packedMesh
+			, Mesh&						_out_mesh
+		) {
+			const VertexLayout& layout = _in_packedMesh.layout;
+			uint32_t vertexCount = _in_packedMesh.vertex_count;
+			uint32_t stride = _in_packedMesh.vertex_stride;
+
+			if (_in_packedMesh.vertices.size() < (size_t)vertexCount * stride)
+				return Result::INVALID_ARG;
+
+			_out_mesh.vertices.assign(vertexCount, Vertex());
+
+			for (uint32_t v = 0; v < vertexCount; v++)
+			{
+				const uint8_t* vertex_p = _in_packedMesh.vertices.data() + (size_t)v * stride;
+				Vertex& vertex = _out_mesh.vertices[v];
+
+				if (HasMeshElement(layout, MeshElement::POSITION))
+				{
+					if (layout.position == VertexPositionFormat::UNORM16)
+					{
+						uint16_t position[3];
+						memcpy(position, vertex_p + _in_packedMesh.position_offset, sizeof(position));
+						for (uint32_t c = 0; c < 3; c++)
+							vertex.pos[c] = _in_packedMesh.position_min[c]
+								+ position[c] * (_in_packedMesh.position_extent[c] / UNORM16_MAX);
+					}
+					else
+						memcpy(vertex.pos, vertex_p + _in_packedMesh.position_offset, sizeof(vertex.pos));
+				}
+
+				if (HasMeshElement(layout, MeshElement::NORMAL))
+				{
+					if (layout.normal == VertexNormalFormat::OCTAHEDRAL16)
+					{
+						int16_t normal[2];
+						memcpy(normal, vertex_p + _in_packedMesh.normal_offset, sizeof(normal));
+						DecodeOctahedralNormal(normal, vertex.norm);
+					}
+					else
+						memcpy(vertex.norm, vertex_p + _in_packedMesh.normal_offset, sizeof(vertex.norm));
+				}
+
+				if (HasMeshElement(layout, MeshElement::COLOR))
+				{
+					if (layout.color == VertexColorFormat::UNORM8)
+					{
+						const uint8_t* color_p = vertex_p + _in_packedMesh.color_offset;
+						for (uint32_t c = 0; c < 4; c++)
+							vertex.color[c] = color_p[c] / UNORM8_MAX;
+					}
+					else
+						memcpy(vertex.color, vertex_p + _in_packedMesh.color_offset, sizeof(vertex.color));
+				}
+
+				if (HasMeshElement(layout, MeshElement::TEXCOORD))
+				{
+					uint16_t texCoord[2];
+					memcpy(texCoord, vertex_p + _in_packedMesh.texcoord_offset, sizeof(texCoord));
+
+					if (layout.texcoord == VertexTexCoordFormat::HALF)
+						for (uint32_t c = 0; c < 2; c++)
+							vertex.texCoord[c] = ConvertHalfToFloat(texCoord[c]);
+					else if (layout.texcoord == VertexTexCoordFormat::UNORM16)
+						for (uint32_t c = 0; c < 2; c++)
+							vertex.texCoord[c] = _in_packedMesh.texcoord_min[c]
+								+ texCoord[c] * (_in_packedMesh.texcoord_extent[c] / UNORM16_MAX);
+					else
+						memcpy(vertex.texCoord, vertex_p + _in_packedMesh.texcoord_offset, sizeof(vertex.texCoord));
+				}
+
+				if (HasMeshElement(layout, MeshElement::SKIN))
+				{
+					const uint8_t* skin_p = vertex_p + _in_packedMesh.skin_offset;
+
+					if (layout.skin == VertexSkinFormat::FLOAT)
+						memcpy(vertex.weights, skin_p, sizeof(vertex.weights) + sizeof(vertex.joints));
+					else
+					{
+						for (uint32_t c = 0; c < 4; c++)
+							vertex.weights[c] = skin_p[c] / UNORM8_MAX;
+
+						if (layout.skin == VertexSkinFormat::UNORM8_UINT8)
+							for (uint32_t c = 0; c < 4; c++)
+								vertex.joints[c] = skin_p[4 + c];
+						else
+							memcpy(vertex.joints, skin_p + 4, sizeof(vertex.joints));
+					}
+				}
+			}
+
+			_out_mesh.indices = _in_packedMesh.indices;
+			_out_mesh.submeshes = _in_packedMesh.submeshes;
+			_out_mesh.lods = _in_packedMesh.lods;
+			_out_mesh.parts = _in_packedMesh.parts;
+			_out_mesh.meshlets = _in_packedMesh.meshlets;
+			_out_mesh.meshlet_vertices = _in_packedMesh.meshlet_vertices;
+			_out_mesh.meshlet_triangles = _in_packedMesh.meshlet_triangles;
+			_out_mesh.vertex_count = vertexCount;
+			_out_mesh.index_count = (uint32_t)_out_mesh.indices.size();
+
+			return Result::SUCCESS;
+		}
+#pragma endregion
+
+	}
+}
@@ -0,0 +1,61 @@
+#ifndef _FBXEXPORTER_LIBRARY_PACK_H_
+#define _FBXEXPORTER_LIBRARY_PACK_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "defines.h"
+
+namespace fbx_exporter
+{
+	namespace library
+	{
+		/* Converts a float to a 16-bit float, rounding to nearest even.
+		  PARAMETERS
+			_in_value : The value to convert. Values too large for 16 bits become infinity.
+		  RETURNS
+			uint16_t : The bits of the 16-bit float.
+		*/
+		uint16_t ConvertFloatToHalf(const float _in_value);
+
+		/* Converts a 16-bit float to a float.
+		  PARAMETERS
+			_in_half : The bits of the 16-bit float.
+		  RETURNS
+			float : The value converted. Every 16-bit float converts exactly.
+		*/
+		float ConvertHalfToFloat(const uint16_t _in_half);
+
+		/* Projects a direction onto an octahedron unfolded into a square, as two 16-bit signed integers.
+		  PARAMETERS
+			_in_normal_p : The direction vector. Need not be unit length.
+			_out_octahedral_p : Storage for the two projected coordinates, -32767 to 32767.
+		*/
+		void EncodeOctahedralNormal(
+			const float*				_in_normal_p
+			, int16_t*					_out_octahedral_p
+		);
+
+		/* Restores a unit direction from its octahedral projection.
+		  PARAMETERS
+			_in_octahedral_p : The two projected coordinates.
+			_out_normal_p : Storage for the unit direction vector.
+		*/
+		void DecodeOctahedralNormal(
+			const int16_t*				_in_octahedral_p
+			, float*					_out_normal_p
+		);
+
+		/* Sets the stride and element offsets of a packed mesh from its layout.
+		  PARAMETERS
+			_out_packedMesh : The mesh to set the stride and offsets of. Its layout must be set.
+		  NOTES
+			Elements are stored in MeshElement order. Each is padded to a multiple of 4 bytes.
+			Elements missing from the layout take no space, and their offsets are 0.
+		*/
+		void SetPackedVertexLayout(PackedMesh& _out_packedMesh);
+
+	}
+}
+
+#endif // _FBXEXPORTER_LIBRARY_PACK_H_
@@ -0,0 +1,31 @@
+#include "interface.h"
+#include "parallel.h"
+
+#include <atomic>
+
+
+namespace fbx_exporter
+{
+	namespace library
+	{
+#pragma region Variables
+		std::atomic<uint32_t> workerThreadCount(0);
+#pragma endregion
+
+#pragma region Parallel Function Definitions
+		uint32_t GetWorkerThreadCount()
+		{
+			return workerThreadCount.load();
+		}
+#pragma endregion
+
+#pragma region Interface Function Definitions
+		void SetWorkerThreadCount(
+			const uint32_t				_in_threadCount
+		) {
+			workerThreadCount.store(_in_threadCount);
+		}
+#pragma endregion
+
+	}
+}
@@ -0,0 +1,143 @@
+#ifndef _FBXEXPORTER_LIBRARY_PARALLEL_H_
+#define _FBXEXPORTER_LIBRARY_PARALLEL_H_
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace fbx_exporter
+{
+	namespace library
+	{
+		// Job queue owned by one worker thread. Other workers steal from its front.
+		struct WorkQueue
+		{
+			std::mutex				mutex;  // Guards jobs.
+			std::deque<uint32_t>	jobs;  // Indices of jobs not yet started.
+		};
+
+
+		/* Gets the number of hardware threads available.
+		  RETURNS
+			uint32_t : The number of hardware threads, or 1 if it cannot be determined.
+		*/
+		inline uint32_t GetHardwareThreadCount()
+		{
+			uint32_t threadCount = std::thread::hardware_concurrency();
+			return threadCount > 0 ? threadCount : 1;
+		}
+
+		/* Gets the number of threads library stages may use, as set by SetWorkerThreadCount.
+		  RETURNS
+			uint32_t : The thread count. 0 indicates one thread per hardware thread.
+		*/
+		uint32_t GetWorkerThreadCount();
+
+		/* Takes a job from a worker's own queue, or steals one from another worker.
+		  PARAMETERS
+			_in_worker : The index of the worker taking a job.
+			_out_queues : The queues of all workers.
+			_out_job : The job taken.
+		  RETURNS
+			true : A job was taken.
+			false : All queues are empty.
+		*/
+		inline bool TakeParallelJob(
+			const uint32_t								_in_worker
+			, std::vector<std::unique_ptr<WorkQueue>>&	_out_queues
+			, uint32_t&									_out_job
+		) {
+			uint32_t queueCount = (uint32_t)_out_queues.size();
+
+			// own queue is worked from the back, stolen from the front
+			for (uint32_t i = 0; i < queueCount; i++)
+			{
+				WorkQueue& queue = *_out_queues[(_in_worker + i) % queueCount];
+				std::lock_guard<std::mutex> lock(queue.mutex);
+
+				if (queue.jobs.empty())
+					continue;
+
+				if (i == 0)
+				{
+					_out_job = queue.jobs.back();
+					queue.jobs.pop_back();
+				}
+				else
+				{
+					_out_job = queue.jobs.front();
+					queue.jobs.pop_front();
+				}
+
+				return true;
+			}
+
+			return false;
+		}
+
+		/* Runs a job for every index in [0, _in_jobCount) on a work-stealing thread pool.
+		  PARAMETERS
+			_in_jobCount : The number of jobs to run.
+			_in_threadCount : The maximum number of threads to use, including the calling thread.
+				Pass 0 to use one thread per hardware thread.
+			_in_job : Callable invoked as _in_job(jobIndex, workerIndex).
+		  NOTES
+			Jobs are dealt to workers in contiguous blocks so neighbouring jobs tend to run on the
+			same thread. Returns once every job has completed.
+		*/
+		template <typename Job>
+		void ParallelFor(
+			const uint32_t				_in_jobCount
+			, uint32_t					_in_threadCount
+			, const Job&				_in_job
+		) {
+			if (_in_threadCount == 0)
+				_in_threadCount = GetHardwareThreadCount();
+			if (_in_threadCount > _in_jobCount)
+				_in_threadCount = _in_jobCount;
+
+			// run small batches on the calling thread
+			if (_in_threadCount <= 1)
+			{
+				for (uint32_t i = 0; i < _in_jobCount; i++)
+					_in_job(i, 0u);
+				return;
+			}
+
+			std::vector<std::unique_ptr<WorkQueue>> queues;
+			for (uint32_t t = 0; t < _in_threadCount; t++)
+			{
+				queues.emplace_back(new WorkQueue);
+
+				uint32_t first = (uint32_t)((uint64_t)_in_jobCount * t / _in_threadCount);
+				uint32_t last = (uint32_t)((uint64_t)_in_jobCount * (t + 1) / _in_threadCount);
+
+				// queue in reverse so the owner pops its block in order
+				for (uint32_t i = last; i > first; i--)
+					queues[t]->jobs.push_back(i - 1);
+			}
+
+			auto worker = [&](uint32_t _in_worker)
+			{
+				uint32_t job = 0;
+				while (TakeParallelJob(_in_worker, queues, job))
+					_in_job(job, _in_worker);
+			};
+
+			std::vector<std::thread> threads;
+			for (uint32_t t = 1; t < _in_threadCount; t++)
+				threads.emplace_back(worker, t);
+
+			worker(0);
+
+			for (uint32_t t = 0; t < threads.size(); t++)
+				threads[t].join();
+		}
+
+	}
+}
+
+#endif // _FBXEXPORTER_LIBRARY_PARALLEL_H_
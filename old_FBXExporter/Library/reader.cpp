@@ -0,0 +1,1544 @@
+#include "interface.h"
+#include "reader.h"
+#include "simd.h"
+#include "weld.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+namespace fbx_exporter
+{
+	namespace library
+	{
+#pragma region Private Helper Functions
+		// Magic string at the start of every binary .fbx file, including its terminator bytes.
+		const char FBX_BINARY_MAGIC[] = "Kaydara FBX Binary  \x00\x1a\x00";
+		const uint32_t FBX_BINARY_MAGIC_LENGTH = 23;
+		const uint32_t FBX_BINARY_HEADER_LENGTH = 27;
+
+		// Node record offsets widen from 32 to 64 bits in version 7500.
+		uint32_t GetFbxBinaryOffsetSize(const FbxBinaryFile& _in_file)
+		{
+			return _in_file.version >= 7500 ? 8 : 4;
+		}
+
+		uint64_t ReadFbxBinaryOffset(const uint8_t* _in_data_p, const uint32_t _in_offsetSize)
+		{
+			if (_in_offsetSize == 8)
+				return GetFbxBinaryArrayValue<uint64_t>(_in_data_p, 0);
+
+			return GetFbxBinaryArrayValue<uint32_t>(_in_data_p, 0);
+		}
+
+		uint32_t GetFbxBinaryElementSize(const char _in_type)
+		{
+			switch (_in_type)
+			{
+			case 'C': case 'b': return 1;
+			case 'Y': return 2;
+			case 'I': case 'F': case 'i': case 'f': return 4;
+			case 'D': case 'L': case 'd': case 'l': return 8;
+			default: return 0;
+			}
+		}
+
+#pragma region Inflate
+		// Bit reader and output window for a single zlib stream.
+		struct InflateState
+		{
+			const uint8_t*	in_p;  // Compressed input.
+			uint32_t		in_length;  // Length of compressed input in bytes.
+			uint32_t		in_pos;  // Next input byte to read.
+			uint32_t		bit_buffer;  // Bits read but not yet consumed.
+			uint32_t		bit_count;  // Number of valid bits in bit_buffer.
+			uint8_t*		out_p;  // Decompressed output.
+			uint32_t		out_length;  // Capacity of output in bytes.
+			uint32_t		out_pos;  // Next output byte to write.
+			bool			overrun;  // Input was exhausted before the stream ended.
+		};
+
+		// Canonical Huffman decoding table.
+		struct InflateHuffman
+		{
+			uint16_t	counts[16];  // Number of codes of each bit length.
+			uint16_t	symbols[288];  // Symbols ordered by code.
+		};
+
+		uint32_t InflateBits(InflateState& _state, const uint32_t _in_count)
+		{
+			while (_state.bit_count < _in_count)
+			{
+				if (_state.in_pos >= _state.in_length)
+				{
+					_state.overrun = true;
+					return 0;
+				}
+
+				_state.bit_buffer |= (uint32_t)_state.in_p[_state.in_pos++] << _state.bit_count;
+				_state.bit_count += 8;
+			}
+
+			uint32_t value = _state.bit_buffer & ((1u << _in_count) - 1);
+			_state.bit_buffer >>= _in_count;
+			_state.bit_count -= _in_count;
+
+			return value;
+		}
+
+		bool BuildInflateHuffman(
+			const uint8_t*				_in_lengths_p
+			, const uint32_t			_in_count
+			, InflateHuffman&			_out_huffman
+		) {
+			uint16_t offsets[16];
+
+			memset(_out_huffman.counts, 0, sizeof(_out_huffman.counts));
+			for (uint32_t i = 0; i < _in_count; i++)
+				_out_huffman.counts[_in_lengths_p[i]]++;
+			_out_huffman.counts[0] = 0;
+
+			// reject over-subscribed code sets
+			int left = 1;
+			for (uint32_t len = 1; len < 16; len++)
+			{
+				left = (left << 1) - _out_huffman.counts[len];
+				if (left < 0)
+					return false;
+			}
+
+			offsets[1] = 0;
+			for (uint32_t len = 1; len < 15; len++)
+				offsets[len + 1] = offsets[len] + _out_huffman.counts[len];
+
+			for (uint32_t i = 0; i < _in_count; i++)
+				if (_in_lengths_p[i] != 0)
+					_out_huffman.symbols[offsets[_in_lengths_p[i]]++] = (uint16_t)i;
+
+			return true;
+		}
+
+		int InflateDecode(InflateState& _state, const InflateHuffman& _in_huffman)
+		{
+			int code = 0;
+			int first = 0;
+			int index = 0;
+
+			// walk canonical codes one bit at a time
+			for (uint32_t len = 1; len < 16; len++)
+			{
+				code |= (int)InflateBits(_state, 1);
+				int count = _in_huffman.counts[len];
+				if (code - first < count)
+					return _in_huffman.symbols[index + (code - first)];
+
+				index += count;
+				first = (first + count) << 1;
+				code <<= 1;
+			}
+
+			return -1;
+		}
+
+		bool InflateCodes(
+			InflateState&				_state
+			, const InflateHuffman&		_in_lengthCodes
+			, const InflateHuffman&		_in_distanceCodes
+		) {
+			static const uint16_t lengthBase[29] = {
+				3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+				35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+			static const uint16_t lengthExtra[29] = {
+				0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+				3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+			static const uint16_t distanceBase[30] = {
+				1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+				257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145,
+				8193, 12289, 16385, 24577 };
+			static const uint16_t distanceExtra[30] = {
+				0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+				7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+
+			for (;;)
+			{
+				int symbol = InflateDecode(_state, _in_lengthCodes);
+				if (symbol < 0 || _state.overrun)
+					return false;
+
+				// literal byte
+				if (symbol < 256)
+				{
+					if (_state.out_pos >= _state.out_length)
+						return false;
+					_state.out_p[_state.out_pos++] = (uint8_t)symbol;
+				}
+				// end of block
+				else if (symbol == 256)
+				{
+					return true;
+				}
+				// back-reference
+				else
+				{
+					symbol -= 257;
+					if (symbol >= 29)
+						return false;
+					uint32_t length = lengthBase[symbol] + InflateBits(_state, lengthExtra[symbol]);
+
+					symbol = InflateDecode(_state, _in_distanceCodes);
+					if (symbol < 0 || symbol >= 30)
+						return false;
+					uint32_t distance = distanceBase[symbol] + InflateBits(_state, distanceExtra[symbol]);
+
+					if (_state.overrun || distance > _state.out_pos
+						|| length > _state.out_length - _state.out_pos)
+						return false;
+
+					// copy byte by byte, source and destination may overlap
+					uint8_t* dst_p = _state.out_p + _state.out_pos;
+					const uint8_t* src_p = dst_p - distance;
+					for (uint32_t i = 0; i < length; i++)
+						dst_p[i] = src_p[i];
+					_state.out_pos += length;
+				}
+			}
+		}
+
+		bool InflateStored(InflateState& _state)
+		{
+			// discard remaining bits of the current byte
+			_state.bit_buffer = 0;
+			_state.bit_count = 0;
+
+			if (_state.in_pos + 4 > _state.in_length)
+				return false;
+
+			uint32_t length = _state.in_p[_state.in_pos] | (_state.in_p[_state.in_pos + 1] << 8);
+			uint32_t lengthComplement =
+				_state.in_p[_state.in_pos + 2] | (_state.in_p[_state.in_pos + 3] << 8);
+			_state.in_pos += 4;
+
+			if (length != (~lengthComplement & 0xFFFF)
+				|| length > _state.in_length - _state.in_pos
+				|| length > _state.out_length - _state.out_pos)
+				return false;
+
+			memcpy(_state.out_p + _state.out_pos, _state.in_p + _state.in_pos, length);
+			_state.in_pos += length;
+			_state.out_pos += length;
+
+			return true;
+		}
+
+		// Huffman tables of fixed-code blocks.
+		struct InflateFixedCodes
+		{
+			InflateHuffman	length_codes;  // Literal and length codes.
+			InflateHuffman	distance_codes;  // Distance codes.
+		};
+
+		InflateFixedCodes BuildInflateFixedCodes()
+		{
+			InflateFixedCodes codes;
+			uint8_t lengths[288];
+			uint32_t i = 0;
+			for (; i < 144; i++) lengths[i] = 8;
+			for (; i < 256; i++) lengths[i] = 9;
+			for (; i < 280; i++) lengths[i] = 7;
+			for (; i < 288; i++) lengths[i] = 8;
+			BuildInflateHuffman(lengths, 288, codes.length_codes);
+
+			for (i = 0; i < 30; i++) lengths[i] = 5;
+			BuildInflateHuffman(lengths, 30, codes.distance_codes);
+
+			return codes;
+		}
+
+		bool InflateFixed(InflateState& _state)
+		{
+			// built once, on first use; files and images are inflated on several threads at once
+			static const InflateFixedCodes codes = BuildInflateFixedCodes();
+
+			return InflateCodes(_state, codes.length_codes, codes.distance_codes);
+		}
+
+		bool InflateDynamic(InflateState& _state)
+		{
+			static const uint8_t codeLengthOrder[19] = {
+				16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+
+			uint32_t lengthCount = InflateBits(_state, 5) + 257;
+			uint32_t distanceCount = InflateBits(_state, 5) + 1;
+			uint32_t codeLengthCount = InflateBits(_state, 4) + 4;
+			if (_state.overrun || lengthCount > 286 || distanceCount > 30)
+				return false;
+
+			uint8_t lengths[320] = {};
+			for (uint32_t i = 0; i < codeLengthCount; i++)
+				lengths[codeLengthOrder[i]] = (uint8_t)InflateBits(_state, 3);
+
+			InflateHuffman codeLengthCodes;
+			if (!BuildInflateHuffman(lengths, 19, codeLengthCodes))
+				return false;
+
+			// read literal/length and distance code lengths as one run-length coded sequence
+			uint32_t index = 0;
+			while (index < lengthCount + distanceCount)
+			{
+				int symbol = InflateDecode(_state, codeLengthCodes);
+				if (symbol < 0 || _state.overrun)
+					return false;
+
+				if (symbol < 16)
+				{
+					lengths[index++] = (uint8_t)symbol;
+					continue;
+				}
+
+				uint8_t repeated = 0;
+				uint32_t repeat = 0;
+				if (symbol == 16)
+				{
+					if (index == 0)
+						return false;
+					repeated = lengths[index - 1];
+					repeat = 3 + InflateBits(_state, 2);
+				}
+				else if (symbol == 17)
+					repeat = 3 + InflateBits(_state, 3);
+				else
+					repeat = 11 + InflateBits(_state, 7);
+
+				if (index + repeat > lengthCount + distanceCount)
+					return false;
+				while (repeat-- > 0)
+					lengths[index++] = repeated;
+			}
+
+			// end-of-block code must be present
+			if (lengths[256] == 0)
+				return false;
+
+			InflateHuffman lengthCodes;
+			InflateHuffman distanceCodes;
+			if (!BuildInflateHuffman(lengths, lengthCount, lengthCodes)
+				|| !BuildInflateHuffman(lengths + lengthCount, distanceCount, distanceCodes))
+				return false;
+
+			return InflateCodes(_state, lengthCodes, distanceCodes);
+		}
+#pragma endregion
+
+		// Gets the length of an object name, excluding the "\x00\x01Class" suffix.
+		uint32_t GetFbxBinaryObjectNameLength(const FbxBinaryProperty& _in_property)
+		{
+			for (uint32_t i = 0; i < _in_property.length; i++)
+				if (_in_property.data_p[i] == '\0')
+					return i;
+
+			return _in_property.length;
+		}
+
+		// Mapping modes of a geometry layer element.
+		enum struct FbxBinaryMapping
+		{
+			BY_POLYGON_VERTEX = 0
+			, BY_CONTROL_POINT
+			, BY_POLYGON
+			, ALL_SAME
+		};
+
+		// Resolved arrays of one geometry layer element.
+		struct FbxBinaryLayer
+		{
+			bool					present = false;  // Whether the layer exists in the geometry.
+			FbxBinaryMapping		mapping = FbxBinaryMapping::BY_POLYGON_VERTEX;  // Mapping mode.
+			bool					indexed = false;  // Whether values are referenced through an index array.
+			char					direct_type = 0;  // Element type of direct array.
+			const uint8_t*			direct_p = nullptr;  // Direct array values.
+			uint64_t				direct_count = 0;  // Number of values in direct array.
+			const uint8_t*			index_p = nullptr;  // Index array values.
+			uint64_t				index_count = 0;  // Number of values in index array.
+			std::vector<uint8_t>	direct_scratch;  // Inflated direct array, if compressed.
+			std::vector<uint8_t>	index_scratch;  // Inflated index array, if compressed.
+		};
+
+		Result GetFbxBinaryArrayChild(
+			const FbxBinaryFile&		_in_file
+			, const FbxBinaryNode&		_in_parent
+			, const char*				_in_name
+			, std::vector<uint8_t>&		_out_scratch
+			, char&						_out_type
+			, const uint8_t*&			_out_data_p
+			, uint64_t&					_out_count
+		) {
+			FbxBinaryNode node;
+			FbxBinaryProperty prop;
+
+			if (!FindFbxBinaryChild(_in_file, _in_parent, _in_name, node)
+				|| !GetFbxBinaryProperty(node, 0, prop))
+				return Result::FAIL;
+
+			Result ret_result = GetFbxBinaryArray(prop, _out_scratch, _out_data_p);
+			if (!Succeeded(ret_result))
+				return ret_result;
+
+			_out_type = prop.type;
+			_out_count = prop.length;
+			return Result::SUCCESS;
+		}
+
+		void GetFbxBinaryLayer(
+			const FbxBinaryFile&		_in_file
+			, const FbxBinaryNode&		_in_geometry
+			, const char*				_in_layerName
+			, const char*				_in_directName
+			, const char*				_in_indexName
+			, FbxBinaryLayer&			_out_layer
+		) {
+			FbxBinaryNode layer;
+			FbxBinaryNode child;
+			FbxBinaryProperty prop;
+
+			// first layer element of this type is layer 0
+			if (!FindFbxBinaryChild(_in_file, _in_geometry, _in_layerName, layer))
+				return;
+
+			if (FindFbxBinaryChild(_in_file, layer, "MappingInformationType", child)
+				&& GetFbxBinaryProperty(child, 0, prop))
+			{
+				if (FbxBinaryStringIs(prop, "ByVertice") || FbxBinaryStringIs(prop, "ByVertex")
+					|| FbxBinaryStringIs(prop, "ByControlPoint"))
+					_out_layer.mapping = FbxBinaryMapping::BY_CONTROL_POINT;
+				else if (FbxBinaryStringIs(prop, "ByPolygon"))
+					_out_layer.mapping = FbxBinaryMapping::BY_POLYGON;
+				else if (FbxBinaryStringIs(prop, "AllSame"))
+					_out_layer.mapping = FbxBinaryMapping::ALL_SAME;
+			}
+
+			if (FindFbxBinaryChild(_in_file, layer, "ReferenceInformationType", child)
+				&& GetFbxBinaryProperty(child, 0, prop))
+				_out_layer.indexed = !FbxBinaryStringIs(prop, "Direct");
+
+			char indexType = 0;
+			if (!Succeeded(GetFbxBinaryArrayChild(_in_file, layer, _in_directName,
+				_out_layer.direct_scratch, _out_layer.direct_type, _out_layer.direct_p,
+				_out_layer.direct_count)))
+				return;
+
+			if (_out_layer.indexed && (!Succeeded(GetFbxBinaryArrayChild(_in_file, layer, _in_indexName,
+				_out_layer.index_scratch, indexType, _out_layer.index_p, _out_layer.index_count))
+				|| indexType != 'i'))
+				return;
+
+			_out_layer.present = true;
+		}
+
+		// Gets the offset of a value in a layer's direct array, or -1 if it is out of range.
+		int64_t GetFbxBinaryLayerOffset(
+			const FbxBinaryLayer&		_in_layer
+			, const uint32_t			_in_components
+			, const int64_t				_in_polygonVertexIndex
+			, const int64_t				_in_controlPoint
+			, const int64_t				_in_polygonIndex
+		) {
+			int64_t index = _in_polygonVertexIndex;
+			if (_in_layer.mapping == FbxBinaryMapping::BY_CONTROL_POINT)
+				index = _in_controlPoint;
+			else if (_in_layer.mapping == FbxBinaryMapping::BY_POLYGON)
+				index = _in_polygonIndex;
+			else if (_in_layer.mapping == FbxBinaryMapping::ALL_SAME)
+				index = 0;
+
+			if (_in_layer.indexed)
+			{
+				if (index < 0 || (uint64_t)index >= _in_layer.index_count)
+					return -1;
+				index = GetFbxBinaryArrayValue<int32_t>(_in_layer.index_p, index);
+			}
+
+			if (index < 0 || (uint64_t)(index + 1) * _in_components > _in_layer.direct_count)
+				return -1;
+
+			return index * _in_components;
+		}
+
+		void GetElementsFromFbxBinaryPolygonVertex(
+			const FbxBinaryLayer&		_in_normals
+			, const FbxBinaryLayer&		_in_colors
+			, const FbxBinaryLayer&		_in_texCoords
+			, const char				_in_positionType
+			, const uint8_t*			_in_positions_p
+			, const int64_t				_in_polygonVertexIndex
+			, const int64_t				_in_controlPoint
+			, const int64_t				_in_polygonIndex
+			, const uint32_t			_in_elementsToExtract
+			, Vertex&					_out_vertex
+		) {
+			if (_in_elementsToExtract & static_cast<int>(MeshElement::POSITION))
+			{
+				for (uint32_t c = 0; c < 3; c++)
+					_out_vertex.pos[c] = (float)GetFbxBinaryNumber(_in_positionType, _in_positions_p,
+						_in_controlPoint * 3 + c);
+			}
+
+			if ((_in_elementsToExtract & static_cast<int>(MeshElement::NORMAL)) && _in_normals.present)
+			{
+				int64_t offset = GetFbxBinaryLayerOffset(_in_normals, 3, _in_polygonVertexIndex,
+					_in_controlPoint, _in_polygonIndex);
+				if (offset >= 0)
+					for (uint32_t c = 0; c < 3; c++)
+						_out_vertex.norm[c] = (float)GetFbxBinaryNumber(_in_normals.direct_type,
+							_in_normals.direct_p, offset + c);
+			}
+
+			if ((_in_elementsToExtract & static_cast<int>(MeshElement::COLOR)) && _in_colors.present)
+			{
+				int64_t offset = GetFbxBinaryLayerOffset(_in_colors, 4, _in_polygonVertexIndex,
+					_in_controlPoint, _in_polygonIndex);
+				if (offset >= 0)
+					for (uint32_t c = 0; c < 4; c++)
+						_out_vertex.color[c] = (float)GetFbxBinaryNumber(_in_colors.direct_type,
+							_in_colors.direct_p, offset + c);
+			}
+
+			if ((_in_elementsToExtract & static_cast<int>(MeshElement::TEXCOORD)) && _in_texCoords.present)
+			{
+				int64_t offset = GetFbxBinaryLayerOffset(_in_texCoords, 2, _in_polygonVertexIndex,
+					_in_controlPoint, _in_polygonIndex);
+				if (offset >= 0)
+				{
+					_out_vertex.texCoord[0] = (float)GetFbxBinaryNumber(_in_texCoords.direct_type,
+						_in_texCoords.direct_p, offset);
+					_out_vertex.texCoord[1] = (float)(1.0f - GetFbxBinaryNumber(_in_texCoords.direct_type,
+						_in_texCoords.direct_p, offset + 1));
+				}
+			}
+		}
+
+		bool GetFbxBinaryObjectId(
+			const FbxBinaryNode&		_in_node
+			, const uint32_t			_in_propertyIndex
+			, int64_t&					_out_id
+		) {
+			// object ids and connection ends are 64-bit integer properties
+			FbxBinaryProperty prop;
+			if (!GetFbxBinaryProperty(_in_node, _in_propertyIndex, prop) || prop.type != 'L')
+				return false;
+
+			_out_id = GetFbxBinaryArrayValue<int64_t>(prop.data_p, 0);
+			return true;
+		}
+
+		bool FindFbxBinaryObject(
+			const FbxBinaryFile&		_in_file
+			, const FbxBinaryNode&		_in_objects
+			, const char*				_in_name
+			, const int64_t				_in_id
+			, FbxBinaryNode&			_out_object
+		) {
+			int64_t id = 0;
+			bool found = GetFbxBinaryFirstChild(_in_file, _in_objects, _out_object);
+			for (; found; found = GetFbxBinaryNextSibling(_in_file, _in_objects, _out_object, _out_object))
+				if (FbxBinaryNodeNameIs(_out_object, _in_name) && GetFbxBinaryObjectId(_out_object, 0, id)
+					&& id == _in_id)
+					return true;
+
+			return false;
+		}
+
+		bool FindFbxBinaryParentModel(
+			const FbxBinaryFile&		_in_file
+			, const FbxBinaryNode&		_in_objects
+			, const FbxBinaryNode&		_in_connections
+			, const int64_t				_in_childId
+			, FbxBinaryNode&			_out_model
+		) {
+			// object-to-object connections: "OO", child id, parent id
+			FbxBinaryNode node;
+			FbxBinaryProperty prop;
+			bool found = GetFbxBinaryFirstChild(_in_file, _in_connections, node);
+			for (; found; found = GetFbxBinaryNextSibling(_in_file, _in_connections, node, node))
+			{
+				int64_t childId = 0, parentId = 0;
+				if (GetFbxBinaryProperty(node, 0, prop) && FbxBinaryStringIs(prop, "OO")
+					&& GetFbxBinaryObjectId(node, 1, childId) && childId == _in_childId
+					&& GetFbxBinaryObjectId(node, 2, parentId)
+					&& FindFbxBinaryObject(_in_file, _in_objects, "Model", parentId, _out_model))
+					return true;
+			}
+
+			return false;
+		}
+
+		void SetFbxBinaryEulerMatrix(
+			const double*				_in_degrees_p
+			, const int					_in_order
+			, double*					_out_matrix_p
+		) {
+			// axes in the order they are applied, per FbxEuler::EOrder
+			static const int orders[6][3] = { { 0, 1, 2 }, { 0, 2, 1 }, { 1, 2, 0 }, { 1, 0, 2 }, { 2, 0, 1 }, { 2, 1, 0 } };
+			const int* axes = orders[_in_order >= 0 && _in_order < 6 ? _in_order : 0];
+
+			for (int i = 0; i < 16; i++)
+				_out_matrix_p[i] = i % 5 == 0 ? 1.0 : 0.0;
+
+			for (int a = 0; a < 3; a++)
+			{
+				int axis = axes[a];
+				double radians = _in_degrees_p[axis] * 0.017453292519943295;
+				double c = cos(radians), s = sin(radians);
+
+				// row-vector rotation about one axis
+				double rotation[16] = { 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 };
+				int u = (axis + 1) % 3, v = (axis + 2) % 3;
+				rotation[u * 4 + u] = c;
+				rotation[u * 4 + v] = s;
+				rotation[v * 4 + u] = -s;
+				rotation[v * 4 + v] = c;
+
+				MultiplyMatrix4x4(_out_matrix_p, rotation, _out_matrix_p);
+			}
+		}
+
+		void GetFbxBinaryModelTransform(
+			const FbxBinaryFile&		_in_file
+			, const FbxBinaryNode&		_in_model
+			, double*					_out_matrix_p
+		) {
+			// node transform properties, with the SDK's defaults
+			enum { TRANSLATION, ROTATION, SCALING, PRE_ROTATION, POST_ROTATION, ROTATION_OFFSET, ROTATION_PIVOT,
+				SCALING_OFFSET, SCALING_PIVOT, VECTOR_COUNT };
+			static const char* names[VECTOR_COUNT] = { "Lcl Translation", "Lcl Rotation", "Lcl Scaling",
+				"PreRotation", "PostRotation", "RotationOffset", "RotationPivot", "ScalingOffset", "ScalingPivot" };
+
+			double vectors[VECTOR_COUNT][3] = {};
+			vectors[SCALING][0] = vectors[SCALING][1] = vectors[SCALING][2] = 1.0;
+			int rotationOrder = 0;
+
+			// P records: name, type, label, flags, values...
+			FbxBinaryNode properties;
+			FbxBinaryNode node;
+			FbxBinaryProperty prop;
+			bool found = FindFbxBinaryChild(_in_file, _in_model, "Properties70", properties)
+				&& GetFbxBinaryFirstChild(_in_file, properties, node);
+			for (; found; found = GetFbxBinaryNextSibling(_in_file, properties, node, node))
+			{
+				if (!FbxBinaryNodeNameIs(node, "P") || !GetFbxBinaryProperty(node, 0, prop))
+					continue;
+
+				if (FbxBinaryStringIs(prop, "RotationOrder"))
+				{
+					if (GetFbxBinaryProperty(node, 4, prop))
+						rotationOrder = (int)GetFbxBinaryNumber(prop.type, prop.data_p, 0);
+					continue;
+				}
+
+				for (int v = 0; v < VECTOR_COUNT; v++)
+					if (FbxBinaryStringIs(prop, names[v]))
+					{
+						for (uint32_t c = 0; c < 3; c++)
+							if (GetFbxBinaryProperty(node, 4 + c, prop))
+								vectors[v][c] = GetFbxBinaryNumber(prop.type, prop.data_p, 0);
+						break;
+					}
+			}
+
+			auto setTranslation = [](const double* _in_vector_p, const double _in_sign, double* _out_p)
+			{
+				for (int i = 0; i < 16; i++)
+					_out_p[i] = i % 5 == 0 ? 1.0 : 0.0;
+				for (int c = 0; c < 3; c++)
+					_out_p[12 + c] = _in_vector_p[c] * _in_sign;
+			};
+
+			double rotation[16], preRotation[16], postRotation[16], scaling[16], factor[16];
+			SetFbxBinaryEulerMatrix(vectors[ROTATION], rotationOrder, rotation);
+			SetFbxBinaryEulerMatrix(vectors[PRE_ROTATION], 0, preRotation);
+			SetFbxBinaryEulerMatrix(vectors[POST_ROTATION], 0, postRotation);
+			for (int i = 0; i < 16; i++)
+				scaling[i] = i % 5 == 0 ? (i < 12 ? vectors[SCALING][i / 5] : 1.0) : 0.0;
+
+			// inverse post-rotation is its transpose
+			for (int r = 0; r < 3; r++)
+				for (int c = r + 1; c < 3; c++)
+					std::swap(postRotation[r * 4 + c], postRotation[c * 4 + r]);
+
+			// the SDK's T * Roff * Rp * Rpre * R * Rpost^-1 * Rp^-1 * Soff * Sp * S * Sp^-1, for row vectors
+			setTranslation(vectors[SCALING_PIVOT], -1.0, _out_matrix_p);
+			MultiplyMatrix4x4(_out_matrix_p, scaling, _out_matrix_p);
+			setTranslation(vectors[SCALING_PIVOT], 1.0, factor);
+			MultiplyMatrix4x4(_out_matrix_p, factor, _out_matrix_p);
+			setTranslation(vectors[SCALING_OFFSET], 1.0, factor);
+			MultiplyMatrix4x4(_out_matrix_p, factor, _out_matrix_p);
+			setTranslation(vectors[ROTATION_PIVOT], -1.0, factor);
+			MultiplyMatrix4x4(_out_matrix_p, factor, _out_matrix_p);
+			MultiplyMatrix4x4(_out_matrix_p, postRotation, _out_matrix_p);
+			MultiplyMatrix4x4(_out_matrix_p, rotation, _out_matrix_p);
+			MultiplyMatrix4x4(_out_matrix_p, preRotation, _out_matrix_p);
+			setTranslation(vectors[ROTATION_PIVOT], 1.0, factor);
+			MultiplyMatrix4x4(_out_matrix_p, factor, _out_matrix_p);
+			setTranslation(vectors[ROTATION_OFFSET], 1.0, factor);
+			MultiplyMatrix4x4(_out_matrix_p, factor, _out_matrix_p);
+			setTranslation(vectors[TRANSLATION], 1.0, factor);
+			MultiplyMatrix4x4(_out_matrix_p, factor, _out_matrix_p);
+		}
+
+		Matrix GetFbxBinaryGlobalTransform(
+			const FbxBinaryFile&		_in_file
+			, const FbxBinaryNode&		_in_objects
+			, const FbxBinaryNode&		_in_connections
+			, const FbxBinaryNode&		_in_model
+		) {
+			double global[16];
+			double local[16];
+			GetFbxBinaryModelTransform(_in_file, _in_model, global);
+
+			// compose up the parent chain; the depth limit guards against connection cycles
+			FbxBinaryNode model = _in_model;
+			int64_t id = 0;
+			for (uint32_t depth = 0; depth < 1024 && GetFbxBinaryObjectId(model, 0, id)
+				&& FindFbxBinaryParentModel(_in_file, _in_objects, _in_connections, id, model); depth++)
+			{
+				GetFbxBinaryModelTransform(_in_file, model, local);
+				MultiplyMatrix4x4(global, local, global);
+			}
+
+			Matrix matrix;
+			for (int i = 0; i < 16; i++)
+				matrix.values[i] = (float)global[i];
+
+			return matrix;
+		}
+
+		void GetFbxBinaryPolygonMaterials(
+			const FbxBinaryFile&		_in_file
+			, const FbxBinaryNode&		_in_objects
+			, const FbxBinaryNode&		_in_connections
+			, const FbxBinaryNode&		_in_geometry
+			, const int64_t				_in_modelId
+			, const uint64_t			_in_polygonCount
+			, std::vector<uint32_t>&	_out_materials
+		) {
+			_out_materials.assign(_in_polygonCount, NO_MATERIAL);
+
+			// scene material indices follow the file order of material objects
+			std::vector<int64_t> sceneMaterials;
+			FbxBinaryNode node;
+			FbxBinaryProperty prop;
+			int64_t id = 0;
+			bool found = GetFbxBinaryFirstChild(_in_file, _in_objects, node);
+			for (; found; found = GetFbxBinaryNextSibling(_in_file, _in_objects, node, node))
+				if (FbxBinaryNodeNameIs(node, "Material") && GetFbxBinaryObjectId(node, 0, id))
+					sceneMaterials.push_back(id);
+
+			// material layer indices select among the materials connected to the mesh's node, in connection order
+			std::vector<uint32_t> slotMaterials;
+			found = GetFbxBinaryFirstChild(_in_file, _in_connections, node);
+			for (; found; found = GetFbxBinaryNextSibling(_in_file, _in_connections, node, node))
+			{
+				int64_t childId = 0, parentId = 0;
+				if (!GetFbxBinaryProperty(node, 0, prop) || !FbxBinaryStringIs(prop, "OO")
+					|| !GetFbxBinaryObjectId(node, 1, childId) || !GetFbxBinaryObjectId(node, 2, parentId)
+					|| parentId != _in_modelId)
+					continue;
+
+				std::vector<int64_t>::iterator material = std::find(sceneMaterials.begin(), sceneMaterials.end(), childId);
+				if (material != sceneMaterials.end())
+					slotMaterials.push_back((uint32_t)(material - sceneMaterials.begin()));
+			}
+
+			// one index for the whole mesh, or one per polygon
+			FbxBinaryNode layer;
+			FbxBinaryNode child;
+			if (!FindFbxBinaryChild(_in_file, _in_geometry, "LayerElementMaterial", layer)
+				|| !FindFbxBinaryChild(_in_file, layer, "MappingInformationType", child)
+				|| !GetFbxBinaryProperty(child, 0, prop))
+				return;
+
+			bool allSame = FbxBinaryStringIs(prop, "AllSame");
+			if (!allSame && !FbxBinaryStringIs(prop, "ByPolygon"))
+				return;
+
+			std::vector<uint8_t> scratch;
+			char type = 0;
+			const uint8_t* slots_p = nullptr;
+			uint64_t slotCount = 0;
+			if (!Succeeded(GetFbxBinaryArrayChild(_in_file, layer, "Materials", scratch, type, slots_p, slotCount))
+				|| type != 'i')
+				return;
+
+			for (uint64_t p = 0; p < _in_polygonCount; p++)
+			{
+				uint64_t i = allSame ? 0 : p;
+				if (i >= slotCount)
+					continue;
+
+				int32_t slot = GetFbxBinaryArrayValue<int32_t>(slots_p, i);
+				if (slot >= 0 && (uint32_t)slot < slotMaterials.size())
+					_out_materials[p] = slotMaterials[slot];
+			}
+		}
+
+		bool FindFbxBinaryMeshGeometry(
+			const FbxBinaryFile&		_in_file
+			, const FbxBinaryNode&		_in_objects
+			, const char*				_in_meshName
+			, FbxBinaryNode&			_out_geometry
+		) {
+			FbxBinaryNode node;
+			bool found = GetFbxBinaryFirstChild(_in_file, _in_objects, node);
+
+			for (; found; found = GetFbxBinaryNextSibling(_in_file, _in_objects, node, node))
+			{
+				FbxBinaryProperty name;
+				FbxBinaryProperty type;
+
+				// skip non-mesh geometries
+				if (!FbxBinaryNodeNameIs(node, "Geometry") || !GetFbxBinaryProperty(node, 1, name)
+					|| !GetFbxBinaryProperty(node, 2, type) || !FbxBinaryStringIs(type, "Mesh"))
+					continue;
+
+				// keep first mesh with a matching name,
+				// or keep first mesh in file if no name is specified
+				if (_in_meshName == nullptr || _in_meshName[0] == '\0'
+					|| (GetFbxBinaryObjectNameLength(name) == strlen(_in_meshName)
+						&& memcmp(name.data_p, _in_meshName, strlen(_in_meshName)) == 0))
+				{
+					_out_geometry = node;
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		Result GetMeshFromFbxBinaryGeometry(
+			const FbxBinaryFile&		_in_file
+			, const FbxBinaryNode&		_in_objects
+			, const FbxBinaryNode&		_in_connections
+			, const FbxBinaryNode&		_in_geometry
+			, const uint32_t			_in_elementsToExtract
+			, Mesh&						_out_mesh
+		) {
+			std::vector<uint8_t> positionScratch;
+			std::vector<uint8_t> polygonScratch;
+			char positionType = 0;
+			char polygonType = 0;
+			const uint8_t* positions_p = nullptr;
+			const uint8_t* polygonVertices_p = nullptr;
+			uint64_t positionCount = 0;
+			uint64_t polygonVertexCount = 0;
+
+			// only arrays the extractor reads are inflated
+			if (!Succeeded(GetFbxBinaryArrayChild(_in_file, _in_geometry, "Vertices", positionScratch,
+				positionType, positions_p, positionCount))
+				|| !Succeeded(GetFbxBinaryArrayChild(_in_file, _in_geometry, "PolygonVertexIndex",
+					polygonScratch, polygonType, polygonVertices_p, polygonVertexCount))
+				|| polygonType != 'i')
+				return Result::FAIL;
+
+			FbxBinaryLayer normals;
+			FbxBinaryLayer colors;
+			FbxBinaryLayer texCoords;
+
+			if (_in_elementsToExtract & static_cast<int>(MeshElement::NORMAL))
+				GetFbxBinaryLayer(_in_file, _in_geometry, "LayerElementNormal", "Normals",
+					"NormalsIndex", normals);
+			if (_in_elementsToExtract & static_cast<int>(MeshElement::COLOR))
+				GetFbxBinaryLayer(_in_file, _in_geometry, "LayerElementColor", "Colors",
+					"ColorIndex", colors);
+			if (_in_elementsToExtract & static_cast<int>(MeshElement::TEXCOORD))
+				GetFbxBinaryLayer(_in_file, _in_geometry, "LayerElementUV", "UV", "UVIndex",
+					texCoords);
+
+			uint64_t controlPointCount = positionCount / 3;
+
+			// last vertex of a polygon is stored as the bitwise complement of its index
+			std::vector<uint64_t> polygonStarts(1, 0);
+			for (uint64_t i = 0; i < polygonVertexCount; i++)
+			{
+				int32_t polygonVertex = GetFbxBinaryArrayValue<int32_t>(polygonVertices_p, i);
+				if ((uint64_t)(polygonVertex < 0 ? ~polygonVertex : polygonVertex) >= controlPointCount)
+					return Result::FAIL;
+				if (polygonVertex < 0)
+					polygonStarts.push_back(i + 1);
+			}
+			uint64_t polygonCount = polygonStarts.size() - 1;
+
+			// a geometry instanced by several nodes takes the transform and materials of the first
+			FbxBinaryNode model;
+			int64_t geometryId = 0, modelId = 0;
+			bool hasModel = GetFbxBinaryObjectId(_in_geometry, 0, geometryId)
+				&& FindFbxBinaryParentModel(_in_file, _in_objects, _in_connections, geometryId, model)
+				&& GetFbxBinaryObjectId(model, 0, modelId);
+
+			std::vector<uint32_t> polygonMaterials;
+			if (hasModel)
+				GetFbxBinaryPolygonMaterials(_in_file, _in_objects, _in_connections, _in_geometry, modelId,
+					polygonCount, polygonMaterials);
+			else
+				polygonMaterials.assign(polygonCount, NO_MATERIAL);
+
+			// parts are ordered by material, and each keeps its polygons in the order they were authored
+			std::vector<uint32_t> materials;
+			for (uint32_t material : polygonMaterials)
+				if (std::find(materials.begin(), materials.end(), material) == materials.end())
+					materials.push_back(material);
+			std::sort(materials.begin(), materials.end());
+
+			FbxBinaryProperty name;
+			MeshPart part;
+			if (GetFbxBinaryProperty(_in_geometry, 1, name))
+				part.name.assign((const char*)name.data_p, GetFbxBinaryObjectNameLength(name));
+			if (hasModel)
+				part.transform = GetFbxBinaryGlobalTransform(_in_file, _in_objects, _in_connections, model);
+			else
+				for (int i = 0; i < 16; i++)
+					part.transform.values[i] = i % 5 == 0 ? 1.0f : 0.0f;
+
+			VertexWeldTable table;
+			std::vector<MeshPart> parts;
+			std::vector<Vertex> partVertices;
+			_out_mesh.indices.reserve(_out_mesh.indices.size() + polygonVertexCount);
+
+			// corner vertices of the current polygon
+			std::vector<Vertex> corners;
+
+			for (uint32_t material : materials)
+			{
+				// each part is welded alone so parts never share vertices
+				partVertices.clear();
+				InitializeVertexWeldTable((uint32_t)controlPointCount, table);
+
+				part.material = material;
+				part.index_offset = (uint32_t)_out_mesh.indices.size();
+				part.base_vertex = (uint32_t)_out_mesh.vertices.size();
+
+				for (uint64_t p = 0; p < polygonCount; p++)
+				{
+					if (polygonMaterials[p] != material)
+						continue;
+
+					corners.clear();
+					for (uint64_t i = polygonStarts[p]; i < polygonStarts[p + 1]; i++)
+					{
+						int32_t polygonVertex = GetFbxBinaryArrayValue<int32_t>(polygonVertices_p, i);
+						if (polygonVertex < 0)
+							polygonVertex = ~polygonVertex;
+
+						Vertex vertex;
+						GetElementsFromFbxBinaryPolygonVertex(normals, colors, texCoords, positionType,
+							positions_p, (int64_t)i, polygonVertex, (int64_t)p, _in_elementsToExtract, vertex);
+						corners.push_back(vertex);
+					}
+
+					// fan-triangulate polygons with more than three vertices
+					for (uint32_t c = 1; c + 1 < corners.size(); c++)
+					{
+						_out_mesh.indices.push_back(part.base_vertex + WeldVertex(corners[0], table, partVertices));
+						_out_mesh.indices.push_back(part.base_vertex + WeldVertex(corners[c], table, partVertices));
+						_out_mesh.indices.push_back(part.base_vertex + WeldVertex(corners[c + 1], table, partVertices));
+					}
+				}
+
+				part.index_count = (uint32_t)_out_mesh.indices.size() - part.index_offset;
+				part.vertex_count = (uint32_t)partVertices.size();
+				_out_mesh.vertices.insert(_out_mesh.vertices.end(), partVertices.begin(), partVertices.end());
+				parts.push_back(part);
+			}
+
+			// verify vertices and indices were generated
+			if (_out_mesh.vertices.empty() || _out_mesh.indices.empty())
+				return Result::FAIL;
+
+			// a mesh without materials is one range, and needs no part table
+			if (parts.size() > 1 || parts[0].material != NO_MATERIAL)
+				_out_mesh.parts.insert(_out_mesh.parts.end(), parts.begin(), parts.end());
+
+			_out_mesh.vertex_count = (uint32_t)_out_mesh.vertices.size();
+			_out_mesh.index_count = (uint32_t)_out_mesh.indices.size();
+
+			return Result::EXTRACT;
+		}
+
+		// Material property names and SDK default values for each material component.
+		struct FbxBinaryMaterialComponent
+		{
+			const char*	color_name;  // Name of the color property.
+			const char*	factor_name;  // Name of the factor property. nullptr indicates none.
+			float		default_color;  // Default value of each color channel.
+			float		default_factor;  // Default factor.
+			uint32_t	element;  // MaterialElement flag selecting this component.
+			bool		phong_only;  // Whether the component only exists on Phong materials.
+		};
+
+		void GetMaterialFromFbxBinaryNode(
+			const FbxBinaryFile&		_in_file
+			, const FbxBinaryNode&		_in_materialNode
+			, const FbxBinaryNode&		_in_objects
+			, const FbxBinaryNode&		_in_connections
+			, const uint32_t			_in_elementsToExtract
+			, MaterialList&				_out_materialList
+		) {
+			static const FbxBinaryMaterialComponent components[Material::ComponentType::COUNT] = {
+				{ "DiffuseColor", "DiffuseFactor", 0.8f, 1.0f,
+					static_cast<uint32_t>(MaterialElement::DIFFUSE), false },
+				{ "EmissiveColor", "EmissiveFactor", 0.0f, 1.0f,
+					static_cast<uint32_t>(MaterialElement::EMISSIVE), false },
+				{ "SpecularColor", "SpecularFactor", 0.2f, 1.0f,
+					static_cast<uint32_t>(MaterialElement::SPECULAR), true },
+				{ "NormalMap", nullptr, 0.0f, 1.0f,
+					static_cast<uint32_t>(MaterialElement::NORMALMAP), false } };
+
+			Material material;
+			FbxBinaryNode node;
+			FbxBinaryProperty prop;
+
+			// a material without an id cannot be the destination of a texture connection
+			int64_t materialId = 0;
+			bool hasId = GetFbxBinaryObjectId(_in_materialNode, 0, materialId);
+
+			bool isPhong = false;
+			if (FindFbxBinaryChild(_in_file, _in_materialNode, "ShadingModel", node)
+				&& GetFbxBinaryProperty(node, 0, prop))
+				isPhong = FbxBinaryStringIs(prop, "phong") || FbxBinaryStringIs(prop, "Phong");
+
+			FbxBinaryNode properties;
+			bool hasProperties = FindFbxBinaryChild(_in_file, _in_materialNode, "Properties70", properties);
+
+			for (uint32_t c = 0; c < Material::ComponentType::COUNT; c++)
+			{
+				if (!(_in_elementsToExtract & components[c].element)
+					|| (components[c].phong_only && !isPhong))
+					continue;
+
+				Material::Component& component = material[c];
+				for (uint32_t v = 0; v < 3; v++)
+					component.value[v] = components[c].default_color;
+				component.factor = components[c].default_factor;
+
+				// P records: name, type, label, flags, values...
+				bool found = hasProperties && GetFbxBinaryFirstChild(_in_file, properties, node);
+				for (; found; found = GetFbxBinaryNextSibling(_in_file, properties, node, node))
+				{
+					if (!FbxBinaryNodeNameIs(node, "P") || !GetFbxBinaryProperty(node, 0, prop))
+						continue;
+
+					if (FbxBinaryStringIs(prop, components[c].color_name))
+					{
+						for (uint32_t v = 0; v < 3; v++)
+							if (GetFbxBinaryProperty(node, 4 + v, prop))
+								component.value[v] = (float)GetFbxBinaryNumber(prop.type, prop.data_p, 0);
+					}
+					else if (components[c].factor_name != nullptr
+						&& FbxBinaryStringIs(prop, components[c].factor_name)
+						&& GetFbxBinaryProperty(node, 4, prop))
+					{
+						component.factor = (float)GetFbxBinaryNumber(prop.type, prop.data_p, 0);
+					}
+				}
+
+				// find a texture connected to the color property, skipping malformed connections
+				found = hasId && GetFbxBinaryFirstChild(_in_file, _in_connections, node);
+				for (; found; found = GetFbxBinaryNextSibling(_in_file, _in_connections, node, node))
+				{
+					int64_t destinationId = 0, textureId = 0;
+					if (!GetFbxBinaryProperty(node, 0, prop) || !FbxBinaryStringIs(prop, "OP")
+						|| !GetFbxBinaryObjectId(node, 2, destinationId) || destinationId != materialId
+						|| !GetFbxBinaryProperty(node, 3, prop)
+						|| !FbxBinaryStringIs(prop, components[c].color_name)
+						|| !GetFbxBinaryObjectId(node, 1, textureId))
+						continue;
+
+					FbxBinaryNode texture;
+					bool foundTexture = GetFbxBinaryFirstChild(_in_file, _in_objects, texture);
+					for (; foundTexture;
+						foundTexture = GetFbxBinaryNextSibling(_in_file, _in_objects, texture, texture))
+					{
+						FbxBinaryNode filename;
+						int64_t id = 0;
+						if (!FbxBinaryNodeNameIs(texture, "Texture") || !GetFbxBinaryObjectId(texture, 0, id)
+							|| id != textureId
+							|| !FindFbxBinaryChild(_in_file, texture, "RelativeFilename", filename)
+							|| !GetFbxBinaryProperty(filename, 0, prop) || prop.type != 'S')
+							continue;
+
+						component.input = InternTexturePath((const char*)prop.data_p, prop.length,
+							_out_materialList);
+						break;
+					}
+
+					break;
+				}
+			}
+
+			_out_materialList.materials.push_back(material);
+		}
+#pragma endregion
+
+#pragma region Reader Function Definitions
+		bool InflateZlibStream(
+			const uint8_t*				_in_data_p
+			, const uint32_t			_in_length
+			, uint8_t*					_out_data_p
+			, const uint32_t			_in_outLength
+		) {
+			// zlib header: deflate method, no preset dictionary
+			if (_in_length < 2 || (_in_data_p[0] & 0x0F) != 8
+				|| ((_in_data_p[0] << 8) | _in_data_p[1]) % 31 != 0 || (_in_data_p[1] & 0x20))
+				return false;
+
+			InflateState state = { _in_data_p, _in_length, 2, 0, 0, _out_data_p, _in_outLength, 0, false };
+
+			uint32_t last = 0;
+			do
+			{
+				last = InflateBits(state, 1);
+				uint32_t type = InflateBits(state, 2);
+
+				bool ok = false;
+				if (type == 0)
+					ok = InflateStored(state);
+				else if (type == 1)
+					ok = InflateFixed(state);
+				else if (type == 2)
+					ok = InflateDynamic(state);
+
+				if (!ok || state.overrun)
+					return false;
+			} while (!last);
+
+			// the Adler-32 trailer is not checked, array lengths are validated instead
+			return state.out_pos == _in_outLength;
+		}
+		Result OpenFbxBinaryFile(
+			const char*					_in_fbxFilepath
+			, FbxBinaryFile&			_out_file
+		) {
+			// ensure file is unmapped
+			if (_in_fbxFilepath == nullptr || _out_file.data_p != nullptr)
+				return Result::INVALID_ARG;
+
+#ifdef _WIN32
+			HANDLE file = CreateFileA(_in_fbxFilepath, GENERIC_READ, FILE_SHARE_READ, nullptr,
+				OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+			if (file == INVALID_HANDLE_VALUE)
+				return Result::FAIL;
+
+			LARGE_INTEGER size;
+			HANDLE mapping = nullptr;
+			if (!GetFileSizeEx(file, &size) || size.QuadPart == 0
+				|| (mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr)) == nullptr)
+			{
+				CloseHandle(file);
+				return Result::FAIL;
+			}
+
+			_out_file.data_p = (const uint8_t*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+			_out_file.size = (uint64_t)size.QuadPart;
+			_out_file.file_handle_p = file;
+			_out_file.mapping_handle_p = mapping;
+#else
+			int file = open(_in_fbxFilepath, O_RDONLY);
+			if (file < 0)
+				return Result::FAIL;
+
+			struct stat status;
+			if (fstat(file, &status) != 0 || status.st_size == 0)
+			{
+				close(file);
+				return Result::FAIL;
+			}
+
+			void* data_p = mmap(nullptr, (size_t)status.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+			close(file);
+
+			if (data_p != MAP_FAILED)
+			{
+				_out_file.data_p = (const uint8_t*)data_p;
+				_out_file.size = (uint64_t)status.st_size;
+			}
+#endif
+
+			// ensure file was mapped
+			if (_out_file.data_p == nullptr)
+			{
+				CloseFbxBinaryFile(_out_file);
+				return Result::FAIL;
+			}
+
+			// ensure file is a binary .fbx file
+			if (_out_file.size < FBX_BINARY_HEADER_LENGTH
+				|| memcmp(_out_file.data_p, FBX_BINARY_MAGIC, FBX_BINARY_MAGIC_LENGTH) != 0)
+			{
+				CloseFbxBinaryFile(_out_file);
+				return Result::FAIL;
+			}
+
+			_out_file.version = GetFbxBinaryArrayValue<uint32_t>(_out_file.data_p + FBX_BINARY_MAGIC_LENGTH, 0);
+
+			return Result::SUCCESS;
+		}
+		void CloseFbxBinaryFile(
+			FbxBinaryFile&				_out_file
+		) {
+#ifdef _WIN32
+			if (_out_file.data_p != nullptr)
+				UnmapViewOfFile(_out_file.data_p);
+			if (_out_file.mapping_handle_p != nullptr)
+				CloseHandle(_out_file.mapping_handle_p);
+			if (_out_file.file_handle_p != nullptr)
+				CloseHandle(_out_file.file_handle_p);
+#else
+			if (_out_file.data_p != nullptr)
+				munmap((void*)_out_file.data_p, (size_t)_out_file.size);
+#endif
+
+			_out_file = FbxBinaryFile();
+		}
+
+		void GetFbxBinaryRootNode(
+			const FbxBinaryFile&		_in_file
+			, FbxBinaryNode&			_out_node
+		) {
+			_out_node = FbxBinaryNode();
+			_out_node.children_p = _in_file.data_p + FBX_BINARY_HEADER_LENGTH;
+			_out_node.end_p = _in_file.data_p + _in_file.size;
+		}
+
+		bool ReadFbxBinaryNode(
+			const FbxBinaryFile&		_in_file
+			, const uint8_t*			_in_record_p
+			, const uint8_t*			_in_end_p
+			, FbxBinaryNode&			_out_node
+		) {
+			uint32_t offsetSize = GetFbxBinaryOffsetSize(_in_file);
+			uint32_t headerLength = offsetSize * 3 + 1;
+
+			if (_in_record_p == nullptr || _in_record_p + headerLength > _in_end_p)
+				return false;
+
+			uint64_t endOffset = ReadFbxBinaryOffset(_in_record_p, offsetSize);
+			uint64_t propertyCount = ReadFbxBinaryOffset(_in_record_p + offsetSize, offsetSize);
+			uint64_t propertyListLength = ReadFbxBinaryOffset(_in_record_p + offsetSize * 2, offsetSize);
+			uint8_t nameLength = _in_record_p[offsetSize * 3];
+
+			// a zeroed record terminates a node list
+			if (endOffset == 0)
+				return false;
+
+			// reject records that do not fit inside their enclosing list; offsets are checked
+			// before they form pointers, which may not point past the mapping
+			if (endOffset > (uint64_t)(_in_end_p - _in_file.data_p))
+				return false;
+
+			const uint8_t* properties_p = _in_record_p + headerLength + nameLength;
+			const uint8_t* end_p = _in_file.data_p + endOffset;
+
+			if (end_p <= _in_record_p || properties_p > end_p
+				|| propertyListLength > (uint64_t)(end_p - properties_p))
+				return false;
+
+			_out_node.name = (const char*)(_in_record_p + headerLength);
+			_out_node.name_length = nameLength;
+			_out_node.property_count = (uint32_t)propertyCount;
+			_out_node.properties_p = properties_p;
+			_out_node.children_p = properties_p + propertyListLength;
+			_out_node.end_p = end_p;
+
+			return true;
+		}
+
+		bool GetFbxBinaryFirstChild(
+			const FbxBinaryFile&		_in_file
+			, const FbxBinaryNode&		_in_parent
+			, FbxBinaryNode&			_out_child
+		) {
+			return ReadFbxBinaryNode(_in_file, _in_parent.children_p, _in_parent.end_p, _out_child);
+		}
+
+		bool GetFbxBinaryNextSibling(
+			const FbxBinaryFile&		_in_file
+			, const FbxBinaryNode&		_in_parent
+			, const FbxBinaryNode&		_in_node
+			, FbxBinaryNode&			_out_sibling
+		) {
+			// copy end before _out_sibling may overwrite _in_node
+			const uint8_t* next_p = _in_node.end_p;
+			return ReadFbxBinaryNode(_in_file, next_p, _in_parent.end_p, _out_sibling);
+		}
+
+		bool FindFbxBinaryChild(
+			const FbxBinaryFile&		_in_file
+			, const FbxBinaryNode&		_in_parent
+			, const char*				_in_name
+			, FbxBinaryNode&			_out_child
+		) {
+			FbxBinaryNode node;
+			bool found = GetFbxBinaryFirstChild(_in_file, _in_parent, node);
+
+			for (; found; found = GetFbxBinaryNextSibling(_in_file, _in_parent, node, node))
+			{
+				if (FbxBinaryNodeNameIs(node, _in_name))
+				{
+					_out_child = node;
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		bool GetFbxBinaryProperty(
+			const FbxBinaryNode&		_in_node
+			, const uint32_t			_in_propertyIndex
+			, FbxBinaryProperty&		_out_property
+		) {
+			if (_in_propertyIndex >= _in_node.property_count)
+				return false;
+
+			const uint8_t* data_p = _in_node.properties_p;
+			const uint8_t* end_p = _in_node.children_p;
+
+			for (uint32_t i = 0; i <= _in_propertyIndex; i++)
+			{
+				if (data_p >= end_p)
+					return false;
+
+				FbxBinaryProperty prop;
+				prop.type = (char)*data_p++;
+
+				uint32_t elementSize = GetFbxBinaryElementSize(prop.type);
+				uint64_t byteCount = 0;
+
+				switch (prop.type)
+				{
+				// scalar values
+				case 'Y': case 'C': case 'I': case 'F': case 'D': case 'L':
+					prop.length = 1;
+					byteCount = elementSize;
+					break;
+
+				// arrays: element count, encoding, byte count
+				case 'f': case 'd': case 'l': case 'i': case 'b':
+					if (data_p + 12 > end_p)
+						return false;
+					prop.length = GetFbxBinaryArrayValue<uint32_t>(data_p, 0);
+					prop.encoding = GetFbxBinaryArrayValue<uint32_t>(data_p, 1);
+					prop.compressed_length = GetFbxBinaryArrayValue<uint32_t>(data_p, 2);
+					data_p += 12;
+					byteCount = prop.compressed_length;
+					break;
+
+				// strings and raw data: byte count
+				case 'S': case 'R':
+					if (data_p + 4 > end_p)
+						return false;
+					prop.length = GetFbxBinaryArrayValue<uint32_t>(data_p, 0);
+					data_p += 4;
+					byteCount = prop.length;
+					break;
+
+				default:
+					return false;
+				}
+
+				if (byteCount > (uint64_t)(end_p - data_p))
+					return false;
+
+				prop.data_p = data_p;
+				data_p += byteCount;
+
+				if (i == _in_propertyIndex)
+					_out_property = prop;
+			}
+
+			return true;
+		}
+
+		Result GetFbxBinaryArray(
+			const FbxBinaryProperty&	_in_property
+			, std::vector<uint8_t>&		_out_scratch
+			, const uint8_t*&			_out_data_p
+		) {
+			uint32_t elementSize = GetFbxBinaryElementSize(_in_property.type);
+
+			// ensure property is an array
+			if (_in_property.type < 'a' || elementSize == 0)
+				return Result::INVALID_ARG;
+
+			uint64_t byteCount = (uint64_t)_in_property.length * elementSize;
+
+			// raw arrays are used in place
+			if (_in_property.encoding == 0)
+			{
+				if (byteCount > _in_property.compressed_length)
+					return Result::FAIL;
+
+				_out_data_p = _in_property.data_p;
+				return Result::SUCCESS;
+			}
+
+			if (_in_property.encoding != 1 || byteCount > 0xFFFFFFFF)
+				return Result::FAIL;
+
+			_out_scratch.resize((size_t)byteCount);
+			if (!InflateZlibStream(_in_property.data_p, _in_property.compressed_length,
+				_out_scratch.data(), (uint32_t)byteCount))
+				return Result::FAIL;
+
+			_out_data_p = _out_scratch.data();
+			return Result::SUCCESS;
+		}
+
+		double GetFbxBinaryNumber(
+			const char					_in_type
+			, const uint8_t*			_in_data_p
+			, const uint64_t			_in_index
+		) {
+			switch (_in_type)
+			{
+			case 'Y': return GetFbxBinaryArrayValue<int16_t>(_in_data_p, _in_index);
+			case 'C': case 'b': return GetFbxBinaryArrayValue<uint8_t>(_in_data_p, _in_index);
+			case 'I': case 'i': return GetFbxBinaryArrayValue<int32_t>(_in_data_p, _in_index);
+			case 'F': case 'f': return GetFbxBinaryArrayValue<float>(_in_data_p, _in_index);
+			case 'D': case 'd': return GetFbxBinaryArrayValue<double>(_in_data_p, _in_index);
+			case 'L': case 'l': return (double)GetFbxBinaryArrayValue<int64_t>(_in_data_p, _in_index);
+			default: return 0.0;
+			}
+		}
+
+		bool FbxBinaryNodeNameIs(
+			const FbxBinaryNode&		_in_node
+			, const char*				_in_name
+		) {
+			return strlen(_in_name) == _in_node.name_length
+				&& memcmp(_in_node.name, _in_name, _in_node.name_length) == 0;
+		}
+
+		bool FbxBinaryStringIs(
+			const FbxBinaryProperty&	_in_property
+			, const char*				_in_string
+		) {
+			return _in_property.type == 'S' && strlen(_in_string) == _in_property.length
+				&& memcmp(_in_property.data_p, _in_string, _in_property.length) == 0;
+		}
+#pragma endregion
+
+#pragma region Interface Function Definitions
+		Result GetMeshFromFbxBinaryFile(
+			const char*					_in_fbxFilepath
+			, const char*				_in_meshName
+			, const uint32_t			_in_elementsToExtract
+			, Mesh&						_out_mesh
+		) {
+			Result ret_result = Result::FAIL;
+
+			FbxBinaryFile file;
+			FbxBinaryNode root;
+			FbxBinaryNode objects;
+			FbxBinaryNode connections;
+			FbxBinaryNode geometry;
+
+			ret_result = OpenFbxBinaryFile(_in_fbxFilepath, file);
+			if (!Succeeded(ret_result))
+				return ret_result;
+
+			GetFbxBinaryRootNode(file, root);
+
+			// without connections the mesh has no node, so no materials and an identity transform
+			if (!FindFbxBinaryChild(file, root, "Connections", connections))
+				connections = FbxBinaryNode();
+
+			if (FindFbxBinaryChild(file, root, "Objects", objects)
+				&& FindFbxBinaryMeshGeometry(file, objects, _in_meshName, geometry))
+				ret_result = GetMeshFromFbxBinaryGeometry(file, objects, connections, geometry,
+					_in_elementsToExtract, _out_mesh);
+			else
+				ret_result = Result::FAIL;
+
+			CloseFbxBinaryFile(file);
+			return ret_result;
+		}
+		Result GetMaterialsFromFbxBinaryFile(
+			const char*					_in_fbxFilepath
+			, const uint32_t			_in_elementsToExtract
+			, MaterialList&				_out_materialList
+		) {
+			Result ret_result = Result::FAIL;
+
+			FbxBinaryFile file;
+			FbxBinaryNode root;
+			FbxBinaryNode objects;
+			FbxBinaryNode connections;
+
+			ret_result = OpenFbxBinaryFile(_in_fbxFilepath, file);
+			if (!Succeeded(ret_result))
+				return ret_result;
+
+			GetFbxBinaryRootNode(file, root);
+
+			if (!FindFbxBinaryChild(file, root, "Objects", objects)
+				|| !FindFbxBinaryChild(file, root, "Connections", connections))
+			{
+				CloseFbxBinaryFile(file);
+				return Result::FAIL;
+			}
+
+			// extract every material in file order, into a local list so failure leaves the output unchanged
+			MaterialList materialList;
+			FbxBinaryNode node;
+
+			bool found = GetFbxBinaryFirstChild(file, objects, node);
+			for (; found; found = GetFbxBinaryNextSibling(file, objects, node, node))
+				if (FbxBinaryNodeNameIs(node, "Material"))
+					GetMaterialFromFbxBinaryNode(file, node, objects, connections, _in_elementsToExtract,
+						materialList);
+
+			if (materialList.materials.empty())
+				ret_result = Result::FAIL;
+			else
+			{
+				_out_materialList = std::move(materialList);
+				ret_result = Result::EXTRACT;
+			}
+
+			CloseFbxBinaryFile(file);
+			return ret_result;
+		}
+		int32_t InternTexturePath(
+			const char*					_in_filepath_p
+			, const uint32_t			_in_length
+			, MaterialList&				_out_materialList
+		) {
+			for (size_t t = 0; t < _out_materialList.textures.size(); t++)
+			{
+				const TexturePath& texture = _out_materialList.textures[t];
+				if (texture.length == _in_length
+					&& memcmp(&_out_materialList.strings[texture.offset], _in_filepath_p, _in_length) == 0)
+					return (int32_t)t;
+			}
+
+			TexturePath texture;
+			texture.offset = (uint32_t)_out_materialList.strings.size();
+			texture.length = _in_length;
+			_out_materialList.strings.append(_in_filepath_p, _in_length);
+			_out_materialList.textures.push_back(texture);
+
+			return (int32_t)(_out_materialList.textures.size() - 1);
+		}
+#pragma endregion
+
+	}
+}
@@ -0,0 +1,257 @@
+#ifndef _FBXEXPORTER_LIBRARY_READER_H_
+#define _FBXEXPORTER_LIBRARY_READER_H_
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "defines.h"
+
+namespace fbx_exporter
+{
+	namespace library
+	{
+		// Read-only memory mapping of a binary .fbx file.
+		struct FbxBinaryFile
+		{
+			const uint8_t*	data_p = nullptr;  // Start of the mapped file.
+			uint64_t		size = 0;  // Length of the mapped file in bytes.
+			uint32_t		version = 0;  // FBX file version, e.g. 7500.
+			void*			file_handle_p = nullptr;  // Platform file handle.
+			void*			mapping_handle_p = nullptr;  // Platform mapping handle.
+		};
+
+		// View of one node record inside a mapped file. Nothing is copied out of the mapping.
+		struct FbxBinaryNode
+		{
+			const char*		name = nullptr;  // Node name. Not null-terminated.
+			uint32_t		name_length = 0;  // Length of node name in bytes.
+			uint32_t		property_count = 0;  // Number of properties in the node.
+			const uint8_t*	properties_p = nullptr;  // Start of the property list.
+			const uint8_t*	children_p = nullptr;  // Start of the nested node list.
+			const uint8_t*	end_p = nullptr;  // End of the node record, including nested nodes.
+		};
+
+		// View of one property value inside a node record.
+		struct FbxBinaryProperty
+		{
+			char			type = 0;  // FBX type code, e.g. 'I', 'D', 'S', 'd', 'i'.
+			const uint8_t*	data_p = nullptr;  // Start of the value, past any length header.
+			uint32_t		length = 0;  // Element count for arrays, byte count for 'S' and 'R'.
+			uint32_t		encoding = 0;  // 0 for raw arrays, 1 for zlib-compressed arrays.
+			uint32_t		compressed_length = 0;  // Byte count of array data in the file.
+		};
+
+
+		/* Memory-maps a binary .fbx file and validates its header.
+		  PARAMETERS
+			_in_fbxFilepath : The path to the .fbx file to map.
+			_out_file : The mapping created.
+		  RETURNS
+			INVALID_ARG : An invalid argument was passed.
+			FAIL : File could not be mapped, or is not a binary .fbx file.
+			SUCCESS : File was mapped.
+		*/
+		Result OpenFbxBinaryFile(
+			const char*					_in_fbxFilepath
+			, FbxBinaryFile&			_out_file
+		);
+
+		/* Unmaps a binary .fbx file.
+		  PARAMETERS
+			_out_file : The mapping to release. Reset on return.
+		*/
+		void CloseFbxBinaryFile(
+			FbxBinaryFile&				_out_file
+		);
+
+		/* Gets a node whose nested node list is the top-level node list of a file.
+		  PARAMETERS
+			_in_file : The mapped file.
+			_out_node : The root node.
+		*/
+		void GetFbxBinaryRootNode(
+			const FbxBinaryFile&		_in_file
+			, FbxBinaryNode&			_out_node
+		);
+
+		/* Reads the node record starting at a position in a mapped file.
+		  PARAMETERS
+			_in_file : The mapped file.
+			_in_record_p : The start of the node record.
+			_in_end_p : The end of the enclosing node list.
+			_out_node : The node read.
+		  RETURNS
+			true : A node was read.
+			false : The record is a list terminator or lies outside the enclosing list.
+		*/
+		bool ReadFbxBinaryNode(
+			const FbxBinaryFile&		_in_file
+			, const uint8_t*			_in_record_p
+			, const uint8_t*			_in_end_p
+			, FbxBinaryNode&			_out_node
+		);
+
+		/* Gets the first nested node of a node.
+		  PARAMETERS
+			_in_file : The mapped file.
+			_in_parent : The node to search.
+			_out_child : The first nested node.
+		  RETURNS
+			true : A nested node was found.
+			false : The node has no nested nodes.
+		*/
+		bool GetFbxBinaryFirstChild(
+			const FbxBinaryFile&		_in_file
+			, const FbxBinaryNode&		_in_parent
+			, FbxBinaryNode&			_out_child
+		);
+
+		/* Gets the node following a node in the same node list.
+		  PARAMETERS
+			_in_file : The mapped file.
+			_in_parent : The node whose nested list contains _in_node.
+			_in_node : The current node.
+			_out_sibling : The next node.
+		  RETURNS
+			true : A following node was found.
+			false : _in_node is the last node in the list.
+		*/
+		bool GetFbxBinaryNextSibling(
+			const FbxBinaryFile&		_in_file
+			, const FbxBinaryNode&		_in_parent
+			, const FbxBinaryNode&		_in_node
+			, FbxBinaryNode&			_out_sibling
+		);
+
+		/* Finds the first nested node of a node with a matching name.
+		  PARAMETERS
+			_in_file : The mapped file.
+			_in_parent : The node to search.
+			_in_name : The node name to search for.
+			_out_child : The node found.
+		  RETURNS
+			true : A matching node was found.
+			false : No nested node has a matching name.
+		*/
+		bool FindFbxBinaryChild(
+			const FbxBinaryFile&		_in_file
+			, const FbxBinaryNode&		_in_parent
+			, const char*				_in_name
+			, FbxBinaryNode&			_out_child
+		);
+
+		/* Gets a property of a node by position.
+		  PARAMETERS
+			_in_node : The node to read from.
+			_in_propertyIndex : The position of the property in the node's property list.
+			_out_property : The property found.
+		  RETURNS
+			true : The property was found.
+			false : The node has too few properties or the property list is malformed.
+		*/
+		bool GetFbxBinaryProperty(
+			const FbxBinaryNode&		_in_node
+			, const uint32_t			_in_propertyIndex
+			, FbxBinaryProperty&		_out_property
+		);
+
+		/* Gets the elements of an array property, inflating them if they are compressed.
+		  PARAMETERS
+			_in_property : The array property to read.
+			_out_scratch : Storage for inflated data. Untouched if the array is not compressed.
+			_out_data_p : Pointer to the first element, either in the mapping or in _out_scratch.
+		  RETURNS
+			INVALID_ARG : The property is not an array.
+			FAIL : Compressed data could not be inflated.
+			SUCCESS : Elements are available at _out_data_p.
+		  NOTES
+			Elements may be unaligned; read them with GetFbxBinaryArrayValue.
+		*/
+		Result GetFbxBinaryArray(
+			const FbxBinaryProperty&	_in_property
+			, std::vector<uint8_t>&		_out_scratch
+			, const uint8_t*&			_out_data_p
+		);
+
+		/* Reads a possibly unaligned value from a property or array.
+		  PARAMETERS
+			_in_data_p : The start of the values.
+			_in_index : The position of the value to read.
+		  RETURNS
+			T : The value read.
+		*/
+		template <typename T>
+		inline T GetFbxBinaryArrayValue(
+			const uint8_t*				_in_data_p
+			, const uint64_t			_in_index
+		) {
+			T value;
+			memcpy(&value, _in_data_p + _in_index * sizeof(T), sizeof(T));
+			return value;
+		}
+
+		/* Reads a numeric property of any scalar or array element type as a double.
+		  PARAMETERS
+			_in_type : The FBX type code of the value.
+			_in_data_p : The start of the values.
+			_in_index : The position of the value to read.
+		  RETURNS
+			double : The value read, or 0.0 if the type is not numeric.
+		*/
+		double GetFbxBinaryNumber(
+			const char					_in_type
+			, const uint8_t*			_in_data_p
+			, const uint64_t			_in_index
+		);
+
+		/* Compares a node name to a null-terminated string.
+		  PARAMETERS
+			_in_node : The node to check.
+			_in_name : The name to compare against.
+		  RETURNS
+			true : The names match.
+			false : The names differ.
+		*/
+		bool FbxBinaryNodeNameIs(
+			const FbxBinaryNode&		_in_node
+			, const char*				_in_name
+		);
+
+		/* Compares a string property to a null-terminated string.
+		  PARAMETERS
+			_in_property : The property to check.
+			_in_string : The string to compare against.
+		  RETURNS
+			true : The property is a string matching _in_string.
+			false : The property is not a string or differs.
+		*/
+		bool FbxBinaryStringIs(
+			const FbxBinaryProperty&	_in_property
+			, const char*				_in_string
+		);
+
+		/* Decompresses a zlib stream whose decompressed length is known.
+		  PARAMETERS
+			_in_data_p : The zlib stream, starting at its two-byte header.
+			_in_length : The length of the stream in bytes.
+			_out_data_p : Storage for _in_outLength decompressed bytes.
+			_in_outLength : The exact decompressed length.
+		  RETURNS
+			true : The stream was decompressed to exactly _in_outLength bytes.
+			false : The stream is malformed, truncated, or decompresses to another length.
+		  NOTES
+			Used for compressed .fbx arrays and for the image data of .png textures. The Adler-32
+			trailer is not checked.
+		*/
+		bool InflateZlibStream(
+			const uint8_t*				_in_data_p
+			, const uint32_t			_in_length
+			, uint8_t*					_out_data_p
+			, const uint32_t			_in_outLength
+		);
+
+	}
+}
+
+#endif // _FBXEXPORTER_LIBRARY_READER_H_
@@ -0,0 +1,92 @@
+#ifndef _FBXEXPORTER_LIBRARY_SIMD_H_
+#define _FBXEXPORTER_LIBRARY_SIMD_H_
+
+#include <cstddef>
+
+#if defined(_M_X64) || defined(_M_AMD64) || defined(__SSE2__) \
+	|| (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FBXLIB_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace fbx_exporter
+{
+	namespace library
+	{
+		/* Multiplies two row-major 4x4 matrices of doubles.
+		  PARAMETERS
+			_in_a_p : The left matrix.
+			_in_b_p : The right matrix.
+			_out_p : The product _in_a_p x _in_b_p. May alias _in_a_p but not _in_b_p.
+		  NOTES
+			With row-vector matrices, as stored in Matrix, the product applies _in_a_p first.
+		*/
+		inline void MultiplyMatrix4x4(
+			const double*				_in_a_p
+			, const double*				_in_b_p
+			, double*					_out_p
+		) {
+#ifdef FBXLIB_SSE2
+			__m128d b0lo = _mm_loadu_pd(_in_b_p + 0), b0hi = _mm_loadu_pd(_in_b_p + 2);
+			__m128d b1lo = _mm_loadu_pd(_in_b_p + 4), b1hi = _mm_loadu_pd(_in_b_p + 6);
+			__m128d b2lo = _mm_loadu_pd(_in_b_p + 8), b2hi = _mm_loadu_pd(_in_b_p + 10);
+			__m128d b3lo = _mm_loadu_pd(_in_b_p + 12), b3hi = _mm_loadu_pd(_in_b_p + 14);
+
+			// each output row is a linear combination of the rows of b
+			for (int r = 0; r < 4; r++)
+			{
+				__m128d a0 = _mm_set1_pd(_in_a_p[r * 4 + 0]);
+				__m128d a1 = _mm_set1_pd(_in_a_p[r * 4 + 1]);
+				__m128d a2 = _mm_set1_pd(_in_a_p[r * 4 + 2]);
+				__m128d a3 = _mm_set1_pd(_in_a_p[r * 4 + 3]);
+
+				__m128d lo = _mm_add_pd(_mm_add_pd(_mm_mul_pd(a0, b0lo), _mm_mul_pd(a1, b1lo)),
+					_mm_add_pd(_mm_mul_pd(a2, b2lo), _mm_mul_pd(a3, b3lo)));
+				__m128d hi = _mm_add_pd(_mm_add_pd(_mm_mul_pd(a0, b0hi), _mm_mul_pd(a1, b1hi)),
+					_mm_add_pd(_mm_mul_pd(a2, b2hi), _mm_mul_pd(a3, b3hi)));
+
+				_mm_storeu_pd(_out_p + r * 4 + 0, lo);
+				_mm_storeu_pd(_out_p + r * 4 + 2, hi);
+			}
+#else
+			for (int r = 0; r < 4; r++)
+			{
+				double a[4] = { _in_a_p[r * 4 + 0], _in_a_p[r * 4 + 1], _in_a_p[r * 4 + 2], _in_a_p[r * 4 + 3] };
+				for (int c = 0; c < 4; c++)
+					_out_p[r * 4 + c] = (a[0] * _in_b_p[c] + a[1] * _in_b_p[4 + c])
+						+ (a[2] * _in_b_p[8 + c] + a[3] * _in_b_p[12 + c]);
+			}
+#endif
+		}
+
+		/* Converts an array of doubles to floats.
+		  PARAMETERS
+			_in_values_p : The doubles to convert.
+			_in_count : The number of values to convert.
+			_out_values_p : Storage for _in_count floats.
+		  NOTES
+			Values are rounded to nearest, so the result matches casting each value.
+		*/
+		inline void ConvertDoublesToFloats(
+			const double*				_in_values_p
+			, const size_t				_in_count
+			, float*					_out_values_p
+		) {
+			size_t i = 0;
+#ifdef FBXLIB_SSE2
+			// two conversions of two doubles each make one store of four floats
+			for (; i + 4 <= _in_count; i += 4)
+			{
+				__m128 lo = _mm_cvtpd_ps(_mm_loadu_pd(_in_values_p + i));
+				__m128 hi = _mm_cvtpd_ps(_mm_loadu_pd(_in_values_p + i + 2));
+				_mm_storeu_ps(_out_values_p + i, _mm_movelh_ps(lo, hi));
+			}
+#endif
+			for (; i < _in_count; i++)
+				_out_values_p[i] = (float)_in_values_p[i];
+		}
+
+	}
+}
+
+#endif // _FBXEXPORTER_LIBRARY_SIMD_H_
@@ -0,0 +1,731 @@
+#include "interface.h"
+#include "optimize.h"
+#include "parallel.h"
+#include "simplify.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <numeric>
+
+
+namespace fbx_exporter
+{
+	namespace library
+	{
+#pragma region Private Helper Functions
+		enum : uint32_t
+		{
+			NO_OPEN_EDGE = 0xFFFFFFFF  // Marks a vertex with no open edge in that direction.
+			, SEVERAL_OPEN_EDGES = 0xFFFFFFFE  // Marks a vertex with more than one open edge in that direction.
+			, SIMPLIFY_ERROR_SAMPLE_COUNT = 4096  // Most collapse errors sampled to pick a pass's error limit.
+		};
+
+		// Edge collapse moving one vertex onto a neighbour.
+		struct EdgeCollapse
+		{
+			uint32_t	source = 0;  // Vertex removed.
+			uint32_t	target = 0;  // Vertex the source moves onto.
+			float		error = 0.0f;  // Quadric error of the source position at the target position.
+		};
+
+		void AddPlaneToQuadric(
+			const float*				_in_normal_p
+			, const float				_in_distance
+			, const float				_in_weight
+			, Quadric&					_out_quadric
+		) {
+			const float* n = _in_normal_p;
+			float d = _in_distance;
+			float w = _in_weight;
+
+			_out_quadric.a00 += w * n[0] * n[0];
+			_out_quadric.a11 += w * n[1] * n[1];
+			_out_quadric.a22 += w * n[2] * n[2];
+			_out_quadric.a10 += w * n[1] * n[0];
+			_out_quadric.a20 += w * n[2] * n[0];
+			_out_quadric.a21 += w * n[2] * n[1];
+			_out_quadric.b0 += w * n[0] * d;
+			_out_quadric.b1 += w * n[1] * d;
+			_out_quadric.b2 += w * n[2] * d;
+			_out_quadric.c += w * d * d;
+			_out_quadric.w += w;
+		}
+
+		void AddQuadric(
+			const Quadric&				_in_quadric
+			, Quadric&					_out_quadric
+		) {
+			_out_quadric.a00 += _in_quadric.a00;
+			_out_quadric.a11 += _in_quadric.a11;
+			_out_quadric.a22 += _in_quadric.a22;
+			_out_quadric.a10 += _in_quadric.a10;
+			_out_quadric.a20 += _in_quadric.a20;
+			_out_quadric.a21 += _in_quadric.a21;
+			_out_quadric.b0 += _in_quadric.b0;
+			_out_quadric.b1 += _in_quadric.b1;
+			_out_quadric.b2 += _in_quadric.b2;
+			_out_quadric.c += _in_quadric.c;
+			_out_quadric.w += _in_quadric.w;
+		}
+
+		float GetQuadricError(
+			const Quadric&				_in_quadric
+			, const float*				_in_position_p
+		) {
+			const Quadric& q = _in_quadric;
+			float x = _in_position_p[0], y = _in_position_p[1], z = _in_position_p[2];
+
+			float error = q.a00 * x * x + q.a11 * y * y + q.a22 * z * z
+				+ 2.0f * (q.a10 * x * y + q.a20 * x * z + q.a21 * y * z)
+				+ 2.0f * (q.b0 * x + q.b1 * y + q.b2 * z) + q.c;
+
+			// average over the plane weights so the error is a squared distance
+			error = fabsf(error);
+			return q.w > 0.0f ? error / q.w : error;
+		}
+
+		void GetTriangleNormal(
+			const float*				_in_p0_p
+			, const float*				_in_p1_p
+			, const float*				_in_p2_p
+			, float*					_out_normal_p
+		) {
+			float e1[3] = { _in_p1_p[0] - _in_p0_p[0], _in_p1_p[1] - _in_p0_p[1], _in_p1_p[2] - _in_p0_p[2] };
+			float e2[3] = { _in_p2_p[0] - _in_p0_p[0], _in_p2_p[1] - _in_p0_p[1], _in_p2_p[2] - _in_p0_p[2] };
+
+			_out_normal_p[0] = e1[1] * e2[2] - e1[2] * e2[1];
+			_out_normal_p[1] = e1[2] * e2[0] - e1[0] * e2[2];
+			_out_normal_p[2] = e1[0] * e2[1] - e1[1] * e2[0];
+		}
+
+		void BuildVertexTriangles(
+			const std::vector<uint32_t>&	_in_indices
+			, const uint32_t			_in_vertexCount
+			, std::vector<uint32_t>&	_out_offsets
+			, std::vector<uint32_t>&	_out_triangles
+		) {
+			// triangles using each vertex, packed per vertex
+			_out_offsets.assign(_in_vertexCount + 1, 0);
+			for (uint32_t index : _in_indices)
+				_out_offsets[index + 1]++;
+			for (uint32_t v = 0; v < _in_vertexCount; v++)
+				_out_offsets[v + 1] += _out_offsets[v];
+
+			std::vector<uint32_t> fillOffsets(_out_offsets.begin(), _out_offsets.end() - 1);
+			_out_triangles.resize(_in_indices.size());
+			for (uint32_t i = 0; i < (uint32_t)_in_indices.size(); i++)
+				_out_triangles[fillOffsets[_in_indices[i]]++] = i / 3;
+		}
+
+		bool HasHalfEdge(
+			const std::vector<uint32_t>&	_in_indices
+			, const std::vector<uint32_t>&	_in_offsets
+			, const std::vector<uint32_t>&	_in_triangles
+			, const uint32_t			_in_from
+			, const uint32_t			_in_to
+		) {
+			for (uint32_t a = _in_offsets[_in_from]; a < _in_offsets[_in_from + 1]; a++)
+			{
+				const uint32_t* triangle_p = &_in_indices[_in_triangles[a] * 3];
+				for (uint32_t c = 0; c < 3; c++)
+					if (triangle_p[c] == _in_from && triangle_p[(c + 1) % 3] == _in_to)
+						return true;
+			}
+
+			return false;
+		}
+
+		bool CanCollapseEdge(
+			const SimplificationState&	_in_state
+			, const uint32_t			_in_source
+			, const uint32_t			_in_target
+		) {
+			const uint32_t source = _in_source, target = _in_target;
+			bool alongLoop = _in_state.loops[source] == target || _in_state.loop_backs[source] == target;
+
+			switch (_in_state.kinds[source])
+			{
+			case CollapseVertexKind::MANIFOLD:
+				return true;
+
+			case CollapseVertexKind::BORDER:
+				// collapsing onto a corner or a seam would pull the loop off its shape
+				return _in_state.kinds[target] == CollapseVertexKind::BORDER && alongLoop;
+
+			case CollapseVertexKind::SEAM:
+			{
+				if (_in_state.kinds[target] != CollapseVertexKind::SEAM || !alongLoop)
+					return false;
+
+				// the copy on the other side must collapse along the same seam edge
+				uint32_t sibling = _in_state.wedges[source];
+				uint32_t siblingTarget = _in_state.loops[source] == target
+					? _in_state.loop_backs[sibling] : _in_state.loops[sibling];
+
+				return siblingTarget < _in_state.remap.size() && siblingTarget != target
+					&& _in_state.remap[siblingTarget] == _in_state.remap[target];
+			}
+
+			default:
+				return false;
+			}
+		}
+
+		bool HasCollapseFlips(
+			const SimplificationState&	_in_state
+			, const std::vector<uint32_t>&	_in_indices
+			, const std::vector<uint32_t>&	_in_offsets
+			, const std::vector<uint32_t>&	_in_triangles
+			, const uint32_t			_in_source
+			, const uint32_t			_in_target
+		) {
+			const float* target_p = &_in_state.positions[_in_target * 3];
+			uint32_t targetPosition = _in_state.remap[_in_target];
+
+			for (uint32_t a = _in_offsets[_in_source]; a < _in_offsets[_in_source + 1]; a++)
+			{
+				const uint32_t* triangle_p = &_in_indices[_in_triangles[a] * 3];
+
+				// triangles using the target position are removed by the collapse
+				if (_in_state.remap[triangle_p[0]] == targetPosition || _in_state.remap[triangle_p[1]] == targetPosition
+					|| _in_state.remap[triangle_p[2]] == targetPosition)
+					continue;
+
+				const float* corners_p[3];
+				const float* moved_p[3];
+				for (uint32_t c = 0; c < 3; c++)
+				{
+					corners_p[c] = &_in_state.positions[triangle_p[c] * 3];
+					moved_p[c] = triangle_p[c] == _in_source ? target_p : corners_p[c];
+				}
+
+				float before[3], after[3];
+				GetTriangleNormal(corners_p[0], corners_p[1], corners_p[2], before);
+				GetTriangleNormal(moved_p[0], moved_p[1], moved_p[2], after);
+
+				float dot = before[0] * after[0] + before[1] * after[1] + before[2] * after[2];
+				float area = before[0] * before[0] + before[1] * before[1] + before[2] * before[2];
+				if (dot <= 0.0f && area > 0.0f)
+					return true;
+			}
+
+			return false;
+		}
+
+		void RemapEdgeLoops(
+			const std::vector<uint32_t>&	_in_collapseRemap
+			, std::vector<uint32_t>&	_out_loops
+		) {
+			for (uint32_t v = 0; v < (uint32_t)_out_loops.size(); v++)
+			{
+				uint32_t next = _out_loops[v];
+				if (next >= _out_loops.size())
+					continue;
+
+				// when the next vertex collapsed onto this one, the loop skips past it
+				uint32_t remapped = _in_collapseRemap[next];
+				_out_loops[v] = remapped == v ? _out_loops[next] : remapped;
+			}
+		}
+#pragma endregion
+
+#pragma region Simplify Function Definitions
+		void InitializeSimplification(
+			const std::vector<Vertex>&	_in_vertices
+			, const std::vector<uint32_t>&	_in_indices
+			, SimplificationState&		_out_state
+		) {
+			uint32_t vertexCount = (uint32_t)_in_vertices.size();
+			uint32_t indexCount = (uint32_t)_in_indices.size();
+
+			_out_state = SimplificationState();
+
+			// -- normalize positions --
+			// quadrics lose precision far from the origin, so errors are measured in the unit cube
+			float min[3] = { FLT_MAX, FLT_MAX, FLT_MAX };
+			float max[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+			for (const Vertex& vertex : _in_vertices)
+				for (uint32_t c = 0; c < 3; c++)
+				{
+					min[c] = std::min(min[c], vertex.pos[c]);
+					max[c] = std::max(max[c], vertex.pos[c]);
+				}
+
+			float scale = std::max(max[0] - min[0], std::max(max[1] - min[1], max[2] - min[2]));
+			_out_state.scale = scale > 0.0f ? scale : 1.0f;
+
+			_out_state.positions.resize((size_t)vertexCount * 3);
+			for (uint32_t v = 0; v < vertexCount; v++)
+				for (uint32_t c = 0; c < 3; c++)
+					_out_state.positions[v * 3 + c] = (_in_vertices[v].pos[c] - min[c]) / _out_state.scale;
+			// -- /normalize positions --
+
+			// -- group positions --
+			// vertices split by a normal, color, or UV seam share a position
+			std::vector<uint32_t> order(vertexCount);
+			std::iota(order.begin(), order.end(), 0);
+			std::sort(order.begin(), order.end(), [&](uint32_t _in_a, uint32_t _in_b)
+			{
+				const float* a_p = _in_vertices[_in_a].pos;
+				const float* b_p = _in_vertices[_in_b].pos;
+				for (uint32_t c = 0; c < 3; c++)
+					if (a_p[c] != b_p[c])
+						return a_p[c] < b_p[c];
+				return _in_a < _in_b;
+			});
+
+			_out_state.remap.resize(vertexCount);
+			_out_state.wedges.resize(vertexCount);
+			for (uint32_t first = 0, last = 0; first < vertexCount; first = last)
+			{
+				const float* position_p = _in_vertices[order[first]].pos;
+				for (last = first + 1; last < vertexCount; last++)
+				{
+					const float* other_p = _in_vertices[order[last]].pos;
+					if (other_p[0] != position_p[0] || other_p[1] != position_p[1] || other_p[2] != position_p[2])
+						break;
+				}
+
+				for (uint32_t i = first; i < last; i++)
+				{
+					_out_state.remap[order[i]] = order[first];
+					_out_state.wedges[order[i]] = order[i + 1 < last ? i + 1 : first];
+				}
+			}
+			// -- /group positions --
+
+			// -- find open edges --
+			// an edge is open when no triangle uses the same two vertices in the opposite direction
+			std::vector<uint32_t> offsets, triangles;
+			BuildVertexTriangles(_in_indices, vertexCount, offsets, triangles);
+
+			_out_state.loops.assign(vertexCount, NO_OPEN_EDGE);
+			_out_state.loop_backs.assign(vertexCount, NO_OPEN_EDGE);
+
+			for (uint32_t i = 0; i < indexCount; i++)
+			{
+				uint32_t from = _in_indices[i];
+				uint32_t to = _in_indices[i % 3 == 2 ? i - 2 : i + 1];
+
+				if (from == to || HasHalfEdge(_in_indices, offsets, triangles, to, from))
+					continue;
+
+				uint32_t& loop = _out_state.loops[from];
+				uint32_t& loopBack = _out_state.loop_backs[to];
+				loop = loop == NO_OPEN_EDGE || loop == to ? to : SEVERAL_OPEN_EDGES;
+				loopBack = loopBack == NO_OPEN_EDGE || loopBack == from ? from : SEVERAL_OPEN_EDGES;
+			}
+			// -- /find open edges --
+
+			// -- classify vertices --
+			_out_state.kinds.assign(vertexCount, CollapseVertexKind::LOCKED);
+
+			for (uint32_t v = 0; v < vertexCount; v++)
+			{
+				if (_out_state.remap[v] != v)
+					continue;
+
+				uint32_t sibling = _out_state.wedges[v];
+				uint32_t loop = _out_state.loops[v], loopBack = _out_state.loop_backs[v];
+
+				if (sibling == v)
+				{
+					if (loop == NO_OPEN_EDGE && loopBack == NO_OPEN_EDGE)
+						_out_state.kinds[v] = CollapseVertexKind::MANIFOLD;
+					else if (loop < vertexCount && loopBack < vertexCount)
+						_out_state.kinds[v] = CollapseVertexKind::BORDER;
+				}
+				else if (_out_state.wedges[sibling] == v)
+				{
+					uint32_t siblingLoop = _out_state.loops[sibling], siblingLoopBack = _out_state.loop_backs[sibling];
+
+					// both sides must run along the same two positions, in opposite directions
+					if (loop < vertexCount && loopBack < vertexCount
+						&& siblingLoop < vertexCount && siblingLoopBack < vertexCount
+						&& _out_state.remap[loop] == _out_state.remap[siblingLoopBack]
+						&& _out_state.remap[loopBack] == _out_state.remap[siblingLoop])
+					{
+						_out_state.kinds[v] = CollapseVertexKind::SEAM;
+						_out_state.kinds[sibling] = CollapseVertexKind::SEAM;
+					}
+				}
+			}
+			// -- /classify vertices --
+
+			// -- build quadrics --
+			_out_state.quadrics.assign(vertexCount, Quadric());
+
+			for (uint32_t i = 0; i < indexCount; i += 3)
+			{
+				const uint32_t* triangle_p = &_in_indices[i];
+				const float* p0_p = &_out_state.positions[triangle_p[0] * 3];
+				const float* p1_p = &_out_state.positions[triangle_p[1] * 3];
+				const float* p2_p = &_out_state.positions[triangle_p[2] * 3];
+
+				float normal[3];
+				GetTriangleNormal(p0_p, p1_p, p2_p, normal);
+
+				float length = sqrtf(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+				if (length == 0.0f)
+					continue;
+
+				for (uint32_t c = 0; c < 3; c++)
+					normal[c] /= length;
+
+				// surface plane, weighted by triangle area
+				float distance = -(normal[0] * p0_p[0] + normal[1] * p0_p[1] + normal[2] * p0_p[2]);
+				for (uint32_t c = 0; c < 3; c++)
+					AddPlaneToQuadric(normal, distance, length * 0.5f, _out_state.quadrics[_out_state.remap[triangle_p[c]]]);
+
+				// planes through open edges keep borders and seams from drifting within the surface
+				for (uint32_t c = 0; c < 3; c++)
+				{
+					uint32_t from = triangle_p[c], to = triangle_p[(c + 1) % 3];
+					if (_out_state.loops[from] != to && _out_state.loops[from] != SEVERAL_OPEN_EDGES)
+						continue;
+					if (HasHalfEdge(_in_indices, offsets, triangles, to, from))
+						continue;
+
+					const float* from_p = &_out_state.positions[from * 3];
+					const float* to_p = &_out_state.positions[to * 3];
+					float edge[3] = { to_p[0] - from_p[0], to_p[1] - from_p[1], to_p[2] - from_p[2] };
+					float edgeLengthSq = edge[0] * edge[0] + edge[1] * edge[1] + edge[2] * edge[2];
+
+					float edgeNormal[3] =
+					{
+						edge[1] * normal[2] - edge[2] * normal[1]
+						, edge[2] * normal[0] - edge[0] * normal[2]
+						, edge[0] * normal[1] - edge[1] * normal[0]
+					};
+					float edgeNormalLength = sqrtf(edgeNormal[0] * edgeNormal[0] + edgeNormal[1] * edgeNormal[1]
+						+ edgeNormal[2] * edgeNormal[2]);
+					if (edgeNormalLength == 0.0f)
+						continue;
+
+					for (uint32_t e = 0; e < 3; e++)
+						edgeNormal[e] /= edgeNormalLength;
+
+					float edgeDistance = -(edgeNormal[0] * from_p[0] + edgeNormal[1] * from_p[1] + edgeNormal[2] * from_p[2]);
+					float weight = edgeLengthSq * SIMPLIFY_EDGE_WEIGHT;
+
+					AddPlaneToQuadric(edgeNormal, edgeDistance, weight, _out_state.quadrics[_out_state.remap[from]]);
+					AddPlaneToQuadric(edgeNormal, edgeDistance, weight, _out_state.quadrics[_out_state.remap[to]]);
+				}
+			}
+			// -- /build quadrics --
+		}
+
+		float SimplifyIndices(
+			SimplificationState&		_out_state
+			, const uint32_t			_in_targetIndexCount
+			, std::vector<uint32_t>&	_out_indices
+		) {
+			SimplificationState& state = _out_state;
+			uint32_t vertexCount = (uint32_t)state.remap.size();
+
+			std::vector<uint32_t> offsets, triangles;
+			std::vector<EdgeCollapse> collapses;
+			std::vector<float> sampleErrors;
+			std::vector<uint32_t> collapseRemap(vertexCount);
+			std::vector<uint8_t> collapseLocked(vertexCount);
+
+			while (_out_indices.size() > _in_targetIndexCount)
+			{
+				uint32_t indexCount = (uint32_t)_out_indices.size();
+				BuildVertexTriangles(_out_indices, vertexCount, offsets, triangles);
+
+				// -- pick collapses --
+				collapses.clear();
+				for (uint32_t i = 0; i < indexCount; i++)
+				{
+					uint32_t a = _out_indices[i];
+					uint32_t b = _out_indices[i % 3 == 2 ? i - 2 : i + 1];
+
+					if (state.remap[a] == state.remap[b])
+						continue;
+
+					// interior edges are seen from both of their triangles; pick them once
+					if (a > b && HasHalfEdge(_out_indices, offsets, triangles, b, a))
+						continue;
+
+					bool forward = CanCollapseEdge(state, a, b);
+					bool backward = CanCollapseEdge(state, b, a);
+					if (!forward && !backward)
+						continue;
+
+					float forwardError = forward
+						? GetQuadricError(state.quadrics[state.remap[a]], &state.positions[b * 3]) : FLT_MAX;
+					float backwardError = backward
+						? GetQuadricError(state.quadrics[state.remap[b]], &state.positions[a * 3]) : FLT_MAX;
+
+					EdgeCollapse collapse;
+					collapse.source = forwardError <= backwardError ? a : b;
+					collapse.target = forwardError <= backwardError ? b : a;
+					collapse.error = std::min(forwardError, backwardError);
+					collapses.push_back(collapse);
+				}
+
+				if (collapses.empty())
+					break;
+
+				// -- /pick collapses --
+
+				// -- perform collapses --
+				// most collapses remove two triangles, and about a third of the cheapest are locked out by
+				// others. Collapses far costlier than those needed to reach the goal wait for the next
+				// pass, where cheaper ones may have opened up
+				auto compareErrors = [](const EdgeCollapse& _in_a, const EdgeCollapse& _in_b)
+				{
+					return _in_a.error < _in_b.error;
+				};
+
+				uint32_t triangleGoal = (indexCount - _in_targetIndexCount + 2) / 3;
+				size_t goalIndex = std::min<size_t>(collapses.size() - 1, triangleGoal * 3 / 4);
+
+				// the limit only needs to be close, so it is read from an evenly spaced sample
+				size_t sampleStride = collapses.size() / SIMPLIFY_ERROR_SAMPLE_COUNT + 1;
+				sampleErrors.clear();
+				for (size_t c = 0; c < collapses.size(); c += sampleStride)
+					sampleErrors.push_back(collapses[c].error);
+				std::sort(sampleErrors.begin(), sampleErrors.end());
+				float errorLimit = sampleErrors[goalIndex / sampleStride] * 1.5f;
+
+				// only collapses under the limit are sorted up front
+				size_t sortedCount = std::partition(collapses.begin(), collapses.end(),
+					[&](const EdgeCollapse& _in_collapse) { return _in_collapse.error <= errorLimit; }) - collapses.begin();
+				std::sort(collapses.begin(), collapses.begin() + sortedCount, compareErrors);
+
+				std::iota(collapseRemap.begin(), collapseRemap.end(), 0);
+				std::fill(collapseLocked.begin(), collapseLocked.end(), 0);
+
+				uint32_t removedTriangles = 0;
+				uint32_t collapseCount = 0;
+
+				for (size_t c = 0; c < collapses.size(); c++)
+				{
+					// collapses over the limit are only used when too few under it could be
+					if (c == sortedCount)
+					{
+						std::sort(collapses.begin() + sortedCount, collapses.end(), compareErrors);
+						sortedCount = collapses.size();
+					}
+
+					const EdgeCollapse& collapse = collapses[c];
+					if (removedTriangles >= triangleGoal)
+						break;
+					if (collapse.error > errorLimit && removedTriangles > triangleGoal / 3)
+						break;
+
+					uint32_t source = collapse.source, target = collapse.target;
+					uint32_t sourcePosition = state.remap[source], targetPosition = state.remap[target];
+
+					// flip checks use this pass's triangles, so each position moves at most once per pass
+					if (collapseLocked[sourcePosition] || collapseLocked[targetPosition])
+						continue;
+
+					bool seam = state.kinds[source] == CollapseVertexKind::SEAM;
+					uint32_t sibling = state.wedges[source];
+					uint32_t siblingTarget = state.loops[source] == target
+						? state.loop_backs[sibling] : state.loops[sibling];
+
+					if (HasCollapseFlips(state, _out_indices, offsets, triangles, source, target)
+						|| (seam && HasCollapseFlips(state, _out_indices, offsets, triangles, sibling, siblingTarget)))
+						continue;
+
+					AddQuadric(state.quadrics[sourcePosition], state.quadrics[targetPosition]);
+
+					collapseRemap[source] = target;
+					if (seam)
+						collapseRemap[sibling] = siblingTarget;
+
+					collapseLocked[sourcePosition] = 1;
+					collapseLocked[targetPosition] = 1;
+
+					removedTriangles += state.kinds[source] == CollapseVertexKind::BORDER ? 1 : 2;
+					state.error = std::max(state.error, collapse.error);
+					collapseCount++;
+				}
+
+				if (collapseCount == 0)
+					break;
+				// -- /perform collapses --
+
+				// -- remap indices --
+				RemapEdgeLoops(collapseRemap, state.loops);
+				RemapEdgeLoops(collapseRemap, state.loop_backs);
+
+				uint32_t writeCount = 0;
+				for (uint32_t i = 0; i < indexCount; i += 3)
+				{
+					uint32_t v0 = collapseRemap[_out_indices[i + 0]];
+					uint32_t v1 = collapseRemap[_out_indices[i + 1]];
+					uint32_t v2 = collapseRemap[_out_indices[i + 2]];
+
+					// drop triangles that collapsed to a line or a point
+					uint32_t p0 = state.remap[v0], p1 = state.remap[v1], p2 = state.remap[v2];
+					if (p0 == p1 || p1 == p2 || p2 == p0)
+						continue;
+
+					_out_indices[writeCount++] = v0;
+					_out_indices[writeCount++] = v1;
+					_out_indices[writeCount++] = v2;
+				}
+				_out_indices.resize(writeCount);
+				// -- /remap indices --
+			}
+
+			return sqrtf(state.error) * state.scale;
+		}
+#pragma endregion
+
+#pragma region Interface Function Definitions
+		Result GenerateMeshLods(
+			const Mesh&					_in_mesh
+			, const std::vector<float>&	_in_triangleRatios
+			, Mesh&						_out_mesh
+		) {
+			uint32_t vertexCount = (uint32_t)_in_mesh.vertices.size();
+
+			// an existing chain is rebuilt from its first level
+			uint32_t sourceIndexCount = _in_mesh.lods.empty()
+				? (uint32_t)_in_mesh.indices.size() : _in_mesh.lods[0].index_count;
+			uint32_t sourceIndexOffset = _in_mesh.lods.empty() ? 0 : _in_mesh.lods[0].index_offset;
+
+			// verify mesh holds whole triangles that reference its vertices
+			if (sourceIndexCount == 0 || sourceIndexCount % 3 != 0
+				|| (size_t)sourceIndexOffset + sourceIndexCount > _in_mesh.indices.size())
+				return Result::INVALID_ARG;
+			for (uint32_t i = sourceIndexOffset; i < sourceIndexOffset + sourceIndexCount; i++)
+				if (_in_mesh.indices[i] >= vertexCount)
+					return Result::INVALID_ARG;
+
+			// verify levels get coarser
+			for (size_t r = 0; r < _in_triangleRatios.size(); r++)
+				if (!(_in_triangleRatios[r] > 0.0f && _in_triangleRatios[r] < 1.0f)
+					|| (r > 0 && _in_triangleRatios[r] >= _in_triangleRatios[r - 1]))
+					return Result::INVALID_ARG;
+
+			// -- source parts --
+			// each part is simplified alone so parts never share triangles; a mesh without parts is one
+			std::vector<MeshPart> sourceParts(1);
+			sourceParts[0].index_offset = sourceIndexOffset;
+			sourceParts[0].index_count = sourceIndexCount;
+
+			if (!_in_mesh.parts.empty())
+			{
+				std::vector<uint32_t> boundaries;
+				if (!GetPartBoundaries(_in_mesh, boundaries))
+					return Result::INVALID_ARG;
+
+				uint32_t partCount = _in_mesh.lods.empty() ? (uint32_t)_in_mesh.parts.size() : _in_mesh.lods[0].part_count;
+				sourceParts.assign(_in_mesh.parts.begin(), _in_mesh.parts.begin() + partCount);
+			}
+			uint32_t partCount = (uint32_t)sourceParts.size();
+			// -- /source parts --
+
+			// -- simplify parts --
+			// indices and largest error of every level of every part, each part's chain run by one job
+			std::vector<std::vector<std::vector<uint32_t>>> partLevels(partCount);
+			std::vector<std::vector<float>> partErrors(partCount);
+
+			ParallelFor(partCount, GetWorkerThreadCount(), [&](uint32_t _in_part, uint32_t)
+			{
+				const MeshPart& part = sourceParts[_in_part];
+				if (part.index_count == 0)
+				{
+					partLevels[_in_part].resize(_in_triangleRatios.size());
+					partErrors[_in_part].resize(_in_triangleRatios.size(), 0.0f);
+					return;
+				}
+
+				// simplify a copy of the part's vertex span so state stays proportional to the part
+				std::vector<uint32_t> levelIndices(_in_mesh.indices.begin() + part.index_offset,
+					_in_mesh.indices.begin() + part.index_offset + part.index_count);
+				uint32_t first = *std::min_element(levelIndices.begin(), levelIndices.end());
+				uint32_t last = *std::max_element(levelIndices.begin(), levelIndices.end());
+				for (uint32_t& index : levelIndices)
+					index -= first;
+
+				std::vector<Vertex> partVertices(_in_mesh.vertices.begin() + first, _in_mesh.vertices.begin() + last + 1);
+				SimplificationState state;
+				InitializeSimplification(partVertices, levelIndices, state);
+
+				for (float ratio : _in_triangleRatios)
+				{
+					uint32_t targetIndexCount = (uint32_t)(part.index_count / 3 * (double)ratio) * 3;
+					partErrors[_in_part].push_back(SimplifyIndices(state, targetIndexCount, levelIndices));
+
+					partLevels[_in_part].push_back(levelIndices);
+					for (uint32_t& index : partLevels[_in_part].back())
+						index += first;
+				}
+			});
+			// -- /simplify parts --
+
+			// build into locals so _in_mesh and _out_mesh may be the same mesh
+			std::vector<Vertex> vertices = _in_mesh.vertices;
+			std::vector<uint32_t> indices(_in_mesh.indices.begin() + sourceIndexOffset,
+				_in_mesh.indices.begin() + sourceIndexOffset + sourceIndexCount);
+			std::vector<MeshLod> lods(1);
+			lods[0].index_count = sourceIndexCount;
+			std::vector<MeshPart> parts;
+
+			if (!_in_mesh.parts.empty())
+			{
+				lods[0].part_count = partCount;
+				parts = sourceParts;
+				for (MeshPart& part : parts)
+					part.index_offset -= sourceIndexOffset;
+			}
+
+			for (size_t r = 0; r < _in_triangleRatios.size(); r++)
+			{
+				MeshLod lod;
+				lod.index_offset = (uint32_t)indices.size();
+				for (uint32_t p = 0; p < partCount; p++)
+				{
+					lod.index_count += (uint32_t)partLevels[p][r].size();
+					lod.error = std::max(lod.error, partErrors[p][r]);
+				}
+
+				// once no collapse is left, further levels would only repeat the last one
+				if (lod.index_count >= lods.back().index_count)
+					break;
+
+				if (!_in_mesh.parts.empty())
+				{
+					lod.part_offset = (uint32_t)parts.size();
+					lod.part_count = partCount;
+				}
+
+				for (uint32_t p = 0; p < partCount; p++)
+				{
+					if (!_in_mesh.parts.empty())
+					{
+						MeshPart part = sourceParts[p];
+						part.index_offset = (uint32_t)indices.size();
+						part.index_count = (uint32_t)partLevels[p][r].size();
+						parts.push_back(part);
+					}
+					indices.insert(indices.end(), partLevels[p][r].begin(), partLevels[p][r].end());
+				}
+				lods.push_back(lod);
+			}
+
+			_out_mesh.vertices.swap(vertices);
+			_out_mesh.indices.swap(indices);
+			_out_mesh.lods.swap(lods);
+			_out_mesh.parts.swap(parts);
+			_out_mesh.submeshes.clear();
+			UpdatePartVertexRanges(_out_mesh);
+			ClearMeshlets(_out_mesh);
+			_out_mesh.vertex_count = (uint32_t)_out_mesh.vertices.size();
+			_out_mesh.index_count = (uint32_t)_out_mesh.indices.size();
+
+			return Result::SUCCESS;
+		}
+#pragma endregion
+
+	}
+}
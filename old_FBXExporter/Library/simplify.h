@@ -0,0 +1,93 @@
+#ifndef _FBXEXPORTER_LIBRARY_SIMPLIFY_H_
+#define _FBXEXPORTER_LIBRARY_SIMPLIFY_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "defines.h"
+
+namespace fbx_exporter
+{
+	namespace library
+	{
+		// Weight of the planes that hold border and seam edges in place, relative to surface planes.
+		const float SIMPLIFY_EDGE_WEIGHT = 10.0f;
+
+
+		// Indicates which edge collapses may remove a vertex.
+		enum struct CollapseVertexKind : uint8_t
+		{
+			MANIFOLD = 0  // Interior vertex. May collapse onto any neighbour.
+			, BORDER  // Vertex on one open edge loop. May only collapse along the loop.
+			, SEAM  // One of two vertices sharing a position on an attribute seam. Both collapse along the seam together.
+			, LOCKED  // Vertex where borders or seams meet. Never removed.
+		};
+
+		// Sum of squared distances to a set of planes, weighted by the area each plane came from.
+		struct Quadric
+		{
+			float	a00 = 0.0f, a11 = 0.0f, a22 = 0.0f;  // Diagonal of the symmetric 3x3 matrix.
+			float	a10 = 0.0f, a20 = 0.0f, a21 = 0.0f;  // Lower triangle of the symmetric 3x3 matrix.
+			float	b0 = 0.0f, b1 = 0.0f, b2 = 0.0f;  // Linear term.
+			float	c = 0.0f;  // Constant term.
+			float	w = 0.0f;  // Total weight of the planes.
+		};
+
+		// Topology and error quadrics kept while simplifying one mesh into successive levels of detail.
+		struct SimplificationState
+		{
+			std::vector<float>				positions;  // Vertex positions scaled into the unit cube, 3 per vertex.
+			float							scale = 1.0f;  // Largest bounding box size. Scales errors back to mesh units.
+			std::vector<uint32_t>			remap;  // First vertex with the same position, per vertex.
+			std::vector<uint32_t>			wedges;  // Next vertex with the same position, per vertex. Forms a cycle.
+			std::vector<CollapseVertexKind>	kinds;  // Collapses allowed, per vertex.
+			std::vector<uint32_t>			loops;  // Vertex the open edge leaving each vertex leads to.
+			std::vector<uint32_t>			loop_backs;  // Vertex the open edge arriving at each vertex comes from.
+			std::vector<Quadric>			quadrics;  // Error quadric per position, indexed by remap.
+			float							error = 0.0f;  // Largest collapse error so far, squared, in the unit cube.
+		};
+
+
+		/* Builds the topology and error quadrics used to simplify a mesh.
+		  PARAMETERS
+			_in_vertices : The vertices of the mesh.
+			_in_indices : The index list to simplify, three indices per triangle.
+			_out_state : The state to initialize.
+		  NOTES
+			Vertices sharing a position are grouped, and open edges between groups are found by
+			looking for the opposite half-edge. A position with one vertex and no open edges is
+			MANIFOLD, and one with a single open edge in and out is BORDER. A position with two
+			vertices whose open edges run along the same positions in opposite directions is a
+			SEAM. Every other vertex is LOCKED. Each position's quadric holds the planes of its
+			triangles, and the planes through its border and seam edges perpendicular to them.
+		*/
+		void InitializeSimplification(
+			const std::vector<Vertex>&	_in_vertices
+			, const std::vector<uint32_t>&	_in_indices
+			, SimplificationState&		_out_state
+		);
+
+		/* Removes triangles from an index list by collapsing edges until a triangle count is reached.
+		  PARAMETERS
+			_out_state : The state built for the index list. Updated by the collapses.
+			_in_targetIndexCount : The number of indices to stop at.
+			_out_indices : The index list to simplify. Degenerate triangles are removed.
+		  RETURNS
+			float : The largest distance from the source surface so far, in mesh units.
+		  NOTES
+			Each pass sorts the allowed collapses by quadric error and applies the cheapest, at most
+			one per position, skipping those that would flip a triangle. Vertices always collapse
+			onto existing vertices, so the simplified indices use the source vertices. Stops early
+			when no allowed collapse is left. Calling again with a lower target continues from the
+			result, so the error of a chain of levels only grows.
+		*/
+		float SimplifyIndices(
+			SimplificationState&		_out_state
+			, const uint32_t			_in_targetIndexCount
+			, std::vector<uint32_t>&	_out_indices
+		);
+
+	}
+}
+
+#endif // _FBXEXPORTER_LIBRARY_SIMPLIFY_H_
@@ -0,0 +1,1185 @@
+#include "interface.h"
+#include "parallel.h"
+#include "reader.h"
+#include "simd.h"
+#include "texture.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <limits>
+
+
+namespace fbx_exporter
+{
+	namespace library
+	{
+#pragma region Private Helper Functions
+		// First eight bytes of every .png file.
+		const uint8_t PNG_SIGNATURE[8] = { 0x89, 'P', 'N', 'G', 0x0D, 0x0A, 0x1A, 0x0A };
+
+		// Interpolation weights of BC7 4-bit indices, out of 64.
+		const uint32_t BC7_INDEX_WEIGHTS[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+		// Weight of the first endpoint for each BC1 index in four-color mode.
+		const float BC1_ENDPOINT_WEIGHTS[4] = { 1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f };
+
+		uint32_t ReadBigEndian32(const uint8_t* _in_data_p)
+		{
+			return ((uint32_t)_in_data_p[0] << 24) | ((uint32_t)_in_data_p[1] << 16)
+				| ((uint32_t)_in_data_p[2] << 8) | (uint32_t)_in_data_p[3];
+		}
+
+		uint8_t PaethPredictor(
+			const int					_in_left
+			, const int					_in_up
+			, const int					_in_upLeft
+		) {
+			int estimate = _in_left + _in_up - _in_upLeft;
+			int left = std::abs(estimate - _in_left);
+			int up = std::abs(estimate - _in_up);
+			int upLeft = std::abs(estimate - _in_upLeft);
+
+			if (left <= up && left <= upLeft)
+				return (uint8_t)_in_left;
+			return (uint8_t)(up <= upLeft ? _in_up : _in_upLeft);
+		}
+
+		bool UnfilterPngScanlines(
+			const uint32_t				_in_height
+			, const size_t				_in_rowBytes
+			, const uint32_t			_in_pixelBytes
+			, uint8_t*					_out_data_p
+		) {
+			const uint8_t* previous_p = nullptr;
+
+			// each scanline starts with its filter type, and is filtered against the unfiltered line above
+			for (uint32_t y = 0; y < _in_height; y++)
+			{
+				uint8_t* line_p = _out_data_p + (size_t)y * (_in_rowBytes + 1);
+				uint8_t* row_p = line_p + 1;
+
+				for (size_t i = 0; i < _in_rowBytes; i++)
+				{
+					int left = i >= _in_pixelBytes ? row_p[i - _in_pixelBytes] : 0;
+					int up = previous_p != nullptr ? previous_p[i] : 0;
+					int upLeft = previous_p != nullptr && i >= _in_pixelBytes ? previous_p[i - _in_pixelBytes] : 0;
+
+					switch (line_p[0])
+					{
+					case 0: break;
+					case 1: row_p[i] = (uint8_t)(row_p[i] + left); break;
+					case 2: row_p[i] = (uint8_t)(row_p[i] + up); break;
+					case 3: row_p[i] = (uint8_t)(row_p[i] + ((left + up) >> 1)); break;
+					case 4: row_p[i] = (uint8_t)(row_p[i] + PaethPredictor(left, up, upLeft)); break;
+					default: return false;
+					}
+				}
+
+				previous_p = row_p;
+			}
+
+			return true;
+		}
+
+		bool ExtensionIs(
+			const char*					_in_filepath
+			, const char*				_in_extension
+		) {
+			const char* extension_p = strrchr(_in_filepath, '.');
+			if (extension_p == nullptr || strlen(extension_p) != strlen(_in_extension))
+				return false;
+
+			for (size_t i = 0; _in_extension[i] != '\0'; i++)
+				if (tolower((unsigned char)extension_p[i]) != _in_extension[i])
+					return false;
+
+			return true;
+		}
+
+		uint32_t SelectPaletteIndices(
+			const uint8_t*				_in_texels_p
+			, const uint8_t*			_in_palette_p
+			, const uint32_t			_in_paletteSize
+			, uint8_t*					_out_indices_p
+		) {
+			int32_t errors[16];
+			int32_t indices[16];
+
+#ifdef FBXLIB_SSE2
+			// four texels per register, widened to 16 bits so differences can be squared and summed with madd
+			__m128i zero = _mm_setzero_si128();
+			__m128i texelsLo[4], texelsHi[4], bestErrors[4], bestIndices[4];
+			for (int g = 0; g < 4; g++)
+			{
+				__m128i texels = _mm_loadu_si128((const __m128i*)(_in_texels_p + g * 16));
+				texelsLo[g] = _mm_unpacklo_epi8(texels, zero);
+				texelsHi[g] = _mm_unpackhi_epi8(texels, zero);
+				bestErrors[g] = _mm_set1_epi32(std::numeric_limits<int32_t>::max());
+				bestIndices[g] = zero;
+			}
+
+			for (uint32_t p = 0; p < _in_paletteSize; p++)
+			{
+				int32_t color;
+				memcpy(&color, _in_palette_p + p * 4, 4);
+				__m128i entry = _mm_unpacklo_epi8(_mm_set1_epi32(color), zero);
+				__m128i index = _mm_set1_epi32((int32_t)p);
+
+				for (int g = 0; g < 4; g++)
+				{
+					__m128i lo = _mm_sub_epi16(texelsLo[g], entry);
+					__m128i hi = _mm_sub_epi16(texelsHi[g], entry);
+					__m128 loSums = _mm_castsi128_ps(_mm_madd_epi16(lo, lo));
+					__m128 hiSums = _mm_castsi128_ps(_mm_madd_epi16(hi, hi));
+
+					// madd leaves red+green and blue+alpha of each texel in neighbouring lanes
+					__m128i error = _mm_add_epi32(
+						_mm_castps_si128(_mm_shuffle_ps(loSums, hiSums, _MM_SHUFFLE(2, 0, 2, 0))),
+						_mm_castps_si128(_mm_shuffle_ps(loSums, hiSums, _MM_SHUFFLE(3, 1, 3, 1))));
+
+					// ties keep the lower index
+					__m128i better = _mm_cmplt_epi32(error, bestErrors[g]);
+					bestErrors[g] = _mm_or_si128(_mm_and_si128(better, error), _mm_andnot_si128(better, bestErrors[g]));
+					bestIndices[g] = _mm_or_si128(_mm_and_si128(better, index), _mm_andnot_si128(better, bestIndices[g]));
+				}
+			}
+
+			for (int g = 0; g < 4; g++)
+			{
+				_mm_storeu_si128((__m128i*)(errors + g * 4), bestErrors[g]);
+				_mm_storeu_si128((__m128i*)(indices + g * 4), bestIndices[g]);
+			}
+#else
+			for (int i = 0; i < 16; i++)
+			{
+				errors[i] = std::numeric_limits<int32_t>::max();
+				indices[i] = 0;
+
+				for (uint32_t p = 0; p < _in_paletteSize; p++)
+				{
+					int32_t error = 0;
+					for (int c = 0; c < 4; c++)
+					{
+						int32_t d = (int32_t)_in_texels_p[i * 4 + c] - (int32_t)_in_palette_p[p * 4 + c];
+						error += d * d;
+					}
+
+					if (error < errors[i])
+					{
+						errors[i] = error;
+						indices[i] = (int32_t)p;
+					}
+				}
+			}
+#endif
+
+			uint32_t totalError = 0;
+			for (int i = 0; i < 16; i++)
+			{
+				totalError += (uint32_t)errors[i];
+				_out_indices_p[i] = (uint8_t)indices[i];
+			}
+
+			return totalError;
+		}
+
+		uint32_t SelectBC4Indices(
+			const uint8_t*				_in_values_p
+			, const uint8_t*			_in_palette_p
+			, uint8_t*					_out_indices_p
+		) {
+			uint32_t totalError = 0;
+
+#ifdef FBXLIB_SSE2
+			// all sixteen values fit one register; distances stay within a byte
+			__m128i zero = _mm_setzero_si128();
+			__m128i values = _mm_loadu_si128((const __m128i*)_in_values_p);
+			__m128i bestDistances = _mm_set1_epi8((char)0xFF);
+			__m128i bestIndices = zero;
+
+			for (int p = 0; p < 8; p++)
+			{
+				__m128i entry = _mm_set1_epi8((char)_in_palette_p[p]);
+				__m128i distance = _mm_or_si128(_mm_subs_epu8(values, entry), _mm_subs_epu8(entry, values));
+
+				// unsigned distance < best, as distance == min(distance, best) and distance != best
+				__m128i better = _mm_andnot_si128(_mm_cmpeq_epi8(distance, bestDistances),
+					_mm_cmpeq_epi8(_mm_min_epu8(distance, bestDistances), distance));
+				bestDistances = _mm_min_epu8(distance, bestDistances);
+				bestIndices = _mm_or_si128(_mm_and_si128(better, _mm_set1_epi8((char)p)),
+					_mm_andnot_si128(better, bestIndices));
+			}
+
+			__m128i lo = _mm_unpacklo_epi8(bestDistances, zero);
+			__m128i hi = _mm_unpackhi_epi8(bestDistances, zero);
+			__m128i sums = _mm_add_epi32(_mm_madd_epi16(lo, lo), _mm_madd_epi16(hi, hi));
+
+			int32_t errors[4];
+			_mm_storeu_si128((__m128i*)errors, sums);
+			_mm_storeu_si128((__m128i*)_out_indices_p, bestIndices);
+			totalError = (uint32_t)(errors[0] + errors[1] + errors[2] + errors[3]);
+#else
+			for (int i = 0; i < 16; i++)
+			{
+				int bestDistance = 256;
+				for (int p = 0; p < 8; p++)
+				{
+					int distance = std::abs((int)_in_values_p[i] - (int)_in_palette_p[p]);
+					if (distance < bestDistance)
+					{
+						bestDistance = distance;
+						_out_indices_p[i] = (uint8_t)p;
+					}
+				}
+				totalError += (uint32_t)(bestDistance * bestDistance);
+			}
+#endif
+
+			return totalError;
+		}
+
+		void GetBlockPrincipalEndpoints(
+			const uint8_t*				_in_texels_p
+			, const uint32_t			_in_channelCount
+			, float*					_out_first_p
+			, float*					_out_second_p
+		) {
+			float mean[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+			for (int i = 0; i < 16; i++)
+				for (uint32_t c = 0; c < _in_channelCount; c++)
+					mean[c] += _in_texels_p[i * 4 + c] / 16.0f;
+
+			// start from the texel farthest from the mean, which is never orthogonal to the main axis
+			float covariance[4][4] = {};
+			float axis[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+			float farthest = 0.0f;
+			for (int i = 0; i < 16; i++)
+			{
+				float d[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+				float distance = 0.0f;
+				for (uint32_t c = 0; c < _in_channelCount; c++)
+				{
+					d[c] = _in_texels_p[i * 4 + c] - mean[c];
+					distance += d[c] * d[c];
+				}
+
+				for (uint32_t r = 0; r < _in_channelCount; r++)
+					for (uint32_t c = 0; c < _in_channelCount; c++)
+						covariance[r][c] += d[r] * d[c];
+
+				if (distance > farthest)
+				{
+					farthest = distance;
+					memcpy(axis, d, sizeof(axis));
+				}
+			}
+
+			// a solid block has no axis
+			if (farthest == 0.0f)
+			{
+				memcpy(_out_first_p, mean, sizeof(float) * _in_channelCount);
+				memcpy(_out_second_p, mean, sizeof(float) * _in_channelCount);
+				return;
+			}
+
+			// power iteration converges on the axis of largest variance
+			for (int iteration = 0; iteration < 8; iteration++)
+			{
+				float next[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+				float largest = 0.0f;
+				for (uint32_t r = 0; r < _in_channelCount; r++)
+				{
+					for (uint32_t c = 0; c < _in_channelCount; c++)
+						next[r] += covariance[r][c] * axis[c];
+					largest = std::max(largest, std::fabs(next[r]));
+				}
+
+				if (largest == 0.0f)
+					break;
+				for (uint32_t c = 0; c < _in_channelCount; c++)
+					axis[c] = next[c] / largest;
+			}
+
+			float axisLength = 0.0f;
+			for (uint32_t c = 0; c < _in_channelCount; c++)
+				axisLength += axis[c] * axis[c];
+
+			// endpoints are the extreme texels projected onto the axis
+			float minT = 0.0f;
+			float maxT = 0.0f;
+			for (int i = 0; i < 16; i++)
+			{
+				float t = 0.0f;
+				for (uint32_t c = 0; c < _in_channelCount; c++)
+					t += (_in_texels_p[i * 4 + c] - mean[c]) * axis[c];
+				t /= axisLength;
+
+				minT = std::min(minT, t);
+				maxT = std::max(maxT, t);
+			}
+
+			for (uint32_t c = 0; c < _in_channelCount; c++)
+			{
+				_out_first_p[c] = std::min(std::max(mean[c] + maxT * axis[c], 0.0f), 255.0f);
+				_out_second_p[c] = std::min(std::max(mean[c] + minT * axis[c], 0.0f), 255.0f);
+			}
+		}
+
+		bool SolveBlockEndpoints(
+			const uint8_t*				_in_texels_p
+			, const uint32_t			_in_channelCount
+			, const uint8_t*			_in_indices_p
+			, const float*				_in_weights_p
+			, float*					_out_first_p
+			, float*					_out_second_p
+		) {
+			// least squares fit of texel = weight * first + (1 - weight) * second
+			float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+			float ax[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+			float bx[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+
+			for (int i = 0; i < 16; i++)
+			{
+				float a = _in_weights_p[_in_indices_p[i]];
+				float b = 1.0f - a;
+				aa += a * a;
+				ab += a * b;
+				bb += b * b;
+				for (uint32_t c = 0; c < _in_channelCount; c++)
+				{
+					ax[c] += a * _in_texels_p[i * 4 + c];
+					bx[c] += b * _in_texels_p[i * 4 + c];
+				}
+			}
+
+			// every texel on one endpoint leaves the other unconstrained
+			float determinant = aa * bb - ab * ab;
+			if (std::fabs(determinant) < 1e-6f)
+				return false;
+
+			for (uint32_t c = 0; c < _in_channelCount; c++)
+			{
+				_out_first_p[c] = std::min(std::max((ax[c] * bb - bx[c] * ab) / determinant, 0.0f), 255.0f);
+				_out_second_p[c] = std::min(std::max((bx[c] * aa - ax[c] * ab) / determinant, 0.0f), 255.0f);
+			}
+
+			return true;
+		}
+
+		uint16_t PackBC1Color(const float* _in_color_p)
+		{
+			uint32_t r = (uint32_t)(_in_color_p[0] * 31.0f / 255.0f + 0.5f);
+			uint32_t g = (uint32_t)(_in_color_p[1] * 63.0f / 255.0f + 0.5f);
+			uint32_t b = (uint32_t)(_in_color_p[2] * 31.0f / 255.0f + 0.5f);
+
+			return (uint16_t)((std::min(r, 31u) << 11) | (std::min(g, 63u) << 5) | std::min(b, 31u));
+		}
+
+		void UnpackBC1Color(const uint16_t _in_color, uint8_t* _out_color_p)
+		{
+			uint32_t r = (_in_color >> 11) & 0x1F;
+			uint32_t g = (_in_color >> 5) & 0x3F;
+			uint32_t b = _in_color & 0x1F;
+
+			_out_color_p[0] = (uint8_t)((r << 3) | (r >> 2));
+			_out_color_p[1] = (uint8_t)((g << 2) | (g >> 4));
+			_out_color_p[2] = (uint8_t)((b << 3) | (b >> 2));
+			_out_color_p[3] = 0;
+		}
+
+		uint32_t FitBC1Colors(
+			const uint8_t*				_in_colors_p
+			, uint16_t&					_out_color0
+			, uint16_t&					_out_color1
+			, uint8_t*					_out_indices_p
+			, uint8_t*					_out_palette_p
+		) {
+			// the larger color comes first, which selects four-color mode
+			if (_out_color0 < _out_color1)
+				std::swap(_out_color0, _out_color1);
+
+			UnpackBC1Color(_out_color0, _out_palette_p);
+			UnpackBC1Color(_out_color1, _out_palette_p + 4);
+
+			// equal colors would select three-color mode, whose last index is transparent black
+			if (_out_color0 == _out_color1)
+				return SelectPaletteIndices(_in_colors_p, _out_palette_p, 1, _out_indices_p);
+
+			for (int c = 0; c < 3; c++)
+			{
+				_out_palette_p[8 + c] = (uint8_t)((2 * _out_palette_p[c] + _out_palette_p[4 + c]) / 3);
+				_out_palette_p[12 + c] = (uint8_t)((_out_palette_p[c] + 2 * _out_palette_p[4 + c]) / 3);
+			}
+			_out_palette_p[11] = _out_palette_p[15] = 0;
+
+			return SelectPaletteIndices(_in_colors_p, _out_palette_p, 4, _out_indices_p);
+		}
+
+		void BuildBC4Palette(
+			const uint8_t				_in_value0
+			, const uint8_t				_in_value1
+			, uint8_t*					_out_palette_p
+		) {
+			_out_palette_p[0] = _in_value0;
+			_out_palette_p[1] = _in_value1;
+
+			// the order of the endpoints selects eight interpolated values, or six plus 0 and 255
+			if (_in_value0 > _in_value1)
+			{
+				for (int i = 2; i < 8; i++)
+					_out_palette_p[i] = (uint8_t)(((8 - i) * _in_value0 + (i - 1) * _in_value1) / 7);
+			}
+			else
+			{
+				for (int i = 2; i < 6; i++)
+					_out_palette_p[i] = (uint8_t)(((6 - i) * _in_value0 + (i - 1) * _in_value1) / 5);
+				_out_palette_p[6] = 0;
+				_out_palette_p[7] = 255;
+			}
+		}
+
+		void QuantizeBC7Endpoint(
+			const float*				_in_color_p
+			, uint8_t*					_out_color_p
+			, uint8_t&					_out_pBit
+		) {
+			// try both shared low bits and keep the one nearer the color
+			float bestError = std::numeric_limits<float>::max();
+			for (uint8_t p = 0; p < 2; p++)
+			{
+				uint8_t color[4];
+				float error = 0.0f;
+				for (int c = 0; c < 4; c++)
+				{
+					int q = (int)std::floor((_in_color_p[c] - p) / 2.0f + 0.5f);
+					color[c] = (uint8_t)std::min(std::max(q, 0), 127);
+
+					float d = (float)((color[c] << 1) | p) - _in_color_p[c];
+					error += d * d;
+				}
+
+				if (error < bestError)
+				{
+					bestError = error;
+					memcpy(_out_color_p, color, 4);
+					_out_pBit = p;
+				}
+			}
+		}
+
+		uint32_t FitBC7Mode6Colors(
+			const uint8_t*				_in_texels_p
+			, const float*				_in_first_p
+			, const float*				_in_second_p
+			, uint8_t*					_out_endpoints_p
+			, uint8_t*					_out_pBits_p
+			, uint8_t*					_out_indices_p
+			, uint8_t*					_out_palette_p
+		) {
+			QuantizeBC7Endpoint(_in_first_p, _out_endpoints_p, _out_pBits_p[0]);
+			QuantizeBC7Endpoint(_in_second_p, _out_endpoints_p + 4, _out_pBits_p[1]);
+
+			for (int c = 0; c < 4; c++)
+			{
+				uint32_t e0 = (uint32_t)((_out_endpoints_p[c] << 1) | _out_pBits_p[0]);
+				uint32_t e1 = (uint32_t)((_out_endpoints_p[4 + c] << 1) | _out_pBits_p[1]);
+
+				for (int i = 0; i < 16; i++)
+					_out_palette_p[i * 4 + c] = (uint8_t)(((64 - BC7_INDEX_WEIGHTS[i]) * e0 + BC7_INDEX_WEIGHTS[i] * e1 + 32) >> 6);
+			}
+
+			return SelectPaletteIndices(_in_texels_p, _out_palette_p, 16, _out_indices_p);
+		}
+
+		void WriteBlockBits(
+			const uint32_t				_in_value
+			, const uint32_t			_in_count
+			, uint32_t&					_out_position
+			, uint8_t*					_out_block_p
+		) {
+			for (uint32_t b = 0; b < _in_count; b++, _out_position++)
+				if ((_in_value >> b) & 1)
+					_out_block_p[_out_position >> 3] |= (uint8_t)(1 << (_out_position & 7));
+		}
+#pragma endregion
+
+#pragma region Texture Function Definitions
+		Result DecodePngImage(
+			const uint8_t*				_in_data_p
+			, const size_t				_in_length
+			, Image&					_out_image
+		) {
+			if (_in_length < sizeof(PNG_SIGNATURE) || memcmp(_in_data_p, PNG_SIGNATURE, sizeof(PNG_SIGNATURE)) != 0)
+				return Result::FAIL;
+
+			uint32_t width = 0;
+			uint32_t height = 0;
+			uint32_t bitDepth = 0;
+			uint32_t colorType = 0;
+			bool hasHeader = false;
+			uint8_t palette[256 * 4];
+			uint32_t paletteCount = 0;
+			std::vector<uint8_t> compressed;
+
+			// -- chunks --
+			// length, type, data and CRC; image data may be split over several IDAT chunks
+			size_t position = sizeof(PNG_SIGNATURE);
+			while (position + 12 <= _in_length)
+			{
+				uint32_t chunkLength = ReadBigEndian32(_in_data_p + position);
+				const uint8_t* type_p = _in_data_p + position + 4;
+				const uint8_t* chunk_p = _in_data_p + position + 8;
+
+				if (chunkLength > _in_length - position - 12)
+					return Result::FAIL;
+
+				if (memcmp(type_p, "IHDR", 4) == 0)
+				{
+					// compression and filter methods must be 0, interlaced images are not supported
+					if (chunkLength < 13 || chunk_p[10] != 0 || chunk_p[11] != 0 || chunk_p[12] != 0)
+						return Result::FAIL;
+
+					width = ReadBigEndian32(chunk_p);
+					height = ReadBigEndian32(chunk_p + 4);
+					bitDepth = chunk_p[8];
+					colorType = chunk_p[9];
+					hasHeader = true;
+				}
+				else if (memcmp(type_p, "PLTE", 4) == 0)
+				{
+					paletteCount = std::min(chunkLength / 3, 256u);
+					for (uint32_t i = 0; i < paletteCount; i++)
+					{
+						memcpy(palette + i * 4, chunk_p + i * 3, 3);
+						palette[i * 4 + 3] = 255;
+					}
+				}
+				else if (memcmp(type_p, "tRNS", 4) == 0 && colorType == 3)
+				{
+					for (uint32_t i = 0; i < chunkLength && i < paletteCount; i++)
+						palette[i * 4 + 3] = chunk_p[i];
+				}
+				else if (memcmp(type_p, "IDAT", 4) == 0)
+				{
+					compressed.insert(compressed.end(), chunk_p, chunk_p + chunkLength);
+				}
+				else if (memcmp(type_p, "IEND", 4) == 0)
+				{
+					break;
+				}
+
+				position += 12 + (size_t)chunkLength;
+			}
+			// -- /chunks --
+
+			// channels of each color type: gray, -, RGB, palette index, gray and alpha, -, RGBA
+			static const uint32_t channelCounts[7] = { 1, 0, 3, 1, 2, 0, 4 };
+			uint32_t channelCount = colorType < 7 ? channelCounts[colorType] : 0;
+			bool validDepth = bitDepth == 8
+				|| (bitDepth == 16 && colorType != 3)
+				|| ((bitDepth == 1 || bitDepth == 2 || bitDepth == 4) && (colorType == 0 || colorType == 3));
+
+			if (!hasHeader || channelCount == 0 || !validDepth || compressed.empty()
+				|| width == 0 || height == 0 || width > IMAGE_DIMENSION_LIMIT || height > IMAGE_DIMENSION_LIMIT
+				|| (colorType == 3 && paletteCount == 0))
+				return Result::FAIL;
+
+			// -- image data --
+			uint32_t pixelBits = channelCount * bitDepth;
+			size_t rowBytes = ((size_t)width * pixelBits + 7) / 8;
+			uint64_t rawLength = (uint64_t)height * (rowBytes + 1);
+			if (rawLength > std::numeric_limits<uint32_t>::max() || compressed.size() > std::numeric_limits<uint32_t>::max())
+				return Result::FAIL;
+
+			std::vector<uint8_t> raw((size_t)rawLength);
+			if (!InflateZlibStream(compressed.data(), (uint32_t)compressed.size(), raw.data(), (uint32_t)rawLength)
+				|| !UnfilterPngScanlines(height, rowBytes, std::max(pixelBits / 8, 1u), raw.data()))
+				return Result::FAIL;
+			// -- /image data --
+
+			// -- conversion --
+			Image image;
+			image.width = width;
+			image.height = height;
+			image.pixels.resize((size_t)width * height * 4);
+
+			uint32_t sampleBytes = bitDepth / 8;
+			uint32_t sampleMax = (1u << std::min(bitDepth, 8u)) - 1;
+
+			for (uint32_t y = 0; y < height; y++)
+			{
+				const uint8_t* row_p = raw.data() + (size_t)y * (rowBytes + 1) + 1;
+				uint8_t* pixel_p = image.pixels.data() + (size_t)y * width * 4;
+
+				for (uint32_t x = 0; x < width; x++, pixel_p += 4)
+				{
+					// 16-bit samples are big-endian, so their first byte is the high byte
+					uint8_t samples[4] = { 0, 0, 0, 0 };
+					if (bitDepth >= 8)
+					{
+						const uint8_t* sample_p = row_p + (size_t)x * channelCount * sampleBytes;
+						for (uint32_t c = 0; c < channelCount; c++)
+							samples[c] = sample_p[c * sampleBytes];
+					}
+					else
+					{
+						size_t bit = (size_t)x * bitDepth;
+						samples[0] = (uint8_t)((row_p[bit >> 3] >> (8 - bitDepth - (bit & 7))) & sampleMax);
+					}
+
+					switch (colorType)
+					{
+					case 0:
+					{
+						uint8_t gray = (uint8_t)(samples[0] * 255 / sampleMax);
+						pixel_p[0] = pixel_p[1] = pixel_p[2] = gray;
+						pixel_p[3] = 255;
+						break;
+					}
+					case 2:
+						memcpy(pixel_p, samples, 3);
+						pixel_p[3] = 255;
+						break;
+					case 3:
+						if (samples[0] >= paletteCount)
+							return Result::FAIL;
+						memcpy(pixel_p, palette + samples[0] * 4, 4);
+						break;
+					case 4:
+						pixel_p[0] = pixel_p[1] = pixel_p[2] = samples[0];
+						pixel_p[3] = samples[1];
+						break;
+					default:
+						memcpy(pixel_p, samples, 4);
+						break;
+					}
+				}
+			}
+			// -- /conversion --
+
+			_out_image = std::move(image);
+
+			return Result::SUCCESS;
+		}
+		Result DecodeTgaImage(
+			const uint8_t*				_in_data_p
+			, const size_t				_in_length
+			, Image&					_out_image
+		) {
+			if (_in_length < 18)
+				return Result::FAIL;
+
+			// header: ID length, color map type, image type, color map spec, origin, size, depth, descriptor
+			uint32_t idLength = _in_data_p[0];
+			uint32_t colorMapType = _in_data_p[1];
+			uint32_t imageType = _in_data_p[2];
+			uint32_t colorMapLength = _in_data_p[5] | (_in_data_p[6] << 8);
+			uint32_t colorMapEntryBits = _in_data_p[7];
+			uint32_t width = _in_data_p[12] | (_in_data_p[13] << 8);
+			uint32_t height = _in_data_p[14] | (_in_data_p[15] << 8);
+			uint32_t pixelBits = _in_data_p[16];
+			uint32_t descriptor = _in_data_p[17];
+
+			// true-color images hold 24 or 32-bit BGR(A) pixels, grayscale images 8-bit values
+			bool trueColor = imageType == 2 || imageType == 10;
+			bool grayscale = imageType == 3 || imageType == 11;
+			bool runLength = imageType >= 9;
+			if ((!trueColor && !grayscale) || colorMapType > 1
+				|| (trueColor && pixelBits != 24 && pixelBits != 32) || (grayscale && pixelBits != 8)
+				|| width == 0 || height == 0 || width > IMAGE_DIMENSION_LIMIT || height > IMAGE_DIMENSION_LIMIT)
+				return Result::FAIL;
+
+			// a color map may precede true-color data, and is skipped
+			size_t position = 18 + idLength + (colorMapType == 1 ? (size_t)colorMapLength * ((colorMapEntryBits + 7) / 8) : 0);
+			uint32_t pixelBytes = pixelBits / 8;
+			bool hasAlpha = pixelBits == 32 && (descriptor & 0x0F) != 0;
+			size_t pixelCount = (size_t)width * height;
+
+			// pixels in file order, converted to RGBA
+			std::vector<uint8_t> pixels(pixelCount * 4);
+			auto readPixel = [&](const uint8_t* _in_pixel_p, uint8_t* _out_pixel_p)
+			{
+				if (grayscale)
+				{
+					_out_pixel_p[0] = _out_pixel_p[1] = _out_pixel_p[2] = _in_pixel_p[0];
+					_out_pixel_p[3] = 255;
+				}
+				else
+				{
+					_out_pixel_p[0] = _in_pixel_p[2];
+					_out_pixel_p[1] = _in_pixel_p[1];
+					_out_pixel_p[2] = _in_pixel_p[0];
+					_out_pixel_p[3] = hasAlpha ? _in_pixel_p[3] : 255;
+				}
+			};
+
+			for (size_t i = 0; i < pixelCount;)
+			{
+				// run-length packets repeat one pixel or hold up to 128 raw pixels
+				size_t count = 1;
+				bool repeat = false;
+				if (runLength)
+				{
+					if (position >= _in_length)
+						return Result::FAIL;
+					uint8_t packet = _in_data_p[position++];
+					count = std::min((size_t)(packet & 0x7F) + 1, pixelCount - i);
+					repeat = (packet & 0x80) != 0;
+				}
+
+				size_t bytes = (repeat ? 1 : count) * pixelBytes;
+				if (bytes > _in_length - std::min(position, _in_length))
+					return Result::FAIL;
+
+				for (size_t p = 0; p < count; p++, i++)
+					readPixel(_in_data_p + position + (repeat ? 0 : p * pixelBytes), &pixels[i * 4]);
+				position += bytes;
+			}
+
+			// rows are stored bottom-up unless the descriptor says otherwise
+			Image image;
+			image.width = width;
+			image.height = height;
+			image.pixels.resize(pixelCount * 4);
+
+			bool topDown = (descriptor & 0x20) != 0;
+			bool rightToLeft = (descriptor & 0x10) != 0;
+			for (uint32_t y = 0; y < height; y++)
+			{
+				const uint8_t* source_p = &pixels[(size_t)(topDown ? y : height - 1 - y) * width * 4];
+				uint8_t* destination_p = &image.pixels[(size_t)y * width * 4];
+
+				if (!rightToLeft)
+					memcpy(destination_p, source_p, (size_t)width * 4);
+				else
+					for (uint32_t x = 0; x < width; x++)
+						memcpy(destination_p + x * 4, source_p + (size_t)(width - 1 - x) * 4, 4);
+			}
+
+			_out_image = std::move(image);
+
+			return Result::SUCCESS;
+		}
+		void GetImageBlock(
+			const Image&				_in_image
+			, const uint32_t			_in_blockX
+			, const uint32_t			_in_blockY
+			, uint8_t*					_out_texels_p
+		) {
+			for (uint32_t y = 0; y < TEXTURE_BLOCK_DIMENSION; y++)
+			{
+				uint32_t sourceY = std::min(_in_blockY * TEXTURE_BLOCK_DIMENSION + y, _in_image.height - 1);
+				const uint8_t* row_p = &_in_image.pixels[(size_t)sourceY * _in_image.width * 4];
+
+				for (uint32_t x = 0; x < TEXTURE_BLOCK_DIMENSION; x++)
+				{
+					uint32_t sourceX = std::min(_in_blockX * TEXTURE_BLOCK_DIMENSION + x, _in_image.width - 1);
+					memcpy(_out_texels_p + (y * TEXTURE_BLOCK_DIMENSION + x) * 4, row_p + (size_t)sourceX * 4, 4);
+				}
+			}
+		}
+		void EncodeBC1Block(
+			const uint8_t*				_in_texels_p
+			, uint8_t*					_out_block_p
+			, uint8_t*					_out_decoded_p
+		) {
+			// alpha is cleared so palette distances only measure color
+			uint8_t colors[64];
+			for (int i = 0; i < 16; i++)
+			{
+				memcpy(colors + i * 4, _in_texels_p + i * 4, 3);
+				colors[i * 4 + 3] = 0;
+			}
+
+			float first[3];
+			float second[3];
+			GetBlockPrincipalEndpoints(colors, 3, first, second);
+
+			uint16_t color0 = PackBC1Color(first);
+			uint16_t color1 = PackBC1Color(second);
+			uint8_t indices[16];
+			uint8_t palette[16];
+			uint32_t error = FitBC1Colors(colors, color0, color1, indices, palette);
+
+			// refit the endpoints to the chosen indices, keeping them only if the block improves
+			if (error > 0 && SolveBlockEndpoints(colors, 3, indices, BC1_ENDPOINT_WEIGHTS, first, second))
+			{
+				uint16_t refinedColor0 = PackBC1Color(first);
+				uint16_t refinedColor1 = PackBC1Color(second);
+				uint8_t refinedIndices[16];
+				uint8_t refinedPalette[16];
+				uint32_t refinedError = FitBC1Colors(colors, refinedColor0, refinedColor1, refinedIndices, refinedPalette);
+
+				if (refinedError < error)
+				{
+					color0 = refinedColor0;
+					color1 = refinedColor1;
+					memcpy(indices, refinedIndices, sizeof(indices));
+					memcpy(palette, refinedPalette, sizeof(palette));
+				}
+			}
+
+			uint32_t indexBits = 0;
+			for (int i = 0; i < 16; i++)
+			{
+				indexBits |= (uint32_t)indices[i] << (i * 2);
+
+				memcpy(_out_decoded_p + i * 4, palette + indices[i] * 4, 3);
+				_out_decoded_p[i * 4 + 3] = 255;
+			}
+
+			// colors and indices are little-endian
+			_out_block_p[0] = (uint8_t)(color0 & 0xFF);
+			_out_block_p[1] = (uint8_t)(color0 >> 8);
+			_out_block_p[2] = (uint8_t)(color1 & 0xFF);
+			_out_block_p[3] = (uint8_t)(color1 >> 8);
+			for (int b = 0; b < 4; b++)
+				_out_block_p[4 + b] = (uint8_t)(indexBits >> (b * 8));
+		}
+		void EncodeBC4Block(
+			const uint8_t*				_in_values_p
+			, uint8_t*					_out_block_p
+			, uint8_t*					_out_decoded_p
+		) {
+			// eight-value mode spans the extremes, six-value mode the extremes other than 0 and 255
+			uint8_t low = 255, high = 0;
+			uint8_t innerLow = 255, innerHigh = 0;
+			for (int i = 0; i < 16; i++)
+			{
+				uint8_t value = _in_values_p[i];
+				low = std::min(low, value);
+				high = std::max(high, value);
+				if (value != 0 && value != 255)
+				{
+					innerLow = std::min(innerLow, value);
+					innerHigh = std::max(innerHigh, value);
+				}
+			}
+			if (innerLow > innerHigh)
+				innerLow = innerHigh = 0;
+
+			uint8_t endpoints[2] = { high, low };
+			uint8_t palette[8];
+			uint8_t indices[16];
+			BuildBC4Palette(high, low, palette);
+			uint32_t error = SelectBC4Indices(_in_values_p, palette, indices);
+
+			if (error > 0)
+			{
+				uint8_t innerPalette[8];
+				uint8_t innerIndices[16];
+				BuildBC4Palette(innerLow, innerHigh, innerPalette);
+
+				if (SelectBC4Indices(_in_values_p, innerPalette, innerIndices) < error)
+				{
+					endpoints[0] = innerLow;
+					endpoints[1] = innerHigh;
+					memcpy(palette, innerPalette, sizeof(palette));
+					memcpy(indices, innerIndices, sizeof(indices));
+				}
+			}
+
+			// two endpoints, then sixteen 3-bit indices in a little-endian 48-bit field
+			uint64_t indexBits = 0;
+			for (int i = 0; i < 16; i++)
+			{
+				indexBits |= (uint64_t)indices[i] << (i * 3);
+				_out_decoded_p[i] = palette[indices[i]];
+			}
+
+			_out_block_p[0] = endpoints[0];
+			_out_block_p[1] = endpoints[1];
+			for (int b = 0; b < 6; b++)
+				_out_block_p[2 + b] = (uint8_t)(indexBits >> (b * 8));
+		}
+		void EncodeBC7Block(
+			const uint8_t*				_in_texels_p
+			, uint8_t*					_out_block_p
+			, uint8_t*					_out_decoded_p
+		) {
+			float first[4];
+			float second[4];
+			GetBlockPrincipalEndpoints(_in_texels_p, 4, first, second);
+
+			uint8_t endpoints[8];
+			uint8_t pBits[2];
+			uint8_t indices[16];
+			uint8_t palette[64];
+			uint32_t error = FitBC7Mode6Colors(_in_texels_p, first, second, endpoints, pBits, indices, palette);
+
+			// refit the endpoints to the chosen indices, keeping them only if the block improves
+			float weights[16];
+			for (int i = 0; i < 16; i++)
+				weights[i] = (64 - BC7_INDEX_WEIGHTS[i]) / 64.0f;
+
+			if (error > 0 && SolveBlockEndpoints(_in_texels_p, 4, indices, weights, first, second))
+			{
+				uint8_t refinedEndpoints[8];
+				uint8_t refinedPBits[2];
+				uint8_t refinedIndices[16];
+				uint8_t refinedPalette[64];
+				uint32_t refinedError = FitBC7Mode6Colors(_in_texels_p, first, second,
+					refinedEndpoints, refinedPBits, refinedIndices, refinedPalette);
+
+				if (refinedError < error)
+				{
+					memcpy(endpoints, refinedEndpoints, sizeof(endpoints));
+					memcpy(pBits, refinedPBits, sizeof(pBits));
+					memcpy(indices, refinedIndices, sizeof(indices));
+					memcpy(palette, refinedPalette, sizeof(palette));
+				}
+			}
+
+			for (int i = 0; i < 16; i++)
+				memcpy(_out_decoded_p + i * 4, palette + indices[i] * 4, 4);
+
+			// the first index is stored without its top bit, so it must be below 8; the weights are
+			// symmetric, so swapping the endpoints and inverting the indices decodes the same colors
+			if (indices[0] >= 8)
+			{
+				for (int c = 0; c < 4; c++)
+					std::swap(endpoints[c], endpoints[4 + c]);
+				std::swap(pBits[0], pBits[1]);
+				for (int i = 0; i < 16; i++)
+					indices[i] = (uint8_t)(15 - indices[i]);
+			}
+
+			// mode 6: mode bit, 7-bit endpoints per channel, two p-bits, then the indices
+			uint32_t position = 0;
+			memset(_out_block_p, 0, 16);
+			WriteBlockBits(1 << 6, 7, position, _out_block_p);
+			for (int c = 0; c < 4; c++)
+			{
+				WriteBlockBits(endpoints[c], 7, position, _out_block_p);
+				WriteBlockBits(endpoints[4 + c], 7, position, _out_block_p);
+			}
+			WriteBlockBits(pBits[0], 1, position, _out_block_p);
+			WriteBlockBits(pBits[1], 1, position, _out_block_p);
+			for (int i = 0; i < 16; i++)
+				WriteBlockBits(indices[i], i == 0 ? 3 : 4, position, _out_block_p);
+		}
+		void EncodeTextureBlock(
+			const TextureFormat			_in_format
+			, const uint8_t*			_in_texels_p
+			, uint8_t*					_out_block_p
+			, uint8_t*					_out_decoded_p
+		) {
+			uint8_t channels[2][16];
+			uint8_t decodedChannels[2][16];
+
+			switch (_in_format)
+			{
+			case TextureFormat::BC1:
+				EncodeBC1Block(_in_texels_p, _out_block_p, _out_decoded_p);
+				break;
+			case TextureFormat::BC3:
+				for (int i = 0; i < 16; i++)
+					channels[0][i] = _in_texels_p[i * 4 + 3];
+
+				EncodeBC4Block(channels[0], _out_block_p, decodedChannels[0]);
+				EncodeBC1Block(_in_texels_p, _out_block_p + 8, _out_decoded_p);
+
+				for (int i = 0; i < 16; i++)
+					_out_decoded_p[i * 4 + 3] = decodedChannels[0][i];
+				break;
+			case TextureFormat::BC5:
+				for (int i = 0; i < 16; i++)
+				{
+					channels[0][i] = _in_texels_p[i * 4 + 0];
+					channels[1][i] = _in_texels_p[i * 4 + 1];
+				}
+
+				EncodeBC4Block(channels[0], _out_block_p, decodedChannels[0]);
+				EncodeBC4Block(channels[1], _out_block_p + 8, decodedChannels[1]);
+
+				for (int i = 0; i < 16; i++)
+				{
+					_out_decoded_p[i * 4 + 0] = decodedChannels[0][i];
+					_out_decoded_p[i * 4 + 1] = decodedChannels[1][i];
+					_out_decoded_p[i * 4 + 2] = 0;
+					_out_decoded_p[i * 4 + 3] = 255;
+				}
+				break;
+			case TextureFormat::BC7:
+				EncodeBC7Block(_in_texels_p, _out_block_p, _out_decoded_p);
+				break;
+			}
+		}
+		uint32_t GetTextureBlockSize(
+			const TextureFormat			_in_format
+		) {
+			switch (_in_format)
+			{
+			case TextureFormat::BC1: return 8;
+			case TextureFormat::BC3: return 16;
+			case TextureFormat::BC5: return 16;
+			case TextureFormat::BC7: return 16;
+			default: return 0;
+			}
+		}
+		uint32_t GetTextureChannelCount(
+			const TextureFormat			_in_format
+		) {
+			switch (_in_format)
+			{
+			case TextureFormat::BC1: return 3;
+			case TextureFormat::BC3: return 4;
+			case TextureFormat::BC5: return 2;
+			case TextureFormat::BC7: return 4;
+			default: return 0;
+			}
+		}
+#pragma endregion
+
+#pragma region Interface Function Definitions
+		Result LoadImageFile(
+			const char*					_in_filepath
+			, Image&					_out_image
+		) {
+			if (_in_filepath == nullptr)
+				return Result::INVALID_ARG;
+
+			std::ifstream file(_in_filepath, std::ios::binary | std::ios::ate);
+			if (!file.is_open())
+				return Result::FAIL;
+
+			std::streamoff size = file.tellg();
+			if (size <= 0)
+				return Result::FAIL;
+
+			std::vector<uint8_t> data((size_t)size);
+			file.seekg(0);
+			if (!file.read((char*)data.data(), size))
+				return Result::FAIL;
+
+			// .png files are recognized by their signature; .tga files have none
+			if (data.size() >= sizeof(PNG_SIGNATURE) && memcmp(data.data(), PNG_SIGNATURE, sizeof(PNG_SIGNATURE)) == 0)
+				return DecodePngImage(data.data(), data.size(), _out_image);
+			if (ExtensionIs(_in_filepath, ".tga"))
+				return DecodeTgaImage(data.data(), data.size(), _out_image);
+
+			return Result::FAIL;
+		}
+		Result CompressTextures(
+			const std::vector<Image>&	_in_images
+			, const std::vector<TextureFormat>&	_in_formats
+			, std::vector<CompressedTexture>&	_out_textures
+			, std::vector<TextureCompressionStats>&	_out_stats
+		) {
+			uint32_t textureCount = (uint32_t)_in_images.size();
+
+			// verify every image is complete and has a known format
+			if (_in_formats.size() != textureCount)
+				return Result::INVALID_ARG;
+			for (uint32_t t = 0; t < textureCount; t++)
+				if (_in_images[t].width == 0 || _in_images[t].height == 0
+					|| _in_images[t].pixels.size() != (size_t)_in_images[t].width * _in_images[t].height * 4
+					|| GetTextureBlockSize(_in_formats[t]) == 0)
+					return Result::INVALID_ARG;
+
+			// -- jobs --
+			// rows of blocks of every texture share one job list, so small textures fill threads large ones leave idle
+			std::vector<CompressedTexture> textures(textureCount);
+			std::vector<uint32_t> jobTextures;
+			std::vector<uint32_t> jobFirstRows;
+			std::vector<uint32_t> jobRowCounts;
+
+			for (uint32_t t = 0; t < textureCount; t++)
+			{
+				CompressedTexture& texture = textures[t];
+				texture.format = _in_formats[t];
+				texture.width = _in_images[t].width;
+				texture.height = _in_images[t].height;
+				texture.block_size = GetTextureBlockSize(texture.format);
+
+				uint32_t blocksWide = (texture.width + TEXTURE_BLOCK_DIMENSION - 1) / TEXTURE_BLOCK_DIMENSION;
+				uint32_t blocksHigh = (texture.height + TEXTURE_BLOCK_DIMENSION - 1) / TEXTURE_BLOCK_DIMENSION;
+				texture.blocks.resize((size_t)blocksWide * blocksHigh * texture.block_size);
+
+				uint32_t rowsPerJob = std::max(TEXTURE_JOB_BLOCK_COUNT / blocksWide, 1u);
+				for (uint32_t row = 0; row < blocksHigh; row += rowsPerJob)
+				{
+					jobTextures.push_back(t);
+					jobFirstRows.push_back(row);
+					jobRowCounts.push_back(std::min(rowsPerJob, blocksHigh - row));
+				}
+			}
+			// -- /jobs --
+
+			// -- blocks --
+			uint32_t jobCount = (uint32_t)jobTextures.size();
+			std::vector<uint64_t> jobErrors(jobCount, 0);
+			std::vector<double> jobMilliseconds(jobCount, 0.0);
+
+			ParallelFor(jobCount, GetWorkerThreadCount(), [&](uint32_t _in_job, uint32_t)
+			{
+				std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+				const Image& image = _in_images[jobTextures[_in_job]];
+				CompressedTexture& texture = textures[jobTextures[_in_job]];
+				uint32_t channelCount = GetTextureChannelCount(texture.format);
+				uint32_t blocksWide = (texture.width + TEXTURE_BLOCK_DIMENSION - 1) / TEXTURE_BLOCK_DIMENSION;
+
+				uint8_t texels[64];
+				uint8_t decoded[64];
+				uint64_t error = 0;
+
+				for (uint32_t row = jobFirstRows[_in_job]; row < jobFirstRows[_in_job] + jobRowCounts[_in_job]; row++)
+				{
+					for (uint32_t column = 0; column < blocksWide; column++)
+					{
+						GetImageBlock(image, column, row, texels);
+						EncodeTextureBlock(texture.format, texels,
+							&texture.blocks[((size_t)row * blocksWide + column) * texture.block_size], decoded);
+
+						// edge blocks repeat pixels; only those inside the image are measured
+						uint32_t width = std::min(TEXTURE_BLOCK_DIMENSION, texture.width - column * TEXTURE_BLOCK_DIMENSION);
+						uint32_t height = std::min(TEXTURE_BLOCK_DIMENSION, texture.height - row * TEXTURE_BLOCK_DIMENSION);
+						for (uint32_t y = 0; y < height; y++)
+							for (uint32_t x = 0; x < width; x++)
+								for (uint32_t c = 0; c < channelCount; c++)
+								{
+									uint32_t i = (y * TEXTURE_BLOCK_DIMENSION + x) * 4 + c;
+									int32_t d = (int32_t)decoded[i] - (int32_t)texels[i];
+									error += (uint64_t)(d * d);
+								}
+					}
+				}
+
+				jobErrors[_in_job] = error;
+				jobMilliseconds[_in_job] = std::chrono::duration<double, std::milli>(
+					std::chrono::steady_clock::now() - start).count();
+			});
+			// -- /blocks --
+
+			std::vector<TextureCompressionStats> stats(textureCount);
+			std::vector<uint64_t> errors(textureCount, 0);
+			for (uint32_t job = 0; job < jobCount; job++)
+			{
+				stats[jobTextures[job]].milliseconds += jobMilliseconds[job];
+				errors[jobTextures[job]] += jobErrors[job];
+			}
+
+			for (uint32_t t = 0; t < textureCount; t++)
+			{
+				const CompressedTexture& texture = textures[t];
+				stats[t].block_count = (uint32_t)(texture.blocks.size() / texture.block_size);
+
+				double samples = (double)texture.width * texture.height * GetTextureChannelCount(texture.format);
+				stats[t].psnr = errors[t] == 0 ? std::numeric_limits<float>::infinity()
+					: (float)(10.0 * std::log10(255.0 * 255.0 * samples / (double)errors[t]));
+			}
+
+			_out_textures = std::move(textures);
+			_out_stats = std::move(stats);
+
+			return Result::SUCCESS;
+		}
+#pragma endregion
+
+	}
+}
@@ -0,0 +1,148 @@
+#ifndef _FBXEXPORTER_LIBRARY_TEXTURE_H_
+#define _FBXEXPORTER_LIBRARY_TEXTURE_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "defines.h"
+
+namespace fbx_exporter
+{
+	namespace library
+	{
+		// Width and height of a compressed block in pixels.
+		const uint32_t TEXTURE_BLOCK_DIMENSION = 4;
+
+		// Blocks encoded by one parallel job. Jobs cover whole rows of blocks of one texture.
+		const uint32_t TEXTURE_JOB_BLOCK_COUNT = 256;
+
+		// Largest width or height of an image that can be decoded.
+		const uint32_t IMAGE_DIMENSION_LIMIT = 16384;
+
+
+		/* Decodes a .png file held in memory.
+		  PARAMETERS
+			_in_data_p : The contents of the file.
+			_in_length : The length of the file in bytes.
+			_out_image : The decoded image.
+		  RETURNS
+			FAIL : The data is not a supported PNG image, or is truncated or corrupt.
+			SUCCESS : The image was decoded.
+		  NOTES
+			Chunk CRCs are not checked; the image data is validated by its inflated length instead.
+		*/
+		Result DecodePngImage(
+			const uint8_t*				_in_data_p
+			, const size_t				_in_length
+			, Image&					_out_image
+		);
+
+		/* Decodes a .tga file held in memory.
+		  PARAMETERS
+			_in_data_p : The contents of the file.
+			_in_length : The length of the file in bytes.
+			_out_image : The decoded image.
+		  RETURNS
+			FAIL : The data is not a 24 or 32-bit true-color or 8-bit grayscale TGA image, or is truncated.
+			SUCCESS : The image was decoded.
+		*/
+		Result DecodeTgaImage(
+			const uint8_t*				_in_data_p
+			, const size_t				_in_length
+			, Image&					_out_image
+		);
+
+		/* Copies the pixels of one 4x4 block of an image.
+		  PARAMETERS
+			_in_image : The image to read.
+			_in_blockX : The column of the block.
+			_in_blockY : The row of the block.
+			_out_texels_p : Storage for 16 RGBA texels, in row-major order.
+		  NOTES
+			Blocks reaching past the right or bottom edge repeat the last column or row.
+		*/
+		void GetImageBlock(
+			const Image&				_in_image
+			, const uint32_t			_in_blockX
+			, const uint32_t			_in_blockY
+			, uint8_t*					_out_texels_p
+		);
+
+		/* Encodes the RGB channels of a block as a four-color BC1 block.
+		  PARAMETERS
+			_in_texels_p : The 16 RGBA texels of the block. Alpha is ignored.
+			_out_block_p : Storage for the 8-byte block.
+			_out_decoded_p : Storage for the 16 RGBA texels as the block decodes. Alpha is 255.
+		*/
+		void EncodeBC1Block(
+			const uint8_t*				_in_texels_p
+			, uint8_t*					_out_block_p
+			, uint8_t*					_out_decoded_p
+		);
+
+		/* Encodes one channel of a block as a BC4 block.
+		  PARAMETERS
+			_in_values_p : The 16 values of the block.
+			_out_block_p : Storage for the 8-byte block.
+			_out_decoded_p : Storage for the 16 values as the block decodes.
+		  NOTES
+			Both the eight-value and the six-value mode, which adds exact 0 and 255, are tried and
+			the one with less error is kept.
+		*/
+		void EncodeBC4Block(
+			const uint8_t*				_in_values_p
+			, uint8_t*					_out_block_p
+			, uint8_t*					_out_decoded_p
+		);
+
+		/* Encodes a block as a mode 6 BC7 block.
+		  PARAMETERS
+			_in_texels_p : The 16 RGBA texels of the block.
+			_out_block_p : Storage for the 16-byte block.
+			_out_decoded_p : Storage for the 16 RGBA texels as the block decodes.
+		*/
+		void EncodeBC7Block(
+			const uint8_t*				_in_texels_p
+			, uint8_t*					_out_block_p
+			, uint8_t*					_out_decoded_p
+		);
+
+		/* Encodes a block in any texture format.
+		  PARAMETERS
+			_in_format : The format to encode.
+			_in_texels_p : The 16 RGBA texels of the block.
+			_out_block_p : Storage for the block, GetTextureBlockSize(_in_format) bytes.
+			_out_decoded_p : Storage for the 16 RGBA texels as the block decodes. Channels the
+			  format does not store are 0, or 255 for alpha.
+		*/
+		void EncodeTextureBlock(
+			const TextureFormat			_in_format
+			, const uint8_t*			_in_texels_p
+			, uint8_t*					_out_block_p
+			, uint8_t*					_out_decoded_p
+		);
+
+		/* Gets the size of one block of a texture format.
+		  PARAMETERS
+			_in_format : The format to check.
+		  RETURNS
+			uint32_t : 8 for BC1, 16 for the other formats, 0 for an unknown format.
+		*/
+		uint32_t GetTextureBlockSize(
+			const TextureFormat			_in_format
+		);
+
+		/* Gets the number of channels a texture format stores, counted from red.
+		  PARAMETERS
+			_in_format : The format to check.
+		  RETURNS
+			uint32_t : 2 for BC5, 3 for BC1, 4 for BC3 and BC7, 0 for an unknown format.
+		*/
+		uint32_t GetTextureChannelCount(
+			const TextureFormat			_in_format
+		);
+
+	}
+}
+
+#endif // _FBXEXPORTER_LIBRARY_TEXTURE_H_
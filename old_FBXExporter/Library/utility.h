@@ -2,6 +2,8 @@
 #define _FBXEXPORTER_FBXLIBRARY_UTILITY_H_
 
 #include <cstdint>
+#include <iosfwd>
+#include <vector>
 
 #include "fbxsdk.h"
 #pragma comment(lib, "libfbxsdk.lib")
@@ -12,6 +14,13 @@ namespace fbx_exporter
 {
 	namespace library
 	{
+		// Imported scene shared between extractions from the same .fbx file.
+		struct FbxSession
+		{
+			FbxManager*	fbx_manager_p = nullptr;  // Manager that owns the scene.
+			FbxScene*	fbx_scene_p = nullptr;  // Scene imported from the file.
+		};
+
 		// Stores animation joint data in intermediate form between FbxScene and AnimationJoint.
 		struct AnimationJointFbx
 		{
@@ -62,23 +71,113 @@ namespace fbx_exporter
 			, Mesh&						_out_mesh
 		);
 
-		/* Extracts material data from an FbxScene and stores it in a Material.
+		/* Extracts every mesh of an FbxScene into one Mesh, with a part per mesh and material.
+		  PARAMETERS
+			_in_fbxScene_p : The FBX scene to extract data from.
+			_in_elementsToExtract : A bit-flag set denoting which vertex elements to store.
+			_out_mesh : The mesh container to store extracted data in.
+		  RETURNS
+			FAIL : The scene has no mesh with polygons.
+			SUCCESS : Data was extracted successfully.
+		*/
+		Result GetMeshesFromFbxScene(
+			const FbxScene*				_in_fbxScene_p
+			, const uint32_t			_in_elementsToExtract
+			, Mesh&						_out_mesh
+		);
+
+		/* Extracts mesh data from an FbxScene as GetMeshFromFbxScene does, writing indices to a stream.
+		  PARAMETERS
+			_in_fbxScene_p : The FBX scene to extract data from.
+			_in_meshName : The mesh name to search the scene for, if desired.
+				Pass "" to get the first mesh from the file.
+			_in_elementsToExtract : A bit-flag set denoting which vertex elements to store.
+			_out_indexStream : The binary stream uint32_t indices are written to.
+			_out_mesh : The mesh container to store extracted vertices and parts in.
+		  RETURNS
+			INVALID_ARG : An invalid argument was passed.
+			FAIL : The mesh has no polygons, or the stream failed.
+			SUCCESS : Data was extracted successfully.
+		*/
+		Result StreamMeshFromFbxScene(
+			const FbxScene*				_in_fbxScene_p
+			, const char*				_in_meshName
+			, const uint32_t			_in_elementsToExtract
+			, std::ostream&				_out_indexStream
+			, Mesh&						_out_mesh
+		);
+
+		/* Extracts every mesh of an FbxScene as GetMeshesFromFbxScene does, writing indices to a stream.
+		  PARAMETERS
+			_in_fbxScene_p : The FBX scene to extract data from.
+			_in_elementsToExtract : A bit-flag set denoting which vertex elements to store.
+			_out_indexStream : The binary stream uint32_t indices are written to.
+			_out_mesh : The mesh container to store extracted vertices and parts in.
+		  RETURNS
+			FAIL : The scene has no mesh with polygons, or the stream failed.
+			SUCCESS : Data was extracted successfully.
+		*/
+		Result StreamMeshesFromFbxScene(
+			const FbxScene*				_in_fbxScene_p
+			, const uint32_t			_in_elementsToExtract
+			, std::ostream&				_out_indexStream
+			, Mesh&						_out_mesh
+		);
+
+		/* Extracts every material of an FbxScene and stores them in a MaterialList.
 		  PARAMETERS
 			_in_fbxScene_p : The FBX scene to extract data from.
-			_in_materialNum : The material number to get from the scene.
 			_in_elementsToExtract : A bit-flag set denoting which texture elements to store.
 			_out_materialList : The material and filepath container to store extracted data in.
 		  RETURNS
-			INVALID_ARG : An invalid argument was passed.
+			FAIL : The scene has no materials.
 			EXTRACT : Data was successfully extracted.
 		*/
 		Result GetMaterialsFromFbxScene(
 			const FbxScene*				_in_fbxScene_p
-			, const uint32_t			_in_materialNum
 			, const uint32_t			_in_elementsToExtract
 			, MaterialList&				_out_materialList
 		);
 
+		/* Reads the skeleton and bind pose used by the animation stacks of an FbxScene.
+		  PARAMETERS
+			_in_fbxScene_p : The FBX scene to extract data from.
+			_out_jointsFbx : The skeleton nodes, with parents before their children.
+			_out_joints : The bind pose of each joint in _out_jointsFbx.
+		  RETURNS
+			FAIL : The scene has no bind pose or no skeleton root.
+			SUCCESS : The skeleton was read.
+		*/
+		Result GetAnimationJointsFromFbxScene(
+			const FbxScene*				_in_fbxScene_p
+			, std::vector<AnimationJointFbx>&	_out_jointsFbx
+			, std::vector<AnimationJoint>&	_out_joints
+		);
+
+		/* Samples one animation stack of an FbxScene and stores it in an AnimationClip.
+		  PARAMETERS
+			_in_fbxScene_p : The FBX scene to extract data from.
+			_in_fbxAnimStack_p : The stack to sample. Must be the current stack of the scene.
+			_in_jointsFbx : The skeleton nodes from GetAnimationJointsFromFbxScene.
+			_in_joints : The bind pose from GetAnimationJointsFromFbxScene.
+			_in_elementsToExtract : A bit-flag set denoting which animation elements to store.
+			_out_animationClip : The animation container to store extracted data in.
+		  RETURNS
+			FAIL : No stack was passed.
+			EXTRACT : Data was extracted successfully.
+		  NOTES
+			Frames are sampled from the start of the stack's time span, and frame times are stored
+			relative to it.
+		*/
+		Result GetAnimationFromFbxAnimStack(
+			const FbxScene*				_in_fbxScene_p
+			, const FbxAnimStack*		_in_fbxAnimStack_p
+			, const std::vector<AnimationJointFbx>&	_in_jointsFbx
+			, const std::vector<AnimationJoint>&	_in_joints
+			, const uint32_t			_in_elementsToExtract
+			, AnimationClip&			_out_animationClip
+		);
+
 		/* Extracts animation data from an FbxScene and stores it in an AnimationClip.
 		  PARAMETERS
 			_in_fbxScene_p : The FBX scene to extract data from.
@@ -89,6 +188,11 @@ namespace fbx_exporter
 			EXTRACT : Data was successfully extracted.
 		  NOTES
 			Extracts animations at 30 frames per second.
+			Frames are sampled in parallel on up to GetWorkerThreadCount() threads, each with its own
+			animation evaluator. Output is identical to sampling on a single thread.
+			Only root joints are evaluated in model space. Other joints are evaluated relative to
+			their parent and composed in joint order. With AnimationElement::LOCAL_TRANSFORMS,
+			the parent-relative transforms are stored instead, and root joints stay in model space.
 		*/
 		Result GetAnimationFromFbxScene(
 			const FbxScene*				_in_fbxScene_p
@@ -96,6 +200,24 @@ namespace fbx_exporter
 			, AnimationClip&			_out_animationClip
 		);
 
+		/* Extracts every animation stack of an FbxScene and stores each in an AnimationClip.
+		  PARAMETERS
+			_in_fbxScene_p : The FBX scene to extract data from.
+			_in_elementsToExtract : A bit-flag set denoting which animation elements to store.
+			_out_animationClips : The animation containers to store extracted data in, one per stack.
+		  RETURNS
+			FAIL : The scene has no skeleton or no animation stacks.
+			EXTRACT : Data was extracted successfully.
+		  NOTES
+			The skeleton is read once and shared by every clip. The current animation stack of the
+			scene is restored before returning.
+		*/
+		Result GetAnimationsFromFbxScene(
+			const FbxScene*				_in_fbxScene_p
+			, const uint32_t			_in_elementsToExtract
+			, std::vector<AnimationClip>&	_out_animationClips
+		);
+
 	}
 }
 
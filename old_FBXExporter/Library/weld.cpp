@@ -0,0 +1,142 @@
+#include "weld.h"
+
+#include <cstring>
+
+
+namespace fbx_exporter
+{
+	namespace library
+	{
+#pragma region Private Helper Functions
+		uint32_t HashFloats(
+			const float*				_in_values_p
+			, const uint32_t			_in_count
+			, uint32_t					_in_hash
+		) {
+			for (uint32_t i = 0; i < _in_count; i++)
+			{
+				uint32_t bits = 0;
+				memcpy(&bits, &_in_values_p[i], sizeof(bits));
+
+				// -0.0f compares equal to 0.0f, so both must hash the same
+				if (bits == 0x80000000)
+					bits = 0;
+
+				_in_hash = (_in_hash ^ bits) * 0x9E3779B1;
+				_in_hash ^= _in_hash >> 15;
+			}
+
+			return _in_hash;
+		}
+
+		uint32_t HashVertex(const Vertex& _in_vertex)
+		{
+			uint32_t hash = 0x811C9DC5;
+
+			hash = HashFloats(_in_vertex.pos, 3, hash);
+			hash = HashFloats(_in_vertex.norm, 3, hash);
+			hash = HashFloats(_in_vertex.color, 4, hash);
+			hash = HashFloats(_in_vertex.texCoord, 2, hash);
+			hash = HashFloats(_in_vertex.weights, 4, hash);
+
+			// joint indices are hashed two to a word
+			for (uint32_t i = 0; i < 4; i += 2)
+			{
+				hash = (hash ^ (_in_vertex.joints[i] | ((uint32_t)_in_vertex.joints[i + 1] << 16))) * 0x9E3779B1;
+				hash ^= hash >> 15;
+			}
+
+			// final avalanche so low bits used for slot selection depend on every attribute
+			hash ^= hash >> 16;
+			hash *= 0x85EBCA6B;
+			hash ^= hash >> 13;
+
+			return hash;
+		}
+
+		void GrowVertexWeldTable(
+			const std::vector<Vertex>&	_in_vertices
+			, VertexWeldTable&			_out_table
+		) {
+			InitializeVertexWeldTable((uint32_t)_out_table.slots.size(), _out_table);
+
+			// reinsert every unique vertex; all are known to be distinct
+			for (uint32_t v = 0; v < _in_vertices.size(); v++)
+			{
+				uint32_t slot = HashVertex(_in_vertices[v]) & _out_table.mask;
+				while (_out_table.slots[slot] != VertexWeldTable::EMPTY_SLOT)
+					slot = (slot + 1) & _out_table.mask;
+
+				_out_table.slots[slot] = v;
+			}
+		}
+#pragma endregion
+
+#pragma region Weld Function Definitions
+		void InitializeVertexWeldTable(
+			const uint32_t				_in_vertexCapacity
+			, VertexWeldTable&			_out_table
+		) {
+			// keep load factor at or below one half
+			uint32_t slotCount = 16;
+			while (slotCount < _in_vertexCapacity * 2)
+				slotCount <<= 1;
+
+			_out_table.slots.assign(slotCount, VertexWeldTable::EMPTY_SLOT);
+			_out_table.mask = slotCount - 1;
+		}
+
+		uint32_t WeldVertex(
+			const Vertex&				_in_vertex
+			, VertexWeldTable&			_out_table
+			, std::vector<Vertex>&		_out_vertices
+		) {
+			// grow before probing so the returned slot stays valid
+			if ((_out_vertices.size() + 1) * 2 > _out_table.slots.size())
+				GrowVertexWeldTable(_out_vertices, _out_table);
+
+			uint32_t slot = HashVertex(_in_vertex) & _out_table.mask;
+
+			// linear probe until a matching vertex or an empty slot is found
+			while (_out_table.slots[slot] != VertexWeldTable::EMPTY_SLOT)
+			{
+				uint32_t index = _out_table.slots[slot];
+				if (_out_vertices[index] == _in_vertex)
+					return index;
+
+				slot = (slot + 1) & _out_table.mask;
+			}
+
+			uint32_t index = (uint32_t)_out_vertices.size();
+			_out_table.slots[slot] = index;
+			_out_vertices.push_back(_in_vertex);
+
+			return index;
+		}
+
+		Result CompactifyVertices(
+			const std::vector<Vertex>&	_in_vertices
+			, std::vector<Vertex>&		_out_vertices
+			, std::vector<uint32_t>&	_out_indices
+		) {
+			Result ret_result = Result::FAIL;
+
+			VertexWeldTable table;
+			InitializeVertexWeldTable((uint32_t)_in_vertices.size(), table);
+
+			_out_indices.reserve(_out_indices.size() + _in_vertices.size());
+
+			// weld each raw vertex against the unique vertices found so far
+			for (uint32_t i = 0; i < _in_vertices.size(); i++)
+				_out_indices.push_back(WeldVertex(_in_vertices[i], table, _out_vertices));
+
+			// verify vertices and indices were generated
+			if (_out_vertices.size() > 0 && _out_indices.size() > 0)
+				ret_result = Result::SUCCESS;
+
+			return ret_result;
+		}
+#pragma endregion
+
+	}
+}
@@ -0,0 +1,70 @@
+#ifndef _FBXEXPORTER_LIBRARY_WELD_H_
+#define _FBXEXPORTER_LIBRARY_WELD_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "defines.h"
+
+namespace fbx_exporter
+{
+	namespace library
+	{
+		// Open-addressing hash table mapping vertices to their index in a unique vertex list.
+		struct VertexWeldTable
+		{
+			enum : uint32_t
+			{
+				EMPTY_SLOT = 0xFFFFFFFF  // Marks an unused slot.
+			};
+
+			std::vector<uint32_t>	slots;  // Unique vertex index per slot, or EMPTY_SLOT.
+			uint32_t				mask = 0;  // Slot count minus one; slot count is a power of two.
+		};
+
+
+		/* Sizes a weld table to hold a number of unique vertices without growing.
+		  PARAMETERS
+			_in_vertexCapacity : The number of unique vertices expected.
+			_out_table : The table to initialize. Existing contents are discarded.
+		*/
+		void InitializeVertexWeldTable(
+			const uint32_t				_in_vertexCapacity
+			, VertexWeldTable&			_out_table
+		);
+
+		/* Finds a vertex in a unique vertex list, appending it if it is not already present.
+		  PARAMETERS
+			_in_vertex : The vertex to weld.
+			_out_table : The weld table indexing _out_vertices. Grows as needed.
+			_out_vertices : The unique vertex list.
+		  RETURNS
+			uint32_t : The index of the vertex in _out_vertices.
+		*/
+		uint32_t WeldVertex(
+			const Vertex&				_in_vertex
+			, VertexWeldTable&			_out_table
+			, std::vector<Vertex>&		_out_vertices
+		);
+
+		/* Removes duplicate vertices from a raw vertex list and generates an index list.
+		  PARAMETERS
+			_in_vertices : The raw vertex list, three vertices per triangle.
+			_out_vertices : The unique vertex list.
+			_out_indices : The index list referencing _out_vertices.
+		  RETURNS
+			FAIL : No vertices or indices were generated.
+			SUCCESS : Vertices and indices were generated.
+		  NOTES
+			Unique vertices keep the order of their first occurrence in _in_vertices.
+		*/
+		Result CompactifyVertices(
+			const std::vector<Vertex>&	_in_vertices
+			, std::vector<Vertex>&		_out_vertices
+			, std::vector<uint32_t>&	_out_indices
+		);
+
+	}
+}
+
+#endif // _FBXEXPORTER_LIBRARY_WELD_H_
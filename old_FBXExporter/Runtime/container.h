@@ -0,0 +1,276 @@
+#ifndef _FBXEXPORTER_RUNTIME_CONTAINER_H_
+#define _FBXEXPORTER_RUNTIME_CONTAINER_H_
+
+#include <cstdint>
+
+#include "defines.h"
+
+namespace fbx_exporter
+{
+	namespace runtime
+	{
+		// First four bytes of every exported .mesh, .mat, .anim, .animlib and .tex file: "FBXC".
+		const uint32_t CONTAINER_MAGIC = 0x43584246;
+
+		// Version of the container layout. Readers reject files with another major version.
+		const uint16_t CONTAINER_VERSION_MAJOR = 1;
+		const uint16_t CONTAINER_VERSION_MINOR = 0;
+
+		// Alignment of the section table and of sections holding small records.
+		const uint32_t CONTAINER_TABLE_ALIGNMENT = 16;
+
+		// Alignment of sections holding bulk arrays such as vertices, indices and keys. One cache line.
+		const uint32_t CONTAINER_BULK_ALIGNMENT = 64;
+
+
+		// Indicates what an exported container file holds.
+		enum struct ContainerType : uint32_t
+		{
+			MESH = 1  // A .mesh file.
+			, MATERIALS  // A .mat file.
+			, ANIMATION  // A .anim file.
+			, TEXTURE  // A .tex file.
+			, ANIMATION_LIBRARY  // A .animlib file.
+		};
+
+		// Indicates what a section of a container file holds. Sections a file does not need are left out.
+		enum struct SectionType : uint32_t
+		{
+			// .mesh sections
+			MESH_INFO = 1  // One MeshInfo.
+			, VERTICES  // Vertices, MeshInfo::vertex_stride bytes each.
+			, INDICES  // Indices, MeshInfo::index_size bytes each.
+			, SUBMESHES  // MeshSubmeshRecord per submesh.
+			, LODS  // MeshLodRecord per level of detail.
+			, PARTS  // MeshPartRecord per part.
+			, MESHLETS  // MeshletRecord per meshlet.
+			, MESHLET_VERTICES  // uint32_t mesh vertex per meshlet vertex.
+			, MESHLET_TRIANGLES  // uint8_t local vertex indices, three per meshlet triangle.
+			, STRINGS  // Characters of names and texture filepaths, not null-terminated. Records store offsets and lengths into it.
+
+			// .mat sections
+			, MATERIALS = 32  // MaterialRecord per material.
+			, TEXTURES  // TexturePathRecord per texture filepath. MaterialComponentRecord::input indexes them.
+
+			// .anim sections
+			, ANIMATION_INFO = 64  // One AnimationInfo.
+			, JOINTS  // ContainerJoint per joint, parents before children.
+			, TRACKS  // AnimationTrackRecord per channel: translation, rotation and scale of each joint.
+			, KEY_TIMES  // Key times of every channel. float, or uint16_t for quantized keys.
+			, KEY_VALUES  // Key values of every channel. float, or uint16_t for quantized keys.
+
+			// .tex sections
+			, TEXTURE_INFO = 96  // One TextureInfo.
+			, TEXTURE_BLOCKS  // Compressed 4x4 blocks in row-major order, TextureInfo::block_size bytes each.
+
+			// .animlib sections, with the JOINTS, TRACKS, KEY_TIMES, KEY_VALUES and STRINGS of every clip
+			, ANIMATION_LIBRARY_INFO = 128  // One AnimationLibraryInfo.
+			, SKELETONS  // AnimationSkeletonRecord per skeleton. Each skeleton's joints are stored once.
+			, CLIPS  // AnimationClipRecord per clip.
+		};
+
+		// Indicates how a .mesh file's indices are stored.
+		enum struct IndexBase : uint32_t
+		{
+			WHOLE_MESH = 0  // Indices address the whole vertex list.
+			, SUBMESH  // 16-bit indices are relative to the base_vertex of their submesh.
+		};
+
+
+		// Header at the start of a container file.
+		struct ContainerHeader
+		{
+			uint32_t		magic = CONTAINER_MAGIC;  // CONTAINER_MAGIC.
+			uint16_t		version_major = CONTAINER_VERSION_MAJOR;  // Major version of the layout.
+			uint16_t		version_minor = CONTAINER_VERSION_MINOR;  // Minor version of the layout. Newer minor versions only add sections.
+			ContainerType	type = ContainerType::MESH;  // What the file holds.
+			uint32_t		section_count = 0;  // Number of entries in the section table.
+			uint64_t		file_size = 0;  // Length of the file in bytes. Shorter files are truncated.
+			uint64_t		section_table_offset = 0;  // Byte offset of the section table. A multiple of CONTAINER_TABLE_ALIGNMENT.
+		};
+
+		// Entry of a container file's section table.
+		struct ContainerSection
+		{
+			SectionType		type = SectionType::MESH_INFO;  // What the section holds.
+			uint32_t		element_size = 0;  // Bytes per element.
+			uint32_t		alignment = 0;  // Alignment of offset. CONTAINER_TABLE_ALIGNMENT or CONTAINER_BULK_ALIGNMENT.
+			uint32_t		reserved = 0;  // Always 0.
+			uint64_t		offset = 0;  // Byte offset of the section from the start of the file.
+			uint64_t		element_count = 0;  // Number of elements. The section is element_size * element_count bytes.
+		};
+
+		// Layout of the vertices and indices of a .mesh file.
+		struct MeshInfo
+		{
+			uint32_t	vertex_count = 0;  // Number of vertices.
+			uint32_t	index_count = 0;  // Number of indices.
+			uint32_t	vertex_stride = 0;  // Bytes per vertex. A multiple of 4.
+			uint32_t	index_size = 0;  // Bytes per index. 2 or 4.
+			IndexBase	index_base = IndexBase::WHOLE_MESH;  // What indices are relative to.
+			uint32_t	elements = 0;  // library::MeshElement flags of the elements stored.
+			uint32_t	position_format = 0;  // library::VertexPositionFormat of positions.
+			uint32_t	normal_format = 0;  // library::VertexNormalFormat of normals.
+			uint32_t	color_format = 0;  // library::VertexColorFormat of colors.
+			uint32_t	texcoord_format = 0;  // library::VertexTexCoordFormat of texture coordinates.
+			uint32_t	skin_format = 0;  // library::VertexSkinFormat of skin weights and joint indices.
+			uint32_t	position_offset = 0;  // Byte offset of the position in a vertex.
+			uint32_t	normal_offset = 0;  // Byte offset of the normal in a vertex.
+			uint32_t	color_offset = 0;  // Byte offset of the color in a vertex.
+			uint32_t	texcoord_offset = 0;  // Byte offset of the texture coordinate in a vertex.
+			uint32_t	skin_offset = 0;  // Byte offset of the skin weights in a vertex. Joint indices follow them.
+			float		position_min[3] = { 0.0f, 0.0f, 0.0f };  // Bounding box minimum. Dequantizes UNORM16 positions.
+			float		position_extent[3] = { 0.0f, 0.0f, 0.0f };  // Bounding box size. Dequantizes UNORM16 positions.
+			float		texcoord_min[2] = { 0.0f, 0.0f };  // Texture coordinate minimum. Dequantizes UNORM16 texture coordinates.
+			float		texcoord_extent[2] = { 0.0f, 0.0f };  // Texture coordinate range. Dequantizes UNORM16 texture coordinates.
+		};
+
+		// Index range of a .mesh file whose vertices fit 16-bit indices. Laid out as library::Submesh.
+		struct MeshSubmeshRecord
+		{
+			uint32_t	index_offset;  // First index of the submesh.
+			uint32_t	index_count;  // Number of indices in the submesh.
+			uint32_t	base_vertex;  // First vertex of the submesh.
+			uint32_t	vertex_count;  // Number of vertices in the submesh, starting at base_vertex.
+		};
+
+		// Index range of one level of detail of a .mesh file. Laid out as library::MeshLod.
+		struct MeshLodRecord
+		{
+			uint32_t	index_offset;  // First index of the level.
+			uint32_t	index_count;  // Number of indices in the level.
+			float		error;  // Largest distance from the first level's surface, in mesh units.
+			uint32_t	meshlet_offset;  // First meshlet of the level.
+			uint32_t	meshlet_count;  // Number of meshlets in the level.
+			uint32_t	part_offset;  // First part of the level.
+			uint32_t	part_count;  // Number of parts in the level.
+		};
+
+		// Index range of one scene mesh and material of a .mesh file.
+		struct MeshPartRecord
+		{
+			uint32_t	name_offset;  // First character of the mesh name in the STRINGS section.
+			uint32_t	name_length;  // Number of characters in the mesh name.
+			uint32_t	material;  // Index of the part's material among the scene's materials. 0xFFFFFFFF if it has none.
+			uint32_t	index_offset;  // First index of the part.
+			uint32_t	index_count;  // Number of indices in the part.
+			uint32_t	base_vertex;  // Smallest vertex the part's indices use.
+			uint32_t	vertex_count;  // Number of vertices from base_vertex to the largest vertex the part uses.
+			uint32_t	meshlet_offset;  // First meshlet of the part.
+			uint32_t	meshlet_count;  // Number of meshlets in the part.
+			uint32_t	reserved;  // Always 0.
+			float		transform[16];  // Global transform of the mesh's node.
+		};
+
+		// Cluster of a .mesh file's triangles with its bounds. Laid out as library::Meshlet.
+		struct MeshletRecord
+		{
+			uint32_t	vertex_offset;  // First entry of the meshlet in MESHLET_VERTICES.
+			uint32_t	vertex_count;  // Number of vertices in the meshlet.
+			uint32_t	triangle_offset;  // First byte of the meshlet in MESHLET_TRIANGLES.
+			uint32_t	triangle_count;  // Number of triangles in the meshlet.
+			float		center[3];  // Center of the bounding sphere.
+			float		radius;  // Radius of the bounding sphere.
+			float		cone_apex[3];  // Apex of the normal cone.
+			float		cone_axis[3];  // Average facing direction of the triangles.
+			float		cone_cutoff;  // The meshlet faces away when dot(normalize(cone_apex - eye), cone_axis) >= cone_cutoff.
+		};
+
+		// One component of a material of a .mat file. Laid out as library::Material::Component.
+		struct MaterialComponentRecord
+		{
+			float		value[3];  // Color value.
+			float		factor;  // Texture strength factor.
+			int32_t		input;  // Index of the texture filepath in TEXTURES. -1 if the component has no texture.
+		};
+
+		// Material of a .mat file: diffuse, emissive, specular and normal map components. Laid out as library::Material.
+		struct MaterialRecord
+		{
+			MaterialComponentRecord	components[4];  // Components in library::Material::ComponentType order.
+		};
+
+		// Texture filepath of a .mat file. Laid out as library::TexturePath.
+		struct TexturePathRecord
+		{
+			uint32_t	offset;  // First character of the filepath in the STRINGS section.
+			uint32_t	length;  // Number of characters in the filepath.
+		};
+
+		// Layout of the keys of a .anim file.
+		struct AnimationInfo
+		{
+			AnimationFormat	format = AnimationFormat::FLOAT_KEYS;  // How keys are stored.
+			uint32_t		joint_count = 0;  // Number of joints. TRACKS holds three channels per joint.
+			double			duration = 0.0;  // Animation length in seconds.
+		};
+
+		// Layout of the keys and counts of a .animlib file.
+		struct AnimationLibraryInfo
+		{
+			AnimationFormat	format = AnimationFormat::FLOAT_KEYS;  // How the keys of every clip are stored.
+			uint32_t		skeleton_count = 0;  // Number of skeletons.
+			uint32_t		clip_count = 0;  // Number of clips.
+			uint32_t		reserved = 0;  // Always 0.
+		};
+
+		// Layout of the blocks of a .tex file.
+		struct TextureInfo
+		{
+			uint32_t	format = 0;  // library::TextureFormat of the blocks.
+			uint32_t	width = 0;  // Width in pixels. Blocks past the right edge repeat the last column.
+			uint32_t	height = 0;  // Height in pixels. Blocks past the bottom edge repeat the last row.
+			uint32_t	block_size = 0;  // Bytes per block. 8 or 16.
+		};
+
+		// Bind pose joint of a .anim or .animlib file. Laid out as library::AnimationJoint.
+		struct ContainerJoint
+		{
+			float		global_transform[16];  // Model-space joint transformation matrix.
+			int32_t		parent_index;  // Index of the parent joint. -1 indicates no parent.
+		};
+
+		// Keys of one channel of a .anim or .animlib file.
+		struct AnimationTrackRecord
+		{
+			uint32_t	key_count;  // Number of keys. 0 for a constant quantized vector channel, whose value is min.
+			uint32_t	time_offset;  // First key time of the channel in KEY_TIMES, in elements.
+			uint32_t	value_offset;  // First key value of the channel in KEY_VALUES, in elements.
+			uint32_t	reserved;  // Always 0.
+			float		min[3];  // Smallest value of a quantized vector channel. 0 otherwise.
+			float		extent[3];  // Largest value minus smallest of a quantized vector channel. 0 otherwise.
+		};
+
+		// Skeleton of a .animlib file, shared by the clips that animate it.
+		struct AnimationSkeletonRecord
+		{
+			uint64_t	hash;  // Hash clips are matched to the skeleton by.
+			uint32_t	joint_offset;  // First joint of the skeleton in JOINTS.
+			uint32_t	joint_count;  // Number of joints in the skeleton.
+		};
+
+		// Clip of a .animlib file.
+		struct AnimationClipRecord
+		{
+			uint32_t	name_offset;  // First character of the clip name in the STRINGS section.
+			uint32_t	name_length;  // Number of characters in the clip name.
+			uint32_t	skeleton;  // Index of the clip's skeleton in SKELETONS.
+			uint32_t	track_offset;  // First channel of the clip in TRACKS. Three channels per skeleton joint.
+			double		duration;  // Animation length in seconds.
+		};
+
+		static_assert(sizeof(ContainerHeader) == 32, "ContainerHeader layout changed");
+		static_assert(sizeof(ContainerSection) == 32, "ContainerSection layout changed");
+		static_assert(sizeof(MeshPartRecord) == 104, "MeshPartRecord layout changed");
+		static_assert(sizeof(MaterialRecord) == 80, "MaterialRecord layout changed");
+		static_assert(sizeof(ContainerJoint) == 68, "ContainerJoint layout changed");
+		static_assert(sizeof(AnimationTrackRecord) == 40, "AnimationTrackRecord layout changed");
+		static_assert(sizeof(TextureInfo) == 16, "TextureInfo layout changed");
+		static_assert(sizeof(AnimationLibraryInfo) == 16, "AnimationLibraryInfo layout changed");
+		static_assert(sizeof(AnimationSkeletonRecord) == 16, "AnimationSkeletonRecord layout changed");
+		static_assert(sizeof(AnimationClipRecord) == 24, "AnimationClipRecord layout changed");
+
+	}
+}
+
+#endif // _FBXEXPORTER_RUNTIME_CONTAINER_H_
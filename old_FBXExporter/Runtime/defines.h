@@ -0,0 +1,99 @@
+#ifndef _FBXEXPORTER_RUNTIME_DEFINES_H_
+#define _FBXEXPORTER_RUNTIME_DEFINES_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#if defined(__AVX__)
+#define FBXRT_AVX
+#include <immintrin.h>
+#elif defined(_M_X64) || defined(_M_AMD64) || defined(__SSE2__) \
+	|| (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FBXRT_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace fbx_exporter
+{
+	namespace runtime
+	{
+		// Number of joints sampled together by one SIMD operation.
+#if defined(FBXRT_AVX)
+		const uint32_t JOINT_LANES = 8;
+#else
+		const uint32_t JOINT_LANES = 4;
+#endif
+
+
+		// Indicates the result of a function or operation.
+		enum struct Result
+		{
+			INVALID_ARG = -2  // An invalid argument was passed.
+			, FAIL = -1  // The operation failed to complete.
+			, SUCCESS = 0  // The operation completely successfully.
+		};
+
+		// Indicates how animation keys are stored in a .anim file.
+		enum struct AnimationFormat : uint32_t
+		{
+			FLOAT_KEYS = 0  // Float times, vectors, and quaternions.
+			, QUANTIZED_KEYS  // 16-bit times and range-quantized vectors, 48-bit quaternions.
+		};
+
+
+		// Parent-relative channels of JOINT_LANES joints, one array per component.
+		struct alignas(32) JointBlock
+		{
+			float	translation[3][JOINT_LANES];  // Position x, y, z per joint.
+			float	rotation[4][JOINT_LANES];  // Quaternion x, y, z, w per joint.
+			float	scale[3][JOINT_LANES];  // Scale x, y, z per joint.
+		};
+
+		// Bind pose joint data container.
+		struct AnimationJoint
+		{
+			float	global_transform[16];  // Model-space joint transformation matrix.
+			int		parent_index = -1;  // Index of parent joint. -1 indicates no parent.
+		};
+
+		// Animation clip resampled onto a uniform key grid for branch-free sampling.
+		struct AnimationClip
+		{
+			std::string					name;  // Clip name. Only set for clips from an animation library.
+			uint64_t					skeleton_hash = 0;  // Hash of the skeleton. Only set for clips from an animation library.
+			float						duration = 0.0f;  // Animation length in seconds.
+			float						start_time = 0.0f;  // Time of the first key in seconds.
+			float						key_interval = 0.0f;  // Seconds between keys.
+			uint32_t					key_count = 0;  // Number of keys per joint.
+			uint32_t					joint_count = 0;  // Number of joints.
+			uint32_t					block_count = 0;  // Number of joint blocks per key.
+			std::vector<AnimationJoint>	joints;  // Bind pose joints. Empty for clips from an animation library.
+			std::vector<JointBlock>		blocks;  // Joint blocks, key by key.
+		};
+
+		// Bind pose shared by the clips of an animation library.
+		struct AnimationSkeleton
+		{
+			uint64_t					hash = 0;  // Hash clips reference the skeleton by.
+			std::vector<AnimationJoint>	joints;  // Bind pose joints. Parents precede their children.
+		};
+
+		// Clips loaded from an animation library, and the skeletons they animate.
+		struct AnimationLibrary
+		{
+			std::vector<AnimationSkeleton>	skeletons;  // Skeletons, each stored once.
+			std::vector<AnimationClip>		clips;  // Clips. Each references a skeleton by hash.
+		};
+
+		// Parent-relative joint transformations sampled from a clip.
+		struct AnimationPose
+		{
+			uint32_t					joint_count = 0;  // Number of joints.
+			std::vector<JointBlock>		blocks;  // Joint blocks. Unused lanes hold the identity.
+		};
+
+	}
+}
+
+#endif // _FBXEXPORTER_RUNTIME_DEFINES_H_
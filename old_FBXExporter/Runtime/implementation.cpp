@@ -0,0 +1,550 @@
+#include "interface.h"
+#include "loader.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <string>
+
+
+namespace fbx_exporter
+{
+	namespace runtime
+	{
+#pragma region Private Helper Functions
+		// Channel keys read from a .anim or .animlib file before resampling.
+		struct KeyTrack
+		{
+			std::vector<float>	times;  // Key times in seconds.
+			std::vector<float>	values;  // Key values, packed per key.
+		};
+
+		void DecodeQuantizedKeyTimes(
+			const uint16_t*				_in_times_p
+			, const uint32_t			_in_keyCount
+			, const double				_in_duration
+			, KeyTrack&					_out_track
+		) {
+			_out_track.times.resize(_in_keyCount);
+			for (uint32_t k = 0; k < _in_keyCount; k++)
+				_out_track.times[k] = (float)(_in_times_p[k] / 65535.0 * _in_duration);
+		}
+
+		void DecodeQuantizedVectorKeys(
+			const uint16_t*				_in_values_p
+			, const uint32_t			_in_keyCount
+			, const float*				_in_min_p
+			, const float*				_in_extent_p
+			, KeyTrack&					_out_track
+		) {
+			// constant channels store only their value
+			if (_in_keyCount == 0)
+			{
+				_out_track.times.assign(1, 0.0f);
+				_out_track.values.assign(_in_min_p, _in_min_p + 3);
+				return;
+			}
+
+			_out_track.values.resize((size_t)_in_keyCount * 3);
+			for (size_t i = 0; i < _out_track.values.size(); i++)
+				_out_track.values[i] = _in_min_p[i % 3] + _in_extent_p[i % 3] * (_in_values_p[i] / 65535.0f);
+		}
+
+		void DecodeQuantizedRotationKeys(
+			const uint16_t*				_in_words_p
+			, const uint32_t			_in_keyCount
+			, KeyTrack&					_out_track
+		) {
+			_out_track.values.resize((size_t)_in_keyCount * 4);
+
+			// 2-bit index of the dropped largest component, then three 15-bit components
+			for (uint32_t k = 0; k < _in_keyCount; k++)
+			{
+				uint64_t packed = ((uint64_t)_in_words_p[k * 3 + 0] << 32) | ((uint64_t)_in_words_p[k * 3 + 1] << 16)
+					| _in_words_p[k * 3 + 2];
+				uint32_t largest = (uint32_t)(packed >> 46) & 3;
+				uint32_t shift = 31;
+				float* q = &_out_track.values[k * 4];
+				float sum = 0.0f;
+
+				for (uint32_t i = 0; i < 4; i++)
+				{
+					if (i == largest)
+						continue;
+
+					q[i] = (((packed >> shift) & 0x7FFF) / 32767.0f * 2.0f - 1.0f) * 0.70710678f;
+					sum += q[i] * q[i];
+					shift -= 15;
+				}
+
+				q[largest] = sqrtf(std::max(1.0f - sum, 0.0f));
+			}
+		}
+
+		void SampleKeyTrack(
+			const KeyTrack&				_in_track
+			, const uint32_t			_in_componentCount
+			, const float				_in_time
+			, float*					_out_values_p
+		) {
+			const std::vector<float>& times = _in_track.times;
+			uint32_t next = (uint32_t)(std::upper_bound(times.begin(), times.end(), _in_time) - times.begin());
+			uint32_t previous = next > 0 ? next - 1 : 0;
+			float u = 0.0f;
+
+			if (next == times.size())
+				next = previous;
+			else if (next > previous && times[next] > times[previous])
+				u = (_in_time - times[previous]) / (times[next] - times[previous]);
+
+			for (uint32_t c = 0; c < _in_componentCount; c++)
+			{
+				float a = _in_track.values[previous * _in_componentCount + c];
+				float b = _in_track.values[next * _in_componentCount + c];
+				_out_values_p[c] = a + (b - a) * u;
+			}
+		}
+
+		void SetIdentityJointBlock(JointBlock& _out_block)
+		{
+			memset(&_out_block, 0, sizeof(_out_block));
+			for (uint32_t lane = 0; lane < JOINT_LANES; lane++)
+			{
+				_out_block.rotation[3][lane] = 1.0f;
+				_out_block.scale[0][lane] = 1.0f;
+				_out_block.scale[1][lane] = 1.0f;
+				_out_block.scale[2][lane] = 1.0f;
+			}
+		}
+
+		/* Resamples the channel keys of a clip into joint blocks.
+		  PARAMETERS
+			_in_tracks : The translation, rotation and scale keys of each joint.
+			_in_duration : The clip length in seconds.
+			_in_jointCount : The number of joints in the clip's skeleton.
+			_out_animationClip : The clip to fill. Joints are not changed.
+		*/
+		void ResampleAnimationClipKeys(
+			const std::vector<KeyTrack>&	_in_tracks
+			, const double				_in_duration
+			, const uint32_t			_in_jointCount
+			, AnimationClip&			_out_animationClip
+		) {
+			// -- find key grid --
+
+			// keys were kept from a uniform sampling, so the closest pair of keys gives its interval
+			float startTime = 0.0f, endTime = 0.0f, interval = 0.0f;
+			bool animated = false;
+
+			for (const KeyTrack& track : _in_tracks)
+			{
+				if (track.times.size() < 2)
+					continue;
+
+				startTime = animated ? std::min(startTime, track.times.front()) : track.times.front();
+				endTime = animated ? std::max(endTime, track.times.back()) : track.times.back();
+				animated = true;
+
+				for (size_t k = 1; k < track.times.size(); k++)
+				{
+					float delta = track.times[k] - track.times[k - 1];
+					if (delta > 0.0f && (interval == 0.0f || delta < interval))
+						interval = delta;
+				}
+			}
+
+			// average the single-interval steps, quantized key times are off by up to half a step
+			double stepSum = 0.0;
+			uint32_t stepCount = 0;
+			for (const KeyTrack& track : _in_tracks)
+				for (size_t k = 1; k < track.times.size(); k++)
+				{
+					float delta = track.times[k] - track.times[k - 1];
+					if (delta > 0.0f && delta < interval * 1.5f)
+					{
+						stepSum += delta;
+						stepCount++;
+					}
+				}
+			if (stepCount > 0)
+				interval = (float)(stepSum / stepCount);
+
+			uint32_t keyCount = 1;
+			if (animated && interval > 0.0f)
+			{
+				// fit a whole number of intervals between the first and last key
+				keyCount = (uint32_t)((endTime - startTime) / interval + 0.5f) + 1;
+				interval = keyCount > 1 ? (endTime - startTime) / (keyCount - 1) : 0.0f;
+			}
+
+			// -- /find key grid --
+
+
+			// -- resample keys into joint blocks --
+
+			_out_animationClip.duration = (float)_in_duration;
+			_out_animationClip.start_time = startTime;
+			_out_animationClip.key_interval = interval;
+			_out_animationClip.key_count = keyCount;
+			_out_animationClip.joint_count = _in_jointCount;
+			_out_animationClip.block_count = (_in_jointCount + JOINT_LANES - 1) / JOINT_LANES;
+			_out_animationClip.blocks.resize((size_t)keyCount * _out_animationClip.block_count);
+
+			for (uint32_t k = 0; k < keyCount; k++)
+			{
+				float time = startTime + interval * k;
+				JointBlock* blocks_p = &_out_animationClip.blocks[(size_t)k * _out_animationClip.block_count];
+				const JointBlock* previous_p = k > 0 ? blocks_p - _out_animationClip.block_count : nullptr;
+
+				for (uint32_t b = 0; b < _out_animationClip.block_count; b++)
+					SetIdentityJointBlock(blocks_p[b]);
+
+				for (uint32_t j = 0; j < _in_jointCount; j++)
+				{
+					JointBlock& block = blocks_p[j / JOINT_LANES];
+					uint32_t lane = j % JOINT_LANES;
+					float values[4];
+
+					SampleKeyTrack(_in_tracks[j * 3 + 0], 3, time, values);
+					for (uint32_t c = 0; c < 3; c++)
+						block.translation[c][lane] = values[c];
+
+					SampleKeyTrack(_in_tracks[j * 3 + 2], 3, time, values);
+					for (uint32_t c = 0; c < 3; c++)
+						block.scale[c][lane] = values[c];
+
+					// keep quaternions in one hemisphere so interpolation takes the short path
+					SampleKeyTrack(_in_tracks[j * 3 + 1], 4, time, values);
+					float sign = 1.0f;
+					if (previous_p != nullptr)
+					{
+						const JointBlock& previous = previous_p[j / JOINT_LANES];
+						float dot = 0.0f;
+						for (uint32_t c = 0; c < 4; c++)
+							dot += values[c] * previous.rotation[c][lane];
+						sign = dot < 0.0f ? -1.0f : 1.0f;
+					}
+					for (uint32_t c = 0; c < 4; c++)
+						block.rotation[c][lane] = values[c] * sign;
+				}
+			}
+
+			// -- /resample keys into joint blocks --
+		}
+
+		/* Reads the channel keys of a mapped .anim file, or of one clip of a mapped .animlib file.
+		  PARAMETERS
+			_in_view : The sections of the file or clip, with every channel checked by GetAnimationView
+			  or GetAnimationLibraryView.
+			_out_tracks : The translation, rotation and scale keys of each joint.
+		*/
+		void ReadContainerAnimationKeys(
+			const AnimationView&		_in_view
+			, std::vector<KeyTrack>&	_out_tracks
+		) {
+			bool quantized = _in_view.info_p->format == AnimationFormat::QUANTIZED_KEYS;
+
+			_out_tracks.resize(_in_view.tracks.size);
+			for (size_t t = 0; t < _in_view.tracks.size; t++)
+			{
+				const AnimationTrackRecord& record = _in_view.tracks[t];
+				KeyTrack& track = _out_tracks[t];
+				bool rotation = t % 3 == 1;
+
+				if (!quantized)
+				{
+					const float* times_p = _in_view.times.data_p + record.time_offset;
+					const float* values_p = _in_view.values.data_p + record.value_offset;
+					track.times.assign(times_p, times_p + record.key_count);
+					track.values.assign(values_p, values_p + (size_t)record.key_count * (rotation ? 4 : 3));
+					continue;
+				}
+
+				const uint16_t* times_p = _in_view.quantized_times.data_p + record.time_offset;
+				const uint16_t* values_p = _in_view.quantized_values.data_p + record.value_offset;
+
+				if (record.key_count > 0)
+					DecodeQuantizedKeyTimes(times_p, record.key_count, _in_view.info_p->duration, track);
+				if (rotation)
+					DecodeQuantizedRotationKeys(values_p, record.key_count, track);
+				else
+					DecodeQuantizedVectorKeys(values_p, record.key_count, record.min, record.extent, track);
+			}
+		}
+
+		/* Interpolates one joint block between two keys.
+		  PARAMETERS
+			_in_a : The block at the earlier key.
+			_in_b : The block at the later key.
+			_in_u : The interpolation weight of _in_b.
+			_out_block : The interpolated block. Rotations are normalized.
+		*/
+		void InterpolateJointBlock(
+			const JointBlock&			_in_a
+			, const JointBlock&			_in_b
+			, const float				_in_u
+			, JointBlock&				_out_block
+		) {
+#if defined(FBXRT_AVX)
+			__m256 u = _mm256_set1_ps(_in_u);
+			auto lerp = [&](const float* _in_a_p, const float* _in_b_p, float* _out_p)
+			{
+				__m256 a = _mm256_load_ps(_in_a_p);
+				__m256 b = _mm256_load_ps(_in_b_p);
+				__m256 value = _mm256_add_ps(a, _mm256_mul_ps(_mm256_sub_ps(b, a), u));
+				_mm256_store_ps(_out_p, value);
+				return value;
+			};
+
+			for (uint32_t c = 0; c < 3; c++)
+			{
+				lerp(_in_a.translation[c], _in_b.translation[c], _out_block.translation[c]);
+				lerp(_in_a.scale[c], _in_b.scale[c], _out_block.scale[c]);
+			}
+
+			__m256 x = lerp(_in_a.rotation[0], _in_b.rotation[0], _out_block.rotation[0]);
+			__m256 y = lerp(_in_a.rotation[1], _in_b.rotation[1], _out_block.rotation[1]);
+			__m256 z = lerp(_in_a.rotation[2], _in_b.rotation[2], _out_block.rotation[2]);
+			__m256 w = lerp(_in_a.rotation[3], _in_b.rotation[3], _out_block.rotation[3]);
+
+			__m256 length = _mm256_sqrt_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, x), _mm256_mul_ps(y, y)),
+				_mm256_add_ps(_mm256_mul_ps(z, z), _mm256_mul_ps(w, w))));
+			__m256 scale = _mm256_div_ps(_mm256_set1_ps(1.0f), length);
+
+			_mm256_store_ps(_out_block.rotation[0], _mm256_mul_ps(x, scale));
+			_mm256_store_ps(_out_block.rotation[1], _mm256_mul_ps(y, scale));
+			_mm256_store_ps(_out_block.rotation[2], _mm256_mul_ps(z, scale));
+			_mm256_store_ps(_out_block.rotation[3], _mm256_mul_ps(w, scale));
+#elif defined(FBXRT_SSE2)
+			__m128 u = _mm_set1_ps(_in_u);
+			auto lerp = [&](const float* _in_a_p, const float* _in_b_p, float* _out_p)
+			{
+				__m128 a = _mm_load_ps(_in_a_p);
+				__m128 b = _mm_load_ps(_in_b_p);
+				__m128 value = _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), u));
+				_mm_store_ps(_out_p, value);
+				return value;
+			};
+
+			for (uint32_t c = 0; c < 3; c++)
+			{
+				lerp(_in_a.translation[c], _in_b.translation[c], _out_block.translation[c]);
+				lerp(_in_a.scale[c], _in_b.scale[c], _out_block.scale[c]);
+			}
+
+			__m128 x = lerp(_in_a.rotation[0], _in_b.rotation[0], _out_block.rotation[0]);
+			__m128 y = lerp(_in_a.rotation[1], _in_b.rotation[1], _out_block.rotation[1]);
+			__m128 z = lerp(_in_a.rotation[2], _in_b.rotation[2], _out_block.rotation[2]);
+			__m128 w = lerp(_in_a.rotation[3], _in_b.rotation[3], _out_block.rotation[3]);
+
+			__m128 length = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)),
+				_mm_add_ps(_mm_mul_ps(z, z), _mm_mul_ps(w, w))));
+			__m128 scale = _mm_div_ps(_mm_set1_ps(1.0f), length);
+
+			_mm_store_ps(_out_block.rotation[0], _mm_mul_ps(x, scale));
+			_mm_store_ps(_out_block.rotation[1], _mm_mul_ps(y, scale));
+			_mm_store_ps(_out_block.rotation[2], _mm_mul_ps(z, scale));
+			_mm_store_ps(_out_block.rotation[3], _mm_mul_ps(w, scale));
+#else
+			for (uint32_t lane = 0; lane < JOINT_LANES; lane++)
+			{
+				for (uint32_t c = 0; c < 3; c++)
+				{
+					_out_block.translation[c][lane] = _in_a.translation[c][lane]
+						+ (_in_b.translation[c][lane] - _in_a.translation[c][lane]) * _in_u;
+					_out_block.scale[c][lane] = _in_a.scale[c][lane]
+						+ (_in_b.scale[c][lane] - _in_a.scale[c][lane]) * _in_u;
+				}
+
+				float length = 0.0f;
+				for (uint32_t c = 0; c < 4; c++)
+				{
+					_out_block.rotation[c][lane] = _in_a.rotation[c][lane]
+						+ (_in_b.rotation[c][lane] - _in_a.rotation[c][lane]) * _in_u;
+					length += _out_block.rotation[c][lane] * _out_block.rotation[c][lane];
+				}
+
+				length = sqrtf(length);
+				for (uint32_t c = 0; c < 4; c++)
+					_out_block.rotation[c][lane] /= length;
+			}
+#endif
+		}
+#pragma endregion
+
+#pragma region Interface Function Definitions
+		Result LoadAnimationClip(
+			const char*					_in_animFilepath
+			, AnimationClip&			_out_animationClip
+		) {
+			if (_in_animFilepath == nullptr)
+				return Result::INVALID_ARG;
+
+			// keys are resampled straight out of the mapping, without reading the file into memory first
+			MappedContainer container;
+			if (MapContainerFile(_in_animFilepath, container) != Result::SUCCESS)
+				return Result::FAIL;
+
+			AnimationView view;
+			if (GetAnimationView(container, view) != Result::SUCCESS)
+			{
+				UnmapContainerFile(container);
+				return Result::FAIL;
+			}
+
+			_out_animationClip.joints.resize(view.joints.size);
+			for (size_t j = 0; j < view.joints.size; j++)
+			{
+				memcpy(_out_animationClip.joints[j].global_transform, view.joints[j].global_transform, sizeof(float) * 16);
+				_out_animationClip.joints[j].parent_index = view.joints[j].parent_index;
+			}
+
+			std::vector<KeyTrack> tracks;
+			ReadContainerAnimationKeys(view, tracks);
+			ResampleAnimationClipKeys(tracks, view.info_p->duration, view.info_p->joint_count, _out_animationClip);
+
+			UnmapContainerFile(container);
+			return Result::SUCCESS;
+		}
+
+		Result LoadAnimationLibrary(
+			const char*					_in_animlibFilepath
+			, AnimationLibrary&			_out_animationLibrary
+		) {
+			if (_in_animlibFilepath == nullptr)
+				return Result::INVALID_ARG;
+
+			// keys are resampled straight out of the mapping, as with .anim files
+			MappedContainer container;
+			if (MapContainerFile(_in_animlibFilepath, container) != Result::SUCCESS)
+				return Result::FAIL;
+
+			AnimationLibraryView view;
+			if (GetAnimationLibraryView(container, view) != Result::SUCCESS)
+			{
+				UnmapContainerFile(container);
+				return Result::FAIL;
+			}
+
+			_out_animationLibrary.skeletons.resize(view.skeletons.size);
+			for (size_t s = 0; s < view.skeletons.size; s++)
+			{
+				const AnimationSkeletonRecord& record = view.skeletons[s];
+				AnimationSkeleton& skeleton = _out_animationLibrary.skeletons[s];
+
+				skeleton.hash = record.hash;
+				skeleton.joints.resize(record.joint_count);
+				for (uint32_t j = 0; j < record.joint_count; j++)
+				{
+					const ContainerJoint& joint = view.joints[record.joint_offset + j];
+					memcpy(skeleton.joints[j].global_transform, joint.global_transform, sizeof(float) * 16);
+					skeleton.joints[j].parent_index = joint.parent_index;
+				}
+			}
+
+			// each clip is read as an .anim file whose channels start at the clip's first track
+			_out_animationLibrary.clips.resize(view.clips.size);
+			std::vector<KeyTrack> tracks;
+			for (size_t c = 0; c < view.clips.size; c++)
+			{
+				const AnimationClipRecord& record = view.clips[c];
+				const AnimationSkeletonRecord& skeleton = view.skeletons[record.skeleton];
+				AnimationClip& clip = _out_animationLibrary.clips[c];
+
+				AnimationInfo info;
+				info.format = view.info_p->format;
+				info.joint_count = skeleton.joint_count;
+				info.duration = record.duration;
+
+				AnimationView clipView;
+				clipView.info_p = &info;
+				clipView.tracks.data_p = view.tracks.data_p + record.track_offset;
+				clipView.tracks.size = (size_t)skeleton.joint_count * 3;
+				clipView.times = view.times;
+				clipView.values = view.values;
+				clipView.quantized_times = view.quantized_times;
+				clipView.quantized_values = view.quantized_values;
+
+				// clips share their skeleton's bind pose instead of keeping their own
+				clip.name.assign(view.strings.data_p + record.name_offset, record.name_length);
+				clip.skeleton_hash = skeleton.hash;
+
+				ReadContainerAnimationKeys(clipView, tracks);
+				ResampleAnimationClipKeys(tracks, record.duration, skeleton.joint_count, clip);
+			}
+
+			UnmapContainerFile(container);
+			return Result::SUCCESS;
+		}
+
+		const AnimationSkeleton* FindAnimationSkeleton(
+			const AnimationLibrary&		_in_animationLibrary
+			, const uint64_t			_in_skeletonHash
+		) {
+			for (const AnimationSkeleton& skeleton : _in_animationLibrary.skeletons)
+				if (skeleton.hash == _in_skeletonHash)
+					return &skeleton;
+
+			return nullptr;
+		}
+
+		void InitializeAnimationPose(
+			const AnimationClip&		_in_animationClip
+			, AnimationPose&			_out_pose
+		) {
+			_out_pose.joint_count = _in_animationClip.joint_count;
+			_out_pose.blocks.resize(_in_animationClip.block_count);
+
+			for (uint32_t b = 0; b < _in_animationClip.block_count; b++)
+				SetIdentityJointBlock(_out_pose.blocks[b]);
+		}
+
+		void SampleAnimationClip(
+			const AnimationClip&		_in_animationClip
+			, const float				_in_time
+			, AnimationPose&			_out_pose
+		) {
+			uint32_t keyCount = _in_animationClip.key_count;
+			uint32_t blockCount = _in_animationClip.block_count;
+
+			if (keyCount == 0)
+				return;
+
+			// find the keys around the sample time
+			float position = _in_animationClip.key_interval > 0.0f
+				? (_in_time - _in_animationClip.start_time) / _in_animationClip.key_interval : 0.0f;
+			position = std::min(std::max(position, 0.0f), (float)(keyCount - 1));
+
+			uint32_t key = std::min((uint32_t)position, keyCount - 1);
+			uint32_t next = std::min(key + 1, keyCount - 1);
+			float u = position - key;
+
+			const JointBlock* a_p = &_in_animationClip.blocks[(size_t)key * blockCount];
+			const JointBlock* b_p = &_in_animationClip.blocks[(size_t)next * blockCount];
+
+			for (uint32_t b = 0; b < blockCount; b++)
+				InterpolateJointBlock(a_p[b], b_p[b], u, _out_pose.blocks[b]);
+		}
+
+		void GetAnimationPoseJoint(
+			const AnimationPose&		_in_pose
+			, const uint32_t			_in_jointIndex
+			, float*					_out_translation_p
+			, float*					_out_rotation_p
+			, float*					_out_scale_p
+		) {
+			const JointBlock& block = _in_pose.blocks[_in_jointIndex / JOINT_LANES];
+			uint32_t lane = _in_jointIndex % JOINT_LANES;
+
+			for (uint32_t c = 0; c < 3; c++)
+			{
+				_out_translation_p[c] = block.translation[c][lane];
+				_out_scale_p[c] = block.scale[c][lane];
+			}
+			for (uint32_t c = 0; c < 4; c++)
+				_out_rotation_p[c] = block.rotation[c][lane];
+		}
+#pragma endregion
+
+	}
+}
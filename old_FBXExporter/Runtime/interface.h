@@ -0,0 +1,106 @@
+#ifndef _FBXEXPORTER_RUNTIME_INTERFACE_H_
+#define _FBXEXPORTER_RUNTIME_INTERFACE_H_
+
+#include <cstdint>
+
+#include "defines.h"
+
+namespace fbx_exporter
+{
+	namespace runtime
+	{
+		/* Loads an exported .anim file and resamples its keys into joint blocks.
+		  PARAMETERS
+			_in_animFilepath : The path to the .anim file to read from.
+			_out_animationClip : The clip loaded.
+		  RETURNS
+			INVALID_ARG : An invalid argument was passed.
+			FAIL : File could not be opened or is not a valid .anim file.
+			SUCCESS : The clip was loaded.
+		  NOTES
+			The container header and the bounds and alignment of every section are checked before
+			any key is read. Keys are resampled at the smallest interval between keys in the file.
+			Exported keys lie on the grid they were sampled from, so the resampled clip
+			interpolates to the same values as the file.
+		*/
+		Result LoadAnimationClip(
+			const char*					_in_animFilepath
+			, AnimationClip&			_out_animationClip
+		);
+
+		/* Loads an exported animation library and resamples every clip into joint blocks.
+		  PARAMETERS
+			_in_animlibFilepath : The path to the .animlib file to read from.
+			_out_animationLibrary : The skeletons and clips loaded.
+		  RETURNS
+			INVALID_ARG : An invalid argument was passed.
+			FAIL : File could not be opened, is not a valid .animlib file, or a record reaches past the
+			  section it addresses.
+			SUCCESS : The library was loaded.
+		  NOTES
+			The file is mapped, and its header, section table and every skeleton, clip and channel record
+			are checked before any key is read. Clips are resampled as in LoadAnimationClip.
+			Clips keep no joints of their own. Use FindAnimationSkeleton to get their bind pose.
+		*/
+		Result LoadAnimationLibrary(
+			const char*					_in_animlibFilepath
+			, AnimationLibrary&			_out_animationLibrary
+		);
+
+		/* Finds the skeleton a library clip animates.
+		  PARAMETERS
+			_in_animationLibrary : The library to search.
+			_in_skeletonHash : The skeleton hash of a clip.
+		  RETURNS
+			const AnimationSkeleton* : The skeleton, or nullptr if the library has no such skeleton.
+		*/
+		const AnimationSkeleton* FindAnimationSkeleton(
+			const AnimationLibrary&		_in_animationLibrary
+			, const uint64_t			_in_skeletonHash
+		);
+
+		/* Sizes a pose to hold every joint of a clip.
+		  PARAMETERS
+			_in_animationClip : The clip the pose will be sampled from.
+			_out_pose : The pose to initialize. Every joint is set to the identity.
+		*/
+		void InitializeAnimationPose(
+			const AnimationClip&		_in_animationClip
+			, AnimationPose&			_out_pose
+		);
+
+		/* Samples every joint of a clip at a point in time.
+		  PARAMETERS
+			_in_animationClip : The clip to sample.
+			_in_time : The time to sample, in seconds. Clamped to the first and last key.
+			_out_pose : The pose sampled. Must be initialized for the clip.
+		  NOTES
+			Translation and scale are interpolated linearly, rotations with normalized linear
+			interpolation. JOINT_LANES joints are interpolated by each SIMD operation.
+		*/
+		void SampleAnimationClip(
+			const AnimationClip&		_in_animationClip
+			, const float				_in_time
+			, AnimationPose&			_out_pose
+		);
+
+		/* Reads the transformation of one joint from a pose.
+		  PARAMETERS
+			_in_pose : The pose to read from.
+			_in_jointIndex : The joint to read.
+			_out_translation_p : Storage for the position vector.
+			_out_rotation_p : Storage for the unit quaternion as xyzw.
+			_out_scale_p : Storage for the scale vector.
+		*/
+		void GetAnimationPoseJoint(
+			const AnimationPose&		_in_pose
+			, const uint32_t			_in_jointIndex
+			, float*					_out_translation_p
+			, float*					_out_rotation_p
+			, float*					_out_scale_p
+		);
+
+	}
+}
+
+#endif // _FBXEXPORTER_RUNTIME_INTERFACE_H_
@@ -0,0 +1,697 @@
+#ifndef _FBXEXPORTER_RUNTIME_LOADER_H_
+#define _FBXEXPORTER_RUNTIME_LOADER_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "container.h"
+#include "defines.h"
+
+namespace fbx_exporter
+{
+	namespace runtime
+	{
+		// Read-only run of elements inside a mapped container file.
+		template <typename T>
+		struct Span
+		{
+			const T*	data_p = nullptr;  // First element. nullptr if the file has no such section.
+			size_t		size = 0;  // Number of elements.
+
+			const T& operator[](size_t i) const { return data_p[i]; }
+			const T* begin() const { return data_p; }
+			const T* end() const { return data_p + size; }
+			bool empty() const { return size == 0; }
+		};
+
+		// Exported container file mapped read-only into memory. Pages are read from disk when first touched.
+		struct MappedContainer
+		{
+			const char*	data_p = nullptr;  // Start of the file. nullptr if nothing is mapped.
+			uint64_t	size = 0;  // Length of the file in bytes.
+		};
+
+		// Sections of a mapped .mesh file.
+		struct MeshView
+		{
+			const MeshInfo*				info_p = nullptr;  // Layout of vertices and indices.
+			Span<uint8_t>				vertices;  // Vertex bytes, info_p->vertex_stride per vertex.
+			Span<uint16_t>				short_indices;  // Indices if info_p->index_size is 2. Empty otherwise.
+			Span<uint32_t>				indices;  // Indices if info_p->index_size is 4. Empty otherwise.
+			Span<MeshSubmeshRecord>		submeshes;  // Submeshes. Empty if the mesh was not split.
+			Span<MeshLodRecord>			lods;  // Levels of detail. Empty if none were generated.
+			Span<MeshPartRecord>		parts;  // Parts. Empty if the mesh has one part without a material.
+			Span<MeshletRecord>			meshlets;  // Meshlets. Empty if none were built.
+			Span<uint32_t>				meshlet_vertices;  // Mesh vertex per meshlet vertex.
+			Span<uint8_t>				meshlet_triangles;  // Local vertex indices, three per meshlet triangle.
+			Span<char>					strings;  // Part names, addressed by MeshPartRecord::name_offset.
+		};
+
+		// Sections of a mapped .mat file.
+		struct MaterialsView
+		{
+			Span<MaterialRecord>		materials;  // Materials.
+			Span<TexturePathRecord>		textures;  // Texture filepaths, addressed by MaterialComponentRecord::input.
+			Span<char>					strings;  // Texture filepath characters, addressed by TexturePathRecord::offset.
+		};
+
+		// Sections of a mapped .anim file.
+		struct AnimationView
+		{
+			const AnimationInfo*		info_p = nullptr;  // Key layout, joint count and duration.
+			Span<ContainerJoint>		joints;  // Bind pose joints. Parents precede their children.
+			Span<AnimationTrackRecord>	tracks;  // Translation, rotation and scale channel of each joint.
+			Span<float>					times;  // Key times in seconds, for AnimationFormat::FLOAT_KEYS.
+			Span<float>					values;  // Key values, for AnimationFormat::FLOAT_KEYS.
+			Span<uint16_t>				quantized_times;  // Key times, for AnimationFormat::QUANTIZED_KEYS.
+			Span<uint16_t>				quantized_values;  // Key values, for AnimationFormat::QUANTIZED_KEYS.
+		};
+
+		// Sections of a mapped .animlib file.
+		struct AnimationLibraryView
+		{
+			const AnimationLibraryInfo*	info_p = nullptr;  // Key layout, skeleton count and clip count.
+			Span<AnimationSkeletonRecord>	skeletons;  // Skeletons, each addressing its joints.
+			Span<AnimationClipRecord>	clips;  // Clips, each addressing its skeleton, name and channels.
+			Span<ContainerJoint>		joints;  // Bind pose joints of every skeleton. Parents precede their children.
+			Span<AnimationTrackRecord>	tracks;  // Translation, rotation and scale channel of each joint of every clip.
+			Span<float>					times;  // Key times in seconds, for AnimationFormat::FLOAT_KEYS.
+			Span<float>					values;  // Key values, for AnimationFormat::FLOAT_KEYS.
+			Span<uint16_t>				quantized_times;  // Key times, for AnimationFormat::QUANTIZED_KEYS.
+			Span<uint16_t>				quantized_values;  // Key values, for AnimationFormat::QUANTIZED_KEYS.
+			Span<char>					strings;  // Clip names, addressed by AnimationClipRecord::name_offset.
+		};
+
+		// Sections of a mapped .tex file.
+		struct TextureView
+		{
+			const TextureInfo*			info_p = nullptr;  // Format and size.
+			Span<uint8_t>				blocks;  // Block bytes, info_p->block_size per block, ready to upload.
+		};
+
+
+#pragma region Function Definitions
+		/* Maps an exported container file read-only into memory without reading it.
+		  PARAMETERS
+			_in_filepath : The path to the file to map.
+			_out_container : The mapping. Release it with UnmapContainerFile.
+		  RETURNS
+			INVALID_ARG : An invalid argument was passed.
+			FAIL : The file could not be opened, is empty, or could not be mapped.
+			SUCCESS : The file was mapped.
+		  NOTES
+			Nothing is validated here; the view functions validate the header and section table.
+		*/
+		inline Result MapContainerFile(
+			const char*					_in_filepath
+			, MappedContainer&			_out_container
+		) {
+			if (_in_filepath == nullptr)
+				return Result::INVALID_ARG;
+
+			_out_container = MappedContainer();
+
+#if defined(_WIN32)
+			HANDLE file_h = CreateFileA(_in_filepath, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+				FILE_ATTRIBUTE_NORMAL, nullptr);
+			if (file_h == INVALID_HANDLE_VALUE)
+				return Result::FAIL;
+
+			LARGE_INTEGER size;
+			HANDLE mapping_h = nullptr;
+			if (GetFileSizeEx(file_h, &size) && size.QuadPart > 0)
+				mapping_h = CreateFileMappingA(file_h, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+			// the view keeps the mapping and file open on its own
+			const void* data_p = mapping_h != nullptr ? MapViewOfFile(mapping_h, FILE_MAP_READ, 0, 0, 0) : nullptr;
+			if (mapping_h != nullptr)
+				CloseHandle(mapping_h);
+			CloseHandle(file_h);
+
+			if (data_p == nullptr)
+				return Result::FAIL;
+
+			_out_container.data_p = (const char*)data_p;
+			_out_container.size = (uint64_t)size.QuadPart;
+#else
+			int file = open(_in_filepath, O_RDONLY);
+			if (file < 0)
+				return Result::FAIL;
+
+			struct stat status;
+			void* data_p = MAP_FAILED;
+			if (fstat(file, &status) == 0 && status.st_size > 0)
+				data_p = mmap(nullptr, (size_t)status.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+
+			// the mapping keeps the file open on its own
+			close(file);
+
+			if (data_p == MAP_FAILED)
+				return Result::FAIL;
+
+			_out_container.data_p = (const char*)data_p;
+			_out_container.size = (uint64_t)status.st_size;
+#endif
+
+			return Result::SUCCESS;
+		}
+
+		/* Releases a mapping made by MapContainerFile. Views into it become invalid.
+		  PARAMETERS
+			_out_container : The mapping to release. Emptied.
+		*/
+		inline void UnmapContainerFile(
+			MappedContainer&			_out_container
+		) {
+			if (_out_container.data_p != nullptr)
+			{
+#if defined(_WIN32)
+				UnmapViewOfFile(_out_container.data_p);
+#else
+				munmap((void*)_out_container.data_p, (size_t)_out_container.size);
+#endif
+			}
+
+			_out_container = MappedContainer();
+		}
+
+		/* Asks the OS to start reading a range of a mapped file from disk before it is touched.
+		  PARAMETERS
+			_in_container : The mapping the range lies in.
+			_in_data_p : The start of the range.
+			_in_size : The length of the range in bytes.
+		  NOTES
+			Only a hint; pages not read ahead are still read on first touch. Does nothing where
+			the OS has no such hint.
+		*/
+		inline void PrefetchContainerRange(
+			const MappedContainer&		_in_container
+			, const void*				_in_data_p
+			, const size_t				_in_size
+		) {
+			if (_in_data_p == nullptr || _in_size == 0)
+				return;
+
+#if defined(_WIN32)
+#if defined(_WIN32_WINNT_WIN8) && _WIN32_WINNT >= _WIN32_WINNT_WIN8
+			WIN32_MEMORY_RANGE_ENTRY range = { (PVOID)_in_data_p, _in_size };
+			PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+#endif
+			(void)_in_container;
+#else
+			// advice ranges must start on a page boundary, and the mapping starts on one
+			size_t offset = (size_t)((const char*)_in_data_p - _in_container.data_p);
+			size_t pageOffset = offset - offset % (size_t)sysconf(_SC_PAGESIZE);
+			madvise((void*)(_in_container.data_p + pageOffset), offset - pageOffset + _in_size, MADV_WILLNEED);
+#endif
+		}
+
+		/* Asks the OS to start reading a section of a mapped file from disk before it is touched.
+		  PARAMETERS
+			_in_container : The mapping the section lies in.
+			_in_span : The section, from a view of the mapping.
+		*/
+		template <typename T>
+		inline void PrefetchContainerSection(
+			const MappedContainer&		_in_container
+			, const Span<T>&			_in_span
+		) {
+			PrefetchContainerRange(_in_container, _in_span.data_p, _in_span.size * sizeof(T));
+		}
+
+		/* Checks that a container file in memory holds the expected data and that every section lies within it.
+		  PARAMETERS
+			_in_data_p : The start of the file.
+			_in_size : The length of the file in bytes.
+			_in_type : The kind of container expected.
+		  RETURNS
+			true : The header and every section table entry are valid.
+			false : The file is truncated, of another type or major version, or a section is out of bounds or misaligned.
+		  NOTES
+			Reads only the header and section table, so the pages of the sections stay untouched.
+		*/
+		inline bool ValidateContainer(
+			const char*					_in_data_p
+			, const uint64_t			_in_size
+			, const ContainerType		_in_type
+		) {
+			if (_in_data_p == nullptr || _in_size < sizeof(ContainerHeader))
+				return false;
+
+			const ContainerHeader* header_p = (const ContainerHeader*)_in_data_p;
+			if (header_p->magic != CONTAINER_MAGIC || header_p->version_major != CONTAINER_VERSION_MAJOR
+				|| header_p->type != _in_type || header_p->file_size > _in_size
+				|| header_p->section_table_offset % CONTAINER_TABLE_ALIGNMENT != 0
+				|| header_p->section_table_offset > header_p->file_size
+				|| header_p->section_count > (header_p->file_size - header_p->section_table_offset) / sizeof(ContainerSection))
+				return false;
+
+			const ContainerSection* sections_p = (const ContainerSection*)(_in_data_p + header_p->section_table_offset);
+			for (uint32_t i = 0; i < header_p->section_count; i++)
+			{
+				const ContainerSection& section = sections_p[i];
+				if (section.element_size == 0 || section.alignment == 0 || (section.alignment & (section.alignment - 1)) != 0
+					|| section.offset % section.alignment != 0 || section.offset > header_p->file_size
+					|| section.element_count > (header_p->file_size - section.offset) / section.element_size)
+					return false;
+			}
+
+			return true;
+		}
+
+		/* Finds a section of a validated container file.
+		  PARAMETERS
+			_in_data_p : The start of the file.
+			_in_type : The section to find.
+			_out_span : The elements of the section. Empty if the file has no such section.
+		  RETURNS
+			true : The section was found with elements of type T, or the file has no such section.
+			false : The section's elements are not the size of T.
+		*/
+		template <typename T>
+		inline bool GetContainerSection(
+			const char*					_in_data_p
+			, const SectionType			_in_type
+			, Span<T>&					_out_span
+		) {
+			const ContainerHeader* header_p = (const ContainerHeader*)_in_data_p;
+			const ContainerSection* sections_p = (const ContainerSection*)(_in_data_p + header_p->section_table_offset);
+
+			_out_span = Span<T>();
+			for (uint32_t i = 0; i < header_p->section_count; i++)
+				if (sections_p[i].type == _in_type)
+				{
+					if (sections_p[i].element_size != sizeof(T))
+						return false;
+
+					_out_span.data_p = (const T*)(_in_data_p + sections_p[i].offset);
+					_out_span.size = (size_t)sections_p[i].element_count;
+					return true;
+				}
+
+			return true;
+		}
+
+		/* Checks that the channels of an .anim or .animlib file address only keys within the key sections.
+		  PARAMETERS
+			_in_tracks : The channel records, translation, rotation and scale per joint.
+			_in_quantized : Whether keys are stored as AnimationFormat::QUANTIZED_KEYS.
+			_in_timeCount : The number of key times in the file.
+			_in_valueCount : The number of key value components in the file.
+		  RETURNS
+			true : Every channel's keys lie within the key sections.
+			false : A channel reaches past the key sections, or a channel that must have keys has none.
+		  NOTES
+			Only quantized vector channels may be constant, with their value in the record.
+		*/
+		inline bool ValidateAnimationTracks(
+			const Span<AnimationTrackRecord>&	_in_tracks
+			, const bool				_in_quantized
+			, const size_t				_in_timeCount
+			, const size_t				_in_valueCount
+		) {
+			if (_in_tracks.size % 3 != 0)
+				return false;
+
+			for (size_t t = 0; t < _in_tracks.size; t++)
+			{
+				const AnimationTrackRecord& record = _in_tracks[t];
+				bool rotation = t % 3 == 1;
+				uint64_t componentCount = _in_quantized ? 3 : (rotation ? 4 : 3);
+
+				if ((record.key_count == 0 && (!_in_quantized || rotation))
+					|| (uint64_t)record.time_offset + record.key_count > _in_timeCount
+					|| (uint64_t)record.value_offset + record.key_count * componentCount > _in_valueCount)
+					return false;
+			}
+
+			return true;
+		}
+
+		/* Gets the sections of a mapped .mesh file.
+		  PARAMETERS
+			_in_container : The mapped file.
+			_out_view : The sections, pointing into the mapping.
+		  RETURNS
+			FAIL : The file is not a valid .mesh file, or a record reaches past the section it addresses.
+			SUCCESS : The view points at the file's sections.
+		  NOTES
+			Every submesh, level of detail, part and meshlet record is checked, so the ranges they address
+			can be read without further bounds checks. Index and meshlet vertex values are not checked.
+		*/
+		inline Result GetMeshView(
+			const MappedContainer&		_in_container
+			, MeshView&					_out_view
+		) {
+			_out_view = MeshView();
+
+			if (!ValidateContainer(_in_container.data_p, _in_container.size, ContainerType::MESH))
+				return Result::FAIL;
+
+			const char* data_p = _in_container.data_p;
+			Span<MeshInfo> info;
+			if (!GetContainerSection(data_p, SectionType::MESH_INFO, info) || info.size != 1)
+				return Result::FAIL;
+
+			// vertices and indices have their size in the section table, so check it against the info
+			const ContainerHeader* header_p = (const ContainerHeader*)data_p;
+			const ContainerSection* sections_p = (const ContainerSection*)(data_p + header_p->section_table_offset);
+			for (uint32_t i = 0; i < header_p->section_count; i++)
+			{
+				const ContainerSection& section = sections_p[i];
+				if (section.type == SectionType::VERTICES)
+				{
+					if (section.element_size != info[0].vertex_stride || section.element_count != info[0].vertex_count)
+						return Result::FAIL;
+					_out_view.vertices.data_p = (const uint8_t*)(data_p + section.offset);
+					_out_view.vertices.size = (size_t)(section.element_count * section.element_size);
+				}
+				else if (section.type == SectionType::INDICES)
+				{
+					if (section.element_size != info[0].index_size || section.element_count != info[0].index_count)
+						return Result::FAIL;
+					if (section.element_size == sizeof(uint16_t))
+					{
+						_out_view.short_indices.data_p = (const uint16_t*)(data_p + section.offset);
+						_out_view.short_indices.size = (size_t)section.element_count;
+					}
+					else if (section.element_size == sizeof(uint32_t))
+					{
+						_out_view.indices.data_p = (const uint32_t*)(data_p + section.offset);
+						_out_view.indices.size = (size_t)section.element_count;
+					}
+					else
+						return Result::FAIL;
+				}
+			}
+
+			_out_view.info_p = info.data_p;
+			if (_out_view.vertices.empty() || (_out_view.short_indices.empty() && _out_view.indices.empty())
+				|| !GetContainerSection(data_p, SectionType::SUBMESHES, _out_view.submeshes)
+				|| !GetContainerSection(data_p, SectionType::LODS, _out_view.lods)
+				|| !GetContainerSection(data_p, SectionType::PARTS, _out_view.parts)
+				|| !GetContainerSection(data_p, SectionType::MESHLETS, _out_view.meshlets)
+				|| !GetContainerSection(data_p, SectionType::MESHLET_VERTICES, _out_view.meshlet_vertices)
+				|| !GetContainerSection(data_p, SectionType::MESHLET_TRIANGLES, _out_view.meshlet_triangles)
+				|| !GetContainerSection(data_p, SectionType::STRINGS, _out_view.strings))
+			{
+				_out_view = MeshView();
+				return Result::FAIL;
+			}
+
+			// every record must address only indices, vertices, meshlets, parts and characters in the file
+			uint64_t indexCount = info[0].index_count, vertexCount = info[0].vertex_count;
+			auto inRange = [](uint64_t _in_offset, uint64_t _in_count, uint64_t _in_size)
+			{
+				return _in_offset + _in_count <= _in_size;
+			};
+
+			bool valid = true;
+			for (size_t i = 0; valid && i < _out_view.submeshes.size; i++)
+			{
+				const MeshSubmeshRecord& submesh = _out_view.submeshes[i];
+				valid = inRange(submesh.index_offset, submesh.index_count, indexCount)
+					&& inRange(submesh.base_vertex, submesh.vertex_count, vertexCount);
+			}
+
+			for (size_t i = 0; valid && i < _out_view.lods.size; i++)
+			{
+				const MeshLodRecord& lod = _out_view.lods[i];
+				valid = inRange(lod.index_offset, lod.index_count, indexCount)
+					&& inRange(lod.meshlet_offset, lod.meshlet_count, _out_view.meshlets.size)
+					&& inRange(lod.part_offset, lod.part_count, _out_view.parts.size);
+			}
+
+			for (size_t i = 0; valid && i < _out_view.parts.size; i++)
+			{
+				const MeshPartRecord& part = _out_view.parts[i];
+				valid = inRange(part.name_offset, part.name_length, _out_view.strings.size)
+					&& inRange(part.index_offset, part.index_count, indexCount)
+					&& inRange(part.base_vertex, part.vertex_count, vertexCount)
+					&& inRange(part.meshlet_offset, part.meshlet_count, _out_view.meshlets.size);
+			}
+
+			for (size_t i = 0; valid && i < _out_view.meshlets.size; i++)
+			{
+				const MeshletRecord& meshlet = _out_view.meshlets[i];
+				valid = inRange(meshlet.vertex_offset, meshlet.vertex_count, _out_view.meshlet_vertices.size)
+					&& inRange(meshlet.triangle_offset, (uint64_t)meshlet.triangle_count * 3, _out_view.meshlet_triangles.size);
+			}
+
+			if (!valid)
+			{
+				_out_view = MeshView();
+				return Result::FAIL;
+			}
+
+			return Result::SUCCESS;
+		}
+
+		/* Gets the sections of a mapped .mat file.
+		  PARAMETERS
+			_in_container : The mapped file.
+			_out_view : The sections, pointing into the mapping.
+		  RETURNS
+			FAIL : The file is not a valid .mat file.
+			SUCCESS : The view points at the file's sections.
+		*/
+		inline Result GetMaterialsView(
+			const MappedContainer&		_in_container
+			, MaterialsView&			_out_view
+		) {
+			_out_view = MaterialsView();
+
+			if (!ValidateContainer(_in_container.data_p, _in_container.size, ContainerType::MATERIALS)
+				|| !GetContainerSection(_in_container.data_p, SectionType::MATERIALS, _out_view.materials)
+				|| !GetContainerSection(_in_container.data_p, SectionType::TEXTURES, _out_view.textures)
+				|| !GetContainerSection(_in_container.data_p, SectionType::STRINGS, _out_view.strings))
+			{
+				_out_view = MaterialsView();
+				return Result::FAIL;
+			}
+
+			// filepaths must lie within the strings, and components must name an existing texture
+			for (size_t t = 0; t < _out_view.textures.size; t++)
+			{
+				const TexturePathRecord& texture = _out_view.textures[t];
+				if ((uint64_t)texture.offset + texture.length > _out_view.strings.size)
+				{
+					_out_view = MaterialsView();
+					return Result::FAIL;
+				}
+			}
+
+			for (size_t m = 0; m < _out_view.materials.size; m++)
+				for (const MaterialComponentRecord& component : _out_view.materials[m].components)
+					if (component.input < -1 || (component.input >= 0
+						&& (size_t)component.input >= _out_view.textures.size))
+					{
+						_out_view = MaterialsView();
+						return Result::FAIL;
+					}
+
+			return Result::SUCCESS;
+		}
+
+		/* Gets the sections of a mapped .anim file.
+		  PARAMETERS
+			_in_container : The mapped file.
+			_out_view : The sections, pointing into the mapping.
+		  RETURNS
+			FAIL : The file is not a valid .anim file, or a channel reaches past the key sections.
+			SUCCESS : The view points at the file's sections.
+		  NOTES
+			Every channel record is checked, so its keys can be read without further bounds checks.
+		*/
+		inline Result GetAnimationView(
+			const MappedContainer&		_in_container
+			, AnimationView&			_out_view
+		) {
+			_out_view = AnimationView();
+
+			if (!ValidateContainer(_in_container.data_p, _in_container.size, ContainerType::ANIMATION))
+				return Result::FAIL;
+
+			const char* data_p = _in_container.data_p;
+			Span<AnimationInfo> info;
+			bool valid = GetContainerSection(data_p, SectionType::ANIMATION_INFO, info) && info.size == 1
+				&& GetContainerSection(data_p, SectionType::JOINTS, _out_view.joints)
+				&& GetContainerSection(data_p, SectionType::TRACKS, _out_view.tracks)
+				&& info[0].joint_count > 0 && _out_view.joints.size == info[0].joint_count
+				&& _out_view.tracks.size == (size_t)info[0].joint_count * 3;
+
+			size_t timeCount = 0, valueCount = 0;
+			bool quantized = false;
+			if (valid && info[0].format == AnimationFormat::FLOAT_KEYS)
+			{
+				valid = GetContainerSection(data_p, SectionType::KEY_TIMES, _out_view.times)
+					&& GetContainerSection(data_p, SectionType::KEY_VALUES, _out_view.values);
+				timeCount = _out_view.times.size;
+				valueCount = _out_view.values.size;
+			}
+			else if (valid && info[0].format == AnimationFormat::QUANTIZED_KEYS)
+			{
+				quantized = true;
+				valid = GetContainerSection(data_p, SectionType::KEY_TIMES, _out_view.quantized_times)
+					&& GetContainerSection(data_p, SectionType::KEY_VALUES, _out_view.quantized_values);
+				timeCount = _out_view.quantized_times.size;
+				valueCount = _out_view.quantized_values.size;
+			}
+			else
+				valid = false;
+
+			if (!valid || !ValidateAnimationTracks(_out_view.tracks, quantized, timeCount, valueCount))
+			{
+				_out_view = AnimationView();
+				return Result::FAIL;
+			}
+
+			_out_view.info_p = info.data_p;
+			return Result::SUCCESS;
+		}
+
+		/* Gets the sections of a mapped .animlib file.
+		  PARAMETERS
+			_in_container : The mapped file.
+			_out_view : The sections, pointing into the mapping.
+		  RETURNS
+			FAIL : The file is not a valid .animlib file, or a record reaches past the section it addresses.
+			SUCCESS : The view points at the file's sections.
+		  NOTES
+			Every skeleton, clip and channel record is checked, so each clip's joints, name and keys can be
+			read without further bounds checks.
+		*/
+		inline Result GetAnimationLibraryView(
+			const MappedContainer&		_in_container
+			, AnimationLibraryView&		_out_view
+		) {
+			_out_view = AnimationLibraryView();
+
+			if (!ValidateContainer(_in_container.data_p, _in_container.size, ContainerType::ANIMATION_LIBRARY))
+				return Result::FAIL;
+
+			const char* data_p = _in_container.data_p;
+			Span<AnimationLibraryInfo> info;
+			bool valid = GetContainerSection(data_p, SectionType::ANIMATION_LIBRARY_INFO, info) && info.size == 1
+				&& GetContainerSection(data_p, SectionType::SKELETONS, _out_view.skeletons)
+				&& GetContainerSection(data_p, SectionType::CLIPS, _out_view.clips)
+				&& GetContainerSection(data_p, SectionType::JOINTS, _out_view.joints)
+				&& GetContainerSection(data_p, SectionType::TRACKS, _out_view.tracks)
+				&& GetContainerSection(data_p, SectionType::STRINGS, _out_view.strings)
+				&& _out_view.skeletons.size == info[0].skeleton_count
+				&& _out_view.clips.size == info[0].clip_count;
+
+			size_t timeCount = 0, valueCount = 0;
+			bool quantized = false;
+			if (valid && info[0].format == AnimationFormat::FLOAT_KEYS)
+			{
+				valid = GetContainerSection(data_p, SectionType::KEY_TIMES, _out_view.times)
+					&& GetContainerSection(data_p, SectionType::KEY_VALUES, _out_view.values);
+				timeCount = _out_view.times.size;
+				valueCount = _out_view.values.size;
+			}
+			else if (valid && info[0].format == AnimationFormat::QUANTIZED_KEYS)
+			{
+				quantized = true;
+				valid = GetContainerSection(data_p, SectionType::KEY_TIMES, _out_view.quantized_times)
+					&& GetContainerSection(data_p, SectionType::KEY_VALUES, _out_view.quantized_values);
+				timeCount = _out_view.quantized_times.size;
+				valueCount = _out_view.quantized_values.size;
+			}
+			else
+				valid = false;
+
+			// skeletons must address joints, and clips a skeleton, a name and a whole channel triple per joint
+			for (size_t s = 0; valid && s < _out_view.skeletons.size; s++)
+			{
+				const AnimationSkeletonRecord& skeleton = _out_view.skeletons[s];
+				valid = skeleton.joint_count > 0
+					&& (uint64_t)skeleton.joint_offset + skeleton.joint_count <= _out_view.joints.size;
+			}
+
+			for (size_t c = 0; valid && c < _out_view.clips.size; c++)
+			{
+				const AnimationClipRecord& clip = _out_view.clips[c];
+				valid = clip.skeleton < _out_view.skeletons.size
+					&& (uint64_t)clip.name_offset + clip.name_length <= _out_view.strings.size
+					&& clip.track_offset % 3 == 0
+					&& (uint64_t)clip.track_offset + (uint64_t)_out_view.skeletons[clip.skeleton].joint_count * 3
+						<= _out_view.tracks.size;
+			}
+
+			if (!valid || !ValidateAnimationTracks(_out_view.tracks, quantized, timeCount, valueCount))
+			{
+				_out_view = AnimationLibraryView();
+				return Result::FAIL;
+			}
+
+			_out_view.info_p = info.data_p;
+			return Result::SUCCESS;
+		}
+
+		/* Gets the sections of a mapped .tex file.
+		  PARAMETERS
+			_in_container : The mapped file.
+			_out_view : The sections, pointing into the mapping.
+		  RETURNS
+			FAIL : The file is not a valid .tex file, or it does not hold one block per 4x4 pixels.
+			SUCCESS : The view points at the file's sections.
+		*/
+		inline Result GetTextureView(
+			const MappedContainer&		_in_container
+			, TextureView&				_out_view
+		) {
+			_out_view = TextureView();
+
+			if (!ValidateContainer(_in_container.data_p, _in_container.size, ContainerType::TEXTURE))
+				return Result::FAIL;
+
+			const char* data_p = _in_container.data_p;
+			Span<TextureInfo> info;
+			if (!GetContainerSection(data_p, SectionType::TEXTURE_INFO, info) || info.size != 1
+				|| (info[0].block_size != 8 && info[0].block_size != 16))
+				return Result::FAIL;
+
+			// blocks have their size in the section table, so check it against the info
+			uint64_t blockCount = (uint64_t)((info[0].width + 3) / 4) * ((info[0].height + 3) / 4);
+			const ContainerHeader* header_p = (const ContainerHeader*)data_p;
+			const ContainerSection* sections_p = (const ContainerSection*)(data_p + header_p->section_table_offset);
+			for (uint32_t i = 0; i < header_p->section_count; i++)
+			{
+				const ContainerSection& section = sections_p[i];
+				if (section.type == SectionType::TEXTURE_BLOCKS)
+				{
+					if (section.element_size != info[0].block_size || section.element_count != blockCount)
+						return Result::FAIL;
+					_out_view.blocks.data_p = (const uint8_t*)(data_p + section.offset);
+					_out_view.blocks.size = (size_t)(section.element_count * section.element_size);
+				}
+			}
+
+			if (_out_view.blocks.empty())
+				return Result::FAIL;
+
+			_out_view.info_p = info.data_p;
+			return Result::SUCCESS;
+		}
+#pragma endregion
+
+	}
+}
+
+#endif // _FBXEXPORTER_RUNTIME_LOADER_H_